@@ -0,0 +1,20 @@
+# Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+# at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+# LICENSE and NOTICE for details. LLNL-CODE-806117.
+#
+# This file is part of the MFEM library. For more information and source code
+# availability visit https://mfem.org.
+#
+# MFEM is free software; you can redistribute it and/or modify it under the
+# terms of the BSD-3 license. We welcome feedback and contributions, see file
+# CONTRIBUTING.md for details.
+
+# Script, run with 'cmake -DINPUT=<file> -DOUTPUT=<file> -DNAME=<name> -P', that
+# writes the header OUTPUT defining the string 'NAME_source' with the contents
+# of INPUT. Used to embed the element kernels shared by the library and by the
+# runtime compiled kernels (MFEM_USE_JIT) in the sources of the latter.
+file(READ "${INPUT}" JIT_SOURCE)
+get_filename_component(JIT_INPUT_NAME "${INPUT}" NAME)
+file(WRITE "${OUTPUT}"
+  "// Generated from ${JIT_INPUT_NAME} at build time, do not edit.\n"
+  "static const char *${NAME}_source = R\"_jit_(\n${JIT_SOURCE})_jit_\";\n")
@@ -52,6 +52,7 @@ option(MFEM_USE_CEED "Enable CEED" OFF)
 option(MFEM_USE_UMPIRE "Enable Umpire" OFF)
 option(MFEM_USE_SIMD "Enable use of SIMD intrinsics" OFF)
 option(MFEM_USE_ADIOS2 "Enable ADIOS2" OFF)
+option(MFEM_USE_JIT "Enable runtime compilation of specialized PA kernels" OFF)
 
 set(MFEM_MPI_NP 4 CACHE STRING "Number of processes used for MPI tests")
 
@@ -185,6 +186,13 @@ set(RAJA_DIR "${MFEM_DIR}/../raja" CACHE PATH "Path to RAJA")
 set(CEED_DIR "${MFEM_DIR}/../libCEED" CACHE PATH "Path to libCEED")
 set(UMPIRE_DIR "${MFEM_DIR}/../umpire" CACHE PATH "Path to Umpire")
 
+# Settings for the runtime compiled (JIT) kernels, MFEM_USE_JIT. An empty
+# JIT_CXX means that the C++ compiler used to build MFEM is used.
+set(JIT_CXX "" CACHE STRING "Compiler used for the JIT kernels")
+set(JIT_CXXFLAGS "-O3 -std=c++11" CACHE STRING "Flags used for the JIT kernels")
+set(JIT_CACHE_DIR ".mfem_jit_cache" CACHE STRING
+    "Directory where the compiled JIT kernels are cached")
+
 set(BLAS_INCLUDE_DIRS "" CACHE STRING "Path to BLAS headers.")
 set(BLAS_LIBRARIES "" CACHE STRING "The BLAS library.")
 set(LAPACK_INCLUDE_DIRS "" CACHE STRING "Path to LAPACK headers.")
@@ -140,6 +140,7 @@ MFEM_USE_CEED          = NO
 MFEM_USE_UMPIRE        = NO
 MFEM_USE_SIMD          = NO
 MFEM_USE_ADIOS2        = NO
+MFEM_USE_JIT           = NO
 
 # Compile and link options for zlib.
 ZLIB_DIR =
@@ -150,6 +151,13 @@ ZLIB_RPATH = -Wl,-rpath,$(ZLIB_DIR)/lib
 LIBUNWIND_OPT = -g
 LIBUNWIND_LIB = $(if $(NOTMAC),-lunwind -ldl,)
 
+# Settings for the runtime compiled (JIT) kernels, MFEM_USE_JIT
+JIT_CXX = $(MFEM_HOST_CXX)
+JIT_CXXFLAGS = -O3 -std=c++11
+JIT_CACHE_DIR = .mfem_jit_cache
+JIT_OPT =
+JIT_LIB = $(if $(NOTMAC),-ldl,)
+
 # HYPRE library configuration (needed to build the parallel version)
 HYPRE_DIR = @MFEM_DIR@/../hypre/src/hypre
 HYPRE_OPT = -I$(HYPRE_DIR)/include
@@ -33,6 +33,7 @@
 //               ex1 -pa -d occa-cuda
 //               ex1 -pa -d raja-omp
 //               ex1 -pa -d occa-omp
+//               ex1 -pa -d cpu-simd
 //               ex1 -pa -d ceed-cpu
 //             * ex1 -pa -d ceed-cuda
 //               ex1 -pa -d ceed-cuda:/gpu/cuda/shared
@@ -13,22 +13,140 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include <algorithm>
 #include <cmath>
 
+#if defined(MFEM_THREAD_SAFE) && \
+    (defined(MFEM_USE_OPENMP) || defined(MFEM_USE_LEGACY_OPENMP))
+#define MFEM_THREADED_ASSEMBLY
+#endif
+
 namespace mfem
 {
 
+// Returns true if the element loop of BilinearForm::Assemble() should use
+// OpenMP threads. This requires thread-safe integrators and finite elements,
+// i.e. MFEM_THREAD_SAFE, and either MFEM_USE_LEGACY_OPENMP or MFEM_USE_OPENMP
+// with the OpenMP device backend enabled.
+static bool AssembleUseThreads()
+{
+#if !defined(MFEM_THREADED_ASSEMBLY)
+   return false;
+#elif defined(MFEM_USE_LEGACY_OPENMP)
+   return true;
+#else
+   return Device::Allows(Backend::OMP_MASK);
+#endif
+}
+
+// Greedy coloring of the elements of 'fes' such that elements with the same
+// color do not share any degrees of freedom. Row c of the returned table lists
+// the elements of color c in increasing order.
+static Table *ColorElements(const FiniteElementSpace &fes)
+{
+   const Table &elem_dof = fes.GetElementToDofTable();
+   const int NE = elem_dof.Size();
+   const int *I = elem_dof.GetI(), *J = elem_dof.GetJ();
+
+   // dof-to-element connectivity, ignoring the orientation of the dofs
+   Table dof_elem;
+   dof_elem.MakeI(fes.GetNDofs());
+   for (int j = 0; j < I[NE]; j++)
+   {
+      dof_elem.AddAColumnInRow(J[j] >= 0 ? J[j] : -1-J[j]);
+   }
+   dof_elem.MakeJ();
+   for (int e = 0; e < NE; e++)
+   {
+      for (int j = I[e]; j < I[e+1]; j++)
+      {
+         dof_elem.AddConnection(J[j] >= 0 ? J[j] : -1-J[j], e);
+      }
+   }
+   dof_elem.ShiftUpI();
+
+   Array<int> color(NE), mark;
+   color = -1;
+   for (int e = 0; e < NE; e++)
+   {
+      for (int j = I[e]; j < I[e+1]; j++)
+      {
+         const int d = J[j] >= 0 ? J[j] : -1-J[j];
+         const int *nbr = dof_elem.GetRow(d);
+         for (int k = 0; k < dof_elem.RowSize(d); k++)
+         {
+            if (color[nbr[k]] >= 0) { mark[color[nbr[k]]] = e; }
+         }
+      }
+      int c = 0;
+      while (c < mark.Size() && mark[c] == e) { c++; }
+      if (c == mark.Size()) { mark.Append(-1); }
+      color[e] = c;
+   }
+
+   Table *colors = new Table;
+   colors->MakeI(mark.Size());
+   for (int e = 0; e < NE; e++) { colors->AddAColumnInRow(color[e]); }
+   colors->MakeJ();
+   for (int e = 0; e < NE; e++) { colors->AddConnection(color[e], e); }
+   colors->ShiftUpI();
+   return colors;
+}
+
+// Add the element matrix 'elmat' to the entries (vdofs, vdofs) of the finalized
+// matrix 'A' which must have sorted column indices, without changing its
+// sparsity pattern. Calls for elements without common rows may run in
+// parallel.
+static void AddElementMatrixCSR(SparseMatrix &A, const Array<int> &vdofs,
+                                const DenseMatrix &elmat)
+{
+   const int *I = A.GetI(), *J = A.GetJ();
+   double *data = A.GetData();
+   const int n = vdofs.Size();
+   for (int i = 0; i < n; i++)
+   {
+      const int row = vdofs[i] >= 0 ? vdofs[i] : -1-vdofs[i];
+      const double si = vdofs[i] >= 0 ? 1.0 : -1.0;
+      const int *row_begin = J + I[row], *row_end = J + I[row+1];
+      for (int j = 0; j < n; j++)
+      {
+         const double a = elmat(i,j);
+         if (a == 0.0) { continue; }
+         const int col = vdofs[j] >= 0 ? vdofs[j] : -1-vdofs[j];
+         const double s = vdofs[j] >= 0 ? si : -si;
+         const int *pos = std::lower_bound(row_begin, row_end, col);
+         MFEM_VERIFY(pos != row_end && *pos == col,
+                     "entry (" << row << "," << col << ") is not in the "
+                     "sparsity pattern");
+         data[pos - J] += s * a;
+      }
+   }
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
 
-   if (precompute_sparsity == 0 || fes->GetVDim() > 1)
+   if (precompute_sparsity == 0 && !reuse_sparsity && !UseColoredAssembly())
    {
       mat = new SparseMatrix(height);
       return;
    }
 
-   const Table &elem_dof = fes->GetElementToDofTable();
+   const int ndofs = fes->GetNDofs();
+   const Table *elem_dof_p = &fes->GetElementToDofTable();
+   Table elem_dof_abs;
+   const int *edJ = elem_dof_p->GetJ();
+   const int ned = elem_dof_p->Size_of_connections();
+   if (std::find_if(edJ, edJ + ned, [](int j) { return j < 0; }) != edJ + ned)
+   {
+      // remove the orientation of the dofs, e.g. for ND and RT spaces
+      elem_dof_abs = *elem_dof_p;
+      int *J = elem_dof_abs.GetJ();
+      for (int j = 0; j < ned; j++) { if (J[j] < 0) { J[j] = -1-J[j]; } }
+      elem_dof_p = &elem_dof_abs;
+   }
+   const Table &elem_dof = *elem_dof_p;
    Table dof_dof;
 
    if (fbfi.Size() > 0)
@@ -40,19 +158,53 @@ void BilinearForm::AllocMat()
          mfem::Mult(*face_elem, elem_dof, face_dof);
          delete face_elem;
       }
-      Transpose(face_dof, dof_face, height);
+      Transpose(face_dof, dof_face, ndofs);
       mfem::Mult(dof_face, face_dof, dof_dof);
    }
    else
    {
       // the sparsity pattern is defined from the map: element->dof
       Table dof_elem;
-      Transpose(elem_dof, dof_elem, height);
+      Transpose(elem_dof, dof_elem, ndofs);
       mfem::Mult(dof_elem, elem_dof, dof_dof);
    }
 
    dof_dof.SortRows();
 
+   const int vdim = fes->GetVDim();
+   if (vdim > 1)
+   {
+      // Expand the pattern to all pairs of vector components
+      const bool byvdim = (fes->GetOrdering() == Ordering::byVDIM);
+      const int *dI = dof_dof.GetI(), *dJ = dof_dof.GetJ();
+      int *I = Memory<int>(height+1);
+      I[0] = 0;
+      for (int r = 0; r < height; r++)
+      {
+         const int d = byvdim ? r / vdim : r % ndofs;
+         I[r+1] = I[r] + vdim*(dI[d+1] - dI[d]);
+      }
+      int *J = Memory<int>(I[height]);
+      for (int r = 0; r < height; r++)
+      {
+         const int d = byvdim ? r / vdim : r % ndofs;
+         int *rJ = J + I[r];
+         for (int c = 0; c < vdim; c++)
+         {
+            for (int k = dI[d]; k < dI[d+1]; k++)
+            {
+               // byVDIM: columns dJ[k]*vdim+c, byNODES: c*ndofs+dJ[k]
+               if (byvdim) { rJ[(k-dI[d])*vdim+c] = dJ[k]*vdim+c; }
+               else { rJ[c*(dI[d+1]-dI[d])+k-dI[d]] = c*ndofs+dJ[k]; }
+            }
+         }
+      }
+      double *data = Memory<double>(I[height]);
+      mat = new SparseMatrix(I, J, data, height, height, true, true, true);
+      *mat = 0.0;
+      return;
+   }
+
    int *I = dof_dof.GetI();
    int *J = dof_dof.GetJ();
    double *data = Memory<double>(I[height]);
@@ -63,6 +215,70 @@ void BilinearForm::AllocMat()
    dof_dof.LoseData();
 }
 
+bool BilinearForm::UseColoredAssembly() const
+{
+   return colored_assembly || AssembleUseThreads();
+}
+
+const Table &BilinearForm::GetElementColors()
+{
+   if (element_colors == NULL || colors_sequence != fes->GetSequence())
+   {
+      delete element_colors;
+      element_colors = ColorElements(*fes);
+      colors_sequence = fes->GetSequence();
+   }
+   return *element_colors;
+}
+
+void BilinearForm::AssembleElementsThreaded()
+{
+   const Table &colors = GetElementColors();
+   if (!mat->ColumnsAreSorted()) { mat->SortColumnIndices(); }
+
+#ifdef MFEM_THREADED_ASSEMBLY
+   #pragma omp parallel
+#endif
+   {
+      // Thread-local scratch data
+      Array<int> el_vdofs;
+      DenseMatrix elmat, elmat_ext, tmp;
+      IsoparametricTransformation eltrans;
+      for (int c = 0; c < colors.Size(); c++)
+      {
+         const int *elems = colors.GetRow(c);
+         const int nc = colors.RowSize(c);
+         // The elements of one color do not share any rows of the matrix
+#ifdef MFEM_THREADED_ASSEMBLY
+         #pragma omp for schedule(dynamic, 16)
+#endif
+         for (int k = 0; k < nc; k++)
+         {
+            const int i = elems[k];
+            fes->GetElementVDofs(i, el_vdofs);
+            if (element_matrices)
+            {
+               elmat_ext.UseExternalData(element_matrices->GetData(i),
+                                         element_matrices->SizeI(),
+                                         element_matrices->SizeJ());
+               AddElementMatrixCSR(*mat, el_vdofs, elmat_ext);
+               continue;
+            }
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int j = 1; j < dbfi.Size(); j++)
+            {
+               dbfi[j]->AssembleElementMatrix(fe, eltrans, tmp);
+               elmat += tmp;
+            }
+            AddElementMatrixCSR(*mat, el_vdofs, elmat);
+         }
+      }
+      elmat_ext.ClearExternalData();
+   }
+}
+
 BilinearForm::BilinearForm(FiniteElementSpace * f)
    : Matrix (f->GetVSize())
 {
@@ -71,9 +287,14 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    mat = mat_e = NULL;
    extern_bfs = 0;
    element_matrices = NULL;
+   element_colors = NULL;
+   colors_sequence = -1;
+   colored_assembly = false;
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   reuse_sparsity = reassembled = false;
+   mat_reuse = NULL;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACYFULL;
@@ -89,9 +310,14 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    mat_e = NULL;
    extern_bfs = 1;
    element_matrices = NULL;
+   element_colors = NULL;
+   colors_sequence = -1;
+   colored_assembly = false;
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   reuse_sparsity = reassembled = false;
+   mat_reuse = NULL;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::LEGACYFULL;
@@ -133,14 +359,20 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
          ext = new PABilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFBilinearFormExtension(this);
+         ext = new MFBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
    }
 }
 
+void BilinearForm::SetIntegratorFusion(bool fuse)
+{
+   MFEM_VERIFY(ext && assembly == AssemblyLevel::PARTIAL,
+               "integrator fusion requires AssemblyLevel::PARTIAL");
+   static_cast<PABilinearFormExtension*>(ext)->SetIntegratorFusion(fuse);
+}
+
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
@@ -390,17 +622,30 @@ void BilinearForm::Assemble(int skip_zeros)
    {
       AllocMat();
    }
-
-#ifdef MFEM_USE_LEGACY_OPENMP
-   int free_element_matrices = 0;
-   if (!element_matrices)
+   else if (reuse_sparsity)
    {
-      ComputeElementMatrices();
-      free_element_matrices = 1;
+      MFEM_VERIFY(!static_cond && !hybridization, "reusing the sparsity pattern"
+                  " is not supported with static condensation or hybridization");
+      if (mat_reuse && height != fes->GetVSize())
+      {
+         // mat holds the conforming matrix, see ConformingAssemble()
+         Swap(mat, mat_reuse);
+         height = width = fes->GetVSize();
+      }
+      *mat = 0.0;
+   }
+   if (reuse_sparsity)
+   {
+      reassembled = true;
+      skip_zeros = 0; // keep the full pattern, if it is not precomputed
    }
-#endif
 
-   if (dbfi.Size())
+   if (dbfi.Size() && !static_cond && !hybridization &&
+       mat->Finalized() && UseColoredAssembly())
+   {
+      AssembleElementsThreaded();
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -576,13 +821,6 @@ void BilinearForm::Assemble(int skip_zeros)
          }
       }
    }
-
-#ifdef MFEM_USE_LEGACY_OPENMP
-   if (free_element_matrices)
-   {
-      FreeElementMatrices();
-   }
-#endif
 }
 
 void BilinearForm::ConformingAssemble()
@@ -597,6 +835,19 @@ void BilinearForm::ConformingAssemble()
    const SparseMatrix *P = fes->GetConformingProlongation();
    if (!P) { return; } // conforming mesh
 
+   if (reuse_sparsity)
+   {
+      // Keep the local matrix for the next Assemble() and write the values of
+      // P^t A P into the conforming matrix of the previous assembly, if any.
+      // Here, #mat_e is managed by ReuseEliminateVDofs().
+      SparseMatrix *PtAP = mfem::RAP(*P, *mat, *P, mat_reuse);
+      mat_reuse = mat;
+      mat = PtAP;
+      height = mat->Height();
+      width = mat->Width();
+      return;
+   }
+
    SparseMatrix *R = Transpose(*P);
    SparseMatrix *RA = mfem::Mult(*R, *mat);
    delete mat;
@@ -764,13 +1015,21 @@ void BilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
    }
    else
    {
-      if (!mat_e)
+      if (!mat_e || reassembled)
       {
          const SparseMatrix *P = fes->GetConformingProlongation();
          if (P) { ConformingAssemble(); }
-         EliminateVDofs(ess_tdof_list, diag_policy);
+         if (reuse_sparsity)
+         {
+            ReuseEliminateVDofs(ess_tdof_list, diag_policy);
+         }
+         else
+         {
+            EliminateVDofs(ess_tdof_list, diag_policy);
+         }
          const int remove_zeros = 0;
          Finalize(remove_zeros);
+         reassembled = false;
       }
       if (hybridization)
       {
@@ -857,8 +1116,9 @@ void BilinearForm::ComputeElementMatrices()
    DenseMatrix tmp;
    IsoparametricTransformation eltrans;
 
-#ifdef MFEM_USE_LEGACY_OPENMP
-   #pragma omp parallel for private(tmp,eltrans)
+#ifdef MFEM_THREADED_ASSEMBLY
+   const bool use_threads = AssembleUseThreads();
+   #pragma omp parallel for private(tmp,eltrans) if (use_threads)
 #endif
    for (int i = 0; i < num_elements; i++)
    {
@@ -975,6 +1235,63 @@ void BilinearForm::EliminateVDofs(const Array<int> &vdofs,
    }
 }
 
+void BilinearForm::ReuseEliminateVDofs(const Array<int> &vdofs,
+                                       DiagonalPolicy dpolicy)
+{
+   if (mat_e && mat_e->Finalized() && vdofs == elim_vdofs)
+   {
+      // Move the eliminated entries using the maps of the previous elimination
+      *mat_e = 0.0;
+      double *A = mat->GetData(), *Ae = mat_e->GetData();
+      for (int k = 0; k < elim_map.Size(); k += 2)
+      {
+         Ae[elim_map[k+1]] += A[elim_map[k]];
+         A[elim_map[k]] = 0.0;
+      }
+      const double diag = (dpolicy == DIAG_ONE) ? 1.0 : 0.0;
+      for (int k = 0; k < elim_diag_map.Size(); k += 2)
+      {
+         Ae[elim_diag_map[k+1]] += A[elim_diag_map[k]] - diag;
+         A[elim_diag_map[k]] = diag;
+      }
+      return;
+   }
+
+   delete mat_e;
+   mat_e = NULL;
+   EliminateVDofs(vdofs, dpolicy);
+   mat_e->Finalize(0);
+   vdofs.Copy(elim_vdofs);
+
+   // Record the positions of the eliminated entries in mat and mat_e
+   Array<int> ess_marker(height);
+   ess_marker = 0;
+   for (int i = 0; i < vdofs.Size(); i++)
+   {
+      ess_marker[(vdofs[i] >= 0) ? vdofs[i] : -1-vdofs[i]] = 1;
+   }
+   elim_map.SetSize(0);
+   elim_diag_map.SetSize(0);
+   const int *I = mat->GetI(), *J = mat->GetJ();
+   const int *Ie = mat_e->GetI(), *Je = mat_e->GetJ();
+   for (int i = 0; i < height; i++)
+   {
+      for (int j = I[i]; j < I[i+1]; j++)
+      {
+         const int col = J[j];
+         if (!ess_marker[i] && !ess_marker[col]) { continue; }
+         if (col == i && dpolicy == DIAG_KEEP) { continue; }
+         int k = Ie[i];
+         while (k < Ie[i+1] && Je[k] != col) { k++; }
+         MFEM_VERIFY(k < Ie[i+1], "eliminated entry (" << i << ',' << col
+                     << ") not found");
+         Array<int> &map = (col == i) ? elim_diag_map : elim_map;
+         map.Append(j);
+         map.Append(k);
+      }
+   }
+}
+
 void BilinearForm::EliminateEssentialBCFromDofs(
    const Array<int> &ess_dofs, const Vector &sol, Vector &rhs,
    DiagonalPolicy dpolicy)
@@ -1033,6 +1350,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::ArrayMult(const Array<const Vector *> &X,
+                             Array<Vector *> &Y) const
+{
+   if (ext)
+   {
+      ext->ArrayMult(X, Y);
+   }
+   else
+   {
+      Operator::ArrayMult(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1052,6 +1382,10 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
 
    delete mat_e;
    mat_e = NULL;
+   delete mat_reuse;
+   mat_reuse = NULL;
+   elim_vdofs.DeleteAll();
+   reassembled = false;
    FreeElementMatrices();
    delete static_cond;
    static_cond = NULL;
@@ -1078,13 +1412,16 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
 void BilinearForm::SetDiagonalPolicy(DiagonalPolicy policy)
 {
    diag_policy = policy;
+   elim_vdofs.DeleteAll(); // the elimination maps depend on the policy
 }
 
 BilinearForm::~BilinearForm()
 {
    delete mat_e;
    delete mat;
+   delete mat_reuse;
    delete element_matrices;
+   delete element_colors;
    delete static_cond;
    delete hybridization;
 
@@ -100,6 +100,13 @@ protected:
 
    DenseTensor *element_matrices; ///< Owned.
 
+   /** @brief Coloring of the elements used by the threaded assembly, see
+       Assemble(). Row c lists the elements of color c. Owned. */
+   Table *element_colors;
+   long colors_sequence; ///< FE space sequence of #element_colors.
+   /// Use the colored element loop also without threads, see UseColoring().
+   bool colored_assembly;
+
    StaticCondensation *static_cond; ///< Owned.
    Hybridization *hybridization; ///< Owned.
 
@@ -109,9 +116,36 @@ protected:
    DiagonalPolicy diag_policy;
 
    int precompute_sparsity;
+
+   /// Reuse the sparsity pattern between assemblies, see ReuseSparsityPattern().
+   bool reuse_sparsity;
+   /** @brief With #reuse_sparsity: the values of #mat were reassembled since
+       the last call to FormSystemMatrix(). */
+   bool reassembled;
+   /** @brief With #reuse_sparsity on nonconforming spaces: the local matrix
+       after ConformingAssemble(), otherwise the conforming matrix of the
+       previous assembly (reused as the output of the triple product). Owned. */
+   SparseMatrix *mat_reuse;
+   /** @brief With #reuse_sparsity: pairs (entry of #mat, entry of #mat_e) of
+       the off-diagonal and the diagonal entries moved by the elimination of
+       #elim_vdofs. */
+   Array<int> elim_map, elim_diag_map;
+   /// The essential vdofs corresponding to #elim_map and #elim_diag_map.
+   Array<int> elim_vdofs;
+
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /** Eliminate the essential vdofs, reusing #mat_e and the elimination maps
+       when the vdofs did not change. */
+   void ReuseEliminateVDofs(const Array<int> &vdofs, DiagonalPolicy dpolicy);
+
+   // Returns true if Assemble() should use AssembleElementsThreaded()
+   bool UseColoredAssembly() const;
+
+   // Threaded assembly of the domain integrators into the finalized mat
+   void AssembleElementsThreaded();
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -119,8 +153,10 @@ protected:
    {
       fes = NULL; sequence = -1;
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
+      element_colors = NULL; colors_sequence = -1; colored_assembly = false;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      reuse_sparsity = reassembled = false; mat_reuse = NULL;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACYFULL;
       batch = 1;
@@ -168,6 +204,13 @@ public:
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief Apply the compatible mass, diffusion and convection domain
+       integrators with a single fused kernel, see PAFusedIntegrators. */
+   /** Only supported with AssemblyLevel::PARTIAL, must be called after
+       SetAssemblyLevel(). Disabled by default, since the fused kernel is
+       slower than the separate kernels for some orders. */
+   void SetIntegratorFusion(bool fuse = true);
+
    /** @brief Enable the use of static condensation. For details see the
        description for class StaticCondensation in fem/staticcond.hpp This method
        should be called before assembly. If the number of unknowns after static
@@ -190,9 +233,12 @@ public:
                             BilinearFormIntegrator *constr_integ,
                             const Array<int> &ess_tdof_list);
 
-   /** @brief For scalar FE spaces, precompute the sparsity pattern of the matrix
-       (assuming dense element matrices) based on the types of integrators
-       present in the bilinear form. */
+   /** @brief Precompute the sparsity pattern of the matrix (assuming dense
+       element matrices) based on the types of integrators present in the
+       bilinear form. */
+   /** For vector FE spaces, all pairs of vector components are coupled. The
+       pattern is always precomputed when the threaded assembly is used, see
+       Assemble() and UseColoring(). */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
    /** @brief Use the given CSR sparsity pattern to allocate the internal
@@ -209,6 +255,37 @@ public:
    /// Use the sparsity of @a A to allocate the internal SparseMatrix.
    void UseSparsity(SparseMatrix &A);
 
+   /** @brief Keep the sparsity pattern of the matrix, and the elimination of
+       the essential dofs, between assemblies. */
+   /** When enabled, the matrix is allocated with a precomputed CSR pattern
+       (see UsePrecomputedSparsity()) and every subsequent call to Assemble()
+       overwrites its values in place, instead of adding to them. The next call
+       to FormSystemMatrix() (or FormLinearSystem()) then redoes the conforming
+       triple product and the elimination of the essential dofs in the existing
+       matrices, reusing the positions of the eliminated entries as long as the
+       list of essential dofs does not change. This is useful, e.g., with time
+       dependent coefficients. With ParBilinearForm, the values of the parallel
+       HypreParMatrix are updated in place as well, so operators and solvers
+       referencing it remain valid.
+
+       This method should be called before the first call to Assemble(). Static
+       condensation and hybridization are not supported. */
+   void ReuseSparsityPattern(bool reuse = true) { reuse_sparsity = reuse; }
+
+   /** @brief Use the colored element loop of the threaded assembly, see
+       Assemble(), also when MFEM is built without threads. */
+   /** Without threads the colors are assembled one after the other, which is
+       mostly useful for testing. This method should be called before the first
+       call to Assemble(). */
+   void UseColoring(bool color = true) { colored_assembly = color; }
+
+   /** @brief Return the coloring of the elements used by the threaded
+       assembly: row c of the table lists the elements of color c. */
+   /** Elements with the same color do not share any degrees of freedom. The
+       coloring is computed on the first call and recomputed when the
+       FiniteElementSpace changes. */
+   const Table &GetElementColors();
+
    /// Pre-allocate the internal SparseMatrix before assembly.
    /**  If the flag 'precompute sparsity'
        is set, the matrix is allocated in CSR format (i.e.
@@ -247,6 +324,10 @@ public:
    /// Matrix vector multiplication:  \f$ y = M x \f$
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Matrix vector multiplication for several vectors: \f$ Y_i = M X_i \f$
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /** @brief Matrix vector multiplication with the original uneliminated
        matrix.  The original matrix is \f$ M + M_e \f$ so we have:
        \f$ y = M x + M_e x \f$ */
@@ -356,6 +437,16 @@ public:
    }
 
    /// Assembles the form i.e. sums over all domain/bdr integrators.
+   /** When MFEM is built with MFEM_THREAD_SAFE and either MFEM_USE_LEGACY_OPENMP
+       or MFEM_USE_OPENMP (with the "omp" device backend enabled), the domain
+       integrators of the legacy full assembly are computed by OpenMP threads.
+       The elements are colored such that elements of the same color do not
+       share degrees of freedom, and the element matrices are added in place to
+       a precomputed sparsity pattern, which then also contains the entries
+       that are numerically zero. The integrators and coefficients must be
+       thread-safe. Static condensation and hybridization use the serial
+       loop. The colored loop can also be enabled without threads with
+       UseColoring(). */
    void Assemble(int skip_zeros = 1);
 
    /** @brief Assemble the diagonal of the bilinear form into diag
@@ -41,13 +41,22 @@ const Operator *BilinearFormExtension::GetRestriction() const
 PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    : BilinearFormExtension(form),
      trialFes(a->FESpace()),
-     testFes(a->FESpace())
+     testFes(a->FESpace()),
+     comm_overlap(false),
+     overlap_restrict(NULL),
+     overlap_nint(0),
+     fuse_integs(false)
 {
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
 }
 
+PABilinearFormExtension::~PABilinearFormExtension()
+{
+   delete overlap_restrict;
+}
+
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 {
    ElementDofOrdering ordering = UsesTensorBasis(*a->FESpace())?
@@ -95,6 +104,22 @@ void PABilinearFormExtension::Assemble()
    {
       integrators[i]->AssemblePA(*a->FESpace());
    }
+   SetupOverlapOrder();
+
+   // The fused kernel is a per-element host kernel, so it is not used by the
+   // backends with their own kernels.
+   fused_integs.Clear();
+   const bool fuse = fuse_integs && elem_restrict &&
+                     !Device::Allows(Backend::DEVICE_MASK | Backend::CEED_MASK |
+                                     Backend::OCCA_MASK | Backend::CPU_SIMD);
+   if (fuse)
+   {
+      for (int i = 0; i < integratorCount; ++i)
+      {
+         fused_integs.Add(*integrators[i]);
+      }
+      if (fused_integs.Size() < 2) { fused_integs.Clear(); }
+   }
 
    MFEM_VERIFY(a->GetBBFI()->Size() == 0,
                "Partial assembly does not support AddBoundaryIntegrator yet.");
@@ -158,11 +183,92 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   delete overlap_restrict;
+   overlap_restrict = nullptr;
+   fused_integs.Clear();
+}
+
+void PABilinearFormExtension::SetupOverlapOrder()
+{
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(trialFes);
+   bool supported = comm_overlap && pfes && pfes->Conforming() &&
+                    !DeviceCanUseCeed() &&
+                    dynamic_cast<const ElementRestriction*>(elem_restrict) &&
+                    a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0;
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size() && supported; ++i)
+   {
+      supported = integrators[i]->SupportsPARange();
+   }
+   if (!supported)
+   {
+      delete overlap_restrict;
+      overlap_restrict = NULL;
+      return;
+   }
+
+   // The order is kept until Update(), so that the overlap operators of a
+   // previous assembly remain valid
+   if (!overlap_restrict)
+   {
+      // The interior elements, in mesh order, followed by the boundary ones
+      const int ne = pfes->GetNE();
+      Array<int> bdr_elements, vdofs;
+      overlap_order.SetSize(ne);
+      overlap_nint = 0;
+      for (int e = 0; e < ne; e++)
+      {
+         pfes->GetElementVDofs(e, vdofs);
+         bool bdr = false;
+         for (int j = 0; j < vdofs.Size() && !bdr; j++)
+         {
+            const int ldof = (vdofs[j] >= 0) ? vdofs[j] : -1-vdofs[j];
+            bdr = (pfes->GetLocalTDofNumber(ldof) < 0);
+         }
+         if (bdr) { bdr_elements.Append(e); }
+         else { overlap_order[overlap_nint++] = e; }
+      }
+      for (int i = 0; i < bdr_elements.Size(); i++)
+      {
+         overlap_order[overlap_nint + i] = bdr_elements[i];
+      }
+
+      ElementDofOrdering ordering = UsesTensorBasis(*pfes)?
+                                    ElementDofOrdering::LEXICOGRAPHIC:
+                                    ElementDofOrdering::NATIVE;
+      overlap_restrict = new ElementRestriction(*pfes, ordering,
+                                                &overlap_order);
+   }
+   elem_restrict = overlap_restrict;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->ReorderElementsPA(overlap_order);
+   }
+#endif
+}
+
+Operator *PABilinearFormExtension::NewOverlapOperator() const
+{
+#ifdef MFEM_USE_MPI
+   if (!overlap_restrict) { return NULL; }
+   return new ParPAOverlapOperator(
+             *this, *static_cast<const ParFiniteElementSpace*>(trialFes));
+#else
+   return NULL;
+#endif
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                                OperatorHandle &A)
 {
+   Operator *rap = comm_overlap ? NewOverlapOperator() : NULL;
+   if (rap)
+   {
+      A.Reset(new ConstrainedOperator(rap, ess_tdof_list, true));
+      return;
+   }
    Operator *oper;
    Operator::FormSystemOperator(ess_tdof_list, oper);
    A.Reset(oper); // A will own oper
@@ -174,6 +280,18 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
                                                Vector &X, Vector &B,
                                                int copy_interior)
 {
+   Operator *rap = comm_overlap ? NewOverlapOperator() : NULL;
+   if (rap)
+   {
+      const Operator *P = GetProlongation();
+      InitTVectors(P, GetRestriction(), P, x, b, X, B);
+      if (!copy_interior) { X.SetSubVectorComplement(ess_tdof_list, 0.0); }
+      ConstrainedOperator *constrainedA =
+         new ConstrainedOperator(rap, ess_tdof_list, true);
+      constrainedA->EliminateRHS(X, B);
+      A.Reset(constrainedA);
+      return;
+   }
    Operator *oper;
    Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
    A.Reset(oper); // A will own oper
@@ -197,10 +315,7 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    {
       elem_restrict->Mult(x, localX);
       localY = 0.0;
-      for (int i = 0; i < iSz; ++i)
-      {
-         integrators[i]->AddMultPA(localX, localY);
-      }
+      AddMultDomainPA(localX, localY);
       elem_restrict->MultTranspose(localY, y);
    }
 
@@ -237,6 +352,79 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::AddMultDomainPA(const Vector &x, Vector &y,
+                                              const bool transpose) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   // The fused kernel is its own transpose without convection
+   const bool fused = fused_integs.Size() > 0 &&
+                      (!transpose || fused_integs.IsSymmetric());
+   if (fused) { fused_integs.AddMultPA(x, y); }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (fused && fused_integs.Contains(integrators[i])) { continue; }
+      if (transpose) { integrators[i]->AddMultTransposePA(x, y); }
+      else { integrators[i]->AddMultPA(x, y); }
+   }
+}
+
+void PABilinearFormExtension::AddMultDomainPARange(const Vector &x,
+                                                   Vector &y,
+                                                   const int e_begin,
+                                                   const int e_end,
+                                                   const bool transpose) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const bool fused = fused_integs.Size() > 0 &&
+                      (!transpose || fused_integs.IsSymmetric());
+   if (fused) { fused_integs.AddMultPARange(x, y, e_begin, e_end); }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (fused && fused_integs.Contains(integrators[i])) { continue; }
+      if (transpose)
+      {
+         integrators[i]->AddMultTransposePARange(x, y, e_begin, e_end);
+      }
+      else { integrators[i]->AddMultPARange(x, y, e_begin, e_end); }
+   }
+}
+
+void PABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   const int nv = X.Size();
+   if (nv == 1 || DeviceCanUseCeed() || !elem_restrict ||
+       a->GetFBFI()->Size() > 0 || a->GetBFBFI()->Size() > 0)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   const int ne_size = localX.Size();
+   localXb.SetSize(nv*ne_size, Device::GetDeviceMemoryType());
+   localYb.SetSize(nv*ne_size, Device::GetDeviceMemoryType());
+   localXb.UseDevice(true);
+   localYb.UseDevice(true);
+   Vector xv, yv;
+   for (int i = 0; i < nv; i++)
+   {
+      xv.MakeRef(localXb, i*ne_size, ne_size);
+      elem_restrict->Mult(*X[i], xv);
+   }
+   localYb = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultBlockPA(localXb, localYb, nv);
+   }
+   for (int i = 0; i < nv; i++)
+   {
+      yv.MakeRef(localYb, i*ne_size, ne_size);
+      elem_restrict->MultTranspose(yv, *Y[i]);
+   }
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -245,10 +433,7 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    {
       elem_restrict->Mult(x, localX);
       localY = 0.0;
-      for (int i = 0; i < iSz; ++i)
-      {
-         integrators[i]->AddMultTransposePA(localX, localY);
-      }
+      AddMultDomainPA(localX, localY, true);
       elem_restrict->MultTranspose(localY, y);
    }
    else
@@ -294,6 +479,224 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+#ifdef MFEM_USE_MPI
+
+ParPAOverlapOperator::ParPAOverlapOperator(const PABilinearFormExtension &ext_,
+                                           const ParFiniteElementSpace &pfes)
+   : ext(ext_),
+     elem_restrict(ext_.overlap_restrict),
+     P(new DeviceConformingProlongationOperator(pfes)),
+     nint(ext_.overlap_nint),
+     ne(pfes.GetNE())
+{
+   MFEM_VERIFY(elem_restrict, "the communication overlap is not set up");
+   height = width = P->Width();
+
+   // Mark the scalar ldofs with external vector components
+   const int ndofs = pfes.GetNDofs();
+   Array<bool> external(ndofs);
+   external = false;
+   const Array<int> &external_ldofs = P->GetExternalLDofs();
+   for (int i = 0; i < external_ldofs.Size(); i++)
+   {
+      external[pfes.VDofToDof(external_ldofs[i])] = true;
+   }
+   for (int i = 0; i < ndofs; i++)
+   {
+      (external[i] ? bdr_dofs : int_dofs).Append(i);
+   }
+
+   x.SetSize(P->Height(), Device::GetDeviceMemoryType());
+   y.SetSize(P->Height(), Device::GetDeviceMemoryType());
+   x.UseDevice(true);
+   y.UseDevice(true);
+}
+
+ParPAOverlapOperator::~ParPAOverlapOperator()
+{
+   delete P;
+}
+
+void ParPAOverlapOperator::Apply(const Vector &X, Vector &Y,
+                                 bool transpose) const
+{
+   Vector &localX = ext.localX, &localY = ext.localY;
+
+   // The owned ldofs of x are available after BcastBegin(): the action of the
+   // interior elements is computed while the external ldofs are received
+   P->BcastBegin(X, x);
+   localY = 0.0;
+   elem_restrict->MultElements(x, localX, 0, nint);
+   if (!transpose) { ext.AddMultDomainPARange(localX, localY, 0, nint, false); }
+   P->BcastEnd(x);
+   elem_restrict->MultElements(x, localX, nint, ne);
+   ext.AddMultDomainPARange(localX, localY, nint, ne, transpose);
+
+   // Only the external ldofs of y are needed by ReduceBegin(), and they only
+   // get contributions from the boundary elements. In MultTranspose(), the
+   // action of the interior elements is computed while they are sent.
+   elem_restrict->MultTransposeDofs(localY, y, bdr_dofs);
+   P->ReduceBegin(y);
+   if (transpose) { ext.AddMultDomainPARange(localX, localY, 0, nint, true); }
+   elem_restrict->MultTransposeDofs(localY, y, int_dofs);
+   P->ReduceEnd(y, Y);
+}
+
+#endif // MFEM_USE_MPI
+
+// Data and methods for matrix-free bilinear forms
+MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
+   : BilinearFormExtension(form),
+     trialFes(a->FESpace()),
+     testFes(a->FESpace())
+{
+   elem_restrict = NULL;
+}
+
+void MFBilinearFormExtension::Assemble()
+{
+   ElementDofOrdering ordering = UsesTensorBasis(*a->FESpace())?
+                                 ElementDofOrdering::LEXICOGRAPHIC:
+                                 ElementDofOrdering::NATIVE;
+   elem_restrict = trialFes->GetElementRestriction(ordering);
+   if (elem_restrict)
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleMF(*a->FESpace());
+   }
+
+   MFEM_VERIFY(a->GetBBFI()->Size() == 0,
+               "Matrix-free action does not support AddBoundaryIntegrator yet.");
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0,
+               "Matrix-free action does not support "
+               "AddInteriorFaceIntegrator yet.");
+   MFEM_VERIFY(a->GetBFBFI()->Size() == 0,
+               "Matrix-free action does not support AddBdrFaceIntegrator yet.");
+}
+
+void MFBilinearFormExtension::AssembleDiagonal(Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(localY);
+      }
+      const ElementRestriction* H1elem_restrict =
+         dynamic_cast<const ElementRestriction*>(elem_restrict);
+      if (H1elem_restrict)
+      {
+         H1elem_restrict->MultTransposeUnsigned(localY, y);
+      }
+      else
+      {
+         elem_restrict->MultTranspose(localY, y);
+      }
+   }
+   else
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
+                                               OperatorHandle &A)
+{
+   Operator *oper;
+   Operator::FormSystemOperator(ess_tdof_list, oper);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
+                                               Vector &x, Vector &b,
+                                               OperatorHandle &A,
+                                               Vector &X, Vector &B,
+                                               int copy_interior)
+{
+   Operator *oper;
+   Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultMF(localX, localY);
+      }
+      elem_restrict->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultMF(x, y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposeMF(localX, localY);
+      }
+      elem_restrict->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposeMF(x, y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::Update()
+{
+   FiniteElementSpace *fes = a->FESpace();
+   height = width = fes->GetVSize();
+   trialFes = fes;
+   testFes = fes;
+
+   elem_restrict = nullptr;
+}
+
+
 // Data and methods for element-assembled bilinear forms
 EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
    : PABilinearFormExtension(form),
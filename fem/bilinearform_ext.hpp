@@ -21,6 +21,7 @@ namespace mfem
 
 class BilinearForm;
 class MixedBilinearForm;
+class BilinearFormIntegrator;
 
 /// Class extending the BilinearForm class to support different AssemblyLevels.
 /**  FA - Full Assembly
@@ -62,6 +63,55 @@ public:
    virtual void Update() = 0;
 };
 
+/** @brief Fused partial assembly action of the mass, diffusion and convection
+    domain integrators of a form. */
+/** The MassIntegrator, DiffusionIntegrator and ConvectionIntegrator assembled
+    with the same tensor product DofToQuad maps, i.e. on the same space with the
+    same IntegrationRule, are applied by a single kernel: the values and the
+    gradients of the E-vector are interpolated once, the sum of the pointwise
+    operators is applied at the quadrature points, and the result is integrated
+    back once. */
+class PAFusedIntegrators
+{
+protected:
+   const DofToQuad *maps;  ///< Not owned
+   int dim, ne;
+   const Vector *mass_data, *diff_data, *conv_data;  ///< Not owned
+   Array<const BilinearFormIntegrator*> integs;
+
+public:
+   PAFusedIntegrators() { Clear(); }
+
+   /// Remove all the integrators.
+   void Clear();
+
+   /** @brief Add the partially assembled @a integ to the fused integrators,
+       if it is supported and compatible with the ones already added. */
+   /** Return true if @a integ was added. */
+   bool Add(const BilinearFormIntegrator &integ);
+
+   /// Return the number of fused integrators.
+   int Size() const { return integs.Size(); }
+
+   /// Return true if @a integ is one of the fused integrators.
+   bool Contains(const BilinearFormIntegrator *integ) const
+   { return integs.Find(integ) >= 0; }
+
+   /** @brief Return true if the fused operator is symmetric, i.e. if there is
+       no convection integrator, so that AddMultPA() is also its transpose. */
+   bool IsSymmetric() const { return conv_data == nullptr; }
+
+   /** @brief Add the action of the fused integrators on the E-vector @a x to
+       the E-vector @a y. */
+   void AddMultPA(const Vector &x, Vector &y) const;
+
+   /** @brief Add the action of the fused integrators on the elements e_begin
+       <= e < e_end of the E-vector @a x to the same elements of the E-vector
+       @a y, see BilinearFormIntegrator::AddMultPARange(). */
+   void AddMultPARange(const Vector &x, Vector &y,
+                       const int e_begin, const int e_end) const;
+};
+
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -70,13 +120,39 @@ protected:
    mutable Vector localX, localY;
    mutable Vector faceIntX, faceIntY;
    mutable Vector faceBdrX, faceBdrY;
+   mutable Vector localXb, localYb; // used by ArrayMult()
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   bool comm_overlap;
+   /// Element restriction in interior-first order, see SetupOverlapOrder().
+   ElementRestriction *overlap_restrict; // owned
+   Array<int> overlap_order; // mesh element of each E-vector element
+   int overlap_nint; // number of interior elements, stored first
+   bool fuse_integs;
+   PAFusedIntegrators fused_integs;
 
 public:
    PABilinearFormExtension(BilinearForm*);
 
+   virtual ~PABilinearFormExtension();
+
+   /** @brief Overlap the communication of the shared dofs with the local work
+       in the parallel system operator, see ParPAOverlapOperator. */
+   /** Used by FormSystemMatrix() and FormLinearSystem() if the form is defined
+       on a conforming ParFiniteElementSpace; ignored otherwise. Takes effect in
+       the next call to Assemble(). */
+   void SetCommunicationOverlap(bool overlap) { comm_overlap = overlap; }
+
+   /** @brief Apply the compatible domain integrators with a single fused
+       kernel, see PAFusedIntegrators. Disabled by default. */
+   /** Takes effect in the next call to Assemble(). */
+   void SetIntegratorFusion(bool fuse) { fuse_integs = fuse; }
+
+   /// Return the integrators fused by the last call to Assemble().
+   const PAFusedIntegrators &GetFusedIntegrators() const
+   { return fused_integs; }
+
    void Assemble();
    void AssembleDiagonal(Vector &diag) const;
    void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
@@ -86,12 +162,103 @@ public:
                          int copy_interior = 0);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+   /** @brief Action on several vectors, applying the domain integrators to all
+       of them with BilinearFormIntegrator::AddMultBlockPA(). */
+   /** Forms with face integrators use the default Operator::ArrayMult(). */
+   void ArrayMult(const Array<const Vector *> &X, Array<Vector *> &Y) const;
    void Update();
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+   /** @brief Add the (transposed) action of the domain integrators on the
+       E-vector @a x to the E-vector @a y, using the fused integrators if any
+       and, for the transpose, if they are symmetric. */
+   void AddMultDomainPA(const Vector &x, Vector &y,
+                        const bool transpose = false) const;
+
+   /** @brief Add the (transposed) action of the domain integrators on the
+       elements e_begin <= e < e_end of the E-vector @a x to the E-vector @a y,
+       using the fused integrators as in AddMultDomainPA(). */
+   /** Requires BilinearFormIntegrator::SupportsPARange() for all the domain
+       integrators. */
+   void AddMultDomainPARange(const Vector &x, Vector &y, const int e_begin,
+                             const int e_end, const bool transpose) const;
+
+   /** @brief If the communication overlap is enabled and supported, reorder
+       the elements of the E-vectors and of the partially assembled data so that
+       the interior elements, that do not touch external (non-owned) ldofs,
+       come first. */
+   /** Called by Assemble(). The reordered element restriction replaces
+       elem_restrict, it is owned by the extension and kept until Update(). */
+   void SetupOverlapOrder();
+
+   /** @brief Return a new ParPAOverlapOperator for this form, or NULL if the
+       overlap is not set up for it, see SetupOverlapOrder(). */
+   Operator *NewOverlapOperator() const;
+
+#ifdef MFEM_USE_MPI
+   friend class ParPAOverlapOperator;
+#endif
 };
 
+#ifdef MFEM_USE_MPI
+
+class ParFiniteElementSpace;
+class DeviceConformingProlongationOperator;
+
+/** @brief Parallel system operator P^T A P of a partially assembled form that
+    overlaps the exchange of the shared dofs with the local work. */
+/** The elements are split into the interior elements, that do not touch
+    external (non-owned) ldofs, and the boundary elements, which the extension
+    stores after the interior elements, see
+    PABilinearFormExtension::SetupOverlapOrder(). In Mult(), the
+    element restriction and the element kernels of the interior elements are
+    computed while the values of the external ldofs are received. The transpose
+    element restriction of the external ldofs, that only get contributions
+    from the boundary elements, is computed first, so that their values are
+    sent to the owners while the transpose restriction of the remaining ldofs
+    is computed. In MultTranspose(), the element kernels of the interior
+    elements are computed while the values of the external ldofs are sent
+    instead. The kernels are applied to the two ranges of interior and
+    boundary elements, which requires BilinearFormIntegrator::SupportsPARange()
+    for all the domain integrators. The prolongation is applied with the split
+    phases of DeviceConformingProlongationOperator, also with the host
+    backends. */
+class ParPAOverlapOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &ext;
+   const ElementRestriction *elem_restrict; // not owned
+   DeviceConformingProlongationOperator *P; // owned
+   /// The interior elements are [0, nint), the boundary elements [nint, ne).
+   const int nint, ne;
+   /// Scalar ldofs with no external / with external vector components.
+   Array<int> int_dofs, bdr_dofs;
+   mutable Vector x, y;
+
+   void Apply(const Vector &X, Vector &Y, bool transpose) const;
+
+public:
+   /** @brief Construct the operator of @a ext, after the overlap has been set
+       up by its Assemble(), see PABilinearFormExtension::SetupOverlapOrder(). */
+   ParPAOverlapOperator(const PABilinearFormExtension &ext,
+                        const ParFiniteElementSpace &pfes);
+
+   virtual ~ParPAOverlapOperator();
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   virtual void Mult(const Vector &X, Vector &Y) const
+   { Apply(X, Y, false); }
+
+   virtual void MultTranspose(const Vector &X, Vector &Y) const
+   { Apply(X, Y, true); }
+};
+
+#endif // MFEM_USE_MPI
+
 /// Data and methods for element-assembled bilinear forms
 class EABilinearFormExtension : public PABilinearFormExtension
 {
@@ -130,24 +297,30 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
 };
 
-/// Data and methods for matrix-free bilinear forms NOT YET IMPLEMENTED.
+/// Data and methods for matrix-free bilinear forms
+/** The action is computed on-the-fly: the geometric factors and the
+    coefficients are recomputed at the quadrature points in every call to
+    Mult(), so that the storage is of the order of an E-vector. */
 class MFBilinearFormExtension : public BilinearFormExtension
 {
+protected:
+   const FiniteElementSpace *trialFes, *testFes; // Not owned
+   mutable Vector localX, localY;
+   const Operator *elem_restrict; // Not owned
+
 public:
-   MFBilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
+   MFBilinearFormExtension(BilinearForm *form);
 
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
    void FormLinearSystem(const Array<int> &ess_tdof_list,
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~MFBilinearFormExtension() {}
+                         int copy_interior = 0);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void Update();
 };
 
 /// Class extending the MixedBilinearForm class to support different AssemblyLevels.
@@ -93,6 +93,88 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultBlockPA(const Vector &x, Vector &y,
+                                            const int nv) const
+{
+   const int xsize = x.Size()/nv, ysize = y.Size()/nv;
+   Vector xv, yv;
+   for (int v = 0; v < nv; v++)
+   {
+      xv.MakeRef(const_cast<Vector&>(x), v*xsize, xsize);
+      yv.MakeRef(y, v*ysize, ysize);
+      AddMultPA(xv, yv);
+   }
+}
+
+void BilinearFormIntegrator::AddMultPARange(const Vector &, Vector &,
+                                            const int, const int) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPARange(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePARange(const Vector &, Vector &,
+                                                     const int,
+                                                     const int) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposePARange(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::ReorderElementsPA(const Array<int> &)
+{
+   mfem_error ("BilinearFormIntegrator::ReorderElementsPA(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::ReorderElementData(Vector &x,
+                                                const Array<int> &order)
+{
+   const int ne = order.Size();
+   if (ne == 0) { return; }
+   const int esize = x.Size()/ne;
+   Vector old_x(x);
+   const double *h_old_x = old_x.HostRead();
+   double *h_x = x.HostWrite();
+   for (int e = 0; e < ne; e++)
+   {
+      std::copy(h_old_x + order[e]*esize, h_old_x + (order[e]+1)*esize,
+                h_x + e*esize);
+   }
+}
+
+void BilinearFormIntegrator::MakeElementRangeRef(const Vector &x, const int ne,
+                                                 const int e_begin,
+                                                 const int e_end, Vector &xr)
+{
+   const int esize = x.Size()/ne;
+   xr.MakeRef(const_cast<Vector&>(x), e_begin*esize, (e_end - e_begin)*esize);
+}
+
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace&)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleDiagonalMF(Vector &)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleDiagonalMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposeMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposeMF(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
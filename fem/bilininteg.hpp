@@ -27,6 +27,70 @@ constexpr int HCURL_MAX_Q1D = 6;
 constexpr int HDIV_MAX_D1D = 5;
 constexpr int HDIV_MAX_Q1D = 6;
 
+/** @brief Groups of elements with the same geometry, used by the partial
+    assembly of integrators on spaces without a tensor product basis. */
+/** This is the case of spaces on simplices, wedges, or on meshes with several
+    element geometries, see UsesTensorBasis(). The elements of each group are
+    processed together with the DofToQuad::FULL maps of the group, using the
+    E-vector layout of ElementRestriction with ElementDofOrdering::NATIVE. */
+class PAElementGroups
+{
+public:
+   struct Group
+   {
+      Geometry::Type type;    ///< Geometry of the elements of the group
+      int ne, nd, nq;         ///< Number of elements, dofs and quad points
+      int e_offset;           ///< Offset of the group in the E-vectors
+      int q_offset;           ///< Offset of the group quad points, nq x ne
+      const int *elements;    ///< Mesh indices of the elements, not owned
+      const IntegrationRule *ir;     ///< Not owned
+      const DofToQuad *maps;         ///< Not owned
+      const GeometricFactors *geom;  ///< Not owned
+   };
+
+protected:
+   const FiniteElementSpace *fes;
+   bool enabled;
+   Array<Group> groups;
+   Array<int> elements;
+
+public:
+   PAElementGroups() : fes(NULL), enabled(false) { }
+
+   /** @brief Setup the element groups of @a fes, if it does not use a tensor
+       product basis. Return true in that case, false otherwise. */
+   bool Setup(const FiniteElementSpace &fes);
+
+   /// Return true if the last call to Setup() returned true.
+   bool IsEnabled() const { return enabled; }
+
+   /// Return the number of groups.
+   int Size() const { return groups.Size(); }
+
+   /// Return the vector dimension of the space given to Setup().
+   int GetVDim() const { return fes->GetVDim(); }
+
+   const Group &operator[](int g) const { return groups[g]; }
+
+   /// Return the total number of quadrature points of all groups.
+   int GetNQ() const;
+
+   /** @brief Set the integration rule of group @a g and compute its DofToQuad
+       maps and its GeometricFactors with the given @a flags. */
+   /** The groups must be set in increasing order. */
+   void SetRule(int g, const IntegrationRule &ir, int flags);
+
+   /** @brief Evaluate the coefficient @a Q at the quadrature points of group
+       @a g: a single value if @a Q is NULL or constant, otherwise an array of
+       size nq x ne. */
+   void EvalCoefficient(int g, Coefficient *Q, Vector &coeff) const;
+
+   /** @brief Evaluate the vector coefficient @a Q at the quadrature points of
+       group @a g: a single vector if @a Q is constant, otherwise an array of
+       size vdim x nq x ne. */
+   void EvalCoefficient(int g, VectorCoefficient &Q, Vector &coeff) const;
+};
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
@@ -85,6 +149,61 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on several vectors.
+   /** Perform the action of integrator on the @a nv E-vectors stored one after
+       the other (column-blocked) in @a x and add the results to the
+       corresponding E-vectors in @a y.
+
+       The default implementation calls AddMultPA() for each vector; integrators
+       can override it to load their partially assembled data only once for all
+       the vectors. This method can be called only after the method
+       AssemblePA() has been called. */
+   virtual void AddMultBlockPA(const Vector &x, Vector &y, const int nv) const;
+
+   /** @brief Return true if the method AddMultPARange() is supported in the
+       current partially assembled state of the integrator. */
+   /** AddMultTransposePARange() is then supported if AddMultTransposePA() is
+       implemented. */
+   virtual bool SupportsPARange() const { return false; }
+
+   /// Method for partially assembled action on a range of elements.
+   /** Perform the action of integrator on the elements e_begin <= e < e_end of
+       the input @a x and add the result to the same elements of the output
+       @a y. Both @a x and @a y are E-vectors of all the elements, the other
+       elements of @a y are not modified.
+
+       This method can be called only after the method AssemblePA() has been
+       called and if SupportsPARange() returns true. */
+   virtual void AddMultPARange(const Vector &x, Vector &y,
+                               const int e_begin, const int e_end) const;
+
+   /** @brief Method for partially assembled transposed action on a range of
+       elements, see AddMultPARange(). */
+   virtual void AddMultTransposePARange(const Vector &x, Vector &y,
+                                        const int e_begin,
+                                        const int e_end) const;
+
+   /** @brief Reorder the elements of the partially assembled data, so that
+       the new element e is the old element @a order[e]. */
+   /** The E-vectors given to the other PA methods must then use the same
+       element order. This method can be called only after the method
+       AssemblePA() has been called and if SupportsPARange() returns true. */
+   virtual void ReorderElementsPA(const Array<int> &order);
+
+   /** @brief Reorder the elements of @a x, which stores the same number of
+       entries for each element, so that the new element e is the old element
+       @a order[e]. */
+   static void ReorderElementData(Vector &x, const Array<int> &order);
+
+   /** @brief Make @a xr a reference to the entries of the elements e_begin <=
+       e < e_end of @a x, which stores the same number of entries for each of
+       its @a ne elements, element by element. */
+   /** This is the layout of the E-vectors and of the partially assembled data
+       with a tensor product basis. */
+   static void MakeElementRangeRef(const Vector &x, const int ne,
+                                   const int e_begin, const int e_end,
+                                   Vector &xr);
+
    /// Method defining element assembly.
    /** The result of the element assembly is added and stored in the @a emat
        Vector. */
@@ -101,6 +220,32 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   /// Method defining matrix-free assembly.
+   /** Only the data needed to recompute the geometric factors and the
+       coefficient at the quadrature points is stored, e.g. the mesh nodes as an
+       E-vector. The action is computed later in AddMultMF(). */
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   /// Assemble diagonal and add it to Vector @a diag, matrix-free version.
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   /// Method for matrix-free action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   /// Method for matrix-free transposed action.
+   /** Perform the transpose action of integrator on the input @a x and add the
+       result to the output @a y. Both @a x and @a y are E-vectors.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -271,6 +416,21 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   virtual void AssembleMF(const FiniteElementSpace &fes)
+   {
+      bfi->AssembleMF(fes);
+   }
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   {
+      bfi->AddMultMF(x, y);
+   }
+
+   virtual void AddMultMF(const Vector& x, Vector& y) const
+   {
+      bfi->AddMultTransposeMF(x, y);
+   }
+
    virtual ~TransposeIntegrator() { if (own_bfi) { delete bfi; } }
 };
 
@@ -1872,6 +2032,17 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   PAElementGroups pa_groups; // used without a tensor product basis
+   void AssemblePAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   friend class PAFusedIntegrators;
+   void AssembleDiagonalPAGroups(Vector &diag);
+
+   // MF extension
+   Array<double> geom_B, geom_G;  ///< 1D maps of the mesh nodes
+   int geom_dofs1D;
+   const IntegrationRule *mf_ir;  ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1886,6 +2057,7 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1898,6 +2070,7 @@ public:
       MQ = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1910,6 +2083,7 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1958,6 +2132,33 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultBlockPA(const Vector &x, Vector &y, const int nv) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const
+   { AddMultPA(x, y); }
+
+   virtual bool SupportsPARange() const;
+
+   virtual void AddMultPARange(const Vector &x, Vector &y,
+                               const int e_begin, const int e_end) const;
+
+   virtual void AddMultTransposePARange(const Vector &x, Vector &y,
+                                        const int e_begin,
+                                        const int e_end) const
+   { AddMultPARange(x, y, e_begin, e_end); }
+
+   virtual void ReorderElementsPA(const Array<int> &order)
+   { ReorderElementData(pa_data, order); }
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -1978,6 +2179,17 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   PAElementGroups pa_groups; // used without a tensor product basis
+   void AssemblePAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   friend class PAFusedIntegrators;
+   void AssembleDiagonalPAGroups(Vector &diag);
+
+   // MF extension
+   Array<double> geom_B, geom_G;  ///< 1D maps of the mesh nodes
+   int geom_dofs1D;
+   const IntegrationRule *mf_ir;  ///< Not owned
+   Vector mf_nodes, mf_coeff;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1991,6 +2203,7 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -2002,6 +2215,7 @@ public:
    {
       maps = NULL;
       geom = NULL;
+      mf_ir = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -2033,6 +2247,33 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultBlockPA(const Vector &x, Vector &y, const int nv) const;
+
+   virtual void AddMultTransposePA(const Vector &x, Vector &y) const
+   { AddMultPA(x, y); }
+
+   virtual bool SupportsPARange() const;
+
+   virtual void AddMultPARange(const Vector &x, Vector &y,
+                               const int e_begin, const int e_end) const;
+
+   virtual void AddMultTransposePARange(const Vector &x, Vector &y,
+                                        const int e_begin,
+                                        const int e_end) const
+   { AddMultPARange(x, y, e_begin, e_end); }
+
+   virtual void ReorderElementsPA(const Array<int> &order)
+   { ReorderElementData(pa_data, order); }
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
@@ -2065,6 +2306,10 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   PAElementGroups pa_groups; // used without a tensor product basis
+   void AssemblePAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   friend class PAFusedIntegrators;
 
 private:
 #ifndef MFEM_THREAD_SAFE
@@ -2087,6 +2332,14 @@ public:
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPARange() const { return !pa_groups.IsEnabled(); }
+
+   virtual void AddMultPARange(const Vector &x, Vector &y,
+                               const int e_begin, const int e_end) const;
+
+   virtual void ReorderElementsPA(const Array<int> &order)
+   { ReorderElementData(pa_data, order); }
+
    static const IntegrationRule &GetRule(const FiniteElement &el,
                                          ElementTransformation &Trans);
 
@@ -2135,6 +2388,10 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   PAElementGroups pa_groups; // used without a tensor product basis
+   void AssemblePAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPAGroups(Vector &diag);
 
 public:
    /// Construct an integrator with coefficient 1.0
@@ -2524,6 +2781,10 @@ protected:
    const GeometricFactors *geom;  ///< Not owned
    int dim, sdim, ne, dofs1D, quad1D;
    Vector pa_data;
+   PAElementGroups pa_groups; // used without a tensor product basis
+   void AssemblePAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPAGroups(Vector &diag);
 
 private:
    DenseMatrix dshape, dshapedxt, pelmat;
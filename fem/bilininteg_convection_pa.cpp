@@ -768,6 +768,7 @@ void SmemPAConvectionApply3D(const int ne,
 
 void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
+   if (pa_groups.Setup(fes)) { return AssemblePAGroups(fes); }
    // Assumes tensor-product elements
    Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
@@ -804,21 +805,8 @@ void ConvectionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    }
    else
    {
-      vel.SetSize(dim * nq * ne);
-      auto C = Reshape(vel.HostWrite(), dim, nq, ne);
-      Vector Vq(dim);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            Q->Eval(Vq, T, ir->IntPoint(q));
-            for (int i = 0; i < dim; ++i)
-            {
-               C(i,q,e) = Vq(i);
-            }
-         }
-      }
+      MFEM_VERIFY(Q->GetVDim() == dim, "");
+      Q->EvalAll(vel, *mesh, *ir);
    }
    PAConvectionSetup(dim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
                      vel, alpha, pa_data);
@@ -871,9 +859,25 @@ static void PAConvectionApply(const int dim,
 // PA Convection Apply kernel
 void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.IsEnabled()) { return AddMultPAGroups(x, y); }
    PAConvectionApply(dim, dofs1D, quad1D, ne,
                      maps->B, maps->G, maps->Bt, maps->Gt,
                      pa_data, x, y);
 }
 
+void ConvectionIntegrator::AddMultPARange(const Vector &x, Vector &y,
+                                          const int e_begin,
+                                          const int e_end) const
+{
+   MFEM_ASSERT(SupportsPARange(), "element ranges are not supported");
+   if (e_end <= e_begin) { return; }
+   Vector xr, yr, dr;
+   MakeElementRangeRef(x, ne, e_begin, e_end, xr);
+   MakeElementRangeRef(y, ne, e_begin, e_end, yr);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, dr);
+   PAConvectionApply(dim, dofs1D, quad1D, e_end - e_begin,
+                     maps->B, maps->G, maps->Bt, maps->Gt,
+                     dr, xr, yr);
+}
+
 } // namespace mfem
@@ -0,0 +1,871 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA on spaces without a tensor product basis, e.g. on simplices or on meshes
+// with several element geometries. The elements are processed by groups of
+// elements with the same geometry, see PAElementGroups, and the kernels apply
+// the dense B (NQ x ND) and G (NQ x DIM x ND) matrices of DofToQuad::FULL.
+
+bool PAElementGroups::Setup(const FiniteElementSpace &fes)
+{
+   this->fes = &fes;
+   groups.SetSize(0);
+   enabled = (fes.GetNE() > 0) && !UsesTensorBasis(fes);
+   if (!enabled) { return false; }
+
+   const Operator *op = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   const ElementRestriction *er = dynamic_cast<const ElementRestriction*>(op);
+   if (er)
+   {
+      groups.SetSize(er->GetNumGroups());
+      for (int g = 0; g < groups.Size(); g++)
+      {
+         Group &G = groups[g];
+         G.type = er->GetGroupGeometry(g);
+         G.ne = er->GetGroupNE(g);
+         G.nd = er->GetGroupDofs(g);
+         G.e_offset = er->GetGroupOffset(g);
+         G.elements = er->GetGroupElements(g);
+      }
+   }
+   else
+   {
+      // L2ElementRestriction: a single geometry, in the mesh element order
+      const int ne = fes.GetNE();
+      elements.SetSize(ne);
+      for (int e = 0; e < ne; e++) { elements[e] = e; }
+      groups.SetSize(1);
+      Group &G = groups[0];
+      G.type = fes.GetMesh()->GetElementBaseGeometry(0);
+      G.ne = ne;
+      G.nd = fes.GetFE(0)->GetDof();
+      G.e_offset = 0;
+      G.elements = elements.GetData();
+   }
+   for (int g = 0; g < groups.Size(); g++)
+   {
+      Group &G = groups[g];
+      G.nq = G.q_offset = 0;
+      G.ir = NULL;
+      G.maps = NULL;
+      G.geom = NULL;
+   }
+   return true;
+}
+
+int PAElementGroups::GetNQ() const
+{
+   if (groups.Size() == 0) { return 0; }
+   const Group &G = groups.Last();
+   return G.q_offset + G.nq*G.ne;
+}
+
+void PAElementGroups::SetRule(int g, const IntegrationRule &ir, int flags)
+{
+   Group &G = groups[g];
+   G.ir = &ir;
+   G.nq = ir.GetNPoints();
+   G.q_offset = (g == 0) ? 0 : groups[g-1].q_offset +
+                groups[g-1].nq*groups[g-1].ne;
+   G.maps = &fes->GetFE(G.elements[0])->GetDofToQuad(ir, DofToQuad::FULL);
+   G.geom = fes->GetMesh()->GetGeometricFactors(ir, flags, G.type);
+}
+
+void PAElementGroups::EvalCoefficient(int g, Coefficient *Q,
+                                      Vector &coeff) const
+{
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+      return;
+   }
+   if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+      return;
+   }
+   const Group &G = groups[g];
+   Mesh *mesh = fes->GetMesh();
+   coeff.SetSize(G.nq*G.ne);
+   auto C = Reshape(coeff.HostWrite(), G.nq, G.ne);
+   for (int k = 0; k < G.ne; k++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(G.elements[k]);
+      for (int q = 0; q < G.nq; q++)
+      {
+         const IntegrationPoint &ip = G.ir->IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,k) = Q->Eval(T, ip);
+      }
+   }
+}
+
+void PAElementGroups::EvalCoefficient(int g, VectorCoefficient &Q,
+                                      Vector &coeff) const
+{
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+      return;
+   }
+   const Group &G = groups[g];
+   Mesh *mesh = fes->GetMesh();
+   const int vdim = Q.GetVDim();
+   coeff.SetSize(vdim*G.nq*G.ne);
+   auto C = Reshape(coeff.HostWrite(), vdim, G.nq, G.ne);
+   Vector v(vdim);
+   for (int k = 0; k < G.ne; k++)
+   {
+      ElementTransformation &T = *mesh->GetElementTransformation(G.elements[k]);
+      for (int q = 0; q < G.nq; q++)
+      {
+         const IntegrationPoint &ip = G.ir->IntPoint(q);
+         T.SetIntPoint(&ip);
+         Q.Eval(v, T, ip);
+         for (int c = 0; c < vdim; c++) { C(c,q,k) = v(c); }
+      }
+   }
+}
+
+// Setup kernels. The Jacobians are given as (NQ x SDIM x DIM x NE) arrays and
+// the coefficients as a single value or (NQ x NE) arrays.
+
+// Mass: D(q,e) = W(q) C(q,e) det(J(q,e))
+static void DenseMassSetup(const int dim, const int sdim,
+                           const int NQ, const int NE,
+                           const Array<double> &w,
+                           const Vector &j,
+                           const Vector &c,
+                           Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   auto W = w.Read();
+   auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto D = Reshape(d.Write(), NQ, NE);
+   if (dim == 2 && sdim == 2)
+   {
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double detJ = (J11*J22)-(J21*J12);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            D(q,e) = W[q] * coeff * detJ;
+         }
+      });
+   }
+   else if (dim == 2 && sdim == 3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,2,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J31 = J(q,2,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double J32 = J(q,2,1,e);
+            const double E = J11*J11 + J21*J21 + J31*J31;
+            const double G = J12*J12 + J22*J22 + J32*J32;
+            const double F = J11*J12 + J21*J22 + J31*J32;
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            D(q,e) = W[q] * coeff * sqrt(E*G - F*F);
+         }
+      });
+   }
+   else if (dim == 3 && sdim == 3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
+            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
+            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+            /* */               J21 * (J12 * J33 - J32 * J13) +
+            /* */               J31 * (J12 * J23 - J22 * J13);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            D(q,e) = W[q] * coeff * detJ;
+         }
+      });
+   }
+   else { MFEM_ABORT("Dimension not supported."); }
+}
+
+// Diffusion: symmetric D = W C det(J) J^{-1} J^{-T}, stored as (NQ x 3 x NE)
+// in 2D: 11, 12, 22, and (NQ x 6 x NE) in 3D: 11, 21, 31, 22, 32, 33.
+static void DenseDiffusionSetup(const int dim, const int sdim,
+                                const int NQ, const int NE,
+                                const Array<double> &w,
+                                const Vector &j,
+                                const Vector &c,
+                                Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   auto W = w.Read();
+   auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   if (dim == 2 && sdim == 2)
+   {
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      auto D = Reshape(d.Write(), NQ,3,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            const double c_detJ = W[q] * coeff / ((J11*J22)-(J21*J12));
+            D(q,0,e) =  c_detJ * (J12*J12 + J22*J22); // 1,1
+            D(q,1,e) = -c_detJ * (J12*J11 + J22*J21); // 1,2
+            D(q,2,e) =  c_detJ * (J11*J11 + J21*J21); // 2,2
+         }
+      });
+   }
+   else if (dim == 2 && sdim == 3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,2,NE);
+      auto D = Reshape(d.Write(), NQ,3,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J31 = J(q,2,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double J32 = J(q,2,1,e);
+            const double E = J11*J11 + J21*J21 + J31*J31;
+            const double G = J12*J12 + J22*J22 + J32*J32;
+            const double F = J11*J12 + J21*J22 + J31*J32;
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            const double alpha = W[q] * coeff / sqrt(E*G - F*F);
+            D(q,0,e) =  alpha * G; // 1,1
+            D(q,1,e) = -alpha * F; // 1,2
+            D(q,2,e) =  alpha * E; // 2,2
+         }
+      });
+   }
+   else if (dim == 3 && sdim == 3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      auto D = Reshape(d.Write(), NQ,6,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J31 = J(q,2,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double J32 = J(q,2,1,e);
+            const double J13 = J(q,0,2,e);
+            const double J23 = J(q,1,2,e);
+            const double J33 = J(q,2,2,e);
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+            /* */               J21 * (J12 * J33 - J32 * J13) +
+            /* */               J31 * (J12 * J23 - J22 * J13);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            const double c_detJ = W[q] * coeff / detJ;
+            // adj(J)
+            const double A11 = (J22 * J33) - (J23 * J32);
+            const double A12 = (J32 * J13) - (J12 * J33);
+            const double A13 = (J12 * J23) - (J22 * J13);
+            const double A21 = (J31 * J23) - (J21 * J33);
+            const double A22 = (J11 * J33) - (J13 * J31);
+            const double A23 = (J21 * J13) - (J11 * J23);
+            const double A31 = (J21 * J32) - (J31 * J22);
+            const double A32 = (J31 * J12) - (J11 * J32);
+            const double A33 = (J11 * J22) - (J12 * J21);
+            D(q,0,e) = c_detJ * (A11*A11 + A12*A12 + A13*A13); // 1,1
+            D(q,1,e) = c_detJ * (A11*A21 + A12*A22 + A13*A23); // 2,1
+            D(q,2,e) = c_detJ * (A11*A31 + A12*A32 + A13*A33); // 3,1
+            D(q,3,e) = c_detJ * (A21*A21 + A22*A22 + A23*A23); // 2,2
+            D(q,4,e) = c_detJ * (A21*A31 + A22*A32 + A23*A33); // 3,2
+            D(q,5,e) = c_detJ * (A31*A31 + A32*A32 + A33*A33); // 3,3
+         }
+      });
+   }
+   else { MFEM_ABORT("Dimension not supported."); }
+}
+
+// Convection: D(q,:,e) = alpha W(q) adj(J(q,e)) V(:,q,e), stored as
+// (NQ x DIM x NE), with a constant velocity or a (DIM x NQ x NE) array.
+static void DenseConvectionSetup(const int dim, const int NQ, const int NE,
+                                 const Array<double> &w,
+                                 const Vector &j,
+                                 const Vector &vel,
+                                 const double alpha,
+                                 Vector &d)
+{
+   auto W = w.Read();
+   if (dim == 2)
+   {
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      const bool const_v = vel.Size() == 2;
+      auto V = const_v ? Reshape(vel.Read(), 2,1,1) :
+               Reshape(vel.Read(), 2,NQ,NE);
+      auto D = Reshape(d.Write(), NQ,2,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double w = alpha * W[q];
+            const double wx = w * (const_v ? V(0,0,0) : V(0,q,e));
+            const double wy = w * (const_v ? V(1,0,0) : V(1,q,e));
+            D(q,0,e) =  wx * J22 - wy * J12;
+            D(q,1,e) = -wx * J21 + wy * J11;
+         }
+      });
+   }
+   else if (dim == 3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      const bool const_v = vel.Size() == 3;
+      auto V = const_v ? Reshape(vel.Read(), 3,1,1) :
+               Reshape(vel.Read(), 3,NQ,NE);
+      auto D = Reshape(d.Write(), NQ,3,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J21 = J(q,1,0,e);
+            const double J31 = J(q,2,0,e);
+            const double J12 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double J32 = J(q,2,1,e);
+            const double J13 = J(q,0,2,e);
+            const double J23 = J(q,1,2,e);
+            const double J33 = J(q,2,2,e);
+            const double w = alpha * W[q];
+            const double wx = w * (const_v ? V(0,0,0) : V(0,q,e));
+            const double wy = w * (const_v ? V(1,0,0) : V(1,q,e));
+            const double wz = w * (const_v ? V(2,0,0) : V(2,q,e));
+            // adj(J)
+            const double A11 = (J22 * J33) - (J23 * J32);
+            const double A12 = (J32 * J13) - (J12 * J33);
+            const double A13 = (J12 * J23) - (J22 * J13);
+            const double A21 = (J31 * J23) - (J21 * J33);
+            const double A22 = (J11 * J33) - (J13 * J31);
+            const double A23 = (J21 * J13) - (J11 * J23);
+            const double A31 = (J21 * J32) - (J31 * J22);
+            const double A32 = (J31 * J12) - (J11 * J32);
+            const double A33 = (J11 * J22) - (J12 * J21);
+            D(q,0,e) = wx * A11 + wy * A12 + wz * A13;
+            D(q,1,e) = wx * A21 + wy * A22 + wz * A23;
+            D(q,2,e) = wx * A31 + wy * A32 + wz * A33;
+         }
+      });
+   }
+   else { MFEM_ABORT("Dimension not supported."); }
+}
+
+// Apply and diagonal kernels. The E-vectors are (ND x VDIM x NE) arrays.
+
+static void DenseMassApply(const int ND, const int NQ, const int VDIM,
+                           const int NE,
+                           const Array<double> &b,
+                           const Vector &d,
+                           const Vector &x,
+                           Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto X = Reshape(x.Read(), ND, VDIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            double u = 0.0;
+            for (int i = 0; i < ND; ++i) { u += B(q,i) * X(i,c,e); }
+            u *= D(q,e);
+            for (int i = 0; i < ND; ++i) { Y(i,c,e) += B(q,i) * u; }
+         }
+      }
+   });
+}
+
+static void DenseMassDiagonal(const int ND, const int NQ, const int VDIM,
+                              const int NE,
+                              const Array<double> &b,
+                              const Vector &d,
+                              Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; ++i)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q) { val += B(q,i) * B(q,i) * D(q,e); }
+         for (int c = 0; c < VDIM; ++c) { Y(i,c,e) += val; }
+      }
+   });
+}
+
+template<int DIM>
+static void DenseDiffusionApply(const int ND, const int NQ, const int VDIM,
+                                const int NE,
+                                const Array<double> &g,
+                                const Vector &d,
+                                const Vector &x,
+                                Vector &y)
+{
+   constexpr int NS = (DIM*(DIM+1))/2;
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, NS, NE);
+   auto X = Reshape(x.Read(), ND, VDIM, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            double grad[DIM], dgrad[DIM];
+            for (int k = 0; k < DIM; ++k) { grad[k] = 0.0; }
+            for (int i = 0; i < ND; ++i)
+            {
+               const double xi = X(i,c,e);
+               for (int k = 0; k < DIM; ++k) { grad[k] += G(q,k,i) * xi; }
+            }
+            if (DIM == 2)
+            {
+               const double O11 = D(q,0,e), O12 = D(q,1,e), O22 = D(q,2,e);
+               dgrad[0] = O11 * grad[0] + O12 * grad[1];
+               dgrad[1] = O12 * grad[0] + O22 * grad[1];
+            }
+            else
+            {
+               const double O11 = D(q,0,e), O21 = D(q,1,e), O31 = D(q,2,e);
+               const double O22 = D(q,3,e), O32 = D(q,4,e), O33 = D(q,5,e);
+               dgrad[0] = O11 * grad[0] + O21 * grad[1] + O31 * grad[2];
+               dgrad[1] = O21 * grad[0] + O22 * grad[1] + O32 * grad[2];
+               dgrad[2] = O31 * grad[0] + O32 * grad[1] + O33 * grad[2];
+            }
+            for (int i = 0; i < ND; ++i)
+            {
+               double val = 0.0;
+               for (int k = 0; k < DIM; ++k) { val += G(q,k,i) * dgrad[k]; }
+               Y(i,c,e) += val;
+            }
+         }
+      }
+   });
+}
+
+template<int DIM>
+static void DenseDiffusionDiagonal(const int ND, const int NQ, const int VDIM,
+                                   const int NE,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y)
+{
+   constexpr int NS = (DIM*(DIM+1))/2;
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, NS, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; ++i)
+      {
+         double val = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            if (DIM == 2)
+            {
+               const double g0 = G(q,0,i), g1 = G(q,1,i);
+               val += D(q,0,e)*g0*g0 + 2.0*D(q,1,e)*g0*g1 + D(q,2,e)*g1*g1;
+            }
+            else
+            {
+               const double g0 = G(q,0,i), g1 = G(q,1,i), g2 = G(q,2,i);
+               val += D(q,0,e)*g0*g0 + D(q,3,e)*g1*g1 + D(q,5,e)*g2*g2 +
+                      2.0*(D(q,1,e)*g0*g1 + D(q,2,e)*g0*g2 + D(q,4,e)*g1*g2);
+            }
+         }
+         for (int c = 0; c < VDIM; ++c) { Y(i,c,e) += val; }
+      }
+   });
+}
+
+static void DenseDiffusionApply(const int dim, const int ND, const int NQ,
+                                const int VDIM, const int NE,
+                                const Array<double> &g,
+                                const Vector &d,
+                                const Vector &x,
+                                Vector &y)
+{
+   if (dim == 2) { return DenseDiffusionApply<2>(ND,NQ,VDIM,NE,g,d,x,y); }
+   if (dim == 3) { return DenseDiffusionApply<3>(ND,NQ,VDIM,NE,g,d,x,y); }
+   MFEM_ABORT("Dimension not supported.");
+}
+
+static void DenseDiffusionDiagonal(const int dim, const int ND, const int NQ,
+                                   const int VDIM, const int NE,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y)
+{
+   if (dim == 2) { return DenseDiffusionDiagonal<2>(ND,NQ,VDIM,NE,g,d,y); }
+   if (dim == 3) { return DenseDiffusionDiagonal<3>(ND,NQ,VDIM,NE,g,d,y); }
+   MFEM_ABORT("Dimension not supported.");
+}
+
+template<int DIM>
+static void DenseConvectionApply(const int ND, const int NQ, const int NE,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Vector &d,
+                                 const Vector &x,
+                                 Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto G = Reshape(g.Read(), NQ, DIM, ND);
+   auto D = Reshape(d.Read(), NQ, DIM, NE);
+   auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double u = 0.0;
+         for (int i = 0; i < ND; ++i)
+         {
+            double dx = 0.0;
+            for (int k = 0; k < DIM; ++k) { dx += D(q,k,e) * G(q,k,i); }
+            u += dx * X(i,e);
+         }
+         for (int i = 0; i < ND; ++i) { Y(i,e) += B(q,i) * u; }
+      }
+   });
+}
+
+// Return a reference to the part of the (const) vector v starting at offset
+static void GroupRef(const Vector &v, int offset, int size, Vector &vg)
+{
+   vg.MakeRef(const_cast<Vector&>(v), offset, size);
+}
+
+void MassIntegrator::AssemblePAGroups(const FiniteElementSpace &fes)
+{
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1, "A single "
+               "IntegrationRule is not supported with several geometries.");
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const int e = pa_groups[g].elements[0];
+      const FiniteElement &el = *fes.GetFE(e);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      pa_groups.SetRule(g, IntRule ? *IntRule : GetRule(el, el, T),
+                        GeometricFactors::JACOBIANS);
+   }
+   pa_data.SetSize(pa_groups.GetNQ(), Device::GetDeviceMemoryType());
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector coeff, d;
+      pa_groups.EvalCoefficient(g, Q, coeff);
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      DenseMassSetup(dim, mesh->SpaceDimension(), G.nq, G.ne,
+                     G.ir->GetWeights(), G.geom->J, coeff, d);
+   }
+}
+
+void MassIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   const int vdim = pa_groups.GetVDim();
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, xg, yg;
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      GroupRef(x, G.e_offset, G.nd*vdim*G.ne, xg);
+      GroupRef(y, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseMassApply(G.nd, G.nq, vdim, G.ne, G.maps->B, d, xg, yg);
+   }
+}
+
+void MassIntegrator::AssembleDiagonalPAGroups(Vector &diag)
+{
+   const int vdim = pa_groups.GetVDim();
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, yg;
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      GroupRef(diag, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseMassDiagonal(G.nd, G.nq, vdim, G.ne, G.maps->B, d, yg);
+   }
+}
+
+void DiffusionIntegrator::AssemblePAGroups(const FiniteElementSpace &fes)
+{
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(MQ == NULL, "Matrix coefficients are not supported.");
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1, "A single "
+               "IntegrationRule is not supported with several geometries.");
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const FiniteElement &el = *fes.GetFE(pa_groups[g].elements[0]);
+      pa_groups.SetRule(g, IntRule ? *IntRule : GetRule(el, el),
+                        GeometricFactors::JACOBIANS);
+   }
+   const int symmDims = (dim * (dim + 1)) / 2;
+   pa_data.SetSize(symmDims * pa_groups.GetNQ(), Device::GetDeviceMemoryType());
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector coeff, d;
+      pa_groups.EvalCoefficient(g, Q, coeff);
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      DenseDiffusionSetup(dim, mesh->SpaceDimension(), G.nq, G.ne,
+                          G.ir->GetWeights(), G.geom->J, coeff, d);
+   }
+}
+
+void DiffusionIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   const int vdim = pa_groups.GetVDim();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, xg, yg;
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      GroupRef(x, G.e_offset, G.nd*vdim*G.ne, xg);
+      GroupRef(y, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseDiffusionApply(dim, G.nd, G.nq, vdim, G.ne, G.maps->G, d, xg, yg);
+   }
+}
+
+void DiffusionIntegrator::AssembleDiagonalPAGroups(Vector &diag)
+{
+   const int vdim = pa_groups.GetVDim();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, yg;
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      GroupRef(diag, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseDiffusionDiagonal(dim, G.nd, G.nq, vdim, G.ne, G.maps->G, d, yg);
+   }
+}
+
+void ConvectionIntegrator::AssemblePAGroups(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "Surface meshes are not "
+               "supported.");
+   MFEM_VERIFY(Q->GetVDim() == dim, "");
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1, "A single "
+               "IntegrationRule is not supported with several geometries.");
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const int e = pa_groups[g].elements[0];
+      const FiniteElement &el = *fes.GetFE(e);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      pa_groups.SetRule(g, IntRule ? *IntRule : GetRule(el, T),
+                        GeometricFactors::JACOBIANS);
+   }
+   pa_data.SetSize(dim * pa_groups.GetNQ(), Device::GetMemoryType());
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector vel, d;
+      pa_groups.EvalCoefficient(g, *Q, vel);
+      GroupRef(pa_data, dim*G.q_offset, dim*G.nq*G.ne, d);
+      DenseConvectionSetup(dim, G.nq, G.ne, G.ir->GetWeights(), G.geom->J,
+                           vel, alpha, d);
+   }
+}
+
+void ConvectionIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, xg, yg;
+      GroupRef(pa_data, dim*G.q_offset, dim*G.nq*G.ne, d);
+      GroupRef(x, G.e_offset, G.nd*G.ne, xg);
+      GroupRef(y, G.e_offset, G.nd*G.ne, yg);
+      const Array<double> &B = G.maps->B, &Gr = G.maps->G;
+      if (dim == 2)
+      {
+         DenseConvectionApply<2>(G.nd, G.nq, G.ne, B, Gr, d, xg, yg);
+      }
+      else
+      {
+         DenseConvectionApply<3>(G.nd, G.nq, G.ne, B, Gr, d, xg, yg);
+      }
+   }
+}
+
+void VectorMassIntegrator::AssemblePAGroups(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(VQ == NULL && MQ == NULL, "Only scalar coefficients are "
+               "supported.");
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1, "A single "
+               "IntegrationRule is not supported with several geometries.");
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const int e = pa_groups[g].elements[0];
+      const FiniteElement &el = *fes.GetFE(e);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      pa_groups.SetRule(g, IntRule ? *IntRule :
+                        MassIntegrator::GetRule(el, el, T),
+                        GeometricFactors::JACOBIANS);
+   }
+   pa_data.SetSize(pa_groups.GetNQ(), Device::GetDeviceMemoryType());
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector coeff, d;
+      pa_groups.EvalCoefficient(g, Q, coeff);
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      DenseMassSetup(dim, mesh->SpaceDimension(), G.nq, G.ne,
+                     G.ir->GetWeights(), G.geom->J, coeff, d);
+   }
+}
+
+void VectorMassIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   const int vdim = pa_groups.GetVDim();
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, xg, yg;
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      GroupRef(x, G.e_offset, G.nd*vdim*G.ne, xg);
+      GroupRef(y, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseMassApply(G.nd, G.nq, vdim, G.ne, G.maps->B, d, xg, yg);
+   }
+}
+
+void VectorMassIntegrator::AssembleDiagonalPAGroups(Vector &diag)
+{
+   const int vdim = pa_groups.GetVDim();
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, yg;
+      GroupRef(pa_data, G.q_offset, G.nq*G.ne, d);
+      GroupRef(diag, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseMassDiagonal(G.nd, G.nq, vdim, G.ne, G.maps->B, d, yg);
+   }
+}
+
+void VectorDiffusionIntegrator::AssemblePAGroups(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   sdim = mesh->SpaceDimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1, "A single "
+               "IntegrationRule is not supported with several geometries.");
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const FiniteElement &el = *fes.GetFE(pa_groups[g].elements[0]);
+      pa_groups.SetRule(g, IntRule ? *IntRule :
+                        DiffusionIntegrator::GetRule(el, el),
+                        GeometricFactors::JACOBIANS);
+   }
+   const int symmDims = (dim * (dim + 1)) / 2;
+   pa_data.SetSize(symmDims * pa_groups.GetNQ(), Device::GetDeviceMemoryType());
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector coeff, d;
+      pa_groups.EvalCoefficient(g, Q, coeff);
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      DenseDiffusionSetup(dim, sdim, G.nq, G.ne, G.ir->GetWeights(),
+                          G.geom->J, coeff, d);
+   }
+}
+
+void VectorDiffusionIntegrator::AddMultPAGroups(const Vector &x,
+                                                Vector &y) const
+{
+   const int vdim = pa_groups.GetVDim();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, xg, yg;
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      GroupRef(x, G.e_offset, G.nd*vdim*G.ne, xg);
+      GroupRef(y, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseDiffusionApply(dim, G.nd, G.nq, vdim, G.ne, G.maps->G, d, xg, yg);
+   }
+}
+
+void VectorDiffusionIntegrator::AssembleDiagonalPAGroups(Vector &diag)
+{
+   const int vdim = pa_groups.GetVDim();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   for (int g = 0; g < pa_groups.Size(); g++)
+   {
+      const PAElementGroups::Group &G = pa_groups[g];
+      Vector d, yg;
+      GroupRef(pa_data, symmDims*G.q_offset, symmDims*G.nq*G.ne, d);
+      GroupRef(diag, G.e_offset, G.nd*vdim*G.ne, yg);
+      DenseDiffusionDiagonal(dim, G.nd, G.nq, vdim, G.ne, G.maps->G, d, yg);
+   }
+}
+
+} // namespace mfem
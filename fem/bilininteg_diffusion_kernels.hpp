@@ -0,0 +1,463 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+#define MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
+
+// Element kernels of the generic PA Diffusion diagonal and apply, used by the
+// library in bilininteg_diffusion_pa.cpp and embedded at build time in the
+// sources of the runtime compiled kernels, see class Jit. This file is compiled
+// on its own by the JIT, so it must not include other headers.
+
+#ifndef MFEM_HOST_DEVICE
+#define MFEM_HOST_DEVICE
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/** @brief Add the diagonal of the PA Diffusion operator of element @a e in 2D
+    to @a y. */
+/** The sizes are given by the template parameters T_D1D and T_Q1D, or by
+    @a d1d and @a q1d when they are 0, in which case MD1 and MQ1 bound them. The
+    layouts are b, g (Q1D,D1D), d(Q1D*Q1D,3,NE), holding the symmetric
+    quadrature point matrices, and y(D1D,D1D,NE). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PADiffusionDiagonal2DElement(const int e, const int d1d, const int q1d,
+                                  const double *b, const double *g,
+                                  const double *d, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*3*e;
+   double *Y = y + D1D*D1D*e;
+   // gradphi \cdot Q \gradphi has four terms
+   double QD0[MQ1][MD1];
+   double QD1[MQ1][MD1];
+   double QD2[MQ1][MD1];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         QD0[qx][dy] = 0.0;
+         QD1[qx][dy] = 0.0;
+         QD2[qx][dy] = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const int q = qx + qy * Q1D;
+            const double D0 = D[q];
+            const double D1 = D[q+Q1D*Q1D];
+            const double D2 = D[q+2*Q1D*Q1D];
+            const double By = b[qy+Q1D*dy];
+            const double Gy = g[qy+Q1D*dy];
+            QD0[qx][dy] += By * By * D0;
+            QD1[qx][dy] += By * Gy * D1;
+            QD2[qx][dy] += Gy * Gy * D2;
+         }
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double Bx = b[qx+Q1D*dx];
+            const double Gx = g[qx+Q1D*dx];
+            Y[dx+D1D*dy] += Gx * Gx * QD0[qx][dy];
+            Y[dx+D1D*dy] += Gx * Bx * QD1[qx][dy];
+            Y[dx+D1D*dy] += Bx * Gx * QD1[qx][dy];
+            Y[dx+D1D*dy] += Bx * Bx * QD2[qx][dy];
+         }
+      }
+   }
+}
+
+/** @brief Add the diagonal of the PA Diffusion operator of element @a e in 3D
+    to @a y, with d(Q1D*Q1D*Q1D,6,NE) and y(D1D,D1D,D1D,NE), see
+    PADiffusionDiagonal2DElement(). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PADiffusionDiagonal3DElement(const int e, const int d1d, const int q1d,
+                                  const double *b, const double *g,
+                                  const double *d, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int Q3D = Q1D*Q1D*Q1D;
+   const double *Q = d + Q3D*6*e;
+   double *Y = y + D1D*D1D*D1D*e;
+   double QQD[MQ1][MQ1][MD1];
+   double QDD[MQ1][MD1][MD1];
+   for (int i = 0; i < 3; ++i)
+   {
+      for (int j = 0; j < 3; ++j)
+      {
+         const int k = j >= i ?
+                       3 - (3-i)*(2-i)/2 + j:
+                       3 - (3-j)*(2-j)/2 + i;
+         // first tensor contraction, along z direction
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  QQD[qx][qy][dz] = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     const int q = qx + (qy + qz * Q1D) * Q1D;
+                     const double O = Q[q+Q3D*k];
+                     const double Bz = b[qz+Q1D*dz];
+                     const double Gz = g[qz+Q1D*dz];
+                     const double L = i==2 ? Gz : Bz;
+                     const double R = j==2 ? Gz : Bz;
+                     QQD[qx][qy][dz] += L * O * R;
+                  }
+               }
+            }
+         }
+         // second tensor contraction, along y direction
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  QDD[qx][dy][dz] = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     const double By = b[qy+Q1D*dy];
+                     const double Gy = g[qy+Q1D*dy];
+                     const double L = i==1 ? Gy : By;
+                     const double R = j==1 ? Gy : By;
+                     QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                  }
+               }
+            }
+         }
+         // third tensor contraction, along x direction
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double Bx = b[qx+Q1D*dx];
+                     const double Gx = g[qx+Q1D*dx];
+                     const double L = i==0 ? Gx : Bx;
+                     const double R = j==0 ? Gx : Bx;
+                     Y[dx+D1D*(dy+D1D*dz)] += L * QDD[qx][dy][dz] * R;
+                  }
+               }
+            }
+         }
+      }
+   }
+}
+
+/** @brief Add the action of the PA Diffusion operator of element @a e in 2D to
+    @a y, for the @a nv components of @a x. */
+/** The layouts are b, g (Q1D,D1D), bt, gt (D1D,Q1D), d(Q1D*Q1D,3,NE) and x, y
+    (D1D,D1D,NE,nv), see PADiffusionDiagonal2DElement() for the sizes. */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply2DElement(const int e, const int NE, const int nv,
+                               const int d1d, const int q1d,
+                               const double *b, const double *g,
+                               const double *bt, const double *gt,
+                               const double *d, const double *x, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*3*e;
+   for (int v = 0; v < nv; ++v)
+   {
+      const double *X = x + D1D*D1D*(e+NE*v);
+      double *Y = y + D1D*D1D*(e+NE*v);
+      double grad[MQ1][MQ1][2];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] = 0.0;
+            grad[qy][qx][1] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[MQ1][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X[dx+D1D*dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * b[qx+Q1D*dx];
+               gradX[qx][1] += s * g[qx+Q1D*dx];
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = b[qy+Q1D*dy];
+            const double wDy = g[qy+Q1D*dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] += gradX[qx][1] * wy;
+               grad[qy][qx][1] += gradX[qx][0] * wDy;
+            }
+         }
+      }
+      // Calculate Dxy, xDy in plane
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+
+            const double O11 = D[q];
+            const double O12 = D[q+Q1D*Q1D];
+            const double O22 = D[q+2*Q1D*Q1D];
+
+            const double gradX = grad[qy][qx][0];
+            const double gradY = grad[qy][qx][1];
+
+            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[MD1][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0;
+            gradX[dx][1] = 0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qy][qx][0];
+            const double gY = grad[qy][qx][1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = bt[dx+D1D*qx];
+               const double wDx = gt[dx+D1D*qx];
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = bt[dy+D1D*qy];
+            const double wDy = gt[dy+D1D*qy];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y[dx+D1D*dy] += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+            }
+         }
+      }
+   }
+}
+
+/** @brief Add the action of the PA Diffusion operator of element @a e in 3D to
+    @a y, with d(Q1D*Q1D*Q1D,6,NE) and x, y (D1D,D1D,D1D,NE,nv), see
+    PADiffusionApply2DElement(). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply3DElement(const int e, const int NE, const int nv,
+                               const int d1d, const int q1d,
+                               const double *b, const double *g,
+                               const double *bt, const double *gt,
+                               const double *d, const double *x, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const int Q3D = Q1D*Q1D*Q1D;
+   const double *D = d + Q3D*6*e;
+   for (int v = 0; v < nv; ++v)
+   {
+      const double *X = x + D1D*D1D*D1D*(e+NE*v);
+      double *Y = y + D1D*D1D*D1D*(e+NE*v);
+      double grad[MQ1][MQ1][MQ1][3];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] = 0.0;
+               grad[qz][qy][qx][1] = 0.0;
+               grad[qz][qy][qx][2] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double gradXY[MQ1][MQ1][3];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradXY[qy][qx][0] = 0.0;
+               gradXY[qy][qx][1] = 0.0;
+               gradXY[qy][qx][2] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[MQ1][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X[dx+D1D*(dy+D1D*dz)];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * b[qx+Q1D*dx];
+                  gradX[qx][1] += s * g[qx+Q1D*dx];
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = b[qy+Q1D*dy];
+               const double wDy = g[qy+Q1D*dy];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double wx  = gradX[qx][0];
+                  const double wDx = gradX[qx][1];
+                  gradXY[qy][qx][0] += wDx * wy;
+                  gradXY[qy][qx][1] += wx  * wDy;
+                  gradXY[qy][qx][2] += wx  * wy;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = b[qz+Q1D*dz];
+            const double wDz = g[qz+Q1D*dz];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+               }
+            }
+         }
+      }
+      // Calculate Dxyz, xDyz, xyDz in plane
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double O11 = D[q];
+               const double O12 = D[q+Q3D];
+               const double O13 = D[q+2*Q3D];
+               const double O22 = D[q+3*Q3D];
+               const double O23 = D[q+4*Q3D];
+               const double O33 = D[q+5*Q3D];
+               const double gradX = grad[qz][qy][qx][0];
+               const double gradY = grad[qz][qy][qx][1];
+               const double gradZ = grad[qz][qy][qx][2];
+               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double gradXY[MD1][MD1][3];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] = 0;
+               gradXY[dy][dx][1] = 0;
+               gradXY[dy][dx][2] = 0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[MD1][3];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0;
+               gradX[dx][1] = 0;
+               gradX[dx][2] = 0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qz][qy][qx][0];
+               const double gY = grad[qz][qy][qx][1];
+               const double gZ = grad[qz][qy][qx][2];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = bt[dx+D1D*qx];
+                  const double wDx = gt[dx+D1D*qx];
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+                  gradX[dx][2] += gZ * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = bt[dy+D1D*qy];
+               const double wDy = gt[dy+D1D*qy];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = bt[dz+D1D*qz];
+            const double wDz = gt[dz+D1D*qz];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y[dx+D1D*(dy+D1D*dz)] +=
+                     ((gradXY[dy][dx][0] * wz) +
+                      (gradXY[dy][dx][1] * wz) +
+                      (gradXY[dy][dx][2] * wDz));
+               }
+            }
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_DIFFUSION_KERNELS_HPP
@@ -0,0 +1,530 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "bilininteg_mf.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// MF Diffusion Integrator
+
+void DiffusionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   MFEM_VERIFY(MQ == NULL, "Matrix coefficients are not supported with "
+               "matrix-free assembly.");
+   MFEM_VERIFY(UsesTensorBasis(fes) && fes.GetVDim() == 1,
+               "Matrix-free diffusion requires a scalar tensor-product space.");
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Matrix-free diffusion is only "
+               "implemented in 2D and 3D.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "Matrix-free diffusion is not "
+               "implemented for surface meshes.");
+   mf_ir = ir;
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   internal::MFSetupNodes(*mesh, *ir, geom_B, geom_G, geom_dofs1D, mf_nodes);
+   internal::MFSetupCoefficient(fes, *ir, Q, mf_coeff);
+}
+
+// Matrix-free Diffusion Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply2D(const int NE,
+                               const int GD1D,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bg_,
+                               const Array<double> &gg_,
+                               const Array<double> &w_,
+                               const Vector &c_,
+                               const Vector &n_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const double *B = b_.Read();
+   const double *G = g_.Read();
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D, 2, NE);
+   const auto X = Reshape(x_.Read(), D1D*D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D*D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      // Rows of the Jacobian of the element transformation
+      double Jx[MQ1][MQ1][2], Jy[MQ1][MQ1][2];
+      double grad[MQ1][MQ1][2];
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFGrad2D<MQ1>(D1D, Q1D, B, G, &X(0,e), grad);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = Jx[qy][qx][0];
+            const double J12 = Jx[qy][qx][1];
+            const double J21 = Jy[qy][qx][0];
+            const double J22 = Jy[qy][qx][1];
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            const double c_detJ = W(qx,qy) * coeff / ((J11*J22)-(J21*J12));
+            const double O11 =  c_detJ * (J12*J12 + J22*J22);
+            const double O12 = -c_detJ * (J12*J11 + J22*J21);
+            const double O22 =  c_detJ * (J11*J11 + J21*J21);
+            const double gradX = grad[qy][qx][0];
+            const double gradY = grad[qy][qx][1];
+            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+         }
+      }
+      internal::MFGradTranspose2D<MD1,MQ1>(D1D, Q1D, B, G, grad, &Y(0,e));
+   });
+}
+
+// Matrix-free Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionApply3D(const int NE,
+                               const int GD1D,
+                               const Array<double> &b_,
+                               const Array<double> &g_,
+                               const Array<double> &bg_,
+                               const Array<double> &gg_,
+                               const Array<double> &w_,
+                               const Vector &c_,
+                               const Vector &n_,
+                               const Vector &x_,
+                               Vector &y_,
+                               const int d1d = 0,
+                               const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const double *B = b_.Read();
+   const double *G = g_.Read();
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D*GD1D, 3, NE);
+   const auto X = Reshape(x_.Read(), D1D*D1D*D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D*D1D*D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      // Rows of the Jacobian of the element transformation
+      double Jx[MQ1][MQ1][MQ1][3];
+      double Jy[MQ1][MQ1][MQ1][3];
+      double Jz[MQ1][MQ1][MQ1][3];
+      double grad[MQ1][MQ1][MQ1][3];
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,2,e), Jz);
+      internal::MFGrad3D<MQ1>(D1D, Q1D, B, G, &X(0,e), grad);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double O[6];
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               internal::MFDiffusionQFunction3D(W(qx,qy,qz) * coeff,
+                                                Jx[qz][qy][qx],
+                                                Jy[qz][qy][qx],
+                                                Jz[qz][qy][qx], O);
+               const double gradX = grad[qz][qy][qx][0];
+               const double gradY = grad[qz][qy][qx][1];
+               const double gradZ = grad[qz][qy][qx][2];
+               grad[qz][qy][qx][0] = (O[0]*gradX)+(O[1]*gradY)+(O[2]*gradZ);
+               grad[qz][qy][qx][1] = (O[1]*gradX)+(O[3]*gradY)+(O[4]*gradZ);
+               grad[qz][qy][qx][2] = (O[2]*gradX)+(O[4]*gradY)+(O[5]*gradZ);
+            }
+         }
+      }
+      internal::MFGradTranspose3D<MD1,MQ1>(D1D, Q1D, B, G, grad, &Y(0,e));
+   });
+}
+
+static void MFDiffusionApply(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int GD1D,
+                             const int NE,
+                             const Array<double> &B,
+                             const Array<double> &G,
+                             const Array<double> &BG,
+                             const Array<double> &GG,
+                             const Array<double> &W,
+                             const Vector &C,
+                             const Vector &N,
+                             const Vector &X,
+                             Vector &Y)
+{
+   const int ID = (D1D << 4 ) | Q1D;
+
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22: return MFDiffusionApply2D<2,2>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x33: return MFDiffusionApply2D<3,3>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x44: return MFDiffusionApply2D<4,4>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x55: return MFDiffusionApply2D<5,5>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x66: return MFDiffusionApply2D<6,6>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         default:   return MFDiffusionApply2D(NE,GD1D,B,G,BG,GG,W,C,N,X,Y,
+                                                 D1D,Q1D);
+      }
+   }
+
+   if (dim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: return MFDiffusionApply3D<2,3>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x34: return MFDiffusionApply3D<3,4>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x45: return MFDiffusionApply3D<4,5>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x56: return MFDiffusionApply3D<5,6>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         case 0x67: return MFDiffusionApply3D<6,7>(NE,GD1D,B,G,BG,GG,W,C,N,X,Y);
+         default:   return MFDiffusionApply3D(NE,GD1D,B,G,BG,GG,W,C,N,X,Y,
+                                                 D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// MF Diffusion Apply kernel
+void DiffusionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   MFDiffusionApply(dim, dofs1D, quad1D, geom_dofs1D, ne,
+                    maps->B, maps->G, geom_B, geom_G,
+                    mf_ir->GetWeights(), mf_coeff, mf_nodes, x, y);
+}
+
+// Matrix-free Diffusion Diagonal 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionDiagonal2D(const int NE,
+                                  const int GD1D,
+                                  const Array<double> &b_,
+                                  const Array<double> &g_,
+                                  const Array<double> &bg_,
+                                  const Array<double> &gg_,
+                                  const Array<double> &w_,
+                                  const Vector &c_,
+                                  const Vector &n_,
+                                  Vector &y_,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const auto B = Reshape(b_.Read(), Q1D, D1D);
+   const auto G = Reshape(g_.Read(), Q1D, D1D);
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D, 2, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][2], Jy[MQ1][MQ1][2];
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      // The symmetric operator at the quadrature points, computed in place
+      // of the Jacobian: Jx holds (O11, O12) and Jy holds (O22, -).
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double J11 = Jx[qy][qx][0];
+            const double J12 = Jx[qy][qx][1];
+            const double J21 = Jy[qy][qx][0];
+            const double J22 = Jy[qy][qx][1];
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            const double c_detJ = W(qx,qy) * coeff / ((J11*J22)-(J21*J12));
+            Jx[qy][qx][0] =  c_detJ * (J12*J12 + J22*J22);
+            Jx[qy][qx][1] = -c_detJ * (J12*J11 + J22*J21);
+            Jy[qy][qx][0] =  c_detJ * (J11*J11 + J21*J21);
+         }
+      }
+      // gradphi \cdot Q \gradphi has four terms
+      double QD0[MQ1][MD1];
+      double QD1[MQ1][MD1];
+      double QD2[MQ1][MD1];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            QD0[qx][dy] = 0.0;
+            QD1[qx][dy] = 0.0;
+            QD2[qx][dy] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               QD0[qx][dy] += B(qy, dy) * B(qy, dy) * Jx[qy][qx][0];
+               QD1[qx][dy] += B(qy, dy) * G(qy, dy) * Jx[qy][qx][1];
+               QD2[qx][dy] += G(qy, dy) * G(qy, dy) * Jy[qy][qx][0];
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Y(dx,dy,e) += G(qx, dx) * G(qx, dx) * QD0[qx][dy];
+               Y(dx,dy,e) += G(qx, dx) * B(qx, dx) * QD1[qx][dy];
+               Y(dx,dy,e) += B(qx, dx) * G(qx, dx) * QD1[qx][dy];
+               Y(dx,dy,e) += B(qx, dx) * B(qx, dx) * QD2[qx][dy];
+            }
+         }
+      }
+   });
+}
+
+// Matrix-free Diffusion Diagonal 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFDiffusionDiagonal3D(const int NE,
+                                  const int GD1D,
+                                  const Array<double> &b_,
+                                  const Array<double> &g_,
+                                  const Array<double> &bg_,
+                                  const Array<double> &gg_,
+                                  const Array<double> &w_,
+                                  const Vector &c_,
+                                  const Vector &n_,
+                                  Vector &y_,
+                                  const int d1d = 0,
+                                  const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const auto B = Reshape(b_.Read(), Q1D, D1D);
+   const auto G = Reshape(g_.Read(), Q1D, D1D);
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D*GD1D, 3, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][MQ1][3];
+      double Jy[MQ1][MQ1][MQ1][3];
+      double Jz[MQ1][MQ1][MQ1][3];
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,2,e), Jz);
+      // The symmetric operator at the quadrature points is computed in place
+      // of the Jacobian: Jx holds its entries 0-2 and Jy its entries 3-5.
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double O[6];
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               internal::MFDiffusionQFunction3D(W(qx,qy,qz) * coeff,
+                                                Jx[qz][qy][qx],
+                                                Jy[qz][qy][qx],
+                                                Jz[qz][qy][qx], O);
+               for (int k = 0; k < 3; ++k)
+               {
+                  Jx[qz][qy][qx][k] = O[k];
+                  Jy[qz][qy][qx][k] = O[k+3];
+               }
+            }
+         }
+      }
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int i = 0; i < DIM; ++i)
+      {
+         for (int j = 0; j < DIM; ++j)
+         {
+            const int k = j >= i ?
+            3 - (3-i)*(2-i)/2 + j:
+            3 - (3-j)*(2-j)/2 + i;
+            // first tensor contraction, along z direction
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     QQD[qx][qy][dz] = 0.0;
+                     for (int qz = 0; qz < Q1D; ++qz)
+                     {
+                        const double Bz = B(qz,dz);
+                        const double Gz = G(qz,dz);
+                        const double L = i==2 ? Gz : Bz;
+                        const double R = j==2 ? Gz : Bz;
+                        const double O = k < 3 ? Jx[qz][qy][qx][k] :
+                                         Jy[qz][qy][qx][k-3];
+                        QQD[qx][qy][dz] += L * O * R;
+                     }
+                  }
+               }
+            }
+            // second tensor contraction, along y direction
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     QDD[qx][dy][dz] = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        const double By = B(qy,dy);
+                        const double Gy = G(qy,dy);
+                        const double L = i==1 ? Gy : By;
+                        const double R = j==1 ? Gy : By;
+                        QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                     }
+                  }
+               }
+            }
+            // third tensor contraction, along x direction
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const double Bx = B(qx,dx);
+                        const double Gx = G(qx,dx);
+                        const double L = i==0 ? Gx : Bx;
+                        const double R = j==0 ? Gx : Bx;
+                        Y(dx, dy, dz, e) += L * QDD[qx][dy][dz] * R;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void MFDiffusionAssembleDiagonal(const int dim,
+                                        const int D1D,
+                                        const int Q1D,
+                                        const int GD1D,
+                                        const int NE,
+                                        const Array<double> &B,
+                                        const Array<double> &G,
+                                        const Array<double> &BG,
+                                        const Array<double> &GG,
+                                        const Array<double> &W,
+                                        const Vector &C,
+                                        const Vector &N,
+                                        Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22:
+            return MFDiffusionDiagonal2D<2,2>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x33:
+            return MFDiffusionDiagonal2D<3,3>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x44:
+            return MFDiffusionDiagonal2D<4,4>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x55:
+            return MFDiffusionDiagonal2D<5,5>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         default: return MFDiffusionDiagonal2D(NE,GD1D,B,G,BG,GG,W,C,N,Y,
+                                                  D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23:
+            return MFDiffusionDiagonal3D<2,3>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x34:
+            return MFDiffusionDiagonal3D<3,4>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x45:
+            return MFDiffusionDiagonal3D<4,5>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         case 0x56:
+            return MFDiffusionDiagonal3D<5,6>(NE,GD1D,B,G,BG,GG,W,C,N,Y);
+         default: return MFDiffusionDiagonal3D(NE,GD1D,B,G,BG,GG,W,C,N,Y,
+                                                  D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DiffusionIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   MFDiffusionAssembleDiagonal(dim, dofs1D, quad1D, geom_dofs1D, ne,
+                               maps->B, maps->G, geom_B, geom_G,
+                               mf_ir->GetWeights(), mf_coeff, mf_nodes, diag);
+}
+
+} // namespace mfem
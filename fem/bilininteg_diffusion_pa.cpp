@@ -13,6 +13,14 @@
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
+#include "../general/jit.hpp"
+#include "bilininteg_simd.hpp"
+#include "bilininteg_diffusion_kernels.hpp"
+#ifdef MFEM_USE_JIT
+#include "bilininteg_diffusion_kernels_jit.hpp"
+#endif
+
+#include <cstdio>
 
 using namespace std;
 
@@ -318,16 +326,7 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
    PADiffusionSetup(dim, sdim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
                     coeff, pa_data);
@@ -335,6 +334,11 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes)
 
 void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
+   // libCEED has its own support for non-tensor elements
+   if (pa_groups.Setup(fes) && !DeviceCanUseCeed())
+   {
+      return AssemblePAGroups(fes);
+   }
    SetupPA(fes);
 }
 
@@ -352,54 +356,18 @@ static void PADiffusionDiagonal2D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
+   const double *B = b.Read();
+   const double *G = g.Read();
    // note the different shape for D, this is a (symmetric) matrix so we only
    // store necessary entries
-   auto D = Reshape(d.Read(), Q1D*Q1D, 3, NE);
-   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   const double *D = d.Read();
+   double *Y = y.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      // gradphi \cdot Q \gradphi has four terms
-      double QD0[MQ1][MD1];
-      double QD1[MQ1][MD1];
-      double QD2[MQ1][MD1];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            QD0[qx][dy] = 0.0;
-            QD1[qx][dy] = 0.0;
-            QD2[qx][dy] = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const int q = qx + qy * Q1D;
-               const double D0 = D(q,0,e);
-               const double D1 = D(q,1,e);
-               const double D2 = D(q,2,e);
-               QD0[qx][dy] += B(qy, dy) * B(qy, dy) * D0;
-               QD1[qx][dy] += B(qy, dy) * G(qy, dy) * D1;
-               QD2[qx][dy] += G(qy, dy) * G(qy, dy) * D2;
-            }
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               Y(dx,dy,e) += G(qx, dx) * G(qx, dx) * QD0[qx][dy];
-               Y(dx,dy,e) += G(qx, dx) * B(qx, dx) * QD1[qx][dy];
-               Y(dx,dy,e) += B(qx, dx) * G(qx, dx) * QD1[qx][dy];
-               Y(dx,dy,e) += B(qx, dx) * B(qx, dx) * QD2[qx][dy];
-            }
-         }
-      }
+      internal::PADiffusionDiagonal2DElement<T_D1D,T_Q1D,MD1,MQ1>(
+         e, d1d, q1d, B, G, D, Y);
    });
 }
 
@@ -506,92 +474,20 @@ static void PADiffusionDiagonal3D(const int NE,
                                   const int d1d = 0,
                                   const int q1d = 0)
 {
-   constexpr int DIM = 3;
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-   constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
-   MFEM_VERIFY(D1D <= MD1, "");
-   MFEM_VERIFY(Q1D <= MQ1, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Q = Reshape(d.Read(), Q1D*Q1D*Q1D, 6, NE);
-   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const double *B = b.Read();
+   const double *G = g.Read();
+   const double *Q = d.Read();
+   double *Y = y.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double QQD[MQ1][MQ1][MD1];
-      double QDD[MQ1][MD1][MD1];
-      for (int i = 0; i < DIM; ++i)
-      {
-         for (int j = 0; j < DIM; ++j)
-         {
-            // first tensor contraction, along z direction
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  for (int dz = 0; dz < D1D; ++dz)
-                  {
-                     QQD[qx][qy][dz] = 0.0;
-                     for (int qz = 0; qz < Q1D; ++qz)
-                     {
-                        const int q = qx + (qy + qz * Q1D) * Q1D;
-                        const int k = j >= i ?
-                        3 - (3-i)*(2-i)/2 + j:
-                        3 - (3-j)*(2-j)/2 + i;
-                        const double O = Q(q,k,e);
-                        const double Bz = B(qz,dz);
-                        const double Gz = G(qz,dz);
-                        const double L = i==2 ? Gz : Bz;
-                        const double R = j==2 ? Gz : Bz;
-                        QQD[qx][qy][dz] += L * O * R;
-                     }
-                  }
-               }
-            }
-            // second tensor contraction, along y direction
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               for (int dz = 0; dz < D1D; ++dz)
-               {
-                  for (int dy = 0; dy < D1D; ++dy)
-                  {
-                     QDD[qx][dy][dz] = 0.0;
-                     for (int qy = 0; qy < Q1D; ++qy)
-                     {
-                        const double By = B(qy,dy);
-                        const double Gy = G(qy,dy);
-                        const double L = i==1 ? Gy : By;
-                        const double R = j==1 ? Gy : By;
-                        QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
-                     }
-                  }
-               }
-            }
-            // third tensor contraction, along x direction
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               for (int dy = 0; dy < D1D; ++dy)
-               {
-                  for (int dx = 0; dx < D1D; ++dx)
-                  {
-                     for (int qx = 0; qx < Q1D; ++qx)
-                     {
-                        const double Bx = B(qx,dx);
-                        const double Gx = G(qx,dx);
-                        const double L = i==0 ? Gx : Bx;
-                        const double R = j==0 ? Gx : Bx;
-                        Y(dx, dy, dz, e) += L * QDD[qx][dy][dz] * R;
-                     }
-                  }
-               }
-            }
-         }
-      }
+      internal::PADiffusionDiagonal3DElement<T_D1D,T_Q1D,MD1,MQ1>(
+         e, d1d, q1d, B, G, Q, Y);
    });
 }
 
@@ -712,6 +608,147 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    });
 }
 
+#ifdef MFEM_USE_JIT
+// Entry points of the runtime compiled PA Diffusion kernels, used for the
+// (D1D,Q1D) combinations without a compile-time instantiation, see class Jit.
+// They are compiled after the element kernels of
+// bilininteg_diffusion_kernels.hpp, embedded at build time in
+// bilininteg_diffusion_kernels_source, with D1D and Q1D given by
+// -DMFEM_JIT_D1D and -DMFEM_JIT_Q1D.
+static const char *jit_diffusion_diag_2d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const double *__restrict b,
+                                const double *__restrict g,
+                                const double *__restrict d,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PADiffusionDiagonal2DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, g, d, y);
+   }
+}
+)_";
+
+static const char *jit_diffusion_diag_3d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const double *__restrict b,
+                                const double *__restrict g,
+                                const double *__restrict d,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PADiffusionDiagonal3DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, g, d, y);
+   }
+}
+)_";
+
+static const char *jit_diffusion_apply_2d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const int NV,
+                                const double *__restrict b,
+                                const double *__restrict g,
+                                const double *__restrict bt,
+                                const double *__restrict gt,
+                                const double *__restrict d,
+                                const double *__restrict x,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PADiffusionApply2DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, NE, NV, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, g, bt, gt, d, x, y);
+   }
+}
+)_";
+
+static const char *jit_diffusion_apply_3d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const int NV,
+                                const double *__restrict b,
+                                const double *__restrict g,
+                                const double *__restrict bt,
+                                const double *__restrict gt,
+                                const double *__restrict d,
+                                const double *__restrict x,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PADiffusionApply3DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, NE, NV, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, g, bt, gt, d, x, y);
+   }
+}
+)_";
+
+typedef void (*JitPADiffusionDiagonalKernel)(const int, const double*,
+                                             const double*, const double*,
+                                             double*);
+typedef void (*JitPADiffusionApplyKernel)(const int, const int, const double*,
+                                          const double*, const double*,
+                                          const double*, const double*,
+                                          const double*, double*);
+
+// Return the runtime compiled kernel 'name' for the given (D1D,Q1D), or NULL.
+static void *JitPADiffusionKernel(const char *name, const std::string &source,
+                                  const int D1D, const int Q1D)
+{
+   if (!Jit::Enabled()) { return NULL; }
+   char defines[64];
+   snprintf(defines, sizeof(defines), "-DMFEM_JIT_D1D=%d -DMFEM_JIT_Q1D=%d",
+            D1D, Q1D);
+   return Jit::Lookup(name, source.c_str(), defines);
+}
+
+static bool JitPADiffusionAssembleDiagonal(const int dim, const int D1D,
+                                           const int Q1D, const int NE,
+                                           const Array<double> &B,
+                                           const Array<double> &G,
+                                           const Vector &D,
+                                           Vector &Y)
+{
+   static const std::string src_2d =
+      std::string(bilininteg_diffusion_kernels_source) + jit_diffusion_diag_2d;
+   static const std::string src_3d =
+      std::string(bilininteg_diffusion_kernels_source) + jit_diffusion_diag_3d;
+   void *ptr = (dim == 2) ?
+               JitPADiffusionKernel("pa_diffusion_diag_2d", src_2d, D1D, Q1D) :
+               JitPADiffusionKernel("pa_diffusion_diag_3d", src_3d, D1D, Q1D);
+   if (!ptr) { return false; }
+   JitPADiffusionDiagonalKernel kernel;
+   *reinterpret_cast<void**>(&kernel) = ptr;
+   kernel(NE, B.HostRead(), G.HostRead(), D.HostRead(), Y.HostReadWrite());
+   return true;
+}
+
+static bool JitPADiffusionApply(const int dim, const int D1D, const int Q1D,
+                                const int NE, const int NV,
+                                const Array<double> &B,
+                                const Array<double> &G,
+                                const Array<double> &Bt,
+                                const Array<double> &Gt,
+                                const Vector &D,
+                                const Vector &X,
+                                Vector &Y)
+{
+   static const std::string src_2d =
+      std::string(bilininteg_diffusion_kernels_source) + jit_diffusion_apply_2d;
+   static const std::string src_3d =
+      std::string(bilininteg_diffusion_kernels_source) + jit_diffusion_apply_3d;
+   void *ptr = (dim == 2) ?
+               JitPADiffusionKernel("pa_diffusion_apply_2d", src_2d, D1D, Q1D) :
+               JitPADiffusionKernel("pa_diffusion_apply_3d", src_3d, D1D, Q1D);
+   if (!ptr) { return false; }
+   JitPADiffusionApplyKernel kernel;
+   *reinterpret_cast<void**>(&kernel) = ptr;
+   kernel(NE, NV, B.HostRead(), G.HostRead(), Bt.HostRead(), Gt.HostRead(),
+          D.HostRead(), X.HostRead(), Y.HostReadWrite());
+   return true;
+}
+#endif // MFEM_USE_JIT
+
 static void PADiffusionAssembleDiagonal(const int dim,
                                         const int D1D,
                                         const int Q1D,
@@ -733,7 +770,16 @@ static void PADiffusionAssembleDiagonal(const int dim,
          case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,B,G,D,Y);
          case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,B,G,D,Y);
          case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionAssembleDiagonal(2,D1D,Q1D,NE,B,G,D,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+         }
       }
    }
    else if (dim == 3)
@@ -748,7 +794,16 @@ static void PADiffusionAssembleDiagonal(const int dim,
          case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,B,G,D,Y);
          case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,B,G,D,Y);
          case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionAssembleDiagonal(3,D1D,Q1D,NE,B,G,D,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+         }
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -756,6 +811,10 @@ static void PADiffusionAssembleDiagonal(const int dim,
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.IsEnabled() && !DeviceCanUseCeed())
+   {
+      return AssembleDiagonalPAGroups(diag);
+   }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -881,112 +940,27 @@ static void PADiffusionApply2D(const int NE,
                                const Vector &x_,
                                Vector &y_,
                                const int d1d = 0,
-                               const int q1d = 0)
+                               const int q1d = 0,
+                               const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto G = Reshape(g_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *G = g_.Read();
+   const double *Bt = bt_.Read();
+   const double *Gt = gt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-
-      double grad[max_Q1D][max_Q1D][2];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         double gradX[max_Q1D][2];
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double wy  = B(qy,dy);
-            const double wDy = G(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
-            }
-         }
-      }
-      // Calculate Dxy, xDy in plane
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const int q = qx + qy * Q1D;
-
-            const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
-
-            const double gradX = grad[qy][qx][0];
-            const double gradY = grad[qy][qx][1];
-
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double gradX[max_D1D][2];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double gX = grad[qy][qx][0];
-            const double gY = grad[qy][qx][1];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double wx  = Bt(dx,qx);
-               const double wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double wy  = Bt(dy,qy);
-            const double wDy = Gt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
-            }
-         }
-      }
+      internal::PADiffusionApply2DElement<T_D1D,T_Q1D,max_D1D,max_Q1D>(
+         e, NE, nv, d1d, q1d, B, G, Bt, Gt, D, X, Y);
    });
 }
 
@@ -1156,182 +1130,26 @@ static void PADiffusionApply3D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
-                               int d1d = 0, int q1d = 0)
+                               int d1d = 0, int q1d = 0, int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *G = g.Read();
+   const double *Bt = bt.Read();
+   const double *Gt = gt.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double grad[max_Q1D][max_Q1D][max_Q1D][3];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double gradXY[max_Q1D][max_Q1D][3];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double gradX[max_Q1D][2];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy  = B(qy,dy);
-               const double wDy = G(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const double wx  = gradX[qx][0];
-                  const double wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz  = B(qz,dz);
-            const double wDz = G(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-               }
-            }
-         }
-      }
-      // Calculate Dxyz, xDyz, xyDz in plane
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const int q = qx + (qy + qz * Q1D) * Q1D;
-               const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O22 = D(q,3,e);
-               const double O23 = D(q,4,e);
-               const double O33 = D(q,5,e);
-               const double gradX = grad[qz][qy][qx][0];
-               const double gradY = grad[qz][qy][qx][1];
-               const double gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double gradXY[max_D1D][max_D1D][3];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            double gradX[max_D1D][3];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double gX = grad[qz][qy][qx][0];
-               const double gY = grad[qz][qy][qx][1];
-               const double gZ = grad[qz][qy][qx][2];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const double wx  = Bt(dx,qx);
-                  const double wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy  = Bt(dy,qy);
-               const double wDy = Gt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz  = Bt(dz,qz);
-            const double wDz = Gt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
-               }
-            }
-         }
-      }
+      internal::PADiffusionApply3DElement<T_D1D,T_Q1D,max_D1D,max_Q1D>(
+         e, NE, nv, d1d, q1d, B, G, Bt, Gt, D, X, Y);
    });
 }
 
@@ -1652,6 +1470,365 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+// Cross-element SIMD PA Diffusion Apply 2D kernel: each lane of the SIMD type
+// holds the data of one element in a batch of PASimd::size elements.
+template<int T_D1D, int T_Q1D>
+static void SimdPADiffusionApply2D(const int NE,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int nv = 1)
+{
+   typedef internal::PASimd::real_t vreal_t;
+   constexpr int SIMD = internal::PASimd::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int ND = D1D*D1D;
+   constexpr int NQ = Q1D*Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const double *D = d_.HostRead();
+   const double *X = x_.HostRead();
+   double *Y = y_.HostReadWrite();
+   for (int e0 = 0; e0 < NE; e0 += SIMD)
+   {
+      const int nl = std::min(SIMD, NE - e0);
+      vreal_t Dq[3*NQ];
+      internal::SimdLoad(Dq, D + 3*NQ*e0, 3*NQ, nl, 3*NQ);
+      for (int v = 0; v < nv; ++v)
+      {
+         const int xoff = ND*(e0 + NE*v);
+         vreal_t x[ND];
+         internal::SimdLoad(x, X + xoff, ND, nl, ND);
+         vreal_t grad[Q1D][Q1D][2];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][0] = 0.0;
+               grad[qy][qx][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            vreal_t gradX[Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const vreal_t s = x[dx + D1D*dy];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0].fma(s, B(qx,dx));
+                  gradX[qx][1].fma(s, G(qx,dx));
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][0].fma(gradX[qx][1], wy);
+                  grad[qy][qx][1].fma(gradX[qx][0], wDy);
+               }
+            }
+         }
+         // Calculate Dxy, xDy in plane
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + qy * Q1D;
+               const vreal_t O11 = Dq[q];
+               const vreal_t O12 = Dq[q + NQ];
+               const vreal_t O22 = Dq[q + 2*NQ];
+               const vreal_t gradX = grad[qy][qx][0];
+               const vreal_t gradY = grad[qy][qx][1];
+               grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+               grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+            }
+         }
+         vreal_t y[ND];
+         for (int i = 0; i < ND; ++i) { y[i] = 0.0; }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            vreal_t gradX[D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0].fma(grad[qy][qx][0], G(qx,dx));
+                  gradX[dx][1].fma(grad[qy][qx][1], B(qx,dx));
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y[dx + D1D*dy].fma(gradX[dx][0], wy);
+                  y[dx + D1D*dy].fma(gradX[dx][1], wDy);
+               }
+            }
+         }
+         internal::SimdAddStore(y, Y + xoff, ND, nl, ND);
+      }
+   }
+}
+
+// Cross-element SIMD PA Diffusion Apply 3D kernel
+template<int T_D1D, int T_Q1D>
+static void SimdPADiffusionApply3D(const int NE,
+                                   const Array<double> &b_,
+                                   const Array<double> &g_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int nv = 1)
+{
+   typedef internal::PASimd::real_t vreal_t;
+   constexpr int SIMD = internal::PASimd::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int ND = D1D*D1D*D1D;
+   constexpr int NQ = Q1D*Q1D*Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const double *D = d_.HostRead();
+   const double *X = x_.HostRead();
+   double *Y = y_.HostReadWrite();
+   for (int e0 = 0; e0 < NE; e0 += SIMD)
+   {
+      const int nl = std::min(SIMD, NE - e0);
+      for (int v = 0; v < nv; ++v)
+      {
+         const int xoff = ND*(e0 + NE*v);
+         vreal_t x[ND];
+         internal::SimdLoad(x, X + xoff, ND, nl, ND);
+         vreal_t grad[Q1D][Q1D][Q1D][3];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][0] = 0.0;
+                  grad[qz][qy][qx][1] = 0.0;
+                  grad[qz][qy][qx][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            vreal_t gradXY[Q1D][Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               vreal_t gradX[Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const vreal_t s = x[dx + D1D*(dy + D1D*dz)];
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0].fma(s, B(qx,dx));
+                     gradX[qx][1].fma(s, G(qx,dx));
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradXY[qy][qx][0].fma(gradX[qx][1], wy);
+                     gradXY[qy][qx][1].fma(gradX[qx][0], wDy);
+                     gradXY[qy][qx][2].fma(gradX[qx][0], wy);
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][0].fma(gradXY[qy][qx][0], wz);
+                     grad[qz][qy][qx][1].fma(gradXY[qy][qx][1], wz);
+                     grad[qz][qy][qx][2].fma(gradXY[qy][qx][2], wDz);
+                  }
+               }
+            }
+         }
+         // Calculate Dxyz, xDyz, xyDz in plane
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const int q = qx + (qy + qz * Q1D) * Q1D;
+                  const double *Dq = D + 6*NQ*e0 + q;
+                  vreal_t O11, O12, O13, O22, O23, O33;
+                  internal::SimdGather(O11, Dq, 6*NQ, nl);
+                  internal::SimdGather(O12, Dq + NQ, 6*NQ, nl);
+                  internal::SimdGather(O13, Dq + 2*NQ, 6*NQ, nl);
+                  internal::SimdGather(O22, Dq + 3*NQ, 6*NQ, nl);
+                  internal::SimdGather(O23, Dq + 4*NQ, 6*NQ, nl);
+                  internal::SimdGather(O33, Dq + 5*NQ, 6*NQ, nl);
+                  const vreal_t gradX = grad[qz][qy][qx][0];
+                  const vreal_t gradY = grad[qz][qy][qx][1];
+                  const vreal_t gradZ = grad[qz][qy][qx][2];
+                  grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+                  grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
+                  grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+               }
+            }
+         }
+         vreal_t y[D1D][D1D][D1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx) { y[dz][dy][dx] = 0.0; }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            vreal_t gradXY[D1D][D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0.0;
+                  gradXY[dy][dx][1] = 0.0;
+                  gradXY[dy][dx][2] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               vreal_t gradX[D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0.0;
+                  gradX[dx][1] = 0.0;
+                  gradX[dx][2] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = B(qx,dx);
+                     const double wDx = G(qx,dx);
+                     gradX[dx][0].fma(grad[qz][qy][qx][0], wDx);
+                     gradX[dx][1].fma(grad[qz][qy][qx][1], wx);
+                     gradX[dx][2].fma(grad[qz][qy][qx][2], wx);
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0].fma(gradX[dx][0], wy);
+                     gradXY[dy][dx][1].fma(gradX[dx][1], wDy);
+                     gradXY[dy][dx][2].fma(gradX[dx][2], wy);
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y[dz][dy][dx].fma(gradXY[dy][dx][0], wz);
+                     y[dz][dy][dx].fma(gradXY[dy][dx][1], wz);
+                     y[dz][dy][dx].fma(gradXY[dy][dx][2], wDz);
+                  }
+               }
+            }
+         }
+         internal::SimdAddStore(&y[0][0][0], Y + xoff, ND, nl, ND);
+      }
+   }
+}
+
+// Cross-element SIMD action, on nv column-blocked E-vectors. Returns false if
+// there is no SIMD instantiation for the given (D1D,Q1D).
+static bool SimdPADiffusionApply(const int dim,
+                                 const int D1D,
+                                 const int Q1D,
+                                 const int NE,
+                                 const int NV,
+                                 const Array<double> &B,
+                                 const Array<double> &G,
+                                 const Vector &D,
+                                 const Vector &X,
+                                 Vector &Y)
+{
+   const int ID = (D1D << 4 ) | Q1D;
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22: SimdPADiffusionApply2D<2,2>(NE,B,G,D,X,Y,NV); return true;
+         case 0x33: SimdPADiffusionApply2D<3,3>(NE,B,G,D,X,Y,NV); return true;
+         case 0x44: SimdPADiffusionApply2D<4,4>(NE,B,G,D,X,Y,NV); return true;
+         case 0x55: SimdPADiffusionApply2D<5,5>(NE,B,G,D,X,Y,NV); return true;
+         case 0x66: SimdPADiffusionApply2D<6,6>(NE,B,G,D,X,Y,NV); return true;
+         case 0x77: SimdPADiffusionApply2D<7,7>(NE,B,G,D,X,Y,NV); return true;
+         case 0x88: SimdPADiffusionApply2D<8,8>(NE,B,G,D,X,Y,NV); return true;
+         case 0x99: SimdPADiffusionApply2D<9,9>(NE,B,G,D,X,Y,NV); return true;
+         default: return false;
+      }
+   }
+   if (dim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: SimdPADiffusionApply3D<2,3>(NE,B,G,D,X,Y,NV); return true;
+         case 0x34: SimdPADiffusionApply3D<3,4>(NE,B,G,D,X,Y,NV); return true;
+         case 0x45: SimdPADiffusionApply3D<4,5>(NE,B,G,D,X,Y,NV); return true;
+         case 0x56: SimdPADiffusionApply3D<5,6>(NE,B,G,D,X,Y,NV); return true;
+         case 0x67: SimdPADiffusionApply3D<6,7>(NE,B,G,D,X,Y,NV); return true;
+         case 0x78: SimdPADiffusionApply3D<7,8>(NE,B,G,D,X,Y,NV); return true;
+         case 0x89: SimdPADiffusionApply3D<8,9>(NE,B,G,D,X,Y,NV); return true;
+         default: return false;
+      }
+   }
+   return false;
+}
+
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1680,6 +1857,11 @@ static void PADiffusionApply(const int dim,
       MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+   if (DeviceCanUseSimd() &&
+       SimdPADiffusionApply(dim,D1D,Q1D,NE,1,B,G,D,X,Y))
+   {
+      return;
+   }
    const int ID = (D1D << 4 ) | Q1D;
 
    if (dim == 2)
@@ -1694,7 +1876,13 @@ static void PADiffusionApply(const int dim,
          case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,D,X,Y);
          case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,D,X,Y);
          case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(2,D1D,Q1D,NE,1,B,G,Bt,Gt,D,X,Y)) { return; }
+#endif
+            return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         }
       }
    }
 
@@ -1711,7 +1899,81 @@ static void PADiffusionApply(const int dim,
          case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,D,X,Y);
          case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,D,X,Y);
          case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(3,D1D,Q1D,NE,1,B,G,Bt,Gt,D,X,Y)) { return; }
+#endif
+            return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         }
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// Action on nv column-blocked E-vectors: the quadrature data of each element
+// is loaded once and applied to all the vectors. Only the generic (register)
+// kernels take several vectors, so the shared memory kernels used by the
+// single vector action for some (D1D,Q1D) pairs are not used here.
+static void PADiffusionApplyBlock(const int dim,
+                                  const int D1D,
+                                  const int Q1D,
+                                  const int NE,
+                                  const int NV,
+                                  const Array<double> &B,
+                                  const Array<double> &G,
+                                  const Array<double> &Bt,
+                                  const Array<double> &Gt,
+                                  const Vector &D,
+                                  const Vector &X,
+                                  Vector &Y)
+{
+   if (DeviceCanUseSimd() &&
+       SimdPADiffusionApply(dim,D1D,Q1D,NE,NV,B,G,D,X,Y))
+   {
+      return;
+   }
+   const int ID = (D1D << 4 ) | Q1D;
+
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22: return PADiffusionApply2D<2,2>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x33: return PADiffusionApply2D<3,3>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x44: return PADiffusionApply2D<4,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x55: return PADiffusionApply2D<5,5>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(2,D1D,Q1D,NE,NV,B,G,Bt,Gt,D,X,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
+         }
+      }
+   }
+
+   if (dim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: return PADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x34: return PADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x45: return PADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         case 0x56: return PADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y,0,0,NV);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPADiffusionApply(3,D1D,Q1D,NE,NV,B,G,Bt,Gt,D,X,Y))
+            {
+               return;
+            }
+#endif
+            return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D,NV);
+         }
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1720,6 +1982,10 @@ static void PADiffusionApply(const int dim,
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.IsEnabled() && !DeviceCanUseCeed())
+   {
+      return AddMultPAGroups(x, y);
+   }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -1734,4 +2000,41 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+bool DiffusionIntegrator::SupportsPARange() const
+{
+   return !pa_groups.IsEnabled() && !DeviceCanUseCeed();
+}
+
+void DiffusionIntegrator::AddMultPARange(const Vector &x, Vector &y,
+                                         const int e_begin,
+                                         const int e_end) const
+{
+   MFEM_ASSERT(SupportsPARange(), "element ranges are not supported");
+   if (e_end <= e_begin) { return; }
+   Vector xr, yr, dr;
+   MakeElementRangeRef(x, ne, e_begin, e_end, xr);
+   MakeElementRangeRef(y, ne, e_begin, e_end, yr);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, dr);
+   PADiffusionApply(dim, dofs1D, quad1D, e_end - e_begin,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    dr, xr, yr);
+}
+
+void DiffusionIntegrator::AddMultBlockPA(const Vector &x, Vector &y,
+                                         const int nv) const
+{
+   bool per_vector = (nv == 1) || DeviceCanUseCeed() ||
+                     pa_groups.IsEnabled();
+#ifdef MFEM_USE_OCCA
+   per_vector = per_vector || DeviceCanUseOcca();
+#endif
+   if (per_vector)
+   {
+      BilinearFormIntegrator::AddMultBlockPA(x, y, nv);
+      return;
+   }
+   PADiffusionApplyBlock(dim, dofs1D, quad1D, ne, nv,
+                         maps->B, maps->G, maps->Bt, maps->Gt, pa_data, x, y);
+}
+
 } // namespace mfem
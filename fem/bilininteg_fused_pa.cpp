@@ -0,0 +1,506 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "bilinearform_ext.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Mass + Diffusion + Convection Apply 2D kernel. The quadrature data that is
+// not used is nullptr. With u the E-vector, the pointwise operators give
+//    r = M u + C.grad(u),  s = D grad(u),
+// that are tested with the basis functions and with their gradients.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAFusedApply2D(const int NE,
+                           const Array<double> &b_,
+                           const Array<double> &g_,
+                           const Array<double> &bt_,
+                           const Array<double> &gt_,
+                           const double *m_,
+                           const double *d_,
+                           const double *c_,
+                           const Vector &x_,
+                           Vector &y_,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_m = (m_ != nullptr);
+   const bool use_d = (d_ != nullptr);
+   const bool use_c = (c_ != nullptr);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto M = Reshape(m_, Q1D*Q1D, NE);
+   auto D = Reshape(d_, Q1D*Q1D, 3, NE);
+   auto C = Reshape(c_, Q1D*Q1D, 2, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // value and gradient at the quadrature points
+      double QQ[max_Q1D][max_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            QQ[qy][qx][0] = 0.0;
+            QQ[qy][qx][1] = 0.0;
+            QQ[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double XQ[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            XQ[qx][0] = 0.0;
+            XQ[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X(dx,dy,e);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               XQ[qx][0] += B(qx,dx) * s;
+               XQ[qx][1] += G(qx,dx) * s;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               QQ[qy][qx][0] += XQ[qx][0] * wy;
+               QQ[qy][qx][1] += XQ[qx][1] * wy;
+               QQ[qy][qx][2] += XQ[qx][0] * wDy;
+            }
+         }
+      }
+      // apply the sum of the pointwise operators
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            const double u = QQ[qy][qx][0];
+            const double gradX = QQ[qy][qx][1];
+            const double gradY = QQ[qy][qx][2];
+            double r = 0.0, sx = 0.0, sy = 0.0;
+            if (use_m) { r += M(q,e) * u; }
+            if (use_c) { r += C(q,0,e) * gradX + C(q,1,e) * gradY; }
+            if (use_d)
+            {
+               const double O11 = D(q,0,e);
+               const double O12 = D(q,1,e);
+               const double O22 = D(q,2,e);
+               sx = (O11 * gradX) + (O12 * gradY);
+               sy = (O12 * gradX) + (O22 * gradY);
+            }
+            QQ[qy][qx][0] = r;
+            QQ[qy][qx][1] = sx;
+            QQ[qy][qx][2] = sy;
+         }
+      }
+      // integrate back
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double DQ[max_D1D][2];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            DQ[dx][0] = 0.0;
+            DQ[dx][1] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double r = QQ[qy][qx][0];
+            const double sx = QQ[qy][qx][1];
+            const double sy = QQ[qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = Bt(dx,qx);
+               const double wDx = Gt(dx,qx);
+               DQ[dx][0] += wx * r + wDx * sx;
+               DQ[dx][1] += wx * sy;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = Bt(dy,qy);
+            const double wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,e) += DQ[dx][0] * wy + DQ[dx][1] * wDy;
+            }
+         }
+      }
+   });
+}
+
+// PA Mass + Diffusion + Convection Apply 3D kernel, see PAFusedApply2D.
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAFusedApply3D(const int NE,
+                           const Array<double> &b_,
+                           const Array<double> &g_,
+                           const Array<double> &bt_,
+                           const Array<double> &gt_,
+                           const double *m_,
+                           const double *d_,
+                           const double *c_,
+                           const Vector &x_,
+                           Vector &y_,
+                           const int d1d = 0,
+                           const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const bool use_m = (m_ != nullptr);
+   const bool use_d = (d_ != nullptr);
+   const bool use_c = (c_ != nullptr);
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto M = Reshape(m_, Q1D*Q1D*Q1D, NE);
+   auto D = Reshape(d_, Q1D*Q1D*Q1D, 6, NE);
+   auto C = Reshape(c_, Q1D*Q1D*Q1D, 3, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      // value and gradient at the quadrature points
+      double QQQ[max_Q1D][max_Q1D][max_Q1D][4];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int i = 0; i < 4; ++i) { QQQ[qz][qy][qx][i] = 0.0; }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double QQ[max_Q1D][max_Q1D][3];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               QQ[qy][qx][0] = 0.0;
+               QQ[qy][qx][1] = 0.0;
+               QQ[qy][qx][2] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double XQ[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               XQ[qx][0] = 0.0;
+               XQ[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X(dx,dy,dz,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  XQ[qx][0] += B(qx,dx) * s;
+                  XQ[qx][1] += G(qx,dx) * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QQ[qy][qx][0] += XQ[qx][0] * wy;
+                  QQ[qy][qx][1] += XQ[qx][1] * wy;
+                  QQ[qy][qx][2] += XQ[qx][0] * wDy;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz  = B(qz,dz);
+            const double wDz = G(qz,dz);
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  QQQ[qz][qy][qx][0] += QQ[qy][qx][0] * wz;
+                  QQQ[qz][qy][qx][1] += QQ[qy][qx][1] * wz;
+                  QQQ[qz][qy][qx][2] += QQ[qy][qx][2] * wz;
+                  QQQ[qz][qy][qx][3] += QQ[qy][qx][0] * wDz;
+               }
+            }
+         }
+      }
+      // apply the sum of the pointwise operators
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               const double u = QQQ[qz][qy][qx][0];
+               const double gradX = QQQ[qz][qy][qx][1];
+               const double gradY = QQQ[qz][qy][qx][2];
+               const double gradZ = QQQ[qz][qy][qx][3];
+               double r = 0.0, sx = 0.0, sy = 0.0, sz = 0.0;
+               if (use_m) { r += M(q,e) * u; }
+               if (use_c)
+               {
+                  r += C(q,0,e) * gradX + C(q,1,e) * gradY + C(q,2,e) * gradZ;
+               }
+               if (use_d)
+               {
+                  const double O11 = D(q,0,e);
+                  const double O12 = D(q,1,e);
+                  const double O13 = D(q,2,e);
+                  const double O22 = D(q,3,e);
+                  const double O23 = D(q,4,e);
+                  const double O33 = D(q,5,e);
+                  sx = (O11 * gradX) + (O12 * gradY) + (O13 * gradZ);
+                  sy = (O12 * gradX) + (O22 * gradY) + (O23 * gradZ);
+                  sz = (O13 * gradX) + (O23 * gradY) + (O33 * gradZ);
+               }
+               QQQ[qz][qy][qx][0] = r;
+               QQQ[qz][qy][qx][1] = sx;
+               QQQ[qz][qy][qx][2] = sy;
+               QQQ[qz][qy][qx][3] = sz;
+            }
+         }
+      }
+      // integrate back
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double DD[max_D1D][max_D1D][2];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               DD[dy][dx][0] = 0.0;
+               DD[dy][dx][1] = 0.0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double DQ[max_D1D][3];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               DQ[dx][0] = 0.0;
+               DQ[dx][1] = 0.0;
+               DQ[dx][2] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double r = QQQ[qz][qy][qx][0];
+               const double sx = QQQ[qz][qy][qx][1];
+               const double sy = QQQ[qz][qy][qx][2];
+               const double sz = QQQ[qz][qy][qx][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  DQ[dx][0] += wx * r + wDx * sx;
+                  DQ[dx][1] += wx * sy;
+                  DQ[dx][2] += wx * sz;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  DD[dy][dx][0] += DQ[dx][0] * wy + DQ[dx][1] * wDy;
+                  DD[dy][dx][1] += DQ[dx][2] * wy;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz  = Bt(dz,qz);
+            const double wDz = Gt(dz,qz);
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,dz,e) += DD[dy][dx][0] * wz + DD[dy][dx][1] * wDz;
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PAFusedApply(const int dim,
+                         const int D1D,
+                         const int Q1D,
+                         const int NE,
+                         const DofToQuad &maps,
+                         const double *m,
+                         const double *d,
+                         const double *c,
+                         const Vector &x,
+                         Vector &y)
+{
+   const Array<double> &B = maps.B;
+   const Array<double> &G = maps.G;
+   const Array<double> &Bt = maps.Bt;
+   const Array<double> &Gt = maps.Gt;
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAFusedApply2D<2,2>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x23: return PAFusedApply2D<2,3>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x33: return PAFusedApply2D<3,3>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x34: return PAFusedApply2D<3,4>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x44: return PAFusedApply2D<4,4>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x45: return PAFusedApply2D<4,5>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x55: return PAFusedApply2D<5,5>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x56: return PAFusedApply2D<5,6>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x66: return PAFusedApply2D<6,6>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x67: return PAFusedApply2D<6,7>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         default:
+            return PAFusedApply2D(NE,B,G,Bt,Gt,m,d,c,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAFusedApply3D<2,3>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x24: return PAFusedApply3D<2,4>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x34: return PAFusedApply3D<3,4>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x35: return PAFusedApply3D<3,5>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x45: return PAFusedApply3D<4,5>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x46: return PAFusedApply3D<4,6>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x56: return PAFusedApply3D<5,6>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         case 0x57: return PAFusedApply3D<5,7>(NE,B,G,Bt,Gt,m,d,c,x,y);
+         default:
+            return PAFusedApply3D(NE,B,G,Bt,Gt,m,d,c,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void PAFusedIntegrators::Clear()
+{
+   maps = nullptr;
+   dim = ne = 0;
+   mass_data = diff_data = conv_data = nullptr;
+   integs.SetSize(0);
+}
+
+bool PAFusedIntegrators::Add(const BilinearFormIntegrator &integ)
+{
+   const DofToQuad *i_maps;
+   const Vector *i_data;
+   const Vector **data;
+   int i_dim, i_ne, nc;
+   if (auto m = dynamic_cast<const MassIntegrator*>(&integ))
+   {
+      if (m->pa_groups.IsEnabled()) { return false; }
+      i_maps = m->maps, i_data = &m->pa_data, i_dim = m->dim, i_ne = m->ne;
+      data = &mass_data;
+      nc = 1;
+   }
+   else if (auto d = dynamic_cast<const DiffusionIntegrator*>(&integ))
+   {
+      if (d->pa_groups.IsEnabled()) { return false; }
+      i_maps = d->maps, i_data = &d->pa_data, i_dim = d->dim, i_ne = d->ne;
+      data = &diff_data;
+      nc = (i_dim*(i_dim+1))/2;
+   }
+   else if (auto c = dynamic_cast<const ConvectionIntegrator*>(&integ))
+   {
+      if (c->pa_groups.IsEnabled()) { return false; }
+      i_maps = c->maps, i_data = &c->pa_data, i_dim = c->dim, i_ne = c->ne;
+      data = &conv_data;
+      nc = i_dim;
+   }
+   else { return false; }
+
+   if (*data != nullptr || i_maps == nullptr) { return false; }
+   if (i_maps->mode != DofToQuad::TENSOR) { return false; }
+   if (i_dim != 2 && i_dim != 3) { return false; }
+   if (i_maps->ndof > MAX_D1D || i_maps->nqpt > MAX_Q1D) { return false; }
+   const int nq = (i_dim == 2) ? i_maps->nqpt*i_maps->nqpt :
+                  i_maps->nqpt*i_maps->nqpt*i_maps->nqpt;
+   if (i_data->Size() != nq*nc*i_ne) { return false; }
+   if (maps && (i_maps != maps || i_dim != dim || i_ne != ne)) { return false; }
+
+   maps = i_maps;
+   dim = i_dim;
+   ne = i_ne;
+   *data = i_data;
+   integs.Append(&integ);
+   return true;
+}
+
+void PAFusedIntegrators::AddMultPA(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(maps, "no integrators");
+   const double *m = mass_data ? mass_data->Read() : nullptr;
+   const double *d = diff_data ? diff_data->Read() : nullptr;
+   const double *c = conv_data ? conv_data->Read() : nullptr;
+   PAFusedApply(dim, maps->ndof, maps->nqpt, ne, *maps, m, d, c, x, y);
+}
+
+void PAFusedIntegrators::AddMultPARange(const Vector &x, Vector &y,
+                                        const int e_begin,
+                                        const int e_end) const
+{
+   MFEM_VERIFY(maps, "no integrators");
+   if (e_end <= e_begin) { return; }
+   // The partially assembled data is stored element by element
+   const double *m = mass_data ? mass_data->Read() : nullptr;
+   const double *d = diff_data ? diff_data->Read() : nullptr;
+   const double *c = conv_data ? conv_data->Read() : nullptr;
+   if (m) { m += e_begin*(mass_data->Size()/ne); }
+   if (d) { d += e_begin*(diff_data->Size()/ne); }
+   if (c) { c += e_begin*(conv_data->Size()/ne); }
+   Vector xr, yr;
+   BilinearFormIntegrator::MakeElementRangeRef(x, ne, e_begin, e_end, xr);
+   BilinearFormIntegrator::MakeElementRangeRef(y, ne, e_begin, e_end, yr);
+   PAFusedApply(dim, maps->ndof, maps->nqpt, e_end - e_begin, *maps, m, d, c,
+                xr, yr);
+}
+
+} // namespace mfem
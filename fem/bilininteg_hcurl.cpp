@@ -752,14 +752,7 @@ void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
 
    if (el->GetDerivType() == mfem::FiniteElement::CURL && dim == 3)
@@ -2084,35 +2077,20 @@ void MixedVectorCurlIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (DQ)
    {
-      Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
-
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-
-         for (int p=0; p<nq; ++p)
-         {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
-      }
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
+      DQ->EvalAll(coeff, *mesh, *ir);
+   }
+   else if (Q)
+   {
+      // the scalar coefficient is stored in the first component
+      Vector qcoeff;
+      Q->EvalAll(qcoeff, *mesh, *ir);
+      const int cdim = coeffDim;
+      const auto C = qcoeff.Read();
+      auto coeffh = Reshape(coeff.ReadWrite(), cdim, nq * ne);
+      MFEM_FORALL(i, nq * ne, coeffh(0, i) = C[i];);
    }
 
    if (testType == mfem::FiniteElement::CURL &&
@@ -2891,35 +2869,14 @@ void MixedVectorWeakCurlIntegrator::AssemblePA(const FiniteElementSpace
 
    Vector coeff(coeffDim * nq * ne);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || DQ)
+   if (DQ)
    {
-      Vector V(coeffDim);
-      if (DQ)
-      {
-         MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
-      }
-
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-
-         for (int p=0; p<nq; ++p)
-         {
-            if (DQ)
-            {
-               DQ->Eval(V, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = V[i];
-               }
-            }
-            else
-            {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
-            }
-         }
-      }
+      MFEM_VERIFY(DQ->GetVDim() == coeffDim, "");
+      DQ->EvalAll(coeff, *mesh, *ir);
+   }
+   else if (Q)
+   {
+      Q->EvalAll(coeff, *mesh, *ir);
    }
 
    testType = test_el->GetDerivType();
@@ -930,14 +930,7 @@ void DivDivIntegrator::AssemblePA(const FiniteElementSpace &fes)
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
 
    if (el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
@@ -1200,14 +1193,7 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
 
    if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
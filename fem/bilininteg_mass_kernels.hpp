@@ -0,0 +1,355 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_MASS_KERNELS_HPP
+#define MFEM_BILININTEG_MASS_KERNELS_HPP
+
+// Element kernels of the generic PA Mass diagonal and apply, used by the
+// library in bilininteg_mass_pa.cpp and embedded at build time in the sources
+// of the runtime compiled kernels, see class Jit. This file is compiled on its
+// own by the JIT, so it must not include other headers.
+
+#ifndef MFEM_HOST_DEVICE
+#define MFEM_HOST_DEVICE
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/** @brief Add the diagonal of the PA Mass operator of element @a e in 2D to
+    @a y. */
+/** The sizes are given by the template parameters T_D1D and T_Q1D, or by
+    @a d1d and @a q1d when they are 0, in which case MD1 and MQ1 bound them. The
+    layouts are b(Q1D,D1D), d(Q1D,Q1D,NE) and y(D1D,D1D,NE). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PAMassAssembleDiagonal2DElement(const int e, const int d1d, const int q1d,
+                                     const double *b, const double *d,
+                                     double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*e;
+   double *Y = y + D1D*D1D*e;
+   double QD[MQ1][MD1];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         QD[qx][dy] = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double B = b[qy+Q1D*dy];
+            QD[qx][dy] += B * B * D[qx+Q1D*qy];
+         }
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double B = b[qx+Q1D*dx];
+            Y[dx+D1D*dy] += B * B * QD[qx][dy];
+         }
+      }
+   }
+}
+
+/** @brief Add the diagonal of the PA Mass operator of element @a e in 3D to
+    @a y, with d(Q1D,Q1D,Q1D,NE) and y(D1D,D1D,D1D,NE), see
+    PAMassAssembleDiagonal2DElement(). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PAMassAssembleDiagonal3DElement(const int e, const int d1d, const int q1d,
+                                     const double *b, const double *d,
+                                     double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*Q1D*e;
+   double *Y = y + D1D*D1D*D1D*e;
+   double QQD[MQ1][MQ1][MD1];
+   double QDD[MQ1][MD1][MD1];
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            QQD[qx][qy][dz] = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double B = b[qz+Q1D*dz];
+               QQD[qx][qy][dz] += B * B * D[qx+Q1D*(qy+Q1D*qz)];
+            }
+         }
+      }
+   }
+   for (int qx = 0; qx < Q1D; ++qx)
+   {
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            QDD[qx][dy][dz] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double B = b[qy+Q1D*dy];
+               QDD[qx][dy][dz] += B * B * QQD[qx][qy][dz];
+            }
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double t = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double B = b[qx+Q1D*dx];
+               t += B * B * QDD[qx][dy][dz];
+            }
+            Y[dx+D1D*(dy+D1D*dz)] += t;
+         }
+      }
+   }
+}
+
+/** @brief Add the action of the PA Mass operator of element @a e in 2D to
+    @a y, for the @a nv components of @a x. */
+/** The layouts are b(Q1D,D1D), bt(D1D,Q1D), d(Q1D,Q1D,NE) and x, y
+    (D1D,D1D,NE,nv), see PAMassAssembleDiagonal2DElement() for the sizes. */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PAMassApply2DElement(const int e, const int NE, const int nv,
+                          const int d1d, const int q1d,
+                          const double *b, const double *bt, const double *d,
+                          const double *x, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*e;
+   for (int v = 0; v < nv; ++v)
+   {
+      const double *X = x + D1D*D1D*(e+NE*v);
+      double *Y = y + D1D*D1D*(e+NE*v);
+      double sol_xy[MQ1][MQ1];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_xy[qy][qx] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double sol_x[MQ1];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            sol_x[qy] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X[dx+D1D*dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] += b[qx+Q1D*dx] * s;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double d2q = b[qy+Q1D*dy];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] += d2q * sol_x[qx];
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_xy[qy][qx] *= D[qx+Q1D*qy];
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double sol_x[MD1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            sol_x[dx] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s = sol_xy[qy][qx];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] += bt[dx+D1D*qx] * s;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double q2d = bt[dy+D1D*qy];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y[dx+D1D*dy] += q2d * sol_x[dx];
+            }
+         }
+      }
+   }
+}
+
+/** @brief Add the action of the PA Mass operator of element @a e in 3D to
+    @a y, with d(Q1D,Q1D,Q1D,NE) and x, y (D1D,D1D,D1D,NE,nv), see
+    PAMassApply2DElement(). */
+template<int T_D1D, int T_Q1D, int MD1 = T_D1D, int MQ1 = T_Q1D>
+MFEM_HOST_DEVICE inline
+void PAMassApply3DElement(const int e, const int NE, const int nv,
+                          const int d1d, const int q1d,
+                          const double *b, const double *bt, const double *d,
+                          const double *x, double *y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   const double *D = d + Q1D*Q1D*Q1D*e;
+   for (int v = 0; v < nv; ++v)
+   {
+      const double *X = x + D1D*D1D*D1D*(e+NE*v);
+      double *Y = y + D1D*D1D*D1D*(e+NE*v);
+      double sol_xyz[MQ1][MQ1][MQ1];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xyz[qz][qy][qx] = 0.0;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         double sol_xy[MQ1][MQ1];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[MQ1];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] = 0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = X[dx+D1D*(dy+D1D*dz)];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += b[qx+Q1D*dx] * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy = b[qy+Q1D*dy];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] += wy * sol_x[qx];
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            const double wz = b[qz+Q1D*dz];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xyz[qz][qy][qx] *= D[qx+Q1D*(qy+Q1D*qz)];
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         double sol_xy[MD1][MD1];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx] = 0;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[MD1];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = sol_xyz[qz][qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += bt[dx+D1D*qx] * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy = bt[dy+D1D*qy];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] += wy * sol_x[dx];
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            const double wz = bt[dz+D1D*qz];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y[dx+D1D*(dy+D1D*dz)] += wz * sol_xy[dy][dx];
+               }
+            }
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_MASS_KERNELS_HPP
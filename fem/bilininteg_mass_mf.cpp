@@ -0,0 +1,428 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "bilininteg_mf.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// MF Mass Integrator
+
+void MassIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   if (mesh->GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   MFEM_VERIFY(UsesTensorBasis(fes) && fes.GetVDim() == 1,
+               "Matrix-free mass requires a scalar tensor-product space.");
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Matrix-free mass is only "
+               "implemented in 2D and 3D.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "Matrix-free mass is not "
+               "implemented for surface meshes.");
+   nq = ir->GetNPoints();
+   mf_ir = ir;
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   internal::MFSetupNodes(*mesh, *ir, geom_B, geom_G, geom_dofs1D, mf_nodes);
+   internal::MFSetupCoefficient(fes, *ir, Q, mf_coeff);
+}
+
+// Matrix-free Mass Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply2D(const int NE,
+                          const int GD1D,
+                          const Array<double> &b_,
+                          const Array<double> &bg_,
+                          const Array<double> &gg_,
+                          const Array<double> &w_,
+                          const Vector &c_,
+                          const Vector &n_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const double *B = b_.Read();
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D, 2, NE);
+   const auto X = Reshape(x_.Read(), D1D*D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D*D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][2], Jy[MQ1][MQ1][2];
+      double val[MQ1][MQ1];
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFEval2D<MD1,MQ1>(D1D, Q1D, B, &X(0,e), val);
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double detJ = (Jx[qy][qx][0] * Jy[qy][qx][1]) -
+                                (Jy[qy][qx][0] * Jx[qy][qx][1]);
+            const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+            val[qy][qx] *= W(qx,qy) * coeff * detJ;
+         }
+      }
+      internal::MFEvalTranspose2D<MD1,MQ1>(D1D, Q1D, B, val, &Y(0,e));
+   });
+}
+
+// Matrix-free Mass Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassApply3D(const int NE,
+                          const int GD1D,
+                          const Array<double> &b_,
+                          const Array<double> &bg_,
+                          const Array<double> &gg_,
+                          const Array<double> &w_,
+                          const Vector &c_,
+                          const Vector &n_,
+                          const Vector &x_,
+                          Vector &y_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const double *B = b_.Read();
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D*GD1D, 3, NE);
+   const auto X = Reshape(x_.Read(), D1D*D1D*D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D*D1D*D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][MQ1][3];
+      double Jy[MQ1][MQ1][MQ1][3];
+      double Jz[MQ1][MQ1][MQ1][3];
+      double val[MQ1][MQ1][MQ1];
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,2,e), Jz);
+      internal::MFEval3D<MD1,MQ1>(D1D, Q1D, B, &X(0,e), val);
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double detJ = internal::MFDet3D(Jx[qz][qy][qx],
+                                                     Jy[qz][qy][qx],
+                                                     Jz[qz][qy][qx]);
+               const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+               val[qz][qy][qx] *= W(qx,qy,qz) * coeff * detJ;
+            }
+         }
+      }
+      internal::MFEvalTranspose3D<MD1,MQ1>(D1D, Q1D, B, val, &Y(0,e));
+   });
+}
+
+static void MFMassApply(const int dim,
+                        const int D1D,
+                        const int Q1D,
+                        const int GD1D,
+                        const int NE,
+                        const Array<double> &B,
+                        const Array<double> &BG,
+                        const Array<double> &GG,
+                        const Array<double> &W,
+                        const Vector &C,
+                        const Vector &N,
+                        const Vector &X,
+                        Vector &Y)
+{
+   const int ID = (D1D << 4 ) | Q1D;
+
+   if (dim == 2)
+   {
+      switch (ID)
+      {
+         case 0x22: return MFMassApply2D<2,2>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x24: return MFMassApply2D<2,4>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x33: return MFMassApply2D<3,3>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x34: return MFMassApply2D<3,4>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x35: return MFMassApply2D<3,5>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x44: return MFMassApply2D<4,4>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x46: return MFMassApply2D<4,6>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x57: return MFMassApply2D<5,7>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         default:   return MFMassApply2D(NE,GD1D,B,BG,GG,W,C,N,X,Y,D1D,Q1D);
+      }
+   }
+
+   if (dim == 3)
+   {
+      switch (ID)
+      {
+         case 0x23: return MFMassApply3D<2,3>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x24: return MFMassApply3D<2,4>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x34: return MFMassApply3D<3,4>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x35: return MFMassApply3D<3,5>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x45: return MFMassApply3D<4,5>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x46: return MFMassApply3D<4,6>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         case 0x56: return MFMassApply3D<5,6>(NE,GD1D,B,BG,GG,W,C,N,X,Y);
+         default:   return MFMassApply3D(NE,GD1D,B,BG,GG,W,C,N,X,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// MF Mass Apply kernel
+void MassIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   MFMassApply(dim, dofs1D, quad1D, geom_dofs1D, ne,
+               maps->B, geom_B, geom_G,
+               mf_ir->GetWeights(), mf_coeff, mf_nodes, x, y);
+}
+
+// Matrix-free Mass Diagonal 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassDiagonal2D(const int NE,
+                             const int GD1D,
+                             const Array<double> &b_,
+                             const Array<double> &bg_,
+                             const Array<double> &gg_,
+                             const Array<double> &w_,
+                             const Vector &c_,
+                             const Vector &n_,
+                             Vector &y_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const auto B = Reshape(b_.Read(), Q1D, D1D);
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D, 2, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][2], Jy[MQ1][MQ1][2];
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad2D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      double QD[MQ1][MD1];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            QD[qx][dy] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double detJ = (Jx[qy][qx][0] * Jy[qy][qx][1]) -
+                                   (Jy[qy][qx][0] * Jx[qy][qx][1]);
+               const double coeff = const_c ? C(0,0,0) : C(qx,qy,e);
+               const double D = W(qx,qy) * coeff * detJ;
+               QD[qx][dy] += B(qy, dy) * B(qy, dy) * D;
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Y(dx,dy,e) += B(qx, dx) * B(qx, dx) * QD[qx][dy];
+            }
+         }
+      }
+   });
+}
+
+// Matrix-free Mass Diagonal 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+static void MFMassDiagonal3D(const int NE,
+                             const int GD1D,
+                             const Array<double> &b_,
+                             const Array<double> &bg_,
+                             const Array<double> &gg_,
+                             const Array<double> &w_,
+                             const Vector &c_,
+                             const Vector &n_,
+                             Vector &y_,
+                             const int d1d = 0,
+                             const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   MFEM_VERIFY(GD1D <= MAX_D1D, "");
+   const bool const_c = c_.Size() == 1;
+   const auto B = Reshape(b_.Read(), Q1D, D1D);
+   const double *BG = bg_.Read();
+   const double *GG = gg_.Read();
+   const auto W = Reshape(w_.Read(), Q1D, Q1D, Q1D);
+   const auto C = const_c ? Reshape(c_.Read(), 1,1,1,1) :
+                  Reshape(c_.Read(), Q1D,Q1D,Q1D,NE);
+   const auto N = Reshape(n_.Read(), GD1D*GD1D*GD1D, 3, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      double Jx[MQ1][MQ1][MQ1][3];
+      double Jy[MQ1][MQ1][MQ1][3];
+      double Jz[MQ1][MQ1][MQ1][3];
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,0,e), Jx);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,1,e), Jy);
+      internal::MFGrad3D<MQ1>(GD1D, Q1D, BG, GG, &N(0,2,e), Jz);
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               QQD[qx][qy][dz] = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  const double detJ = internal::MFDet3D(Jx[qz][qy][qx],
+                                                        Jy[qz][qy][qx],
+                                                        Jz[qz][qy][qx]);
+                  const double coeff = const_c ? C(0,0,0,0) : C(qx,qy,qz,e);
+                  const double D = W(qx,qy,qz) * coeff * detJ;
+                  QQD[qx][qy][dz] += B(qz, dz) * B(qz, dz) * D;
+               }
+            }
+         }
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               QDD[qx][dy][dz] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  QDD[qx][dy][dz] += B(qy, dy) * B(qy, dy) * QQD[qx][qy][dz];
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double t = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  t += B(qx, dx) * B(qx, dx) * QDD[qx][dy][dz];
+               }
+               Y(dx, dy, dz, e) += t;
+            }
+         }
+      }
+   });
+}
+
+static void MFMassAssembleDiagonal(const int dim,
+                                   const int D1D,
+                                   const int Q1D,
+                                   const int GD1D,
+                                   const int NE,
+                                   const Array<double> &B,
+                                   const Array<double> &BG,
+                                   const Array<double> &GG,
+                                   const Array<double> &W,
+                                   const Vector &C,
+                                   const Vector &N,
+                                   Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return MFMassDiagonal2D<2,2>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         case 0x33: return MFMassDiagonal2D<3,3>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         case 0x44: return MFMassDiagonal2D<4,4>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         default: return MFMassDiagonal2D(NE,GD1D,B,BG,GG,W,C,N,Y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return MFMassDiagonal3D<2,3>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         case 0x34: return MFMassDiagonal3D<3,4>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         case 0x45: return MFMassDiagonal3D<4,5>(NE,GD1D,B,BG,GG,W,C,N,Y);
+         default: return MFMassDiagonal3D(NE,GD1D,B,BG,GG,W,C,N,Y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void MassIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   MFMassAssembleDiagonal(dim, dofs1D, quad1D, geom_dofs1D, ne,
+                          maps->B, geom_B, geom_G,
+                          mf_ir->GetWeights(), mf_coeff, mf_nodes, diag);
+}
+
+} // namespace mfem
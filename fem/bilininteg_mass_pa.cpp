@@ -13,6 +13,14 @@
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/mass.hpp"
+#include "../general/jit.hpp"
+#include "bilininteg_simd.hpp"
+#include "bilininteg_mass_kernels.hpp"
+#ifdef MFEM_USE_JIT
+#include "bilininteg_mass_kernels_jit.hpp"
+#endif
+
+#include <cstdio>
 
 using namespace std;
 
@@ -77,16 +85,7 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -157,6 +156,11 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes)
 
 void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
+   // libCEED has its own support for non-tensor elements
+   if (pa_groups.Setup(fes) && !DeviceCanUseCeed())
+   {
+      return AssemblePAGroups(fes);
+   }
    SetupPA(fes);
 }
 
@@ -173,37 +177,15 @@ static void PAMassAssembleDiagonal2D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto D = Reshape(d.Read(), Q1D, Q1D, NE);
-   auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *D = d.Read();
+   double *Y = y.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double QD[MQ1][MD1];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            QD[qx][dy] = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               QD[qx][dy] += B(qy, dy) * B(qy, dy) * D(qx, qy, e);
-            }
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               Y(dx,dy,e) += B(qx, dx) * B(qx, dx) * QD[qx][dy];
-            }
-         }
-      }
+      internal::PAMassAssembleDiagonal2DElement<T_D1D,T_Q1D,MD1,MQ1>(
+         e, d1d, q1d, B, D, Y);
    });
 }
 
@@ -285,60 +267,15 @@ static void PAMassAssembleDiagonal3D(const int NE,
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto D = Reshape(d.Read(), Q1D, Q1D, Q1D, NE);
-   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b.Read();
+   const double *D = d.Read();
+   double *Y = y.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
-      double QQD[MQ1][MQ1][MD1];
-      double QDD[MQ1][MD1][MD1];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int dz = 0; dz < D1D; ++dz)
-            {
-               QQD[qx][qy][dz] = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
-               {
-                  QQD[qx][qy][dz] += B(qz, dz) * B(qz, dz) * D(qx, qy, qz, e);
-               }
-            }
-         }
-      }
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               QDD[qx][dy][dz] = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
-               {
-                  QDD[qx][dy][dz] += B(qy, dy) * B(qy, dy) * QQD[qx][qy][dz];
-               }
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               double t = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  t += B(qx, dx) * B(qx, dx) * QDD[qx][dy][dz];
-               }
-               Y(dx, dy, dz, e) += t;
-            }
-         }
-      }
+      internal::PAMassAssembleDiagonal3DElement<T_D1D,T_Q1D,MD1,MQ1>(
+         e, d1d, q1d, B, D, Y);
    });
 }
 
@@ -428,6 +365,133 @@ static void SmemPAMassAssembleDiagonal3D(const int NE,
    });
 }
 
+#ifdef MFEM_USE_JIT
+// Entry points of the runtime compiled PA Mass kernels, used for the (D1D,Q1D)
+// combinations without a compile-time instantiation, see class Jit. They are
+// compiled after the element kernels of bilininteg_mass_kernels.hpp, embedded
+// at build time in bilininteg_mass_kernels_source, with D1D and Q1D given by
+// -DMFEM_JIT_D1D and -DMFEM_JIT_Q1D.
+static const char *jit_mass_diag_2d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const double *__restrict b,
+                                const double *__restrict d, double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PAMassAssembleDiagonal2DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, d, y);
+   }
+}
+)_";
+
+static const char *jit_mass_diag_3d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const double *__restrict b,
+                                const double *__restrict d, double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PAMassAssembleDiagonal3DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, d, y);
+   }
+}
+)_";
+
+static const char *jit_mass_apply_2d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const int NV,
+                                const double *__restrict b,
+                                const double *__restrict bt,
+                                const double *__restrict d,
+                                const double *__restrict x,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PAMassApply2DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, NE, NV, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, bt, d, x, y);
+   }
+}
+)_";
+
+static const char *jit_mass_apply_3d = R"_(
+extern "C" void mfem_jit_kernel(const int NE, const int NV,
+                                const double *__restrict b,
+                                const double *__restrict bt,
+                                const double *__restrict d,
+                                const double *__restrict x,
+                                double *__restrict y)
+{
+   for (int e = 0; e < NE; ++e)
+   {
+      using namespace mfem::internal;
+      PAMassApply3DElement<MFEM_JIT_D1D,MFEM_JIT_Q1D>(
+         e, NE, NV, MFEM_JIT_D1D, MFEM_JIT_Q1D, b, bt, d, x, y);
+   }
+}
+)_";
+
+typedef void (*JitPAMassDiagonalKernel)(const int, const double*,
+                                        const double*, double*);
+typedef void (*JitPAMassApplyKernel)(const int, const int, const double*,
+                                     const double*, const double*,
+                                     const double*, double*);
+
+// Return the runtime compiled kernel 'name' for the given (D1D,Q1D), or NULL.
+static void *JitPAMassKernel(const char *name, const std::string &source,
+                             const int D1D, const int Q1D)
+{
+   if (!Jit::Enabled()) { return NULL; }
+   char defines[64];
+   snprintf(defines, sizeof(defines), "-DMFEM_JIT_D1D=%d -DMFEM_JIT_Q1D=%d",
+            D1D, Q1D);
+   return Jit::Lookup(name, source.c_str(), defines);
+}
+
+static bool JitPAMassAssembleDiagonal(const int dim, const int D1D,
+                                      const int Q1D, const int NE,
+                                      const Array<double> &B,
+                                      const Vector &D,
+                                      Vector &Y)
+{
+   static const std::string src_2d =
+      std::string(bilininteg_mass_kernels_source) + jit_mass_diag_2d;
+   static const std::string src_3d =
+      std::string(bilininteg_mass_kernels_source) + jit_mass_diag_3d;
+   void *ptr = (dim == 2) ?
+               JitPAMassKernel("pa_mass_diag_2d", src_2d, D1D, Q1D) :
+               JitPAMassKernel("pa_mass_diag_3d", src_3d, D1D, Q1D);
+   if (!ptr) { return false; }
+   JitPAMassDiagonalKernel kernel;
+   *reinterpret_cast<void**>(&kernel) = ptr;
+   kernel(NE, B.HostRead(), D.HostRead(), Y.HostReadWrite());
+   return true;
+}
+
+static bool JitPAMassApply(const int dim, const int D1D, const int Q1D,
+                           const int NE, const int NV,
+                           const Array<double> &B,
+                           const Array<double> &Bt,
+                           const Vector &D,
+                           const Vector &X,
+                           Vector &Y)
+{
+   static const std::string src_2d =
+      std::string(bilininteg_mass_kernels_source) + jit_mass_apply_2d;
+   static const std::string src_3d =
+      std::string(bilininteg_mass_kernels_source) + jit_mass_apply_3d;
+   void *ptr = (dim == 2) ?
+               JitPAMassKernel("pa_mass_apply_2d", src_2d, D1D, Q1D) :
+               JitPAMassKernel("pa_mass_apply_3d", src_3d, D1D, Q1D);
+   if (!ptr) { return false; }
+   JitPAMassApplyKernel kernel;
+   *reinterpret_cast<void**>(&kernel) = ptr;
+   kernel(NE, NV, B.HostRead(), Bt.HostRead(), D.HostRead(), X.HostRead(),
+          Y.HostReadWrite());
+   return true;
+}
+#endif // MFEM_USE_JIT
+
 static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const int Q1D, const int NE,
                                    const Array<double> &B,
@@ -446,7 +510,13 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
          case 0x77: return SmemPAMassAssembleDiagonal2D<7,7,4>(NE,B,D,Y);
          case 0x88: return SmemPAMassAssembleDiagonal2D<8,8,2>(NE,B,D,Y);
          case 0x99: return SmemPAMassAssembleDiagonal2D<9,9,2>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassAssembleDiagonal(2,D1D,Q1D,NE,B,D,Y)) { return; }
+#endif
+            return PAMassAssembleDiagonal2D(NE,B,D,Y,D1D,Q1D);
+         }
       }
    }
    else if (dim == 3)
@@ -460,7 +530,13 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
          case 0x67: return SmemPAMassAssembleDiagonal3D<6,7>(NE,B,D,Y);
          case 0x78: return SmemPAMassAssembleDiagonal3D<7,8>(NE,B,D,Y);
          case 0x89: return SmemPAMassAssembleDiagonal3D<8,9>(NE,B,D,Y);
-         default:   return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassAssembleDiagonal(3,D1D,Q1D,NE,B,D,Y)) { return; }
+#endif
+            return PAMassAssembleDiagonal3D(NE,B,D,Y,D1D,Q1D);
+         }
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -468,6 +544,10 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.IsEnabled() && !DeviceCanUseCeed())
+   {
+      return AssembleDiagonalPAGroups(diag);
+   }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -581,87 +661,25 @@ static void PAMassApply2D(const int NE,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *Bt = bt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xy[max_Q1D][max_Q1D];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         double sol_x[max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            sol_x[qy] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            const double s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] += B(qx,dx)* s;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const double d2q = B(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] += d2q * sol_x[qx];
-            }
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            sol_xy[qy][qx] *= D(qx,qy,e);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         double sol_x[max_D1D];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            sol_x[dx] = 0.0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const double s = sol_xy[qy][qx];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] += Bt(dx,qx) * s;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const double q2d = Bt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += q2d * sol_x[dx];
-            }
-         }
-      }
+      internal::PAMassApply2DElement<T_D1D,T_Q1D,max_D1D,max_Q1D>(
+         e, NE, nv, d1d, q1d, B, Bt, D, X, Y);
    });
 }
 
@@ -796,136 +814,25 @@ static void PAMassApply3D(const int NE,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
-                          const int q1d = 0)
+                          const int q1d = 0,
+                          const int nv = 1)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
-   auto B = Reshape(b_.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   const double *B = b_.Read();
+   const double *Bt = bt_.Read();
+   const double *D = d_.Read();
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
    MFEM_FORALL(e, NE,
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
-      double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] = 0.0;
-            }
-         }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         double sol_xy[max_Q1D][max_Q1D];
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xy[qy][qx] = 0.0;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            double sol_x[max_Q1D];
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_x[qx] = 0;
-            }
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const double s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_x[qx] += B(qx,dx) * s;
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const double wy = B(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xy[qy][qx] += wy * sol_x[qx];
-               }
-            }
-         }
-         for (int qz = 0; qz < Q1D; ++qz)
-         {
-            const double wz = B(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
-               }
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               sol_xyz[qz][qy][qx] *= D(qx,qy,qz,e);
-            }
-         }
-      }
-      for (int qz = 0; qz < Q1D; ++qz)
-      {
-         double sol_xy[max_D1D][max_D1D];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_xy[dy][dx] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            double sol_x[max_D1D];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               sol_x[dx] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const double s = sol_xyz[qz][qy][qx];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_x[dx] += Bt(dx,qx) * s;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const double wy = Bt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  sol_xy[dy][dx] += wy * sol_x[dx];
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const double wz = Bt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) += wz * sol_xy[dy][dx];
-               }
-            }
-         }
-      }
+      internal::PAMassApply3DElement<T_D1D,T_Q1D,max_D1D,max_Q1D>(
+         e, NE, nv, d1d, q1d, B, Bt, D, X, Y);
    });
 }
 
@@ -1156,6 +1063,284 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+// Cross-element SIMD PA Mass Apply 2D kernel: each lane of the SIMD type holds
+// the data of one element in a batch of PASimd::size consecutive elements.
+template<int T_D1D, int T_Q1D>
+static void SimdPAMassApply2D(const int NE,
+                              const Array<double> &b_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int nv = 1)
+{
+   typedef internal::PASimd::real_t vreal_t;
+   constexpr int SIMD = internal::PASimd::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int ND = D1D*D1D;
+   constexpr int NQ = Q1D*Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const double *D = d_.HostRead();
+   const double *X = x_.HostRead();
+   double *Y = y_.HostReadWrite();
+   for (int e0 = 0; e0 < NE; e0 += SIMD)
+   {
+      const int nl = std::min(SIMD, NE - e0);
+      vreal_t Dq[NQ];
+      internal::SimdLoad(Dq, D + NQ*e0, NQ, nl, NQ);
+      for (int v = 0; v < nv; ++v)
+      {
+         const int xoff = ND*(e0 + NE*v);
+         vreal_t x[ND];
+         internal::SimdLoad(x, X + xoff, ND, nl, ND);
+         vreal_t sol_xy[Q1D][Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx) { sol_xy[qy][qx] = 0.0; }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            vreal_t sol_x[Q1D];
+            for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] = 0.0; }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const vreal_t s = x[dx + D1D*dy];
+               for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx].fma(s, B(qx,dx)); }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double d2q = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx].fma(sol_x[qx], d2q);
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] *= Dq[qx + Q1D*qy];
+            }
+         }
+         vreal_t y[D1D][D1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx) { y[dy][dx] = 0.0; }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            vreal_t sol_x[D1D];
+            for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] = 0.0; }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx].fma(sol_xy[qy][qx], B(qx,dx));
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = B(qy,dy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y[dy][dx].fma(sol_x[dx], q2d);
+               }
+            }
+         }
+         internal::SimdAddStore(&y[0][0], Y + xoff, ND, nl, ND);
+      }
+   }
+}
+
+// Cross-element SIMD PA Mass Apply 3D kernel
+template<int T_D1D, int T_Q1D>
+static void SimdPAMassApply3D(const int NE,
+                              const Array<double> &b_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int nv = 1)
+{
+   typedef internal::PASimd::real_t vreal_t;
+   constexpr int SIMD = internal::PASimd::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   constexpr int ND = D1D*D1D*D1D;
+   constexpr int NQ = Q1D*Q1D*Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const double *D = d_.HostRead();
+   const double *X = x_.HostRead();
+   double *Y = y_.HostReadWrite();
+   for (int e0 = 0; e0 < NE; e0 += SIMD)
+   {
+      const int nl = std::min(SIMD, NE - e0);
+      vreal_t Dq[NQ];
+      internal::SimdLoad(Dq, D + NQ*e0, NQ, nl, NQ);
+      for (int v = 0; v < nv; ++v)
+      {
+         const int xoff = ND*(e0 + NE*v);
+         vreal_t x[ND];
+         internal::SimdLoad(x, X + xoff, ND, nl, ND);
+         vreal_t sol_xyz[Q1D][Q1D][Q1D];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx) { sol_xyz[qz][qy][qx] = 0.0; }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            vreal_t sol_xy[Q1D][Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx) { sol_xy[qy][qx] = 0.0; }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               vreal_t sol_x[Q1D];
+               for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] = 0.0; }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const vreal_t s = x[dx + D1D*(dy + D1D*dz)];
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx].fma(s, B(qx,dx));
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx].fma(sol_x[qx], wy);
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[qz][qy][qx].fma(sol_xy[qy][qx], wz);
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[qz][qy][qx] *= Dq[qx + Q1D*(qy + Q1D*qz)];
+               }
+            }
+         }
+         vreal_t y[D1D][D1D][D1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx) { y[dz][dy][dx] = 0.0; }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            vreal_t sol_xy[D1D][D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx) { sol_xy[dy][dx] = 0.0; }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               vreal_t sol_x[D1D];
+               for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] = 0.0; }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx].fma(sol_xyz[qz][qy][qx], B(qx,dx));
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx].fma(sol_x[dx], wy);
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = B(qz,dz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y[dz][dy][dx].fma(sol_xy[dy][dx], wz);
+                  }
+               }
+            }
+         }
+         internal::SimdAddStore(&y[0][0][0], Y + xoff, ND, nl, ND);
+      }
+   }
+}
+
+// Cross-element SIMD action, on nv column-blocked E-vectors. Returns false if
+// there is no SIMD instantiation for the given (D1D,Q1D).
+static bool SimdPAMassApply(const int dim,
+                            const int D1D,
+                            const int Q1D,
+                            const int NE,
+                            const int NV,
+                            const Array<double> &B,
+                            const Vector &D,
+                            const Vector &X,
+                            Vector &Y)
+{
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: SimdPAMassApply2D<2,2>(NE,B,D,X,Y,NV); return true;
+         case 0x33: SimdPAMassApply2D<3,3>(NE,B,D,X,Y,NV); return true;
+         case 0x34: SimdPAMassApply2D<3,4>(NE,B,D,X,Y,NV); return true;
+         case 0x44: SimdPAMassApply2D<4,4>(NE,B,D,X,Y,NV); return true;
+         case 0x45: SimdPAMassApply2D<4,5>(NE,B,D,X,Y,NV); return true;
+         case 0x55: SimdPAMassApply2D<5,5>(NE,B,D,X,Y,NV); return true;
+         case 0x56: SimdPAMassApply2D<5,6>(NE,B,D,X,Y,NV); return true;
+         case 0x66: SimdPAMassApply2D<6,6>(NE,B,D,X,Y,NV); return true;
+         case 0x77: SimdPAMassApply2D<7,7>(NE,B,D,X,Y,NV); return true;
+         case 0x88: SimdPAMassApply2D<8,8>(NE,B,D,X,Y,NV); return true;
+         case 0x99: SimdPAMassApply2D<9,9>(NE,B,D,X,Y,NV); return true;
+         default: return false;
+      }
+   }
+   if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: SimdPAMassApply3D<2,3>(NE,B,D,X,Y,NV); return true;
+         case 0x24: SimdPAMassApply3D<2,4>(NE,B,D,X,Y,NV); return true;
+         case 0x34: SimdPAMassApply3D<3,4>(NE,B,D,X,Y,NV); return true;
+         case 0x45: SimdPAMassApply3D<4,5>(NE,B,D,X,Y,NV); return true;
+         case 0x56: SimdPAMassApply3D<5,6>(NE,B,D,X,Y,NV); return true;
+         case 0x67: SimdPAMassApply3D<6,7>(NE,B,D,X,Y,NV); return true;
+         case 0x78: SimdPAMassApply3D<7,8>(NE,B,D,X,Y,NV); return true;
+         case 0x89: SimdPAMassApply3D<8,9>(NE,B,D,X,Y,NV); return true;
+         default: return false;
+      }
+   }
+   return false;
+}
+
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
@@ -1180,6 +1365,10 @@ static void PAMassApply(const int dim,
       MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
    }
 #endif // MFEM_USE_OCCA
+   if (DeviceCanUseSimd() && SimdPAMassApply(dim,D1D,Q1D,NE,1,B,D,X,Y))
+   {
+      return;
+   }
    const int id = (D1D << 4) | Q1D;
    if (dim == 2)
    {
@@ -1198,7 +1387,13 @@ static void PAMassApply(const int dim,
          case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
          case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
          case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(2,D1D,Q1D,NE,1,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         }
       }
    }
    else if (dim == 3)
@@ -1218,7 +1413,76 @@ static void PAMassApply(const int dim,
          case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
          case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
          case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(3,D1D,Q1D,NE,1,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         }
+      }
+   }
+   mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// Action on nv column-blocked E-vectors: the quadrature data of each element
+// is loaded once and applied to all the vectors. Only the generic (register)
+// kernels take several vectors, so the shared memory kernels used by the
+// single vector action for some (D1D,Q1D) pairs are not used here.
+static void PAMassApplyBlock(const int dim,
+                             const int D1D,
+                             const int Q1D,
+                             const int NE,
+                             const int NV,
+                             const Array<double> &B,
+                             const Array<double> &Bt,
+                             const Vector &D,
+                             const Vector &X,
+                             Vector &Y)
+{
+   if (DeviceCanUseSimd() && SimdPAMassApply(dim,D1D,Q1D,NE,NV,B,D,X,Y))
+   {
+      return;
+   }
+   const int id = (D1D << 4) | Q1D;
+   if (dim == 2)
+   {
+      switch (id)
+      {
+         case 0x22: return PAMassApply2D<2,2>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x24: return PAMassApply2D<2,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x33: return PAMassApply2D<3,3>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x34: return PAMassApply2D<3,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x44: return PAMassApply2D<4,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x45: return PAMassApply2D<4,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x55: return PAMassApply2D<5,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x56: return PAMassApply2D<5,6>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(2,D1D,Q1D,NE,NV,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
+         }
+      }
+   }
+   else if (dim == 3)
+   {
+      switch (id)
+      {
+         case 0x23: return PAMassApply3D<2,3>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x24: return PAMassApply3D<2,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x34: return PAMassApply3D<3,4>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x45: return PAMassApply3D<4,5>(NE,B,Bt,D,X,Y,0,0,NV);
+         case 0x56: return PAMassApply3D<5,6>(NE,B,Bt,D,X,Y,0,0,NV);
+         default:
+         {
+#ifdef MFEM_USE_JIT
+            if (JitPAMassApply(3,D1D,Q1D,NE,NV,B,Bt,D,X,Y)) { return; }
+#endif
+            return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D,NV);
+         }
       }
    }
    mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
@@ -1227,6 +1491,10 @@ static void PAMassApply(const int dim,
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.IsEnabled() && !DeviceCanUseCeed())
+   {
+      return AddMultPAGroups(x, y);
+   }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -1239,4 +1507,39 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+bool MassIntegrator::SupportsPARange() const
+{
+   return !pa_groups.IsEnabled() && !DeviceCanUseCeed();
+}
+
+void MassIntegrator::AddMultPARange(const Vector &x, Vector &y,
+                                    const int e_begin, const int e_end) const
+{
+   MFEM_ASSERT(SupportsPARange(), "element ranges are not supported");
+   if (e_end <= e_begin) { return; }
+   Vector xr, yr, dr;
+   MakeElementRangeRef(x, ne, e_begin, e_end, xr);
+   MakeElementRangeRef(y, ne, e_begin, e_end, yr);
+   MakeElementRangeRef(pa_data, ne, e_begin, e_end, dr);
+   PAMassApply(dim, dofs1D, quad1D, e_end - e_begin, maps->B, maps->Bt,
+               dr, xr, yr);
+}
+
+void MassIntegrator::AddMultBlockPA(const Vector &x, Vector &y,
+                                    const int nv) const
+{
+   bool per_vector = (nv == 1) || DeviceCanUseCeed() ||
+                     pa_groups.IsEnabled();
+#ifdef MFEM_USE_OCCA
+   per_vector = per_vector || DeviceCanUseOcca();
+#endif
+   if (per_vector)
+   {
+      BilinearFormIntegrator::AddMultBlockPA(x, y, nv);
+      return;
+   }
+   PAMassApplyBlock(dim, dofs1D, quad1D, ne, nv, maps->B, maps->Bt, pa_data,
+                    x, y);
+}
+
 } // namespace mfem
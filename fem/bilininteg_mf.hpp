@@ -0,0 +1,580 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_MF
+#define MFEM_BILININTEG_MF
+
+#include "../config/config.hpp"
+#include "../general/forall.hpp"
+#include "fespace.hpp"
+#include "gridfunc.hpp"
+#include "coefficient.hpp"
+
+// Helper functions shared by the matrix-free (AssemblyLevel::NONE) integrator
+// kernels. The element-wise tensor contractions below are designed to be
+// inlined in device kernels; the matrices B and G are stored column-major with
+// size Q1D x D1D and the element values are in lexicographic order.
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/** @brief Store the tensor product @a mesh_nodes as a lexicographic E-vector
+    and the 1D maps, @a geom_B and @a geom_G, of their basis at the points of
+    @a ir. */
+inline void MFSetupTensorNodes(const GridFunction &mesh_nodes,
+                               const IntegrationRule &ir,
+                               Array<double> &geom_B, Array<double> &geom_G,
+                               int &geom_dofs1D, Vector &nodes)
+{
+   const FiniteElementSpace *nfes = mesh_nodes.FESpace();
+   MFEM_VERIFY(UsesTensorBasis(*nfes), "Matrix-free assembly requires "
+               "tensor-product mesh nodes.");
+   const DofToQuad &maps = nfes->GetFE(0)->GetDofToQuad(ir, DofToQuad::TENSOR);
+   maps.B.Copy(geom_B);
+   maps.G.Copy(geom_G);
+   geom_dofs1D = maps.ndof;
+   const Operator *elem_restr =
+      nfes->GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   nodes.SetSize(elem_restr->Height(), Device::GetDeviceMemoryType());
+   elem_restr->Mult(mesh_nodes, nodes);
+}
+
+/** @brief Store the mesh nodes as a lexicographic E-vector and the 1D maps,
+    @a geom_B and @a geom_G, of their basis at the points of @a ir. */
+/** The mesh is not modified: when its nodes do not use a tensor product basis,
+    e.g. when the mesh has only vertices, the nodes are interpolated in a local
+    H1 space. */
+inline void MFSetupNodes(Mesh &mesh, const IntegrationRule &ir,
+                         Array<double> &geom_B, Array<double> &geom_G,
+                         int &geom_dofs1D, Vector &nodes)
+{
+   const GridFunction *mesh_nodes = mesh.GetNodes();
+   if (mesh_nodes && UsesTensorBasis(*mesh_nodes->FESpace()))
+   {
+      MFSetupTensorNodes(*mesh_nodes, ir, geom_B, geom_G, geom_dofs1D, nodes);
+      return;
+   }
+   const int order = mesh_nodes ? mesh_nodes->FESpace()->GetOrder(0) : 1;
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec, mesh.SpaceDimension());
+   GridFunction local_nodes(&fes);
+   mesh.GetNodes(local_nodes);
+   MFSetupTensorNodes(local_nodes, ir, geom_B, geom_G, geom_dofs1D, nodes);
+}
+
+/** @brief Setup the coefficient data used by the matrix-free kernels: a single
+    value for constant coefficients, or one value per quadrature point. */
+/** Coefficients given by a QuadratureFunction are referenced, not copied. */
+inline void MFSetupCoefficient(const FiniteElementSpace &fes,
+                               const IntegrationRule &ir,
+                               Coefficient *Q, Vector &coeff)
+{
+   const int ne = fes.GetNE();
+   const int nq = ir.GetNPoints();
+   if (Q == nullptr)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else if (QuadratureFunctionCoefficient* cQ =
+               dynamic_cast<QuadratureFunctionCoefficient*>(Q))
+   {
+      const QuadratureFunction &qFun = cQ->GetQuadFunction();
+      MFEM_VERIFY(qFun.Size() == nq * ne,
+                  "Incompatible QuadratureFunction dimension \n");
+
+      MFEM_VERIFY(&ir == &qFun.GetSpace()->GetElementIntRule(0),
+                  "IntegrationRule used within integrator and in"
+                  " QuadratureFunction appear to be different");
+      qFun.Read();
+      coeff.MakeRef(const_cast<QuadratureFunction &>(qFun),0);
+   }
+   else
+   {
+      coeff.SetSize(nq * ne);
+      auto C = Reshape(coeff.HostWrite(), nq, ne);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation& T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            C(q,e) = Q->Eval(T, ir.IntPoint(q));
+         }
+      }
+   }
+}
+
+/// Reference gradient at the quadrature points of a 2D scalar field.
+template<int MQ1>
+MFEM_HOST_DEVICE inline void MFGrad2D(const int D1D, const int Q1D,
+                                      const double *B, const double *G,
+                                      const double *x,
+                                      double grad[MQ1][MQ1][2])
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      double gradX[MQ1][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const double s = x[dx + dy*D1D];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B[qx + dx*Q1D];
+            gradX[qx][1] += s * G[qx + dx*Q1D];
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy  = B[qy + dy*Q1D];
+         const double wDy = G[qy + dy*Q1D];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+}
+
+/// Add the transpose of MFGrad2D() applied to @a grad to @a y.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline void MFGradTranspose2D(const int D1D, const int Q1D,
+                                               const double *B, const double *G,
+                                               const double grad[MQ1][MQ1][2],
+                                               double *y)
+{
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      double gradX[MD1][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0.0;
+         gradX[dx][1] = 0.0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const double gX = grad[qy][qx][0];
+         const double gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] += gX * G[qx + dx*Q1D];
+            gradX[dx][1] += gY * B[qx + dx*Q1D];
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy  = B[qy + dy*Q1D];
+         const double wDy = G[qy + dy*Q1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            y[dx + dy*D1D] += (gradX[dx][0] * wy) + (gradX[dx][1] * wDy);
+         }
+      }
+   }
+}
+
+/// Reference gradient at the quadrature points of a 3D scalar field.
+template<int MQ1>
+MFEM_HOST_DEVICE inline void MFGrad3D(const int D1D, const int Q1D,
+                                      const double *B, const double *G,
+                                      const double *x,
+                                      double grad[MQ1][MQ1][MQ1][3])
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      double gradXY[MQ1][MQ1][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[MQ1][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = x[dx + (dy + dz*D1D)*D1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B[qx + dx*Q1D];
+               gradX[qx][1] += s * G[qx + dx*Q1D];
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B[qy + dy*Q1D];
+            const double wDy = G[qy + dy*Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double wx  = gradX[qx][0];
+               const double wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz  = B[qz + dz*Q1D];
+         const double wDz = G[qz + dz*Q1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+            }
+         }
+      }
+   }
+}
+
+/// Add the transpose of MFGrad3D() applied to @a grad to @a y.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline
+void MFGradTranspose3D(const int D1D, const int Q1D,
+                       const double *B, const double *G,
+                       const double grad[MQ1][MQ1][MQ1][3],
+                       double *y)
+{
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      double gradXY[MD1][MD1][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0.0;
+            gradXY[dy][dx][1] = 0.0;
+            gradXY[dy][dx][2] = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[MD1][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+            gradX[dx][2] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qz][qy][qx][0];
+            const double gY = grad[qz][qy][qx][1];
+            const double gZ = grad[qz][qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = B[qx + dx*Q1D];
+               const double wDx = G[qx + dx*Q1D];
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = B[qy + dy*Q1D];
+            const double wDy = G[qy + dy*Q1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz  = B[qz + dz*Q1D];
+         const double wDz = G[qz + dz*Q1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               y[dx + (dy + dz*D1D)*D1D] +=
+                  ((gradXY[dy][dx][0] * wz) +
+                   (gradXY[dy][dx][1] * wz) +
+                   (gradXY[dy][dx][2] * wDz));
+            }
+         }
+      }
+   }
+}
+
+/// Values at the quadrature points of a 2D scalar field.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline void MFEval2D(const int D1D, const int Q1D,
+                                      const double *B, const double *x,
+                                      double val[MQ1][MQ1])
+{
+   double DQ[MD1][MQ1];
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double u = 0.0;
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            u += x[dx + dy*D1D] * B[qx + dx*Q1D];
+         }
+         DQ[dy][qx] = u;
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         double u = 0.0;
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            u += DQ[dy][qx] * B[qy + dy*Q1D];
+         }
+         val[qy][qx] = u;
+      }
+   }
+}
+
+/// Add the transpose of MFEval2D() applied to @a val to @a y.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline void MFEvalTranspose2D(const int D1D, const int Q1D,
+                                               const double *B,
+                                               const double val[MQ1][MQ1],
+                                               double *y)
+{
+   double QD[MQ1][MD1];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double u = 0.0;
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            u += val[qy][qx] * B[qx + dx*Q1D];
+         }
+         QD[qy][dx] = u;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         double u = 0.0;
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            u += QD[qy][dx] * B[qy + dy*Q1D];
+         }
+         y[dx + dy*D1D] += u;
+      }
+   }
+}
+
+/// Values at the quadrature points of a 3D scalar field.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline void MFEval3D(const int D1D, const int Q1D,
+                                      const double *B, const double *x,
+                                      double val[MQ1][MQ1][MQ1])
+{
+   double DDQ[MD1][MD1][MQ1];
+   double DQQ[MD1][MQ1][MQ1];
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               u += x[dx + (dy + dz*D1D)*D1D] * B[qx + dx*Q1D];
+            }
+            DDQ[dz][dy][qx] = u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               u += DDQ[dz][dy][qx] * B[qy + dy*Q1D];
+            }
+            DQQ[dz][qy][qx] = u;
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double u = 0.0;
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               u += DQQ[dz][qy][qx] * B[qz + dz*Q1D];
+            }
+            val[qz][qy][qx] = u;
+         }
+      }
+   }
+}
+
+/// Add the transpose of MFEval3D() applied to @a val to @a y.
+template<int MD1, int MQ1>
+MFEM_HOST_DEVICE inline void MFEvalTranspose3D(const int D1D, const int Q1D,
+                                               const double *B,
+                                               const double val[MQ1][MQ1][MQ1],
+                                               double *y)
+{
+   double QQD[MQ1][MQ1][MD1];
+   double QDD[MQ1][MD1][MD1];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u += val[qz][qy][qx] * B[qx + dx*Q1D];
+            }
+            QQD[qz][qy][dx] = u;
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               u += QQD[qz][qy][dx] * B[qy + dy*Q1D];
+            }
+            QDD[qz][dy][dx] = u;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double u = 0.0;
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               u += QDD[qz][dy][dx] * B[qz + dz*Q1D];
+            }
+            y[dx + (dy + dz*D1D)*D1D] += u;
+         }
+      }
+   }
+}
+
+/// Determinant of the 3x3 Jacobian given by its rows @a Jx, @a Jy and @a Jz.
+MFEM_HOST_DEVICE inline double MFDet3D(const double *Jx, const double *Jy,
+                                       const double *Jz)
+{
+   return Jx[0] * (Jy[1] * Jz[2] - Jz[1] * Jy[2]) -
+          Jy[0] * (Jx[1] * Jz[2] - Jz[1] * Jx[2]) +
+          Jz[0] * (Jx[1] * Jy[2] - Jy[1] * Jx[2]);
+}
+
+/** @brief Compute the symmetric diffusion operator, w detJ J^{-1} J^{-T}, from
+    the rows of the Jacobian. The result is stored in @a O in the order
+    (1,1), (2,1), (3,1), (2,2), (3,2), (3,3). */
+MFEM_HOST_DEVICE inline void MFDiffusionQFunction3D(const double w,
+                                                    const double *Jx,
+                                                    const double *Jy,
+                                                    const double *Jz,
+                                                    double *O)
+{
+   const double J11 = Jx[0], J12 = Jx[1], J13 = Jx[2];
+   const double J21 = Jy[0], J22 = Jy[1], J23 = Jy[2];
+   const double J31 = Jz[0], J32 = Jz[1], J33 = Jz[2];
+   const double c_detJ = w / MFDet3D(Jx, Jy, Jz);
+   // adj(J)
+   const double A11 = (J22 * J33) - (J23 * J32);
+   const double A12 = (J32 * J13) - (J12 * J33);
+   const double A13 = (J12 * J23) - (J22 * J13);
+   const double A21 = (J31 * J23) - (J21 * J33);
+   const double A22 = (J11 * J33) - (J13 * J31);
+   const double A23 = (J21 * J13) - (J11 * J23);
+   const double A31 = (J21 * J32) - (J31 * J22);
+   const double A32 = (J31 * J12) - (J11 * J32);
+   const double A33 = (J11 * J22) - (J12 * J21);
+   // detJ J^{-1} J^{-T} = (1/detJ) adj(J) adj(J)^T
+   O[0] = c_detJ * (A11*A11 + A12*A12 + A13*A13); // 1,1
+   O[1] = c_detJ * (A11*A21 + A12*A22 + A13*A23); // 2,1
+   O[2] = c_detJ * (A11*A31 + A12*A32 + A13*A33); // 3,1
+   O[3] = c_detJ * (A21*A21 + A22*A22 + A23*A23); // 2,2
+   O[4] = c_detJ * (A21*A31 + A22*A32 + A23*A33); // 3,2
+   O[5] = c_detJ * (A31*A31 + A32*A32 + A33*A33); // 3,3
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif
@@ -0,0 +1,95 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_SIMD_HPP
+#define MFEM_BILININTEG_SIMD_HPP
+
+#include "../config/config.hpp"
+#include "../general/device.hpp"
+#include "../linalg/simd.hpp"
+
+namespace mfem
+{
+
+/** @brief Return true if the cross-element SIMD partial assembly kernels,
+    selected with Backend::CPU_SIMD ("cpu-simd"), can be used. */
+inline bool DeviceCanUseSimd()
+{
+   return Device::Allows(Backend::CPU_SIMD) &&
+          !Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK |
+                          Backend::OCCA_MASK | Backend::CEED_MASK |
+                          Backend::RAJA_MASK);
+}
+
+namespace internal
+{
+
+/** @brief SIMD type used by the cross-element partial assembly kernels: lane
+    'l' of a batch holds the data of element 'e0+l'. */
+/** The width is the native SIMD width when MFEM_USE_SIMD is enabled, and at
+    least 4 doubles otherwise, so that the compiler can still vectorize the
+    generic AutoSIMD implementation. */
+struct PASimd
+{
+   static const int size = (MFEM_SIMD_BYTES >= 4*sizeof(double)) ?
+                           MFEM_SIMD_BYTES/sizeof(double) : 4;
+   typedef AutoSIMD<double, size, size*sizeof(double)> real_t;
+};
+
+/** @brief Load the entries ptr[l*stride], l < n, into the lanes of @a v. The
+    remaining lanes, corresponding to padding elements, are set to zero. */
+template <typename simd_t>
+inline MFEM_ALWAYS_INLINE void SimdGather(simd_t &v, const double *ptr,
+                                          const int stride, const int n)
+{
+   for (int l = 0; l < simd_t::size; l++)
+   {
+      v[l] = (l < n) ? ptr[l*stride] : 0.0;
+   }
+}
+
+/** @brief Load the @a count consecutive entries starting at ptr + l*stride into
+    lane 'l' of v[0], ..., v[count-1], for l < n. The remaining lanes are set
+    to zero. */
+/** Each lane reads a contiguous block of memory, which is much cheaper than
+    gathering the entries one SIMD vector at a time. */
+template <typename simd_t>
+inline MFEM_ALWAYS_INLINE void SimdLoad(simd_t *v, const double *ptr,
+                                        const int stride, const int n,
+                                        const int count)
+{
+   for (int l = 0; l < simd_t::size; l++)
+   {
+      const double *p = ptr + l*stride;
+      if (l < n) { for (int i = 0; i < count; i++) { v[i][l] = p[i]; } }
+      else { for (int i = 0; i < count; i++) { v[i][l] = 0.0; } }
+   }
+}
+
+/** @brief Add lane 'l' of v[0], ..., v[count-1] to the @a count consecutive
+    entries starting at ptr + l*stride, for l < n. */
+template <typename simd_t>
+inline MFEM_ALWAYS_INLINE void SimdAddStore(const simd_t *v, double *ptr,
+                                            const int stride, const int n,
+                                            const int count)
+{
+   for (int l = 0; l < n; l++)
+   {
+      double *p = ptr + l*stride;
+      for (int i = 0; i < count; i++) { p[i] += v[i][l]; }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_BILININTEG_SIMD_HPP
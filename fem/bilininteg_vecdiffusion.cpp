@@ -124,6 +124,7 @@ static void PAVectorDiffusionSetup(const int dim,
 
 void VectorDiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
+   if (pa_groups.Setup(fes)) { return AssemblePAGroups(fes); }
    // Assumes tensor-product elements
    Mesh *mesh = fes.GetMesh();
    const FiniteElement &el = *fes.GetFE(0);
@@ -506,6 +507,7 @@ void PAVectorDiffusionApply3D(const int NE,
 // PA Diffusion Apply kernel
 void VectorDiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.IsEnabled()) { return AddMultPAGroups(x, y); }
    const int D1D = dofs1D;
    const int Q1D = quad1D;
    const Array<double> &B = maps->B;
@@ -726,6 +728,7 @@ static void PAVectorDiffusionAssembleDiagonal(const int dim,
 
 void VectorDiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.IsEnabled()) { return AssembleDiagonalPAGroups(diag); }
    PAVectorDiffusionAssembleDiagonal(dim,
                                      dofs1D,
                                      quad1D,
@@ -23,6 +23,7 @@ namespace mfem
 // PA Mass Assemble kernel
 void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
 {
+   if (pa_groups.Setup(fes)) { return AssemblePAGroups(fes); }
    // Assuming the same element type
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
@@ -361,6 +362,7 @@ static void PAVectorMassApply(const int dim,
 
 void VectorMassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.IsEnabled()) { return AddMultPAGroups(x, y); }
    PAVectorMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
 }
 
@@ -514,6 +516,7 @@ static void PAVectorMassAssembleDiagonal(const int dim,
 
 void VectorMassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.IsEnabled()) { return AssembleDiagonalPAGroups(diag); }
    PAVectorMassAssembleDiagonal(dim,
                                 dofs1D,
                                 quad1D,
@@ -760,32 +760,21 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
 
    Vector coeff(coeffDim * ne * nq);
    coeff = 1.0;
-   auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
-   if (Q || VQ || MQ)
+   if (MQ)
    {
-      Vector D(VQ ? coeffDim : 0);
+      MFEM_VERIFY(coeffDim == MQdim, "");
+      MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim, "");
+
+      auto coeffh = Reshape(coeff.HostWrite(), coeffDim, nq, ne);
       DenseMatrix M;
       Vector Msymm;
-      if (MQ)
-      {
-         if (symmetric)
-         {
-            Msymm.SetSize(MQsymmDim);
-         }
-         else
-         {
-            M.SetSize(dim);
-         }
-      }
-
-      if (VQ)
+      if (symmetric)
       {
-         MFEM_VERIFY(coeffDim == dim, "");
+         Msymm.SetSize(MQsymmDim);
       }
-      if (MQ)
+      else
       {
-         MFEM_VERIFY(coeffDim == MQdim, "");
-         MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim, "");
+         M.SetSize(dim);
       }
 
       for (int e=0; e<ne; ++e)
@@ -793,43 +782,37 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
          ElementTransformation *tr = mesh->GetElementTransformation(e);
          for (int p=0; p<nq; ++p)
          {
-            if (MQ)
+            if (MQ->IsSymmetric())
             {
-               if (MQ->IsSymmetric())
-               {
-                  MQ->EvalSymmetric(Msymm, *tr, ir->IntPoint(p));
+               MQ->EvalSymmetric(Msymm, *tr, ir->IntPoint(p));
 
-                  for (int i=0; i<MQsymmDim; ++i)
-                  {
-                     coeffh(i, p, e) = Msymm[i];
-                  }
-               }
-               else
+               for (int i=0; i<MQsymmDim; ++i)
                {
-                  MQ->Eval(M, *tr, ir->IntPoint(p));
-
-                  for (int i=0; i<dim; ++i)
-                     for (int j=0; j<dim; ++j)
-                     {
-                        coeffh(j+(i*dim), p, e) = M(i,j);
-                     }
-               }
-            }
-            else if (VQ)
-            {
-               VQ->Eval(D, *tr, ir->IntPoint(p));
-               for (int i=0; i<coeffDim; ++i)
-               {
-                  coeffh(i, p, e) = D[i];
+                  coeffh(i, p, e) = Msymm[i];
                }
             }
             else
             {
-               coeffh(0, p, e) = Q->Eval(*tr, ir->IntPoint(p));
+               MQ->Eval(M, *tr, ir->IntPoint(p));
+
+               for (int i=0; i<dim; ++i)
+                  for (int j=0; j<dim; ++j)
+                  {
+                     coeffh(j+(i*dim), p, e) = M(i,j);
+                  }
             }
          }
       }
    }
+   else if (VQ)
+   {
+      MFEM_VERIFY(coeffDim == dim, "");
+      VQ->EvalAll(coeff, *mesh, *ir);
+   }
+   else if (Q)
+   {
+      Q->EvalAll(coeff, *mesh, *ir);
+   }
 
    if (trial_curl && test_curl && dim == 3)
    {
@@ -1024,14 +1007,7 @@ void MixedVectorGradientIntegrator::AssemblePA(const FiniteElementSpace
    coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalAll(coeff, *mesh, *ir);
    }
 
    // Use the same setup functions as VectorFEMassIntegrator.
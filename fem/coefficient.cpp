@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -21,6 +22,91 @@ namespace mfem
 
 using namespace std;
 
+// Check if the values of a GridFunction in the space 'fes' at the points of
+// 'ir' can be computed in all elements of 'mesh' at once, using the kernels of
+// the QuadratureInterpolator class.
+static bool UseQuadratureInterpolator(const FiniteElementSpace &fes,
+                                      const Mesh &mesh,
+                                      const IntegrationRule &ir)
+{
+   const int dim = mesh.Dimension();
+   const int vdim = fes.GetVDim();
+   if (fes.GetMesh() != &mesh || mesh.GetNE() == 0 || fes.GetNURBSext())
+   {
+      return false;
+   }
+   if (dim < 2 || mesh.GetNumGeometries(dim) != 1) { return false; }
+   if (vdim != 1 && vdim != dim && !(dim == 2 && vdim == 3)) { return false; }
+   const FiniteElement *fe = fes.GetFE(0);
+   if (fe->GetRangeType() != FiniteElement::SCALAR ||
+       fe->GetMapType() != FiniteElement::VALUE)
+   {
+      return false;
+   }
+   // maximum number of dofs and points supported by the kernels
+   const int max_n = (dim == 2) ? 100 : 1000;
+   return fe->GetDof() <= max_n && ir.GetNPoints() <= max_n;
+}
+
+// Compute the values of the GridFunction 'gf' at the points of 'ir' in all
+// elements of its mesh as a (NQ x VDIM x NE) array.
+static void InterpolateAll(const GridFunction &gf, const IntegrationRule &ir,
+                           Vector &q_val)
+{
+   const FiniteElementSpace &fes = *gf.FESpace();
+   const Operator *elem_restr =
+      fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector e_vec(elem_restr->Height());
+   elem_restr->Mult(gf, e_vec);
+
+   QuadratureInterpolator qi(fes, ir);
+   qi.DisableTensorProducts();
+   qi.SetOutputLayout(QVectorLayout::byNODES);
+   q_val.SetSize(fes.GetVDim()*ir.GetNPoints()*fes.GetNE());
+   qi.Values(e_vec, q_val);
+}
+
+// Compute the physical coordinates of the points of 'ir' in all elements of
+// 'mesh' as a (NQ x SDIM x NE) array. Returns false if this is not possible
+// with a single batched evaluation.
+static bool GetPhysicalPoints(Mesh &mesh, const IntegrationRule &ir, Vector &X)
+{
+   const GridFunction *nodes = mesh.GetNodes();
+   if (!nodes || !UseQuadratureInterpolator(*nodes->FESpace(), mesh, ir))
+   {
+      return false;
+   }
+   InterpolateAll(*nodes, ir, X);
+   return true;
+}
+
+void Coefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                          const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   qcoeff.SetSize(nq*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+void ConstantCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   qcoeff.SetSize(ir.GetNPoints()*mesh.GetNE());
+   qcoeff.UseDevice(true);
+   qcoeff = constant;
+}
+
 double PWConstCoefficient::Eval(ElementTransformation & T,
                                 const IntegrationPoint & ip)
 {
@@ -28,6 +114,20 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void PWConstCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                 const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   qcoeff.SetSize(nq*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; e++)
+   {
+      const double c = constants(mesh.GetAttribute(e)-1);
+      for (int q = 0; q < nq; q++) { C(q,e) = c; }
+   }
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -46,12 +146,71 @@ double FunctionCoefficient::Eval(ElementTransformation & T,
    }
 }
 
+void FunctionCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                  const IntegrationRule &ir)
+{
+   Vector X;
+   if (!GetPhysicalPoints(mesh, ir, X))
+   {
+      Coefficient::EvalAll(qcoeff, mesh, ir);
+      return;
+   }
+
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int sdim = mesh.SpaceDimension();
+   const auto x = Reshape(X.HostRead(), nq, sdim, ne);
+   qcoeff.SetSize(nq*ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   Vector transip(sdim);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { transip(d) = x(q,d,e); }
+         C(q,e) = Function ? (*Function)(transip) :
+                  (*TDFunction)(transip, GetTime());
+      }
+   }
+}
+
 double GridFunctionCoefficient::Eval (ElementTransformation &T,
                                       const IntegrationPoint &ip)
 {
    return GridF -> GetValue (T, ip, Component);
 }
 
+void GridFunctionCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir)
+{
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   if (!UseQuadratureInterpolator(fes, mesh, ir))
+   {
+      Coefficient::EvalAll(qcoeff, mesh, ir);
+      return;
+   }
+
+   Vector q_val;
+   InterpolateAll(*GridF, ir, q_val);
+   if (fes.GetVDim() == 1)
+   {
+      qcoeff.Swap(q_val);
+      return;
+   }
+
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int comp = Component - 1;
+   const auto V = Reshape(q_val.Read(), nq, fes.GetVDim(), ne);
+   qcoeff.SetSize(nq*ne);
+   auto C = Reshape(qcoeff.Write(), nq, ne);
+   MFEM_FORALL(i, nq*ne,
+   {
+      const int q = i % nq, e = i / nq;
+      C(q,e) = V(q,comp,e);
+   });
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -101,6 +260,34 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   qcoeff.SetSize(vdim*nq*ne);
+   double *C = qcoeff.HostWrite();
+   DenseMatrix M;
+   for (int e = 0; e < ne; e++)
+   {
+      Eval(M, *mesh.GetElementTransformation(e), ir);
+      MFEM_ASSERT(M.Height() == vdim && M.Width() == nq, "invalid size");
+      std::copy(M.Data(), M.Data() + vdim*nq, C + vdim*nq*e);
+   }
+}
+
+void VectorConstantCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int vd = vdim;
+   qcoeff.SetSize(vd*nq*ne);
+   const auto v = vec.Read();
+   auto C = Reshape(qcoeff.Write(), vd, nq*ne);
+   MFEM_FORALL(i, vd*nq*ne, C(i % vd, i / vd) = v[i % vd];);
+}
+
 void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -124,6 +311,51 @@ void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
    }
 }
 
+void VectorFunctionCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   Vector X;
+   if (!GetPhysicalPoints(mesh, ir, X))
+   {
+      VectorCoefficient::EvalAll(qcoeff, mesh, ir);
+      return;
+   }
+
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int sdim = mesh.SpaceDimension();
+   const auto x = Reshape(X.HostRead(), nq, sdim, ne);
+   qcoeff.SetSize(vdim*nq*ne);
+   double *C = qcoeff.HostWrite();
+   Vector transip(sdim), V;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int d = 0; d < sdim; d++) { transip(d) = x(q,d,e); }
+         V.SetDataAndSize(C + vdim*(q + nq*e), vdim);
+         if (Function)
+         {
+            (*Function)(transip, V);
+         }
+         else
+         {
+            (*TDFunction)(transip, GetTime(), V);
+         }
+      }
+   }
+   if (Q)
+   {
+      Vector qq;
+      Q->SetTime(GetTime());
+      Q->EvalAll(qq, mesh, ir);
+      const int vd = vdim;
+      const auto w = qq.Read();
+      auto y = Reshape(qcoeff.ReadWrite(), vd, nq*ne);
+      MFEM_FORALL(i, vd*nq*ne, y(i % vd, i / vd) *= w[i / vd];);
+   }
+}
+
 VectorArrayCoefficient::VectorArrayCoefficient (int dim)
    : VectorCoefficient(dim), Coeff(dim), ownCoeff(dim)
 {
@@ -183,6 +415,32 @@ void VectorGridFunctionCoefficient::Eval(
    GridFunc->GetVectorValues(T, ir, M);
 }
 
+void VectorGridFunctionCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                            const IntegrationRule &ir)
+{
+   if (!UseQuadratureInterpolator(*GridFunc->FESpace(), mesh, ir))
+   {
+      VectorCoefficient::EvalAll(qcoeff, mesh, ir);
+      return;
+   }
+
+   Vector q_val;
+   InterpolateAll(*GridFunc, ir, q_val);
+
+   // reorder from (NQ x VDIM x NE) to (VDIM x NQ x NE)
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int vd = vdim;
+   const auto V = Reshape(q_val.Read(), nq, vd, ne);
+   qcoeff.SetSize(vd*nq*ne);
+   auto C = Reshape(qcoeff.Write(), vd, nq, ne);
+   MFEM_FORALL(i, vd*nq*ne,
+   {
+      const int d = i % vd, q = (i / vd) % nq, e = i / (vd*nq);
+      C(d,q,e) = V(q,d,e);
+   });
+}
+
 GradientGridFunctionCoefficient::GradientGridFunctionCoefficient (
    const GridFunction *gf)
    : VectorCoefficient((gf) ?
@@ -291,6 +549,40 @@ void VectorRestrictedCoefficient::Eval(
    }
 }
 
+void MatrixCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int hw = height*width;
+   qcoeff.SetSize(hw*nq*ne);
+   double *C = qcoeff.HostWrite();
+   DenseMatrix K;
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(K, T, ip);
+         std::copy(K.Data(), K.Data() + hw, C + hw*(q + nq*e));
+      }
+   }
+}
+
+void MatrixConstantCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const int nq = ir.GetNPoints();
+   const int ne = mesh.GetNE();
+   const int hw = height*width;
+   qcoeff.SetSize(hw*nq*ne);
+   const auto m = mat.Read();
+   auto C = Reshape(qcoeff.Write(), hw, nq*ne);
+   MFEM_FORALL(i, hw*nq*ne, C(i % hw, i / hw) = m[i % hw];);
+}
+
 void MatrixFunctionCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -398,6 +690,43 @@ void MatrixRestrictedCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
    }
 }
 
+void SumCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                             const IntegrationRule &ir)
+{
+   b->EvalAll(qcoeff, mesh, ir);
+   qcoeff.UseDevice(true);
+   qcoeff *= beta;
+   if (a == NULL)
+   {
+      qcoeff += alpha * aConst;
+   }
+   else
+   {
+      Vector qa;
+      a->EvalAll(qa, mesh, ir);
+      qcoeff.Add(alpha, qa);
+   }
+}
+
+void ProductCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                 const IntegrationRule &ir)
+{
+   b->EvalAll(qcoeff, mesh, ir);
+   qcoeff.UseDevice(true);
+   if (a == NULL)
+   {
+      qcoeff *= aConst;
+   }
+   else
+   {
+      Vector qa;
+      a->EvalAll(qa, mesh, ir);
+      const auto x = qa.Read();
+      auto y = qcoeff.ReadWrite();
+      MFEM_FORALL(i, qcoeff.Size(), y[i] *= x[i];);
+   }
+}
+
 InnerProductCoefficient::InnerProductCoefficient(VectorCoefficient &A,
                                                  VectorCoefficient &B)
    : a(&A), b(&B)
@@ -928,4 +1257,15 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::EvalAll(Vector &qcoeff, Mesh &mesh,
+                                            const IntegrationRule &ir)
+{
+   MFEM_VERIFY(QuadF.Size() == ir.GetNPoints()*mesh.GetNE(),
+               "Incompatible QuadratureFunction dimension");
+   MFEM_VERIFY(&ir == &QuadF.GetSpace()->GetElementIntRule(0),
+               "IntegrationRule used within integrator and in"
+               " QuadratureFunction appear to be different");
+   qcoeff = QuadF;
+}
+
 }
@@ -68,6 +68,18 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of the IntegrationRule
+       @a ir in all elements of @a mesh. */
+   /** On exit, @a qcoeff has size ir.GetNPoints() * mesh.GetNE() and it is
+       ordered as a (NQ x NE) array, i.e. the values of each element are stored
+       contiguously, which is the layout of a QuadratureFunction on the same
+       rule. The result may be accessed on the device.
+
+       The general implementation provided by the base class calls Eval() at one
+       point at a time and can be overloaded for more efficient implementation,
+       e.g. evaluating the coefficient for all elements in a single batch. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -85,6 +97,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Evaluate the coefficient at all quadrature points of @a mesh.
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -121,6 +136,10 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the coefficient at all quadrature points of @a mesh
+       using the element attributes only. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 
@@ -167,6 +186,14 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the coefficient at all quadrature points of @a mesh.
+       The physical coordinates of the points are interpolated from the mesh
+       nodes for all elements at once with a QuadratureInterpolator. */
+   /** Meshes without nodes, or with nodes not supported by the
+       QuadratureInterpolator, use the element-by-element Coefficient::EvalAll.
+   */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 class GridFunction;
@@ -194,6 +221,11 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the coefficient at all quadrature points of @a mesh.
+       When the GridFunction is defined on @a mesh, the values are computed for
+       all elements at once using a QuadratureInterpolator. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 
@@ -382,6 +414,17 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all points of the
+       IntegrationRule @a ir in all elements of @a mesh. */
+   /** On exit, @a qcoeff has size GetVDim() * ir.GetNPoints() * mesh.GetNE()
+       and it is ordered as a (VDIM x NQ x NE) array, i.e. the QVectorLayout
+       byVDIM. The result may be accessed on the device.
+
+       The general implementation provided by the base class calls Eval() at one
+       point at a time and can be overloaded for more efficient implementation.
+   */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -401,6 +444,9 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip) { V = vec; }
 
+   /// Evaluate the vector coefficient at all quadrature points of @a mesh.
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    /// Return a reference to the constant vector in this class.
    const Vector& GetVec() { return vec; }
 };
@@ -438,6 +484,14 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip);
 
+   /** @brief Evaluate the vector coefficient at all quadrature points of
+       @a mesh. The physical coordinates of the points are interpolated from
+       the mesh nodes for all elements at once with a QuadratureInterpolator. */
+   /** Meshes without nodes, or with nodes not supported by the
+       QuadratureInterpolator, use the element-by-element
+       VectorCoefficient::EvalAll. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~VectorFunctionCoefficient() { }
 };
 
@@ -512,6 +566,11 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all quadrature points of
+       @a mesh. When the GridFunction is defined on @a mesh, the values are
+       computed for all elements at once using a QuadratureInterpolator. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~VectorGridFunctionCoefficient() { }
 };
 
@@ -741,6 +800,18 @@ public:
                               const IntegrationPoint &ip)
    { mfem_error("MatrixCoefficient::EvalSymmetric"); }
 
+   /** @brief Evaluate the matrix coefficient at all points of the
+       IntegrationRule @a ir in all elements of @a mesh. */
+   /** On exit, @a qcoeff has size GetHeight() * GetWidth() * ir.GetNPoints() *
+       mesh.GetNE() and it is ordered as a (HEIGHT x WIDTH x NQ x NE) array,
+       i.e. each matrix is stored in column-major order. The result may be
+       accessed on the device.
+
+       The general implementation provided by the base class calls Eval() at one
+       point at a time and can be overloaded for more efficient implementation.
+   */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~MatrixCoefficient() { }
 };
 
@@ -758,6 +829,9 @@ public:
    /// Evaluate the matrix coefficient at @a ip.
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationPoint &ip) { M = mat; }
+
+   /// Evaluate the matrix coefficient at all quadrature points of @a mesh.
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 
@@ -944,6 +1018,9 @@ public:
       return alpha * ((a == NULL ) ? aConst : a->Eval(T, ip) )
              + beta * b->Eval(T, ip);
    }
+
+   /// Evaluate the coefficient at all quadrature points of @a mesh.
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the product of two scalar coefficients or
@@ -983,6 +1060,9 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return ((a == NULL ) ? aConst : a->Eval(T, ip) ) * b->Eval(T, ip); }
+
+   /// Evaluate the coefficient at all quadrature points of @a mesh.
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the ratio of two scalars where one or both
@@ -1604,6 +1684,10 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the values of the QuadratureFunction, which must be defined
+       on @a mesh with the rule @a ir in all elements. */
+   virtual void EvalAll(Vector &qcoeff, Mesh &mesh, const IntegrationRule &ir);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
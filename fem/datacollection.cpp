@@ -1113,4 +1113,238 @@ const char *ParaViewDataCollection::GetDataTypeString() const
    }
 }
 
+
+// class RestartDataCollection implementation
+
+RestartDataCollection::RestartDataCollection(
+   const std::string& collection_name, Mesh *mesh_)
+   : DataCollection(collection_name, mesh_)
+{
+   appendRankToFileName = true; // always include rank in file names
+   cycle = 0;                   // always include cycle in directory names
+}
+
+#ifdef MFEM_USE_MPI
+RestartDataCollection::RestartDataCollection(
+   MPI_Comm comm, const std::string& collection_name, Mesh *mesh_)
+   : DataCollection(collection_name, mesh_)
+{
+   m_comm = comm;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+   appendRankToFileName = true; // always include rank in file names
+   cycle = 0;                   // always include cycle in directory names
+}
+#endif
+
+void RestartDataCollection::SetMesh(Mesh *new_mesh)
+{
+   DataCollection::SetMesh(new_mesh);
+   appendRankToFileName = true;
+}
+
+#ifdef MFEM_USE_MPI
+void RestartDataCollection::SetMesh(MPI_Comm comm, Mesh *new_mesh)
+{
+   // use RestartDataCollection's custom SetMesh, then set MPI info
+   SetMesh(new_mesh);
+   m_comm = comm;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+}
+#endif
+
+void RestartDataCollection::Save()
+{
+   MFEM_VERIFY(mesh != NULL, "the mesh is not set");
+   MFEM_VERIFY(!mesh->NURBSext, "RestartDataCollection does not support NURBS "
+               "meshes");
+
+   std::string dir_name = prefix_path + name;
+   if (cycle != -1)
+   {
+      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   if (create_directory(dir_name, mesh, myid))
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error creating directory: " << dir_name);
+      return;
+   }
+
+   std::string file_name = GetRestartFileName();
+   mfem::ofgzstream file(file_name, compression);
+   file << "MFEM restart v1.0\n";
+   const int64_t header[4] =
+   {
+      0x0102030405060708, // byte order mark
+      cycle, !serial, num_procs
+   };
+   const double times[2] = { time, time_step };
+   file.write((const char*) header, sizeof(header));
+   file.write((const char*) times, sizeof(times));
+
+#ifdef MFEM_USE_MPI
+   ParMesh *pmesh = dynamic_cast<ParMesh*>(mesh);
+   if (pmesh)
+   {
+      pmesh->ParPrintBinary(file);
+   }
+   else
+#endif
+   {
+      mesh->PrintBinary(file);
+   }
+
+   // The fields are saved without the sign changes of ParGridFunction::Save()
+   // since they are loaded on the same (local) mesh
+   file << "\nfields " << field_map.NumFields() << '\n';
+   for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+   {
+      file << it->first << '\n';
+      it->second->GridFunction::SaveBinary(file);
+   }
+   file << "\nqfields " << q_field_map.NumFields() << '\n';
+   for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+        ++it)
+   {
+      file << it->first << '\n';
+      it->second->SaveBinary(file);
+   }
+   if (!file)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error writing restart file: " << file_name);
+   }
+}
+
+void RestartDataCollection::Load(int cycle_)
+{
+   DeleteAll();
+   error = NO_ERROR;
+   cycle = cycle_;
+
+   std::string file_name = GetRestartFileName();
+   named_ifgzstream file(file_name);
+   std::string ident;
+   int64_t header[4] = { 0, 0, 0, 0 };
+   double times[2] = { 0.0, 0.0 };
+   if (!file)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Unable to open restart file: " << file_name);
+   }
+   else
+   {
+      getline(file, ident);
+      file.read((char*) header, sizeof(header));
+      file.read((char*) times, sizeof(times));
+      if (!file || ident != "MFEM restart v1.0" ||
+          header[0] != 0x0102030405060708)
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Invalid restart file: " << file_name);
+      }
+      else if (header[3] != num_procs)
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Processor number mismatch: restart file: "
+                      << header[3] << ", MPI_comm: " << num_procs);
+      }
+   }
+#ifdef MFEM_USE_MPI
+   // The parallel mesh is loaded collectively, so all processors must agree
+   if (m_comm != MPI_COMM_NULL)
+   {
+      int err = error;
+      MPI_Allreduce(&err, &error, 1, MPI_INT, MPI_MAX, m_comm);
+   }
+#endif
+   if (error) { return; }
+   cycle = header[1];
+   time = times[0];
+   time_step = times[1];
+
+   LoadMesh(file, header[2]);
+   if (!error)
+   {
+      LoadFields(file);
+   }
+   if (error)
+   {
+      DeleteAll();
+   }
+}
+
+void RestartDataCollection::LoadMesh(std::istream &in, bool parallel)
+{
+   if (!parallel)
+   {
+      mesh = new Mesh(in, 1, 0, false);
+      serial = true;
+   }
+   else
+   {
+#ifdef MFEM_USE_MPI
+      if (m_comm == MPI_COMM_NULL)
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Cannot load a parallel restart file without MPI"
+                      " communicator");
+         return;
+      }
+      // Do not refine, to keep the element orientations of the saved mesh
+      mesh = new ParMesh(m_comm, in, false);
+      serial = false;
+#else
+      error = READ_ERROR;
+      MFEM_WARNING("Reading parallel format in serial is not supported");
+      return;
+#endif
+   }
+   own_data = true;
+}
+
+void RestartDataCollection::LoadFields(std::istream &in)
+{
+#ifdef MFEM_USE_MPI
+   ParMesh *pmesh = dynamic_cast<ParMesh*>(mesh);
+#endif
+   std::string ident, field_name;
+   int num_fields;
+   in >> ident >> num_fields;
+   MFEM_VERIFY(ident == "fields", "invalid restart file");
+   for (int i = 0; i < num_fields; i++)
+   {
+      in >> std::ws;
+      getline(in, field_name);
+      GridFunction *gf;
+#ifdef MFEM_USE_MPI
+      if (pmesh)
+      {
+         gf = new ParGridFunction(pmesh, in);
+      }
+      else
+#endif
+      {
+         gf = new GridFunction(mesh, in);
+      }
+      field_map.Register(field_name, gf, own_data);
+   }
+   in >> ident >> num_fields;
+   MFEM_VERIFY(ident == "qfields", "invalid restart file");
+   for (int i = 0; i < num_fields; i++)
+   {
+      in >> std::ws;
+      getline(in, field_name);
+      q_field_map.Register(field_name, new QuadratureFunction(mesh, in),
+                           own_data);
+   }
+   if (!in)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Error reading the fields of the restart file");
+   }
+}
+
 }  // end namespace MFEM
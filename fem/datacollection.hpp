@@ -545,5 +545,60 @@ public:
    virtual void Load(int cycle_ = 0) override;
 };
 
+
+/// Data collection for checkpoint/restart with one binary file per MPI rank.
+/** The mesh, all registered fields and q-fields, and the cycle, time and time
+    step are written by Save() to a single binary file per rank, named
+    "restart.<rank>" in the collection directory. Load() restores them without
+    any partitioning or recomputation of the parallel group topology, see
+    ParMesh::ParPrintBinary(), so a parallel collection has to be loaded on the
+    same number of MPI ranks that saved it. The field data is saved as is, i.e.
+    without the orientation sign changes of ParGridFunction::Save(), and after
+    loading each field has its own (Par)FiniteElementSpace.
+
+    For nonconforming meshes, the refinement hierarchy of the NCMesh, or of the
+    ParNCMesh in parallel, is saved with the mesh, see Mesh::PrintBinary(), so
+    the loaded mesh can be refined and derefined further. NURBS meshes are not
+    supported. */
+class RestartDataCollection : public DataCollection
+{
+protected:
+   std::string GetRestartFileName() const
+   { return GetFieldFileName("restart"); }
+
+   // Helper functions for Load()
+   void LoadMesh(std::istream &in, bool parallel);
+   void LoadFields(std::istream &in);
+
+public:
+   /// Constructor. The collection name is used when saving the data.
+   /** If @a mesh_ is NULL, then the mesh can be set later by calling either
+       SetMesh() or Load(). The latter works only in serial. */
+   RestartDataCollection(const std::string& collection_name,
+                         Mesh *mesh_ = NULL);
+
+#ifdef MFEM_USE_MPI
+   /// Construct a parallel RestartDataCollection to be loaded from files.
+   /** Before loading the collection with Load(), some parameters in the
+       collection can be adjusted, e.g. SetPadDigits(), SetPrefixPath(), etc. */
+   RestartDataCollection(MPI_Comm comm, const std::string& collection_name,
+                         Mesh *mesh_ = NULL);
+#endif
+
+   /// Set/change the mesh associated with the collection
+   virtual void SetMesh(Mesh *new_mesh) override;
+
+#ifdef MFEM_USE_MPI
+   /// Set/change the mesh associated with the collection.
+   virtual void SetMesh(MPI_Comm comm, Mesh *new_mesh) override;
+#endif
+
+   /// Save the mesh and all fields to the restart file of this rank.
+   virtual void Save() override;
+
+   /// Load the collection from the restart file of this rank.
+   virtual void Load(int cycle_ = 0) override;
+};
+
 }
 #endif
@@ -40,6 +40,7 @@
 #include "transfer.hpp"
 #include "fespacehierarchy.hpp"
 #include "multigrid.hpp"
+#include "lor.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -980,9 +980,13 @@ public:
    virtual const Operator &BackwardOperator();
 };
 
+/** @brief Return true if the elements of @a fes use tensor product bases, and
+    all have the same geometry. */
 inline bool UsesTensorBasis(const FiniteElementSpace& fes)
 {
-   return dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
+   const Mesh *mesh = fes.GetMesh();
+   return mesh->GetNumGeometries(mesh->Dimension()) <= 1 &&
+          dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
 }
 
 }
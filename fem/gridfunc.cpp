@@ -14,6 +14,7 @@
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 
 #include <limits>
 #include <cstring>
@@ -27,6 +28,31 @@ namespace mfem
 
 using namespace std;
 
+// Write the values of v in the binary format of GridFunction::SaveBinary().
+static void SaveBinaryData(std::ostream &out, const Vector &v)
+{
+   out << "binary_data\n";
+   bin_io::write<int64_t>(out, v.Size());
+   out.write(reinterpret_cast<const char*>(v.HostRead()),
+             v.Size()*sizeof(double));
+   out.flush();
+}
+
+// Read the values written by SaveBinaryData() into v, which is resized to size.
+static void LoadBinaryData(std::istream &in, Vector &v, int size)
+{
+   string buff;
+   getline(in, buff);
+   filter_dos(buff);
+   MFEM_VERIFY(buff == "binary_data", "unknown section: " << buff);
+   const int64_t data_size = bin_io::read<int64_t>(in);
+   MFEM_VERIFY(data_size == size, "invalid binary data size: " << data_size
+               << ", expected: " << size);
+   v.SetSize(size);
+   in.read(reinterpret_cast<char*>(v.HostWrite()), size*sizeof(double));
+   MFEM_VERIFY(in, "error reading binary data");
+}
+
 GridFunction::GridFunction(Mesh *m, std::istream &input)
    : Vector()
 {
@@ -54,6 +80,10 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
          MFEM_ABORT("unknown section: " << buff);
       }
    }
+   else if (next_char == 'b') // First letter of "binary_data"
+   {
+      LoadBinaryData(input, *this, fes->GetVSize());
+   }
    else
    {
       Vector::Load(input, fes->GetVSize());
@@ -3318,6 +3348,14 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::SaveBinary(std::ostream &out) const
+{
+   MFEM_VERIFY(!fes->GetNURBSext(), "NURBS spaces are not supported");
+   fes->Save(out);
+   out << '\n';
+   SaveBinaryData(out, *this);
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &out,
                         const std::string& variable_name,
@@ -3538,7 +3576,15 @@ QuadratureFunction::QuadratureFunction(Mesh *mesh, std::istream &in)
    in >> ident; MFEM_VERIFY(ident == "VDim:", msg);
    in >> vdim;
 
-   Load(in, vdim*qspace->GetSize());
+   in >> std::ws;
+   if (in.peek() == 'b') // First letter of "binary_data"
+   {
+      LoadBinaryData(in, *this, vdim*qspace->GetSize());
+   }
+   else
+   {
+      Load(in, vdim*qspace->GetSize());
+   }
 }
 
 QuadratureFunction & QuadratureFunction::operator=(double value)
@@ -3568,6 +3614,14 @@ void QuadratureFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void QuadratureFunction::SaveBinary(std::ostream &out) const
+{
+   qspace->Save(out);
+   out << "VDim: " << vdim << '\n'
+       << '\n';
+   SaveBinaryData(out, *this);
+}
+
 std::ostream &operator<<(std::ostream &out, const QuadratureFunction &qf)
 {
    qf.Save(out);
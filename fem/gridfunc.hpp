@@ -593,6 +593,14 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Save the GridFunction to an output stream, writing the values in
+       binary form (native byte order). */
+   /** The FiniteElementSpace header is the same as in Save(); it is followed by
+       the line "binary_data", the number of values as a 64-bit integer, and the
+       raw values. The format is detected automatically by the constructor
+       GridFunction(Mesh*, std::istream&). NURBS spaces are not supported. */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
@@ -769,6 +777,10 @@ public:
 
    /// Write the QuadratureFunction to the stream @a out.
    void Save(std::ostream &out) const;
+
+   /** @brief Write the QuadratureFunction to the stream @a out, with the values
+       in binary form, see GridFunction::SaveBinary(). */
+   void SaveBinary(std::ostream &out) const;
 };
 
 /// Overload operator<< for std::ostream and QuadratureFunction.
@@ -18,6 +18,10 @@
 #include "fem.hpp"
 #include <cmath>
 
+#if defined(MFEM_USE_LEGACY_OPENMP) || defined(MFEM_USE_OPENMP)
+#include <mutex>
+#endif
+
 #ifdef MFEM_USE_MPFR
 #include <mpfr.h>
 #endif
@@ -27,6 +31,14 @@ using namespace std;
 namespace mfem
 {
 
+#if defined(MFEM_USE_LEGACY_OPENMP) || defined(MFEM_USE_OPENMP)
+// Guards the rule arrays of all IntegrationRules objects in threaded regions,
+// e.g. the colored assembly of BilinearForm. The lookup is guarded too, since
+// another thread may resize the arrays. The mutex is recursive because some
+// rules are generated from other rules, e.g. the prism rules.
+static std::recursive_mutex ir_mutex;
+#endif
+
 IntegrationRule::IntegrationRule(IntegrationRule &irx, IntegrationRule &iry)
 {
    int i, j, nx, ny;
@@ -935,24 +947,19 @@ const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
       Order = 0;
    }
 
+#if defined(MFEM_USE_LEGACY_OPENMP) || defined(MFEM_USE_OPENMP)
+   std::lock_guard<std::recursive_mutex> lock(ir_mutex);
+#endif
    if (!HaveIntRule(*ir_array, Order))
    {
-#ifdef MFEM_USE_LEGACY_OPENMP
-      #pragma omp critical
-#endif
+      IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
+      int RealOrder = Order;
+      while (RealOrder+1 < ir_array->Size() &&
+      /*  */ (*ir_array)[RealOrder+1] == ir)
       {
-         if (!HaveIntRule(*ir_array, Order))
-         {
-            IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
-            int RealOrder = Order;
-            while (RealOrder+1 < ir_array->Size() &&
-            /*  */ (*ir_array)[RealOrder+1] == ir)
-            {
-               RealOrder++;
-            }
-            ir->SetOrder(RealOrder);
-         }
+         RealOrder++;
       }
+      ir->SetOrder(RealOrder);
    }
 
    return *(*ir_array)[Order];
@@ -976,6 +983,9 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
          ir_array = NULL;
    }
 
+#if defined(MFEM_USE_LEGACY_OPENMP) || defined(MFEM_USE_OPENMP)
+   std::lock_guard<std::recursive_mutex> lock(ir_mutex);
+#endif
    if (HaveIntRule(*ir_array, Order))
    {
       MFEM_ABORT("Overwriting set rules is not supported!");
@@ -24,6 +24,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   ext = NULL;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -31,6 +32,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    dlfi_delta = lf->dlfi_delta;
 
    blfi = lf->blfi;
+   blfi_marker = lf->blfi_marker;
 
    flfi = lf->flfi;
    flfi_marker = lf->flfi_marker;
@@ -76,6 +78,53 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+void LinearForm::UseFastAssembly(bool use_fa)
+{
+   if (use_fa && ext == NULL) { ext = new LinearFormExtension(this); }
+   if (!use_fa) { delete ext; ext = NULL; }
+}
+
+bool LinearForm::SupportsDevice() const
+{
+   if (flfi.Size()) { return false; }
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice(*fes)) { return false; }
+   }
+   for (int k = 0; k < blfi.Size(); k++)
+   {
+      if (!blfi[k]->SupportsDevice(*fes)) { return false; }
+   }
+   const Mesh &mesh = *fes->GetMesh();
+   if (mesh.NURBSext || fes->GetNURBSext()) { return false; }
+   if (mesh.Dimension() != mesh.SpaceDimension()) { return false; }
+   if (fes->GetNE() == 0) { return true; }
+   // Mixed meshes are not supported
+   if (mesh.GetNumGeometries(mesh.Dimension()) > 1) { return false; }
+   if (blfi.Size())
+   {
+      // Boundary integrators require an H1 face restriction for the space and
+      // a face restriction for the mesh nodes
+      if (mesh.Dimension() < 2 || !mesh.Conforming() || fes->IsDGSpace())
+      {
+         return false;
+      }
+      const FiniteElementSpace *nfes =
+         mesh.GetNodes() ? mesh.GetNodes()->FESpace() : NULL;
+      const FiniteElementSpace *spaces[2] = { fes, nfes };
+      for (int i = 0; i < 2; i++)
+      {
+         if (!spaces[i] || (i > 0 && spaces[i]->IsDGSpace())) { continue; }
+         const TensorBasisElement *tfe =
+            dynamic_cast<const TensorBasisElement*>(spaces[i]->GetFE(0));
+         if (tfe == NULL ||
+             (tfe->GetBasisType() != BasisType::GaussLobatto &&
+              tfe->GetBasisType() != BasisType::Positive)) { return false; }
+      }
+   }
+   return true;
+}
+
 void LinearForm::Assemble()
 {
    Array<int> vdofs;
@@ -86,6 +135,13 @@ void LinearForm::Assemble()
 
    Vector::operator=(0.0);
 
+   if (ext && SupportsDevice())
+   {
+      ext->Assemble();
+      AssembleDelta();
+      return;
+   }
+
    // The above operation is executed on device because of UseDevice().
    // The first use of AddElementVector() below will move it back to host
    // because both 'vdofs' and 'elemvect' are on host.
@@ -202,6 +258,7 @@ void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
    NewMemoryAndSize(Memory<double>(v.GetMemory(), v_offset, f->GetVSize()),
                     f->GetVSize(), false);
    ResetDeltaLocations();
+   if (ext) { ext->Update(); }
 }
 
 void LinearForm::AssembleDelta()
@@ -259,6 +316,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
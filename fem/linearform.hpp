@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "lininteg.hpp"
 #include "gridfunc.hpp"
+#include "linearform_ext.hpp"
 
 namespace mfem
 {
@@ -56,6 +57,9 @@ protected:
    /// Force (re)computation of delta locations.
    void ResetDeltaLocations() { dlfi_delta_elem_id.SetSize(0); }
 
+   /// Extension for supporting device assembly, see UseFastAssembly().
+   LinearFormExtension *ext;
+
 private:
    /// Copy construction is not supported; body is undefined.
    LinearForm(const LinearForm &);
@@ -64,7 +68,7 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   { fes = f; extern_lfs = 0; ext = NULL; UseDevice(true); }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +83,7 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm() { fes = NULL; extern_lfs = 0; ext = NULL; UseDevice(true); }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +91,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   { fes = f; extern_lfs = 0; ext = NULL; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -144,6 +148,11 @@ public:
    /// Access all integrators added with AddBoundaryIntegrator().
    Array<LinearFormIntegrator*> *GetBLFI() { return &blfi; }
 
+   /** @brief Access all boundary markers added with AddBoundaryIntegrator().
+       If no marker was specified when the integrator was added, the
+       corresponding pointer (to Array<int>) will be NULL. */
+   Array<Array<int>*> *GetBLFI_Marker() { return &blfi_marker; }
+
    /// Access all integrators added with AddBdrFaceIntegrator().
    Array<LinearFormIntegrator*> *GetFLFI() { return &flfi; }
 
@@ -152,7 +161,26 @@ public:
        corresponding pointer (to Array<int>) will be NULL. */
    Array<Array<int>*> *GetFLFI_Marker() { return &flfi_marker; }
 
+   /** @brief Enable or disable the device assembly of the domain and boundary
+       integrators, see SupportsDevice(). */
+   /** When enabled, Assemble() evaluates the integrators at all quadrature
+       points at once and scatters the resulting E-vectors with the element and
+       boundary face restrictions of the FiniteElementSpace, instead of looping
+       over the elements on the host. Disabled by default. */
+   void UseFastAssembly(bool use_fa);
+
+   /** @brief Return true if all integrators and the FiniteElementSpace support
+       the device assembly enabled with UseFastAssembly(). */
+   /** Currently supported are DomainLFIntegrator, VectorDomainLFIntegrator,
+       BoundaryLFIntegrator and VectorBoundaryLFIntegrator (the latter two only
+       on conforming meshes with tensor product Gauss-Lobatto or Bernstein H1
+       elements), on meshes with a single element type and no NURBS. Delta
+       coefficients are assembled on the host as before. */
+   bool SupportsDevice() const;
+
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
+   /** If UseFastAssembly() was enabled and SupportsDevice() returns true, the
+       domain and boundary integrators are assembled on the device. */
    void Assemble();
 
    /// Assembles delta functions of the linear form
@@ -163,11 +191,14 @@ public:
        updated, e.g. after its associated Mesh object has been refined.
 
        @note This method does not perform assembly. */
-   void Update() { SetSize(fes->GetVSize()); ResetDeltaLocations(); }
+   void Update()
+   {
+      SetSize(fes->GetVSize()); ResetDeltaLocations();
+      if (ext) { ext->Update(); }
+   }
 
    /// Associate a new FE space, @a *f, with this object and Update() it. */
-   void Update(FiniteElementSpace *f)
-   { fes = f; SetSize(f->GetVSize()); ResetDeltaLocations(); }
+   void Update(FiniteElementSpace *f) { fes = f; Update(); }
 
    /** @brief Associate a new FE space, @a *f, with this object and use the data
        of @a v, offset by @a v_offset, to initialize this object's Vector::data.
@@ -0,0 +1,115 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class LinearFormExtension
+
+#include "linearform.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *lf)
+   : lf(lf), elem_restrict(NULL), bdr_restrict(NULL) { }
+
+void LinearFormExtension::Update()
+{
+   elem_restrict = NULL;
+   bdr_restrict = NULL;
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+
+   Array<LinearFormIntegrator*> &dlfi = *lf->GetDLFI();
+   if (dlfi.Size())
+   {
+      if (elem_restrict == NULL)
+      {
+         // Non-tensor elements use the native ordering, see AssembleDevice()
+         const bool tensor = fes.GetNE() > 0 &&
+            dynamic_cast<const TensorBasisElement*>(fes.GetFE(0)) != NULL;
+         const ElementDofOrdering ordering = tensor ?
+                                             ElementDofOrdering::LEXICOGRAPHIC :
+                                             ElementDofOrdering::NATIVE;
+         elem_restrict = fes.GetElementRestriction(ordering);
+         markers.SetSize(fes.GetNE());
+         markers = 1;
+      }
+      b.SetSize(elem_restrict->Height());
+      b.UseDevice(true);
+      b = 0.0;
+      for (int k = 0; k < dlfi.Size(); k++)
+      {
+         dlfi[k]->AssembleDevice(fes, markers, b);
+      }
+      // The LinearForm is zero on entry, so it can be overwritten here.
+      elem_restrict->MultTranspose(b, *lf);
+   }
+
+   Array<LinearFormIntegrator*> &blfi = *lf->GetBLFI();
+   if (blfi.Size())
+   {
+      Mesh &mesh = *fes.GetMesh();
+      if (bdr_restrict == NULL)
+      {
+         const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
+         bdr_restrict =
+            fes.GetFaceRestriction(ordering, FaceType::Boundary);
+         Array<int> face_to_be(fes.GetNF());
+         face_to_be = -1;
+         for (int i = 0; i < mesh.GetNBE(); i++)
+         {
+            face_to_be[mesh.GetBdrElementEdgeIndex(i)] = i;
+         }
+         bdr_face_elements.SetSize(fes.GetNFbyType(FaceType::Boundary));
+         int f_ind = 0;
+         for (int f = 0; f < fes.GetNF(); f++)
+         {
+            int e1, e2;
+            int inf1, inf2;
+            mesh.GetFaceElements(f, &e1, &e2);
+            mesh.GetFaceInfos(f, &inf1, &inf2);
+            if (e2 >= 0 || inf2 >= 0) { continue; }
+            bdr_face_elements[f_ind++] = face_to_be[f];
+         }
+         MFEM_VERIFY(f_ind == bdr_face_elements.Size(),
+                     "Incorrect number of faces.");
+         bdr_face_markers.SetSize(f_ind);
+      }
+      bdr_b.SetSize(bdr_restrict->Height());
+      bdr_b.UseDevice(true);
+      bdr_b = 0.0;
+      Array<Array<int>*> &blfi_marker = *lf->GetBLFI_Marker();
+      for (int k = 0; k < blfi.Size(); k++)
+      {
+         const Array<int> *bdr_marker = blfi_marker[k];
+         MFEM_ASSERT(bdr_marker == NULL ||
+                     bdr_marker->Size() == (mesh.bdr_attributes.Size() ?
+                                            mesh.bdr_attributes.Max() : 0),
+                     "invalid boundary marker for boundary integrator #"
+                     << k << ", counting from zero");
+         int *m = bdr_face_markers.HostWrite();
+         for (int i = 0; i < bdr_face_markers.Size(); i++)
+         {
+            const int be = bdr_face_elements[i];
+            m[i] = (be >= 0) && (bdr_marker == NULL ||
+                                 (*bdr_marker)[mesh.GetBdrAttribute(be)-1]);
+         }
+         blfi[k]->AssembleBoundaryDevice(fes, bdr_face_elements,
+                                         bdr_face_markers, bdr_b);
+      }
+      // The boundary face restriction adds to the LinearForm.
+      bdr_restrict->MultTranspose(bdr_b, *lf);
+   }
+}
+
+}
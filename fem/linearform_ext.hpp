@@ -0,0 +1,64 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LINEARFORM_EXT
+#define MFEM_LINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+
+/// Class extending the LinearForm class to support assembly on devices.
+/** The domain integrators are assembled into element E-vectors which are then
+    scattered with the element restriction, using lexicographic ordering for
+    tensor product elements and native ordering otherwise. The boundary
+    integrators are assembled into boundary face E-vectors which are scattered
+    with the lexicographic boundary face restriction. */
+class LinearFormExtension
+{
+protected:
+   LinearForm *lf; ///< Not owned
+
+   /// Element markers (all ones) used by the domain integrators.
+   Array<int> markers;
+
+   /** @brief Boundary elements associated with the boundary faces (in face
+       restriction order), -1 if there is no such element. */
+   Array<int> bdr_face_elements;
+
+   /// Boundary face markers, set for each boundary integrator.
+   Array<int> bdr_face_markers;
+
+   /// Element and boundary face E-vectors.
+   Vector b, bdr_b;
+
+   /// Element and boundary face restrictions.
+   const Operator *elem_restrict, *bdr_restrict; // Not owned
+
+public:
+   LinearFormExtension(LinearForm *lf);
+
+   /** @brief Invalidate the data depending on the FiniteElementSpace of the
+       LinearForm, e.g. after the space was updated. */
+   void Update();
+
+   /// Assemble the domain and boundary integrators of the LinearForm.
+   /** The LinearForm is expected to be zero on entry. */
+   void Assemble();
+};
+
+}
+
+#endif
@@ -22,6 +22,21 @@ void LinearFormIntegrator::AssembleRHSElementVect(
    mfem_error("LinearFormIntegrator::AssembleRHSElementVect(...)");
 }
 
+void LinearFormIntegrator::AssembleDevice(const FiniteElementSpace&,
+                                          const Array<int>&, Vector&)
+{
+   mfem_error ("LinearFormIntegrator::AssembleDevice(...)\n"
+               "   is not implemented for this class.");
+}
+
+void LinearFormIntegrator::AssembleBoundaryDevice(const FiniteElementSpace&,
+                                                  const Array<int>&,
+                                                  const Array<int>&, Vector&)
+{
+   mfem_error ("LinearFormIntegrator::AssembleBoundaryDevice(...)\n"
+               "   is not implemented for this class.");
+}
+
 
 void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
                                                 ElementTransformation &Tr,
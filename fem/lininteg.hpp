@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -36,6 +38,35 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /** @brief Method probing for device assembly support in the space @a fes,
+       see AssembleDevice() and AssembleBoundaryDevice(). */
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const
+   { return false; }
+
+   /** @brief Method defining the device assembly of a domain integrator: add
+       the contributions of all marked elements to the E-vector @a b. */
+   /** The element E-vector @a b has layout (ND x VDIM x NE), ordered
+       lexicographically for tensor product elements and natively otherwise,
+       and @a markers is an array of size NE. Elements with zero markers are
+       skipped. General coefficients are still evaluated on the host, at all
+       points at once; only constant coefficients are handled entirely on the
+       device. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
+   /** @brief Method defining the device assembly of a boundary integrator: add
+       the contributions of all marked boundary faces to the E-vector @a b. */
+   /** The boundary face E-vector @a b has layout (ND x VDIM x NF) and is
+       obtained with the lexicographic boundary face restriction of @a fes.
+       The arrays @a bdr_face_elements and @a markers have one entry per
+       boundary face: the associated boundary element (-1 if there is none)
+       and the marker. Faces with zero markers are skipped. General
+       coefficients are evaluated on the host with the transformations of the
+       boundary elements, so that they see the boundary attributes. */
+   virtual void AssembleBoundaryDevice(const FiniteElementSpace &fes,
+                                       const Array<int> &bdr_face_elements,
+                                       const Array<int> &markers, Vector &b);
+
    virtual void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -116,6 +147,12 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   /// Method defining the device assembly, see LinearForm::UseFastAssembly().
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -166,6 +203,13 @@ public:
    virtual void AssembleRHSElementVect(const FiniteElement &el,
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
+
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   /// Method defining the device assembly, see LinearForm::UseFastAssembly().
+   virtual void AssembleBoundaryDevice(const FiniteElementSpace &fes,
+                                       const Array<int> &bdr_face_elements,
+                                       const Array<int> &markers, Vector &b);
 };
 
 /// Class for boundary integration \f$ L(v) = (g \cdot n, v) \f$
@@ -227,6 +271,12 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   /// Method defining the device assembly, see LinearForm::UseFastAssembly().
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -253,6 +303,13 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   virtual bool SupportsDevice(const FiniteElementSpace &fes) const;
+
+   /// Method defining the device assembly, see LinearForm::UseFastAssembly().
+   virtual void AssembleBoundaryDevice(const FiniteElementSpace &fes,
+                                       const Array<int> &bdr_face_elements,
+                                       const Array<int> &markers, Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -0,0 +1,477 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "lininteg.hpp"
+#include "fespace.hpp"
+#include "restriction.hpp"
+
+namespace mfem
+{
+
+// Device assembly of linear form integrators
+
+// Weighted quadrature point data, D(q,c,e) = M(e) W(q) detJ(q,e) C(c,q,e),
+// where C is either a constant vector of size VDIM or a (VDIM x NQ x NE) array.
+static void LFQuadratureData(const int vdim,
+                             const int NQ,
+                             const int NE,
+                             const Array<int> &markers,
+                             const Array<double> &w,
+                             const Vector &det,
+                             const Vector &coeff,
+                             Vector &qd)
+{
+   const bool const_c = coeff.Size() == vdim;
+   auto M = markers.Read();
+   auto W = w.Read();
+   auto detJ = Reshape(det.Read(), NQ, NE);
+   auto C = const_c ? Reshape(coeff.Read(), vdim, 1, 1) :
+            Reshape(coeff.Read(), vdim, NQ, NE);
+   auto D = Reshape(qd.Write(), NQ, vdim, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      const double wq = M[e] ? W[q] * detJ(q,e) : 0.0;
+      for (int c = 0; c < vdim; ++c)
+      {
+         D(q,c,e) = wq * (const_c ? C(c,0,0) : C(c,q,e));
+      }
+   });
+}
+
+// Y += B^T D, with B given as a (NQ x ND) array. This is used both for FULL
+// DofToQuad maps and for 1D tensor maps.
+static void LFApplyBt(const int vdim,
+                      const int NE,
+                      const int ND,
+                      const int NQ,
+                      const Array<double> &b,
+                      const Vector &qd,
+                      Vector &y)
+{
+   auto B = Reshape(b.Read(), NQ, ND);
+   auto D = Reshape(qd.Read(), NQ, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int d = 0; d < ND; ++d)
+         {
+            double s = 0.0;
+            for (int q = 0; q < NQ; ++q)
+            {
+               s += B(q,d) * D(q,c,e);
+            }
+            Y(d,c,e) += s;
+         }
+      }
+   });
+}
+
+// Sum-factorized Y += B^T D for 2D tensor product elements.
+static void LFApplyBt2D(const int vdim,
+                        const int NE,
+                        const int d1d,
+                        const int q1d,
+                        const Array<double> &b,
+                        const Vector &qd,
+                        Vector &y)
+{
+   MFEM_VERIFY(d1d <= MAX_D1D, "");
+   MFEM_VERIFY(q1d <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), q1d, d1d);
+   auto D = Reshape(qd.Read(), q1d, q1d, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), d1d, d1d, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int max_D1D = MAX_D1D;
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = D(qx,qy,c,e);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += B(qx,dx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = B(qy,dy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Y(dx,dy,c,e) += q2d * sol_x[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+// Sum-factorized Y += B^T D for 3D tensor product elements.
+static void LFApplyBt3D(const int vdim,
+                        const int NE,
+                        const int d1d,
+                        const int q1d,
+                        const Array<double> &b,
+                        const Vector &qd,
+                        Vector &y)
+{
+   MFEM_VERIFY(d1d <= MAX_D1D, "");
+   MFEM_VERIFY(q1d <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), q1d, d1d);
+   auto D = Reshape(qd.Read(), q1d, q1d, q1d, vdim, NE);
+   auto Y = Reshape(y.ReadWrite(), d1d, d1d, d1d, vdim, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = d1d;
+      const int Q1D = q1d;
+      constexpr int max_D1D = MAX_D1D;
+      for (int c = 0; c < vdim; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double sol_xy[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] = 0.0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double sol_x[max_D1D];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] = 0.0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double s = D(qx,qy,qz,c,e);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx] += B(qx,dx) * s;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy * sol_x[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = B(qz,dz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     Y(dx,dy,dz,c,e) += wz * sol_xy[dy][dx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Add to the E-vector @a b the products of the basis functions with the
+// weighted quadrature data @a qd of NE entities of dimension @a dim.
+static void LFAssemble(const int dim,
+                       const int vdim,
+                       const int NE,
+                       const DofToQuad &maps,
+                       const Vector &qd,
+                       Vector &b)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   if (maps.mode == DofToQuad::TENSOR && dim == 2)
+   {
+      LFApplyBt2D(vdim, NE, ND, NQ, maps.B, qd, b);
+   }
+   else if (maps.mode == DofToQuad::TENSOR && dim == 3)
+   {
+      LFApplyBt3D(vdim, NE, ND, NQ, maps.B, qd, b);
+   }
+   else
+   {
+      MFEM_VERIFY(maps.mode == DofToQuad::FULL || dim == 1, "");
+      LFApplyBt(vdim, NE, ND, NQ, maps.B, qd, b);
+   }
+}
+
+static void DomainLFAssemble(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const int vdim,
+                             const Array<int> &markers,
+                             const Vector &coeff,
+                             Vector &b)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   const int NE = fes.GetNE();
+   const int NQ = ir.GetNPoints();
+   const FiniteElement &el = *fes.GetFE(0);
+   // Tensor product elements use the lexicographic E-vector ordering
+   const bool tensor = dynamic_cast<const TensorBasisElement*>(&el) != NULL;
+   const DofToQuad &maps =
+      el.GetDofToQuad(ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+   Vector qd(NQ*vdim*NE);
+   LFQuadratureData(vdim, NQ, NE, markers, ir.GetWeights(), geom->detJ,
+                    coeff, qd);
+   LFAssemble(dim, vdim, NE, maps, qd, b);
+}
+
+// Map the reference point @a ip of face @a f to the reference point @a bip of
+// the boundary element @a be on that face. The vertices of the face and of the
+// boundary element may be ordered differently, so the map is the symmetry of
+// the reference geometry taking the face vertices to the boundary element
+// ones. It is affine and given by the images of the origin and unit points.
+static void FaceToBdrElementPoint(const Mesh &mesh, const int f, const int be,
+                                  const IntegrationPoint &ip,
+                                  IntegrationPoint &bip)
+{
+   bip = ip;
+   const int fdim = mesh.Dimension() - 1;
+   if (fdim == 0) { return; }
+   Array<int> fv, bv;
+   mesh.GetFaceVertices(f, fv);
+   mesh.GetBdrElementVertices(be, bv);
+   const Geometry::Type geom = mesh.GetFaceBaseGeometry(f);
+   const IntegrationRule &rv = *Geometries.GetVertices(geom);
+   // Face vertices at the unit points (1,0) and (0,1)
+   const int unit[2] = { 1, (geom == Geometry::SQUARE) ? 3 : 2 };
+   const IntegrationPoint &o = rv.IntPoint(bv.Find(fv[0]));
+   const double p[2] = { ip.x, ip.y };
+   bip.x = o.x;
+   bip.y = o.y;
+   for (int d = 0; d < fdim; d++)
+   {
+      const IntegrationPoint &u = rv.IntPoint(bv.Find(fv[unit[d]]));
+      bip.x += p[d] * (u.x - o.x);
+      bip.y += p[d] * (u.y - o.y);
+   }
+}
+
+// Evaluate @a Q (or @a VQ) at the quadrature points of all boundary faces,
+// ordered as the lexicographic boundary face E-vectors. The coefficients are
+// evaluated with the transformations of the boundary elements in
+// @a bdr_face_elements, so that they see the boundary attributes; faces
+// without a boundary element get zero values. General coefficients can only
+// be evaluated on the host, so this loops over the faces on the host and the
+// result is moved to the device by the assembly kernels.
+static void BoundaryLFEvalCoefficient(const FiniteElementSpace &fes,
+                                      const IntegrationRule &ir,
+                                      const int q1d,
+                                      const Array<int> &bdr_face_elements,
+                                      Coefficient *Q,
+                                      VectorCoefficient *VQ,
+                                      Vector &coeff)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int dim = mesh.Dimension();
+   const int NF = fes.GetNFbyType(FaceType::Boundary);
+   const int NQ = ir.GetNPoints();
+   const int vdim = Q ? 1 : VQ->GetVDim();
+   MFEM_VERIFY(bdr_face_elements.Size() == NF, "Incorrect number of faces.");
+   coeff.SetSize(vdim*NQ*NF);
+   auto C = Reshape(coeff.HostWrite(), vdim, NQ, NF);
+   Vector val(vdim);
+   IntegrationPoint bip;
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2;
+      int inf1, inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      if (e2 >= 0 || inf2 >= 0) { continue; }
+      const int face_id = inf1 / 64;
+      const int be = bdr_face_elements[f_ind];
+      ElementTransformation *T =
+         (be >= 0) ? mesh.GetBdrElementTransformation(be) : NULL;
+      for (int q = 0; q < NQ; ++q)
+      {
+         // Convert to lexicographic ordering
+         const int iq = ToLexOrdering(dim, face_id, q1d, q);
+         if (T == NULL)
+         {
+            for (int c = 0; c < vdim; ++c) { C(c,iq,f_ind) = 0.0; }
+            continue;
+         }
+         FaceToBdrElementPoint(mesh, f, be, ir.IntPoint(q), bip);
+         T->SetIntPoint(&bip);
+         if (Q) { C(0,iq,f_ind) = Q->Eval(*T, bip); continue; }
+         VQ->Eval(val, *T, bip);
+         for (int c = 0; c < vdim; ++c) { C(c,iq,f_ind) = val(c); }
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind == NF, "Incorrect number of faces.");
+}
+
+static void BoundaryLFAssemble(const FiniteElementSpace &fes,
+                               const IntegrationRule &ir,
+                               const DofToQuad &maps,
+                               const int vdim,
+                               const Array<int> &markers,
+                               const Vector &coeff,
+                               Vector &b)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int dim = mesh->Dimension();
+   const int NF = fes.GetNFbyType(FaceType::Boundary);
+   const int NQ = ir.GetNPoints();
+   const FaceGeometricFactors *geom =
+      mesh->GetFaceGeometricFactors(ir, FaceGeometricFactors::DETERMINANTS,
+                                    FaceType::Boundary);
+   Vector qd(NQ*vdim*NF);
+   LFQuadratureData(vdim, NQ, NF, markers, ir.GetWeights(), geom->detJ,
+                    coeff, qd);
+   LFAssemble(dim-1, vdim, NF, maps, qd, b);
+}
+
+bool DomainLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == 1;
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        const Array<int> &markers,
+                                        Vector &b)
+{
+   if (fes.GetNE() == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   Vector coeff;
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q.EvalAll(coeff, *fes.GetMesh(), *ir);
+   }
+   DomainLFAssemble(fes, *ir, 1, markers, coeff, b);
+}
+
+bool VectorDomainLFIntegrator::SupportsDevice(
+   const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == Q.GetVDim();
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              const Array<int> &markers,
+                                              Vector &b)
+{
+   if (fes.GetNE() == 0) { return; }
+   const int vdim = Q.GetVDim();
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2 * el.GetOrder());
+   Vector coeff;
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+   }
+   else
+   {
+      Q.EvalAll(coeff, *fes.GetMesh(), *ir);
+   }
+   DomainLFAssemble(fes, *ir, vdim, markers, coeff, b);
+}
+
+bool BoundaryLFIntegrator::SupportsDevice(const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == 1;
+}
+
+void BoundaryLFIntegrator::AssembleBoundaryDevice(
+   const FiniteElementSpace &fes, const Array<int> &bdr_face_elements,
+   const Array<int> &markers, Vector &b)
+{
+   if (fes.GetNFbyType(FaceType::Boundary) == 0) { return; }
+   const FiniteElement &el = *fes.GetFaceElement(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   const DofToQuad &maps = el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   Vector coeff;
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      BoundaryLFEvalCoefficient(fes, *ir, maps.nqpt, bdr_face_elements,
+                                &Q, NULL, coeff);
+   }
+   BoundaryLFAssemble(fes, *ir, maps, 1, markers, coeff, b);
+}
+
+bool VectorBoundaryLFIntegrator::SupportsDevice(
+   const FiniteElementSpace &fes) const
+{
+   return fes.GetVDim() == Q.GetVDim();
+}
+
+void VectorBoundaryLFIntegrator::AssembleBoundaryDevice(
+   const FiniteElementSpace &fes, const Array<int> &bdr_face_elements,
+   const Array<int> &markers, Vector &b)
+{
+   if (fes.GetNFbyType(FaceType::Boundary) == 0) { return; }
+   const int vdim = Q.GetVDim();
+   const FiniteElement &el = *fes.GetFaceElement(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2 * el.GetOrder());
+   const DofToQuad &maps = el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   Vector coeff;
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      coeff = cQ->GetVec();
+   }
+   else
+   {
+      BoundaryLFEvalCoefficient(fes, *ir, maps.nqpt, bdr_face_elements,
+                                NULL, &Q, coeff);
+   }
+   BoundaryLFAssemble(fes, *ir, maps, vdim, markers, coeff, b);
+}
+
+} // namespace mfem
@@ -0,0 +1,337 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the low-order-refined (LOR) discretizations
+
+#include "lor.hpp"
+
+namespace mfem
+{
+
+FiniteElementCollection *LORDiscretization::NewCollection(
+   const FiniteElementSpace &fes_ho, int &ref_factor)
+{
+   const FiniteElementCollection *fec_ho = fes_ho.FEColl();
+   const int dim = fes_ho.GetMesh()->Dimension();
+   MFEM_VERIFY(fes_ho.GetNE() > 0, "the mesh has no elements");
+   MFEM_VERIFY(fes_ho.Conforming(), "nonconforming meshes are not supported");
+   for (int el = 0; el < fes_ho.GetNE(); el++)
+   {
+      const Geometry::Type geom = fes_ho.GetMesh()->GetElementBaseGeometry(el);
+      MFEM_VERIFY(geom == Geometry::SEGMENT || geom == Geometry::SQUARE ||
+                  geom == Geometry::CUBE, "only segments, quadrilaterals and "
+                  "hexahedra are supported");
+   }
+   // The refinement factor is the number of intervals between the closed
+   // points of the high-order basis.
+   ref_factor = fes_ho.GetOrder(0);
+   if (dynamic_cast<const H1_FECollection*>(fec_ho))
+   {
+      return new H1_FECollection(1, dim);
+   }
+   else if (dynamic_cast<const ND_FECollection*>(fec_ho))
+   {
+      return new ND_FECollection(1, dim);
+   }
+   else if (dynamic_cast<const RT_FECollection*>(fec_ho))
+   {
+      return new RT_FECollection(0, dim);
+   }
+   MFEM_ABORT("only H1, ND and RT spaces are supported");
+   return NULL;
+}
+
+// For each DOF i of the high-order element fe_ho, find the sub-element sub[i]
+// of the refined element and the DOF dof[i] of the low-order element fe_lor in
+// that sub-element with a node on the same vertex, edge or face as the node of
+// i; sign[i] is the relative orientation of the two DOFs. The sub-elements are
+// given by their vertices in the reference element of fe_ho, pm(k).
+static void GetLORLocalDofMap(const FiniteElement &fe_ho,
+                              const FiniteElement &fe_lor,
+                              const DenseTensor &pm, Array<int> &sub,
+                              Array<int> &dof, Array<int> &sign)
+{
+   const double tol = 1e-10;
+   const int dim = fe_ho.GetDim();
+   const int ndof_ho = fe_ho.GetDof(), ndof_lor = fe_lor.GetDof();
+   const bool vector_fe = (fe_ho.GetRangeType() == FiniteElement::VECTOR);
+   // Vertices of the sub-elements in the directions of the axes
+   const int axis_vert[3] = { 1, 3, 4 };
+
+   const IntegrationRule &nodes_ho = fe_ho.GetNodes();
+   const IntegrationRule &nodes_lor = fe_lor.GetNodes();
+   DenseMatrix vshape_ho(ndof_ho, dim), vshape_lor(ndof_lor, dim);
+   DenseMatrix dir_lor(ndof_lor, dim);
+   if (vector_fe)
+   {
+      // Direction of the low-order shape functions at their nodes
+      for (int j = 0; j < ndof_lor; j++)
+      {
+         fe_lor.CalcVShape(nodes_lor.IntPoint(j), vshape_lor);
+         for (int d = 0; d < dim; d++) { dir_lor(j,d) = vshape_lor(j,d); }
+      }
+   }
+
+   sub.SetSize(ndof_ho);
+   dof.SetSize(ndof_ho);
+   sign.SetSize(ndof_ho);
+   double x[3], y[3], xl[3], h[3];
+   for (int i = 0; i < ndof_ho; i++)
+   {
+      const IntegrationPoint &ip = nodes_ho.IntPoint(i);
+      ip.Get(x, dim);
+      if (vector_fe) { fe_ho.CalcVShape(ip, vshape_ho); }
+      sub[i] = -1;
+      for (int k = 0; k < pm.SizeK() && sub[i] < 0; k++)
+      {
+         // The sub-elements are axis-aligned boxes in the reference element
+         const DenseMatrix &P = pm(k);
+         bool inside = true;
+         for (int d = 0; d < dim; d++)
+         {
+            h[d] = P(d,axis_vert[d]) - P(d,0);
+            y[d] = (x[d] - P(d,0))/h[d];
+            inside = inside && (y[d] > -tol) && (y[d] < 1.0 + tol);
+         }
+         if (!inside) { continue; }
+         for (int j = 0; j < ndof_lor; j++)
+         {
+            nodes_lor.IntPoint(j).Get(xl, dim);
+            bool match = true;
+            for (int d = 0; d < dim; d++)
+            {
+               const bool closed = (xl[d] < tol || xl[d] > 1.0 - tol);
+               match = match && (closed ? std::abs(y[d] - xl[d]) < tol :
+                                 (y[d] > tol && y[d] < 1.0 - tol));
+            }
+            int s = 1;
+            if (match && vector_fe)
+            {
+               // The sub-element map is a positive scaling, so the directions
+               // of the shape functions are compared componentwise.
+               double dot = 0.0, norm = 0.0;
+               for (int d = 0; d < dim; d++)
+               {
+                  dot += vshape_ho(i,d)*h[d]*dir_lor(j,d);
+                  norm += std::abs(vshape_ho(i,d)*h[d]*dir_lor(j,d));
+               }
+               match = (std::abs(dot) > tol*norm && norm > 0.0);
+               s = (dot > 0.0) ? 1 : -1;
+            }
+            if (match)
+            {
+               sub[i] = k;
+               dof[i] = j;
+               sign[i] = s;
+               break;
+            }
+         }
+      }
+      MFEM_VERIFY(sub[i] >= 0, "the nodes of the high-order basis do not"
+                  " match the refinement type");
+   }
+}
+
+// Return the local true DOF of the vector DOF vdof, or -1 if not owned.
+static int GetLocalTDof(const FiniteElementSpace &fes, int vdof)
+{
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(&fes);
+   if (pfes) { return pfes->GetLocalTDofNumber(vdof); }
+#endif
+   return vdof;
+}
+
+void LORDiscretization::Setup(BilinearForm &a_ho,
+                              const Array<int> &ess_tdof_list)
+{
+   const FiniteElementSpace &fes_ho = *a_ho.FESpace();
+   Mesh &mesh_ho = *fes_ho.GetMesh();
+   const int vdim = fes_ho.GetVDim();
+   MFEM_VERIFY(fes->GetVSize() == fes_ho.GetVSize() &&
+               fes->GetTrueVSize() == fes_ho.GetTrueVSize(),
+               "the LOR space does not match the high-order space");
+
+   // Permutation of the (scalar) local DOFs, matching the DOFs of each
+   // high-order element with the DOFs of its sub-elements
+   const CoarseFineTransformations &cf_tr = mesh->GetRefinementTransforms();
+   Array<int> ldof_perm(fes->GetNDofs());
+   ldof_perm = fes->GetNDofs();
+   Array<int> sub[Geometry::NumGeom], dof[Geometry::NumGeom],
+         sign[Geometry::NumGeom];
+   Array<int> dofs_ho, dofs_lor;
+   for (int el = 0; el < mesh_ho.GetNE(); el++)
+   {
+      const Geometry::Type geom = mesh_ho.GetElementBaseGeometry(el);
+      const DenseTensor &pm = cf_tr.point_matrices[geom];
+      const int nsub = pm.SizeK();
+      if (sub[geom].Size() == 0)
+      {
+         GetLORLocalDofMap(*fes_ho.GetFE(el), *fes->GetFE(el*nsub), pm,
+                           sub[geom], dof[geom], sign[geom]);
+      }
+      fes_ho.GetElementDofs(el, dofs_ho);
+      for (int i = 0; i < dofs_ho.Size(); i++)
+      {
+         const int el_lor = el*nsub + sub[geom][i];
+         MFEM_ASSERT(cf_tr.embeddings[el_lor].parent == el &&
+                     cf_tr.embeddings[el_lor].matrix == sub[geom][i], "");
+         fes->GetElementDofs(el_lor, dofs_lor);
+         int h = dofs_ho[i], l = dofs_lor[dof[geom][i]], s = sign[geom][i];
+         if (h < 0) { h = -1-h; s = -s; }
+         if (l < 0) { l = -1-l; s = -s; }
+         ldof_perm[l] = (s > 0) ? h : -1-h;
+      }
+   }
+
+   // Permutation of the true DOFs
+   perm.SetSize(fes->GetTrueVSize());
+   perm = -1;
+   for (int l = 0; l < ldof_perm.Size(); l++)
+   {
+      MFEM_VERIFY(ldof_perm[l] < fes->GetNDofs(),
+                  "the LOR space does not match the high-order space");
+      const int h = (ldof_perm[l] >= 0) ? ldof_perm[l] : -1-ldof_perm[l];
+      for (int c = 0; c < vdim; c++)
+      {
+         const int tl = GetLocalTDof(*fes, fes->DofToVDof(l, c));
+         const int th = GetLocalTDof(fes_ho, fes_ho.DofToVDof(h, c));
+         MFEM_VERIFY((tl < 0) == (th < 0), "the LOR and high-order true DOFs"
+                     " have different owners");
+         if (tl < 0) { continue; }
+         perm[tl] = (ldof_perm[l] >= 0) ? th : -1-th;
+      }
+   }
+
+   // Essential true DOFs in the LOR numbering
+   Array<int> ho_to_lor(perm.Size());
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      ho_to_lor[(perm[i] >= 0) ? perm[i] : -1-perm[i]] = i;
+   }
+   Array<int> ess_tdof_list_lor(ess_tdof_list.Size());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      ess_tdof_list_lor[i] = ho_to_lor[ess_tdof_list[i]];
+   }
+
+   // The integrators are owned by the high-order form
+   a->UseExternalIntegrators();
+   Array<BilinearFormIntegrator*> &dbfi = *a_ho.GetDBFI();
+   for (int i = 0; i < dbfi.Size(); i++)
+   {
+      a->AddDomainIntegrator(dbfi[i]);
+   }
+   Array<BilinearFormIntegrator*> &bbfi = *a_ho.GetBBFI();
+   Array<Array<int>*> &bbfi_marker = *a_ho.GetBBFI_Marker();
+   for (int i = 0; i < bbfi.Size(); i++)
+   {
+      if (bbfi_marker[i])
+      {
+         a->AddBoundaryIntegrator(bbfi[i], *bbfi_marker[i]);
+      }
+      else
+      {
+         a->AddBoundaryIntegrator(bbfi[i]);
+      }
+   }
+   Array<BilinearFormIntegrator*> &fbfi = *a_ho.GetFBFI();
+   for (int i = 0; i < fbfi.Size(); i++)
+   {
+      a->AddInteriorFaceIntegrator(fbfi[i]);
+   }
+   Array<BilinearFormIntegrator*> &bfbfi = *a_ho.GetBFBFI();
+   Array<Array<int>*> &bfbfi_marker = *a_ho.GetBFBFI_Marker();
+   for (int i = 0; i < bfbfi.Size(); i++)
+   {
+      if (bfbfi_marker[i])
+      {
+         a->AddBdrFaceIntegrator(bfbfi[i], *bfbfi_marker[i]);
+      }
+      else
+      {
+         a->AddBdrFaceIntegrator(bfbfi[i]);
+      }
+   }
+   a->Assemble();
+   a->FormSystemMatrix(ess_tdof_list_lor, A);
+}
+
+LORDiscretization::LORDiscretization(BilinearForm &a_ho,
+                                     const Array<int> &ess_tdof_list,
+                                     int ref_type)
+{
+   const FiniteElementSpace &fes_ho = *a_ho.FESpace();
+   int ref_factor;
+   fec = NewCollection(fes_ho, ref_factor);
+   mesh = new Mesh(fes_ho.GetMesh(), ref_factor, ref_type);
+   fes = new FiniteElementSpace(mesh, fec, fes_ho.GetVDim(),
+                                fes_ho.GetOrdering());
+   a = new BilinearForm(fes);
+   Setup(a_ho, ess_tdof_list);
+}
+
+LORDiscretization::~LORDiscretization()
+{
+   delete a;
+   delete fes;
+   delete fec;
+   delete mesh;
+}
+
+void LORDiscretization::PermuteToLOR(const Vector &x, Vector &x_lor) const
+{
+   x_lor.SetSize(perm.Size());
+   const double *xp = x.HostRead();
+   double *yp = x_lor.HostWrite();
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      const int p = perm[i];
+      yp[i] = (p >= 0) ? xp[p] : -xp[-1-p];
+   }
+}
+
+void LORDiscretization::PermuteFromLOR(const Vector &x_lor, Vector &x) const
+{
+   x.SetSize(perm.Size());
+   const double *xp = x_lor.HostRead();
+   double *yp = x.HostWrite();
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      const int p = perm[i];
+      if (p >= 0) { yp[p] = xp[i]; }
+      else { yp[-1-p] = -xp[i]; }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+ParLORDiscretization::ParLORDiscretization(ParBilinearForm &a_ho,
+                                           const Array<int> &ess_tdof_list,
+                                           int ref_type)
+{
+   ParFiniteElementSpace &pfes_ho = *a_ho.ParFESpace();
+   int ref_factor;
+   fec = NewCollection(pfes_ho, ref_factor);
+   ParMesh *pmesh = new ParMesh(pfes_ho.GetParMesh(), ref_factor, ref_type);
+   ParFiniteElementSpace *pfes =
+      new ParFiniteElementSpace(pmesh, fec, pfes_ho.GetVDim(),
+                                pfes_ho.GetOrdering());
+   mesh = pmesh;
+   fes = pfes;
+   a = new ParBilinearForm(pfes);
+   Setup(a_ho, ess_tdof_list);
+}
+
+#endif
+
+}
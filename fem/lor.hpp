@@ -0,0 +1,202 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LOR
+#define MFEM_LOR
+
+#include "../config/config.hpp"
+#include "bilinearform.hpp"
+#ifdef MFEM_USE_MPI
+#include "pbilinearform.hpp"
+#endif
+
+namespace mfem
+{
+
+/// Low-order-refined (LOR) discretization of a high-order BilinearForm.
+/** The mesh of the high-order space is refined by the order of the space,
+    using the closed (e.g. Gauss-Lobatto) points of the high-order elements as
+    the refined vertices, and the domain, boundary and face integrators of the
+    high-order form are assembled on the refined mesh with the lowest-order H1,
+    ND or RT space. The LOR DOFs are in one-to-one correspondence with the
+    high-order DOFs, see GetDofPermutation().
+
+    The high-order space must be an H1, ND or RT space on a conforming mesh of
+    segments, quadrilaterals or hexahedra, with the closed basis of the
+    refinement type, e.g. the default basis of H1_FECollection,
+    ND_FECollection and RT_FECollection for BasisType::GaussLobatto.
+
+    The integrators are shared with the high-order form, so their coefficients
+    should not depend on the element numbers of the high-order mesh (as e.g. a
+    GridFunctionCoefficient of a high-order GridFunction does). */
+class LORDiscretization
+{
+protected:
+   Mesh *mesh;
+   FiniteElementCollection *fec;
+   FiniteElementSpace *fes;
+   BilinearForm *a;
+   OperatorHandle A;
+   Array<int> perm; ///< See GetDofPermutation().
+
+   LORDiscretization() : mesh(NULL), fec(NULL), fes(NULL), a(NULL) { }
+
+   /// Return the LOR collection for @a fes_ho and its refinement factor.
+   static FiniteElementCollection *NewCollection(
+      const FiniteElementSpace &fes_ho, int &ref_factor);
+
+   /** @brief Compute the DOF permutation, add the integrators of @a a_ho to
+       the LOR form and assemble the LOR system. */
+   void Setup(BilinearForm &a_ho, const Array<int> &ess_tdof_list);
+
+public:
+   /** @brief Construct the LOR discretization of @a a_ho and assemble the LOR
+       system with the given (high-order) essential true DOFs. */
+   LORDiscretization(BilinearForm &a_ho, const Array<int> &ess_tdof_list,
+                     int ref_type = BasisType::GaussLobatto);
+
+   virtual ~LORDiscretization();
+
+   /// Return the refined mesh.
+   Mesh &GetMesh() const { return *mesh; }
+
+   /// Return the low-order space on the refined mesh.
+   FiniteElementSpace &GetFESpace() const { return *fes; }
+
+   /// Return the assembled LOR system, in the LOR true DOF numbering.
+   OperatorHandle &GetAssembledSystem() { return A; }
+
+   /// Return the assembled LOR system as a SparseMatrix.
+   SparseMatrix &GetAssembledMatrix() { return *A.As<SparseMatrix>(); }
+
+   /// Return the permutation from the LOR to the high-order true DOFs.
+   /** Entry i is the high-order true DOF corresponding to the LOR true DOF i,
+       encoded as -1-dof if the orientations of the two DOFs differ. */
+   const Array<int> &GetDofPermutation() const { return perm; }
+
+   /// Permute the high-order true DOF vector @a x to the LOR numbering.
+   void PermuteToLOR(const Vector &x, Vector &x_lor) const;
+
+   /// Permute the LOR true DOF vector @a x_lor to the high-order numbering.
+   void PermuteFromLOR(const Vector &x_lor, Vector &x) const;
+};
+
+#ifdef MFEM_USE_MPI
+
+/// Parallel version of LORDiscretization, see ParMesh(ParMesh*, int, int).
+class ParLORDiscretization : public LORDiscretization
+{
+public:
+   ParLORDiscretization(ParBilinearForm &a_ho,
+                        const Array<int> &ess_tdof_list,
+                        int ref_type = BasisType::GaussLobatto);
+
+   /// Return the refined parallel mesh.
+   ParMesh &GetParMesh() const { return *static_cast<ParMesh*>(mesh); }
+
+   /// Return the low-order parallel space on the refined mesh.
+   ParFiniteElementSpace &GetParFESpace() const
+   { return *static_cast<ParFiniteElementSpace*>(fes); }
+
+   /// Return the assembled LOR system as a HypreParMatrix.
+   HypreParMatrix &GetAssembledMatrix() { return *A.As<HypreParMatrix>(); }
+};
+
+#endif
+
+/// Preconditioner for a high-order operator based on its LOR discretization.
+/** The SolverType (e.g. GSSmoother, UMFPackSolver or HypreBoomerAMG) is
+    constructed with its default constructor and set up with the assembled
+    LOR system. HypreAMS and HypreADS are constructed with the LOR space, so
+    that they can be used for high-order ND and RT spaces. The Mult() method
+    permutes the input to the LOR numbering, applies the solver and permutes
+    the result back.
+
+    The preconditioner does not depend on the high-order operator, so
+    SetOperator() has no effect. */
+template <typename SolverType>
+class LORSolver : public Solver
+{
+protected:
+   LORDiscretization *lor;
+   SolverType *solver;
+   mutable Vector x_lor, y_lor;
+
+   void Init(SolverType *solver_)
+   {
+      solver = solver_;
+      solver->SetOperator(*lor->GetAssembledSystem());
+      height = width = lor->GetDofPermutation().Size();
+   }
+
+public:
+   LORSolver(BilinearForm &a_ho, const Array<int> &ess_tdof_list,
+             int ref_type = BasisType::GaussLobatto)
+   {
+      lor = new LORDiscretization(a_ho, ess_tdof_list, ref_type);
+      Init(new SolverType);
+   }
+
+#ifdef MFEM_USE_MPI
+   LORSolver(ParBilinearForm &a_ho, const Array<int> &ess_tdof_list,
+             int ref_type = BasisType::GaussLobatto)
+   {
+      ParLORDiscretization *plor =
+         new ParLORDiscretization(a_ho, ess_tdof_list, ref_type);
+      lor = plor;
+      Init(NewParSolver(*plor));
+   }
+
+   /// Construct the solver for a parallel LOR discretization.
+   static SolverType *NewParSolver(ParLORDiscretization &plor)
+   { return new SolverType; }
+#endif
+
+   /// Has no effect, the preconditioner is defined by the LOR system.
+   virtual void SetOperator(const Operator &op) { }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      lor->PermuteToLOR(x, x_lor);
+      y_lor.SetSize(x_lor.Size());
+      y_lor = 0.0;
+      solver->Mult(x_lor, y_lor);
+      lor->PermuteFromLOR(y_lor, y);
+   }
+
+   /// Return the solver applied to the LOR system.
+   SolverType &GetSolver() { return *solver; }
+
+   /// Return the LOR discretization.
+   LORDiscretization &GetLOR() { return *lor; }
+
+   virtual ~LORSolver()
+   {
+      delete solver;
+      delete lor;
+   }
+};
+
+#ifdef MFEM_USE_MPI
+
+template <> inline
+HypreAMS *LORSolver<HypreAMS>::NewParSolver(ParLORDiscretization &plor)
+{ return new HypreAMS(&plor.GetParFESpace()); }
+
+template <> inline
+HypreADS *LORSolver<HypreADS>::NewParSolver(ParLORDiscretization &plor)
+{ return new HypreADS(&plor.GetParFESpace()); }
+
+#endif
+
+}
+
+#endif
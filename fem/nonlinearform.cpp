@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -138,6 +139,15 @@ void NonlinearForm::Mult(const Vector &x, Vector &y) const
    if (ext)
    {
       ext->Mult(px, py);
+      if (Serial())
+      {
+         if (cP) { cP->MultTranspose(py, y); }
+         const int N = ess_tdof_list.Size();
+         const auto tdof = ess_tdof_list.Read();
+         auto Y = y.ReadWrite();
+         MFEM_FORALL(i, N, Y[tdof[i]] = 0.0; );
+      }
+      // In parallel, the result is in 'py' which is an alias for 'aux2'.
       return;
    }
 
@@ -264,7 +274,12 @@ Operator &NonlinearForm::GetGradient(const Vector &x) const
 {
    if (ext)
    {
-      MFEM_ABORT("Not yet implemented!");
+      hGrad.Clear();
+      Operator &grad = ext->GetGradient(Prolongate(x));
+      hGrad.Reset(new ConstrainedOperator(&grad, ess_tdof_list));
+      // In both serial and parallel, when using an extension, we return the
+      // final global true-dof gradient with imposed b.c.
+      return *hGrad;
    }
 
    const int skip_zeros = 0;
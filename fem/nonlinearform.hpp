@@ -46,6 +46,9 @@ protected:
 
    mutable SparseMatrix *Grad, *cGrad; // owned
 
+   /// Gradient Operator when not assembled as a matrix.
+   mutable OperatorHandle hGrad; // owned
+
    /// A list of all essential true dofs
    Array<int> ess_tdof_list;
 
@@ -24,7 +24,7 @@ NonlinearFormExtension::NonlinearFormExtension(NonlinearForm *form)
 }
 
 PANonlinearFormExtension::PANonlinearFormExtension(NonlinearForm *form):
-   NonlinearFormExtension(form), fes(*form->FESpace())
+   NonlinearFormExtension(form), fes(*form->FESpace()), Grad(*this)
 {
    const ElementDofOrdering ordering = ElementDofOrdering::LEXICOGRAPHIC;
    elem_restrict_lex = fes.GetElementRestriction(ordering);
@@ -71,4 +71,116 @@ void PANonlinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+Operator &PANonlinearFormExtension::GetGradient(const Vector &x) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *n->GetDNFI();
+   const int iSz = integrators.Size();
+   const Vector *xe = &x;
+   if (elem_restrict_lex)
+   {
+      elem_restrict_lex->Mult(x, localX);
+      xe = &localX;
+   }
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AssembleGradPA(*xe, fes);
+   }
+   return Grad;
+}
+
+PANonlinearFormExtension::Gradient::Gradient(const PANonlinearFormExtension &e)
+   : Operator(e.fes.GetTrueVSize()), ext(e)
+{
+   if (ext.fes.GetProlongationMatrix())
+   {
+      px.SetSize(ext.fes.GetVSize(), Device::GetMemoryType());
+      py.SetSize(ext.fes.GetVSize(), Device::GetMemoryType());
+      py.UseDevice(true);
+   }
+}
+
+void PANonlinearFormExtension::Gradient::Mult(const Vector &x, Vector &y) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   const Operator *P = ext.fes.GetProlongationMatrix();
+   const Vector *lx = &x;
+   Vector *ly = &y;
+   if (P)
+   {
+      P->Mult(x, px);
+      lx = &px;
+      ly = &py;
+   }
+   if (ext.elem_restrict_lex)
+   {
+      ext.elem_restrict_lex->Mult(*lx, ext.localX);
+      ext.localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(ext.localX, ext.localY);
+      }
+      ext.elem_restrict_lex->MultTranspose(ext.localY, *ly);
+   }
+   else
+   {
+      ly->UseDevice(true);
+      *ly = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultGradPA(*lx, *ly);
+      }
+   }
+   if (P) { P->MultTranspose(py, y); }
+}
+
+void PANonlinearFormExtension::Gradient::AssembleDiagonal(Vector &diag) const
+{
+   Array<NonlinearFormIntegrator*> &integrators = *ext.n->GetDNFI();
+   const int iSz = integrators.Size();
+   const Operator *P = ext.fes.GetProlongationMatrix();
+   diag.SetSize(height);
+   Vector *ldiag = P ? &py : &diag;
+   if (ext.elem_restrict_lex)
+   {
+      ext.localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradDiagonalPA(ext.localY);
+      }
+      ext.elem_restrict_lex->MultTranspose(ext.localY, *ldiag);
+   }
+   else
+   {
+      ldiag->UseDevice(true);
+      *ldiag = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleGradDiagonalPA(*ldiag);
+      }
+   }
+   if (!P) { return; }
+   // As in BilinearForm::AssembleDiagonal(), use |P^T| on non-conforming
+   // meshes to obtain a convergent approximation of the diagonal.
+   if (ext.fes.Conforming()) { P->MultTranspose(py, diag); return; }
+   const SparseMatrix *SP = dynamic_cast<const SparseMatrix*>(P);
+#ifdef MFEM_USE_MPI
+   const HypreParMatrix *HP = dynamic_cast<const HypreParMatrix*>(P);
+#endif
+   if (SP)
+   {
+      SP->AbsMultTranspose(py, diag);
+   }
+#ifdef MFEM_USE_MPI
+   else if (HP)
+   {
+      HP->AbsMultTranspose(1.0, py, 0.0, diag);
+   }
+#endif
+   else
+   {
+      MFEM_ABORT("Prolongation matrix has unexpected type.");
+   }
+}
+
 }
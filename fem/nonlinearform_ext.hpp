@@ -32,13 +32,36 @@ public:
 class PANonlinearFormExtension : public NonlinearFormExtension
 {
 protected:
+   /** @brief The action of the gradient of a partially-assembled nonlinear
+       form, as an operator on the true dofs. */
+   class Gradient : public Operator
+   {
+   protected:
+      const PANonlinearFormExtension &ext;
+      mutable Vector px, py; // L-vectors, used when the space has a prolongation
+   public:
+      Gradient(const PANonlinearFormExtension &e);
+      virtual void Mult(const Vector &x, Vector &y) const;
+      /** @brief Diagonal of the gradient, computed from the element diagonals
+          as in BilinearForm::AssembleDiagonal(). */
+      virtual void AssembleDiagonal(Vector &diag) const;
+   };
+
    const FiniteElementSpace &fes; // Not owned
    mutable Vector localX, localY;
    const Operator *elem_restrict_lex; // Not owned
+   mutable Gradient Grad;
 public:
    PANonlinearFormExtension(NonlinearForm*);
    void AssemblePA();
    void Mult(const Vector &x, Vector &y) const;
+
+   /** @brief Assemble the gradient of the integrators at the state @a x (an
+       L-vector) and return its action. */
+   /** The returned operator acts on true-dof vectors, without imposing any
+       essential boundary conditions. It is valid until the next call to this
+       method or the destruction of this object. */
+   Operator &GetGradient(const Vector &x) const;
 };
 }
 #endif // NONLINEARFORM_EXT_HPP
@@ -88,6 +88,23 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Method defining partial assembly of the gradient.
+   /** The gradient is linearized at the state @a x, given as an E-vector, and
+       the result is stored internally so that it can be used later in the
+       method AddMultGradPA(). */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   /// Method for partially assembled gradient action.
+   /** Perform the action of the gradient of the integrator, linearized at the
+       state given to the last call of AssembleGradPA(), on the input @a x and
+       add the result to the output @a y. Both @a x and @a y are E-vectors. */
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   /// Method for computing the diagonal of the partially assembled gradient.
+   /** The diagonal of the gradient, linearized at the state given to the last
+       call of AssembleGradPA(), is added to the E-vector @a diag. */
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
+
    virtual ~NonlinearFormIntegrator() { }
 };
 
@@ -253,9 +270,25 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   const FiniteElementSpace *fespace; ///< Not owned
+   const DofToQuad *maps;             ///< Not owned
+   const IntegrationRule *ir;         ///< Not owned
+   int dim, ne, nq;
+   // pa_data: inverse target Jacobians Jrt at the quadrature points,
+   //          (dim x dim x nq x ne).
+   // pa_weights: quadrature weights times target Jacobian determinants,
+   //             (nq x ne).
+   // pa_grad: reference-space tangent moduli at the linearization state,
+   //          (dim^2 x dim^2 x nq x ne).
+   Vector pa_data, pa_weights, pa_grad;
+   // Reference gradients of the input and the quadrature point stresses.
+   mutable Vector pa_jac, pa_stress;
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), fespace(NULL), maps(NULL), ir(NULL), dim(0), ne(0), nq(0) { }
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -272,6 +305,23 @@ public:
    virtual void AssembleElementGrad(const FiniteElement &el,
                                     ElementTransformation &Ttr,
                                     const Vector &elfun, DenseMatrix &elmat);
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   /** @brief Partial assembly for tensor-product elements with vdim equal to
+       the mesh dimension. Only the target geometry is stored; the @a model is
+       evaluated at the quadrature points during AddMultPA(). */
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   /** @brief Evaluates the tangent moduli of the @a model at the quadrature
+       points, so that the gradient action is a pointwise contraction. */
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
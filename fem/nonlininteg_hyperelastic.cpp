@@ -0,0 +1,161 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "nonlininteg.hpp"
+#include "nonlininteg_pa.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement*>(&el) != NULL,
+               "PA is only supported for tensor-product elements!");
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "dim = " << dim << " is not supported!");
+   MFEM_VERIFY(fes.GetVDim() == dim, "the vector dimension of the space must"
+               " be equal to the mesh dimension!");
+   fespace = &fes;
+   ne = mesh->GetNE();
+   ir = IntRule ? IntRule
+        : &IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3); // <---
+   nq = ir->GetNPoints();
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   const GeometricFactors *geom =
+      mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+
+   // The model is evaluated on the host, so the target geometry is kept there
+   // too; only the inverse Jacobians and the weights are needed.
+   pa_data.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   pa_weights.SetSize(nq*ne, Device::GetMemoryType());
+   auto J = Reshape(geom->J.HostRead(), nq, dim, dim, ne);
+   auto W = Reshape(pa_weights.HostWrite(), nq, ne);
+   double *Jrt_data = pa_data.HostWrite();
+   DenseMatrix Jtr(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int j = 0; j < dim; j++)
+         {
+            for (int i = 0; i < dim; i++)
+            {
+               Jtr(i,j) = J(q,i,j,e);
+            }
+         }
+         Jrt.UseExternalData(Jrt_data + dim*dim*(q + nq*e), dim, dim);
+         CalcInverse(Jtr, Jrt);
+         W(q,e) = ir->IntPoint(q).weight * Jtr.Det();
+      }
+   }
+   Jrt.ClearExternalData();
+
+   pa_jac.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+   pa_stress.SetSize(dim*dim*nq*ne, Device::GetMemoryType());
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   internal::PAVectorGradient(dim, ne, *maps, x, pa_jac);
+
+   // Evaluate the 1st Piola-Kirchhoff stress at the quadrature points and pull
+   // it back to the reference element: stress = w det(Jtr) P Jrt^t.
+   Mesh *mesh = fespace->GetMesh();
+   const double *jac = pa_jac.HostRead();
+   const double *Jrt_data = pa_data.HostRead();
+   const double *W = pa_weights.HostRead();
+   double *stress = pa_stress.HostWrite();
+   DenseMatrix Jpr_q, Jrt_q, S_q, Jpt_q(dim), P_q(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &Ttr = *mesh->GetElementTransformation(e);
+      model->SetTransformation(Ttr);
+      for (int q = 0; q < nq; q++)
+      {
+         const int offset = dim*dim*(q + nq*e);
+         Ttr.SetIntPoint(&ir->IntPoint(q));
+         Jpr_q.UseExternalData(const_cast<double*>(jac) + offset, dim, dim);
+         Jrt_q.UseExternalData(const_cast<double*>(Jrt_data) + offset,
+                               dim, dim);
+         S_q.UseExternalData(stress + offset, dim, dim);
+         Mult(Jpr_q, Jrt_q, Jpt_q);
+
+         model->EvalP(Jpt_q, P_q);
+
+         P_q *= W[q + nq*e];
+         MultABt(P_q, Jrt_q, S_q);
+      }
+   }
+   Jpr_q.ClearExternalData();
+   Jrt_q.ClearExternalData();
+   S_q.ClearExternalData();
+
+   internal::PAVectorGradientTranspose(dim, ne, *maps, pa_stress, y);
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(fespace == &fes, "AssemblePA() must be called first!");
+   internal::PAVectorGradient(dim, ne, *maps, x, pa_jac);
+
+   // Evaluate the tangent moduli at the quadrature points. Passing Jrt in place
+   // of the shape function gradients to AssembleH() gives the moduli in
+   // reference coordinates: H(i + a dim, j + b dim) = w det(Jtr) Jrt(i,k)
+   // Jrt(j,l) d^2W/(dJpt(a,k) dJpt(b,l)). They are stored in the (component,
+   // direction) ordering of the gradients, as (dim^2 x dim^2) matrices.
+   const int dd = dim*dim;
+   pa_grad.SetSize(dd*dd*nq*ne, Device::GetMemoryType());
+   Mesh *mesh = fespace->GetMesh();
+   const double *jac = pa_jac.HostRead();
+   const double *Jrt_data = pa_data.HostRead();
+   const double *W = pa_weights.HostRead();
+   double *H = pa_grad.HostWrite();
+   DenseMatrix Jpr_q, Jrt_q, Jpt_q(dim), H_q(dd);
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation &Ttr = *mesh->GetElementTransformation(e);
+      model->SetTransformation(Ttr);
+      for (int q = 0; q < nq; q++)
+      {
+         const int qe = q + nq*e;
+         Ttr.SetIntPoint(&ir->IntPoint(q));
+         Jpr_q.UseExternalData(const_cast<double*>(jac) + dd*qe, dim, dim);
+         Jrt_q.UseExternalData(const_cast<double*>(Jrt_data) + dd*qe, dim, dim);
+         Mult(Jpr_q, Jrt_q, Jpt_q);
+
+         H_q = 0.0;
+         model->AssembleH(Jpt_q, Jrt_q, W[qe], H_q);
+         internal::PAStoreTangent(dim, H_q, H + dd*dd*qe);
+      }
+   }
+   Jpr_q.ClearExternalData();
+   Jrt_q.ClearExternalData();
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x, Vector &y) const
+{
+   internal::PAVectorGradient(dim, ne, *maps, x, pa_jac);
+   internal::PATangentMult(dim, nq*ne, pa_grad, pa_jac, pa_stress);
+   internal::PAVectorGradientTranspose(dim, ne, *maps, pa_stress, y);
+}
+
+void HyperelasticNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
+{
+   internal::PATangentDiagonal(dim, ne, *maps, pa_grad, diag);
+}
+
+} // namespace mfem
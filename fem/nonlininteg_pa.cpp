@@ -0,0 +1,527 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "nonlininteg_pa.hpp"
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Reference gradients of the components of a vector field at the quadrature
+// points: J(c,i,q,e) = d(x_c)/d(xi_i).
+static void PAVectorGradient2D(const int NE,
+                               const Array<double> &b,
+                               const Array<double> &g,
+                               const Vector &x_,
+                               Vector &j_,
+                               const int D1D,
+                               const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto X = Reshape(x_.Read(), D1D, D1D, 2, NE);
+   auto J = Reshape(j_.Write(), 2, 2, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      for (int c = 0; c < 2; ++c)
+      {
+         double BX[max_D1D][max_Q1D];
+         double GX[max_D1D][max_Q1D];
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u = 0.0;
+               double v = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = X(dx, dy, c, e);
+                  u += B(qx, dx) * s;
+                  v += G(qx, dx) * s;
+               }
+               BX[dy][qx] = u;
+               GX[dy][qx] = v;
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double d0 = 0.0;
+               double d1 = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  d0 += B(qy, dy) * GX[dy][qx];
+                  d1 += G(qy, dy) * BX[dy][qx];
+               }
+               J(c, 0, qx, qy, e) = d0;
+               J(c, 1, qx, qy, e) = d1;
+            }
+         }
+      }
+   });
+}
+
+static void PAVectorGradient3D(const int NE,
+                               const Array<double> &b,
+                               const Array<double> &g,
+                               const Vector &x_,
+                               Vector &j_,
+                               const int D1D,
+                               const int Q1D)
+{
+   constexpr int max_D1D = 8;
+   constexpr int max_Q1D = 8;
+   MFEM_VERIFY(D1D <= max_D1D, "");
+   MFEM_VERIFY(Q1D <= max_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, 3, NE);
+   auto J = Reshape(j_.Write(), 3, 3, Q1D, Q1D, Q1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         double BX[max_D1D][max_D1D][max_Q1D];
+         double GX[max_D1D][max_D1D][max_Q1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double s = X(dx, dy, dz, c, e);
+                     u += B(qx, dx) * s;
+                     v += G(qx, dx) * s;
+                  }
+                  BX[dz][dy][qx] = u;
+                  GX[dz][dy][qx] = v;
+               }
+            }
+         }
+         double BBX[max_D1D][max_Q1D][max_Q1D];
+         double BGX[max_D1D][max_Q1D][max_Q1D];
+         double GBX[max_D1D][max_Q1D][max_Q1D];
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += B(qy, dy) * BX[dz][dy][qx];
+                     v += B(qy, dy) * GX[dz][dy][qx];
+                     w += G(qy, dy) * BX[dz][dy][qx];
+                  }
+                  BBX[dz][qy][qx] = u;
+                  BGX[dz][qy][qx] = v;
+                  GBX[dz][qy][qx] = w;
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double d0 = 0.0;
+                  double d1 = 0.0;
+                  double d2 = 0.0;
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     d0 += B(qz, dz) * BGX[dz][qy][qx];
+                     d1 += B(qz, dz) * GBX[dz][qy][qx];
+                     d2 += G(qz, dz) * BBX[dz][qy][qx];
+                  }
+                  J(c, 0, qx, qy, qz, e) = d0;
+                  J(c, 1, qx, qy, qz, e) = d1;
+                  J(c, 2, qx, qy, qz, e) = d2;
+               }
+            }
+         }
+      }
+   });
+}
+
+// Transpose of the above: Y(d,c,e) += sum_{q,i} dphi_d/d(xi_i)(q) A(c,i,q,e).
+static void PAVectorGradientTranspose2D(const int NE,
+                                        const Array<double> &b,
+                                        const Array<double> &g,
+                                        const Vector &a_,
+                                        Vector &y_,
+                                        const int D1D,
+                                        const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto A = Reshape(a_.Read(), 2, 2, Q1D, Q1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      for (int c = 0; c < 2; ++c)
+      {
+         double GA0[max_Q1D][max_D1D];
+         double BA1[max_Q1D][max_D1D];
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               double v = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u += G(qx, dx) * A(c, 0, qx, qy, e);
+                  v += B(qx, dx) * A(c, 1, qx, qy, e);
+               }
+               GA0[qy][dx] = u;
+               BA1[qy][dx] = v;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double u = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  u += B(qy, dy) * GA0[qy][dx] + G(qy, dy) * BA1[qy][dx];
+               }
+               Y(dx, dy, c, e) += u;
+            }
+         }
+      }
+   });
+}
+
+static void PAVectorGradientTranspose3D(const int NE,
+                                        const Array<double> &b,
+                                        const Array<double> &g,
+                                        const Vector &a_,
+                                        Vector &y_,
+                                        const int D1D,
+                                        const int Q1D)
+{
+   constexpr int max_D1D = 8;
+   constexpr int max_Q1D = 8;
+   MFEM_VERIFY(D1D <= max_D1D, "");
+   MFEM_VERIFY(Q1D <= max_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto A = Reshape(a_.Read(), 3, 3, Q1D, Q1D, Q1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         double GA0[max_Q1D][max_Q1D][max_D1D];
+         double BA1[max_Q1D][max_Q1D][max_D1D];
+         double BA2[max_Q1D][max_Q1D][max_D1D];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  double w = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += G(qx, dx) * A(c, 0, qx, qy, qz, e);
+                     v += B(qx, dx) * A(c, 1, qx, qy, qz, e);
+                     w += B(qx, dx) * A(c, 2, qx, qy, qz, e);
+                  }
+                  GA0[qz][qy][dx] = u;
+                  BA1[qz][qy][dx] = v;
+                  BA2[qz][qy][dx] = w;
+               }
+            }
+         }
+         double AXY[max_Q1D][max_D1D][max_D1D];
+         double BA2Y[max_Q1D][max_D1D][max_D1D];
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  double v = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += B(qy, dy) * GA0[qz][qy][dx];
+                     u += G(qy, dy) * BA1[qz][qy][dx];
+                     v += B(qy, dy) * BA2[qz][qy][dx];
+                  }
+                  AXY[qz][dy][dx] = u;
+                  BA2Y[qz][dy][dx] = v;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     u += B(qz, dz) * AXY[qz][dy][dx];
+                     u += G(qz, dz) * BA2Y[qz][dy][dx];
+                  }
+                  Y(dx, dy, dz, c, e) += u;
+               }
+            }
+         }
+      }
+   });
+}
+
+void PAVectorGradient(const int dim, const int NE, const DofToQuad &maps,
+                      const Vector &x, Vector &jac)
+{
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return PAVectorGradient2D(NE, maps.B, maps.G, x, jac, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      return PAVectorGradient3D(NE, maps.B, maps.G, x, jac, D1D, Q1D);
+   }
+   MFEM_ABORT("dim = " << dim << " is not supported!");
+}
+
+void PAVectorGradientTranspose(const int dim, const int NE,
+                               const DofToQuad &maps, const Vector &S,
+                               Vector &y)
+{
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return PAVectorGradientTranspose2D(NE, maps.B, maps.G, S, y, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      return PAVectorGradientTranspose3D(NE, maps.B, maps.G, S, y, D1D, Q1D);
+   }
+   MFEM_ABORT("dim = " << dim << " is not supported!");
+}
+
+void PATangentMult(const int dim, const int NQE, const Vector &h,
+                   const Vector &dj, Vector &s)
+{
+   const int DD = dim*dim;
+   auto H = Reshape(h.Read(), DD, DD, NQE);
+   auto dJ = Reshape(dj.Read(), DD, NQE);
+   auto S = Reshape(s.Write(), DD, NQE);
+   MFEM_FORALL(p, NQE,
+   {
+      for (int r = 0; r < DD; r++)
+      {
+         double u = 0.0;
+         for (int k = 0; k < DD; k++)
+         {
+            u += H(r, k, p) * dJ(k, p);
+         }
+         S(r, p) = u;
+      }
+   });
+}
+
+// The diagonal entry for dof d and component c is
+//    sum_q sum_{i,j} dphi_d/dxi_i H(c,i,c,j,q) dphi_d/dxi_j,
+// where, for each pair (i,j), the product of the two gradients is a product of
+// 1D factors that are contracted one direction at a time.
+static void PATangentDiagonal2D(const int NE,
+                                const Array<double> &b,
+                                const Array<double> &g,
+                                const Vector &h,
+                                Vector &diag,
+                                const int D1D,
+                                const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto H = Reshape(h.Read(), 2, 2, 2, 2, Q1D, Q1D, NE);
+   auto D = Reshape(diag.ReadWrite(), D1D, D1D, 2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      for (int c = 0; c < 2; ++c)
+      {
+         for (int i = 0; i < 2; ++i)
+         {
+            for (int j = 0; j < 2; ++j)
+            {
+               double QD[max_Q1D][max_D1D];
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        const double Xi = (i == 0) ? G(qx, dx) : B(qx, dx);
+                        const double Xj = (j == 0) ? G(qx, dx) : B(qx, dx);
+                        u += Xi * Xj * H(c, i, c, j, qx, qy, e);
+                     }
+                     QD[qy][dx] = u;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        const double Yi = (i == 1) ? G(qy, dy) : B(qy, dy);
+                        const double Yj = (j == 1) ? G(qy, dy) : B(qy, dy);
+                        u += Yi * Yj * QD[qy][dx];
+                     }
+                     D(dx, dy, c, e) += u;
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+static void PATangentDiagonal3D(const int NE,
+                                const Array<double> &b,
+                                const Array<double> &g,
+                                const Vector &h,
+                                Vector &diag,
+                                const int D1D,
+                                const int Q1D)
+{
+   constexpr int max_D1D = 8;
+   constexpr int max_Q1D = 8;
+   MFEM_VERIFY(D1D <= max_D1D, "");
+   MFEM_VERIFY(Q1D <= max_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto H = Reshape(h.Read(), 3, 3, 3, 3, Q1D, Q1D, Q1D, NE);
+   auto D = Reshape(diag.ReadWrite(), D1D, D1D, D1D, 3, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int c = 0; c < 3; ++c)
+      {
+         for (int i = 0; i < 3; ++i)
+         {
+            for (int j = 0; j < 3; ++j)
+            {
+               double QQD[max_Q1D][max_Q1D][max_D1D];
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double u = 0.0;
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Xi = (i == 0) ? G(qx,dx) : B(qx,dx);
+                           const double Xj = (j == 0) ? G(qx,dx) : B(qx,dx);
+                           u += Xi * Xj * H(c, i, c, j, qx, qy, qz, e);
+                        }
+                        QQD[qz][qy][dx] = u;
+                     }
+                  }
+               }
+               double QDD[max_Q1D][max_D1D][max_D1D];
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double u = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double Yi = (i == 1) ? G(qy,dy) : B(qy,dy);
+                           const double Yj = (j == 1) ? G(qy,dy) : B(qy,dy);
+                           u += Yi * Yj * QQD[qz][qy][dx];
+                        }
+                        QDD[qz][dy][dx] = u;
+                     }
+                  }
+               }
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double u = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const double Zi = (i == 2) ? G(qz,dz) : B(qz,dz);
+                           const double Zj = (j == 2) ? G(qz,dz) : B(qz,dz);
+                           u += Zi * Zj * QDD[qz][dy][dx];
+                        }
+                        D(dx, dy, dz, c, e) += u;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void PATangentDiagonal(const int dim, const int NE, const DofToQuad &maps,
+                       const Vector &H, Vector &diag)
+{
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   if (dim == 2)
+   {
+      return PATangentDiagonal2D(NE, maps.B, maps.G, H, diag, D1D, Q1D);
+   }
+   if (dim == 3)
+   {
+      return PATangentDiagonal3D(NE, maps.B, maps.G, H, diag, D1D, Q1D);
+   }
+   MFEM_ABORT("dim = " << dim << " is not supported!");
+}
+
+} // namespace internal
+
+} // namespace mfem
@@ -0,0 +1,76 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_NONLININTEG_PA
+#define MFEM_NONLININTEG_PA
+
+#include "../config/config.hpp"
+#include "../linalg/densemat.hpp"
+#include "fe.hpp"
+
+// Kernels shared by the partially assembled nonlinear integrators whose state
+// is a vector field with one component per space dimension, e.g. the mesh
+// positions or the deformation. They operate on lexicographic E-vectors of
+// tensor-product elements (D1D^dim x dim x NE) and on quadrature data ordered
+// as (component, reference direction, quadrature point, element), i.e. on
+// column-major dim x dim matrices at each point.
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/// Reference gradients at the quadrature points: jac(c,i,q,e) = dx_c/dxi_i.
+void PAVectorGradient(const int dim, const int NE, const DofToQuad &maps,
+                      const Vector &x, Vector &jac);
+
+/** @brief Transpose of PAVectorGradient():
+    y(d,c,e) += sum_{q,i} dphi_d/dxi_i S(c,i,q,e). */
+void PAVectorGradientTranspose(const int dim, const int NE,
+                               const DofToQuad &maps, const Vector &S,
+                               Vector &y);
+
+/** @brief Pointwise action of stored tangent moduli, S(:,p) = H(:,:,p) dJ(:,p),
+    where H holds a (dim^2 x dim^2) matrix at each of the @a NQE points. */
+void PATangentMult(const int dim, const int NQE, const Vector &H,
+                   const Vector &dJ, Vector &S);
+
+/// Add the diagonal of the operator defined by the tangent moduli @a H to the
+/// E-vector @a diag.
+void PATangentDiagonal(const int dim, const int NE, const DofToQuad &maps,
+                       const Vector &H, Vector &diag);
+
+/** @brief Store the result @a A of HyperelasticModel::AssembleH(), called with
+    the inverse target Jacobian in place of the shape function gradients, in
+    the layout used by PATangentMult(). */
+inline void PAStoreTangent(const int dim, const DenseMatrix &A, double *H)
+{
+   for (int b = 0; b < dim; b++)
+   {
+      for (int j = 0; j < dim; j++)
+      {
+         for (int i = 0; i < dim; i++)
+         {
+            for (int a = 0; a < dim; a++)
+            {
+               H[a + dim*(i + dim*(b + dim*j))] = A(i + a*dim, j + b*dim);
+            }
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif // MFEM_NONLININTEG_PA
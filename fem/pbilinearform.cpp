@@ -15,15 +15,135 @@
 
 #include "fem.hpp"
 #include "../general/sort_pairs.hpp"
+#include <algorithm>
 
 namespace mfem
 {
 
+// Return true if the SparseMatrices A and B have the same sparsity pattern.
+static bool SameSparsity(const SparseMatrix &A, const SparseMatrix &B)
+{
+   if (A.Height() != B.Height() || A.Width() != B.Width() ||
+       A.NumNonZeroElems() != B.NumNonZeroElems())
+   {
+      return false;
+   }
+   const int *AI = A.GetI(), *AJ = A.GetJ(), *BI = B.GetI(), *BJ = B.GetJ();
+   for (int i = 0; i <= A.Height(); i++)
+   {
+      if (AI[i] != BI[i]) { return false; }
+   }
+   for (int j = 0; j < AI[A.Height()]; j++)
+   {
+      if (AJ[j] != BJ[j]) { return false; }
+   }
+   return true;
+}
+
+// Copy the values of src into dst, if both matrices have the same parallel
+// sparsity pattern. Return false otherwise, leaving dst unchanged.
+static bool CopyParMatrixValues(const HypreParMatrix &src, HypreParMatrix &dst)
+{
+   if (src.GetGlobalNumRows() != dst.GetGlobalNumRows() ||
+       src.GetGlobalNumCols() != dst.GetGlobalNumCols())
+   {
+      return false;
+   }
+   SparseMatrix src_diag, src_offd, dst_diag, dst_offd;
+   HYPRE_Int *src_cmap, *dst_cmap;
+   src.GetDiag(src_diag);
+   src.GetOffd(src_offd, src_cmap);
+   dst.GetDiag(dst_diag);
+   dst.GetOffd(dst_offd, dst_cmap);
+   if (!SameSparsity(src_diag, dst_diag) || !SameSparsity(src_offd, dst_offd))
+   {
+      return false;
+   }
+   for (int j = 0; j < src_offd.Width(); j++)
+   {
+      if (src_cmap[j] != dst_cmap[j]) { return false; }
+   }
+   std::copy(src_diag.GetData(), src_diag.GetData() +
+             src_diag.NumNonZeroElems(), dst_diag.GetData());
+   std::copy(src_offd.GetData(), src_offd.GetData() +
+             src_offd.NumNonZeroElems(), dst_offd.GetData());
+   return true;
+}
+
+// The entries of a ParCSR matrix are numbered with the entries of the diag
+// block first, followed by the entries of the offd block.
+static inline double &ParCSREntry(double *diag_data, double *offd_data,
+                                  const int nnz_diag, const int k)
+{
+   return (k < nnz_diag) ? diag_data[k] : offd_data[k - nnz_diag];
+}
+
+// Find the entries of a ParCSR matrix by their local row and global column.
+class ParCSRFinder
+{
+private:
+   hypre_CSRMatrix *diag, *offd;
+   HYPRE_Int col_start, col_end, *cmap;
+   int num_cmap, nnz_diag;
+   // The entries of each row of diag and offd, sorted by column
+   Array<int> diag_perm, offd_perm;
+
+   static void SortRows(hypre_CSRMatrix *M, Array<int> &perm)
+   {
+      const HYPRE_Int *I = hypre_CSRMatrixI(M), *J = hypre_CSRMatrixJ(M);
+      const int nrows = hypre_CSRMatrixNumRows(M);
+      perm.SetSize(I[nrows]);
+      for (int k = 0; k < perm.Size(); k++) { perm[k] = k; }
+      for (int i = 0; i < nrows; i++)
+      {
+         std::sort(perm.GetData() + I[i], perm.GetData() + I[i+1],
+                   [&](int a, int b) { return J[a] < J[b]; });
+      }
+   }
+
+   static int FindInRow(hypre_CSRMatrix *M, const Array<int> &perm,
+                        const int row, const HYPRE_Int col)
+   {
+      const HYPRE_Int *I = hypre_CSRMatrixI(M), *J = hypre_CSRMatrixJ(M);
+      const int *end = perm.GetData() + I[row+1];
+      const int *k = std::lower_bound(perm.GetData() + I[row], end, col,
+                                      [&](int a, HYPRE_Int c)
+      { return J[a] < c; });
+      return (k != end && J[*k] == col) ? *k : -1;
+   }
+
+public:
+   ParCSRFinder(hypre_ParCSRMatrix *A)
+      : diag(hypre_ParCSRMatrixDiag(A)), offd(hypre_ParCSRMatrixOffd(A)),
+        col_start(hypre_ParCSRMatrixFirstColDiag(A)),
+        col_end(hypre_ParCSRMatrixLastColDiag(A) + 1),
+        cmap(hypre_ParCSRMatrixColMapOffd(A)),
+        num_cmap(hypre_CSRMatrixNumCols(offd)),
+        nnz_diag(hypre_CSRMatrixI(diag)[hypre_CSRMatrixNumRows(diag)])
+   {
+      SortRows(diag, diag_perm);
+      SortRows(offd, offd_perm);
+   }
+
+   /// Return the entry (@a row, @a col) as numbered in ParCSREntry(), or -1.
+   int Find(const int row, const HYPRE_Int col) const
+   {
+      if (col_start <= col && col < col_end)
+      {
+         return FindInRow(diag, diag_perm, row, col - col_start);
+      }
+      const HYPRE_Int *c = std::lower_bound(cmap, cmap + num_cmap, col);
+      if (c == cmap + num_cmap || *c != col) { return -1; }
+      const int k = FindInRow(offd, offd_perm, row, c - cmap);
+      return (k < 0) ? -1 : nnz_diag + k;
+   }
+};
+
 void ParBilinearForm::pAllocMat()
 {
    int nbr_size = pfes->GetFaceNbrVSize();
 
-   if (precompute_sparsity == 0 || fes->GetVDim() > 1)
+   if ((precompute_sparsity == 0 && !reuse_sparsity) || fes->GetVDim() > 1)
    {
       if (keep_nbr_block)
       {
@@ -233,6 +353,9 @@ void ParBilinearForm::AssembleSharedFaces(int skip_zeros)
 
 void ParBilinearForm::Assemble(int skip_zeros)
 {
+   // keep the full pattern, if it is not precomputed, see pAllocMat()
+   if (reuse_sparsity) { skip_zeros = 0; }
+
    if (mat == NULL && fbfi.Size() > 0)
    {
       pfes->ExchangeFaceNbrData();
@@ -295,6 +418,13 @@ const
    pfes->Dof_TrueDof_Matrix()->MultTranspose(a, Y, 1.0, y);
 }
 
+void ParBilinearForm::SetCommunicationOverlap(bool overlap)
+{
+   MFEM_VERIFY(ext && assembly == AssemblyLevel::PARTIAL,
+               "communication overlap requires AssemblyLevel::PARTIAL");
+   static_cast<PABilinearFormExtension*>(ext)->SetCommunicationOverlap(overlap);
+}
+
 void ParBilinearForm::FormLinearSystem(
    const Array<int> &ess_tdof_list, Vector &x, Vector &b,
    OperatorHandle &A, Vector &X, Vector &B, int copy_interior)
@@ -345,6 +475,301 @@ void ParBilinearForm::FormLinearSystem(
    }
 }
 
+bool ParBilinearForm::SetupParallelValuesMap()
+{
+   MPI_Comm comm = pfes->GetComm();
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   // The face-neighbor rows and columns of mat are not supported
+   const int vsize = pfes->GetVSize();
+   int ok = (fbfi.Size() == 0 && mat->Height() == vsize &&
+             mat->Width() == vsize);
+   MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+   if (!ok) { return false; }
+
+   hypre_ParCSRMatrix *A = *p_mat.As<HypreParMatrix>();
+   hypre_ParCSRMatrix *P = *pfes->Dof_TrueDof_Matrix();
+   const ParCSRFinder find(A);
+   const HYPRE_Int row_start = hypre_ParCSRMatrixFirstRowIndex(A);
+
+   // The first true dof of each rank, to find the owner of the rows
+   Array<HYPRE_Int> tdof_start(nranks);
+   HYPRE_Int my_tdof_start = hypre_ParCSRMatrixFirstColDiag(P);
+   MPI_Allgather(&my_tdof_start, 1, HYPRE_MPI_INT, tdof_start.GetData(), 1,
+                 HYPRE_MPI_INT, comm);
+
+   // The global true dofs and the weights of the rows of P
+   Array<int> P_I(vsize + 1);
+   Array<HYPRE_Int> P_J;
+   Array<double> P_W;
+   {
+      hypre_CSRMatrix *P_diag = hypre_ParCSRMatrixDiag(P);
+      hypre_CSRMatrix *P_offd = hypre_ParCSRMatrixOffd(P);
+      const HYPRE_Int *P_cmap = hypre_ParCSRMatrixColMapOffd(P);
+      P_I[0] = 0;
+      for (int i = 0; i < vsize; i++)
+      {
+         for (int k = hypre_CSRMatrixI(P_diag)[i];
+              k < hypre_CSRMatrixI(P_diag)[i+1]; k++)
+         {
+            P_J.Append(my_tdof_start + hypre_CSRMatrixJ(P_diag)[k]);
+            P_W.Append(hypre_CSRMatrixData(P_diag)[k]);
+         }
+         for (int k = hypre_CSRMatrixI(P_offd)[i];
+              k < hypre_CSRMatrixI(P_offd)[i+1]; k++)
+         {
+            P_J.Append(P_cmap[hypre_CSRMatrixJ(P_offd)[k]]);
+            P_W.Append(hypre_CSRMatrixData(P_offd)[k]);
+         }
+         P_I[i+1] = P_J.Size();
+      }
+   }
+
+   // The contributions of the entries of mat to the local rows of p_mat, and
+   // the records (rank, row, column) of the contributions to other ranks
+   const int *I = mat->GetI(), *J = mat->GetJ();
+   Array<int> local_map, remote_src;
+   Array<double> local_w, remote_w;
+   Array<HYPRE_Int> remote;
+   for (int i = 0; i < vsize; i++)
+   {
+      for (int a = P_I[i]; a < P_I[i+1]; a++)
+      {
+         const HYPRE_Int row = P_J[a];
+         const int owner =
+            (std::upper_bound(tdof_start.begin(), tdof_start.end(), row) -
+             tdof_start.begin()) - 1;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            for (int b = P_I[J[k]]; b < P_I[J[k]+1]; b++)
+            {
+               if (owner == myrank)
+               {
+                  const int dst = find.Find(row - row_start, P_J[b]);
+                  if (dst < 0) { ok = 0; }
+                  const int pair[2] = { k, dst };
+                  local_map.Append(pair, 2);
+                  local_w.Append(P_W[a]*P_W[b]);
+               }
+               else
+               {
+                  const HYPRE_Int rec[3] = { owner, row, P_J[b] };
+                  remote.Append(rec, 3);
+                  remote_src.Append(k);
+                  remote_w.Append(P_W[a]*P_W[b]);
+               }
+            }
+         }
+      }
+   }
+
+   // Combine the remote contributions to the same entry in one value of the
+   // send buffer; p_map lists the remote contributions first
+   const int nremote = remote_src.Size();
+   Array<int> perm(nremote);
+   for (int i = 0; i < nremote; i++) { perm[i] = i; }
+   const HYPRE_Int *r = remote.GetData();
+   std::sort(perm.begin(), perm.end(), [&](int i, int j)
+   {
+      return std::lexicographical_compare(r + 3*i, r + 3*i + 3,
+                                          r + 3*j, r + 3*j + 3);
+   });
+   Array<int> send_counts(nranks), recv_counts(nranks);
+   Array<HYPRE_Int> send_entries;
+   send_counts = 0;
+   p_map.SetSize(0);
+   p_map_w.SetSize(0);
+   for (int i = 0, slot = -1; i < nremote; i++)
+   {
+      const HYPRE_Int *rec = r + 3*perm[i];
+      if (i == 0 || !std::equal(rec, rec + 3, r + 3*perm[i-1]))
+      {
+         slot++;
+         send_counts[rec[0]]++;
+         send_entries.Append(rec + 1, 2);
+      }
+      const int pair[2] = { remote_src[perm[i]], -1 - slot };
+      p_map.Append(pair, 2);
+      p_map_w.Append(remote_w[perm[i]]);
+   }
+   p_map.Append(local_map);
+   p_map_w.Append(local_w);
+
+   // Send the rows and columns of the remote entries to their owners
+   MPI_Alltoall(send_counts.GetData(), 1, MPI_INT, recv_counts.GetData(), 1,
+                MPI_INT, comm);
+   p_send_ranks.SetSize(0);
+   p_recv_ranks.SetSize(0);
+   p_send_offsets.SetSize(1);
+   p_recv_offsets.SetSize(1);
+   p_send_offsets[0] = p_recv_offsets[0] = 0;
+   for (int q = 0; q < nranks; q++)
+   {
+      if (send_counts[q])
+      {
+         p_send_ranks.Append(q);
+         p_send_offsets.Append(p_send_offsets.Last() + send_counts[q]);
+      }
+      if (recv_counts[q])
+      {
+         p_recv_ranks.Append(q);
+         p_recv_offsets.Append(p_recv_offsets.Last() + recv_counts[q]);
+      }
+   }
+   Array<HYPRE_Int> recv_entries(2*p_recv_offsets.Last());
+   Array<MPI_Request> requests(p_send_ranks.Size() + p_recv_ranks.Size());
+   const int tag = 831;
+   for (int q = 0; q < p_recv_ranks.Size(); q++)
+   {
+      MPI_Irecv(recv_entries.GetData() + 2*p_recv_offsets[q],
+                2*(p_recv_offsets[q+1] - p_recv_offsets[q]), HYPRE_MPI_INT,
+                p_recv_ranks[q], tag, comm, &requests[q]);
+   }
+   for (int q = 0; q < p_send_ranks.Size(); q++)
+   {
+      MPI_Isend(send_entries.GetData() + 2*p_send_offsets[q],
+                2*(p_send_offsets[q+1] - p_send_offsets[q]), HYPRE_MPI_INT,
+                p_send_ranks[q], tag, comm,
+                &requests[p_recv_ranks.Size() + q]);
+   }
+   MPI_Waitall(requests.Size(), requests.GetData(), MPI_STATUSES_IGNORE);
+
+   p_recv_map.SetSize(p_recv_offsets.Last());
+   for (int i = 0; i < p_recv_map.Size(); i++)
+   {
+      p_recv_map[i] = find.Find(recv_entries[2*i] - row_start,
+                                recv_entries[2*i+1]);
+      if (p_recv_map[i] < 0) { ok = 0; }
+   }
+
+   // The triple product may drop entries of the pattern of mat
+   MPI_Allreduce(MPI_IN_PLACE, &ok, 1, MPI_INT, MPI_MIN, comm);
+   return ok;
+}
+
+void ParBilinearForm::SetupParallelElimMap(const Array<int> &ess_tdof_list)
+{
+   hypre_ParCSRMatrix *A = *p_mat.As<HypreParMatrix>();
+   hypre_ParCSRMatrix *Ae = *p_mat_e.As<HypreParMatrix>();
+   const ParCSRFinder find(A);
+   const HYPRE_Int row_start = hypre_ParCSRMatrixFirstRowIndex(A);
+   hypre_CSRMatrix *Ae_diag = hypre_ParCSRMatrixDiag(Ae);
+   hypre_CSRMatrix *Ae_offd = hypre_ParCSRMatrixOffd(Ae);
+   const HYPRE_Int Ae_col_start = hypre_ParCSRMatrixFirstColDiag(Ae);
+   const HYPRE_Int *Ae_cmap = hypre_ParCSRMatrixColMapOffd(Ae);
+   const int nrows = hypre_CSRMatrixNumRows(Ae_diag);
+   const int nnz_diag = hypre_CSRMatrixI(Ae_diag)[nrows];
+
+   Array<bool> ess_row(nrows);
+   ess_row = false;
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      ess_row[ess_tdof_list[i]] = true;
+   }
+
+   // Every entry of Ae is an entry of A moved by the elimination, except for
+   // the unit diagonal of the eliminated rows
+   p_elim_map.SetSize(0);
+   for (int i = 0; i < nrows; i++)
+   {
+      for (int k = hypre_CSRMatrixI(Ae_diag)[i];
+           k < hypre_CSRMatrixI(Ae_diag)[i+1]; k++)
+      {
+         const HYPRE_Int col = Ae_col_start + hypre_CSRMatrixJ(Ae_diag)[k];
+         const int rec[3] = { find.Find(i, col), k,
+                              ess_row[i] && col == row_start + i
+                            };
+         MFEM_ASSERT(rec[0] >= 0, "invalid eliminated entry");
+         p_elim_map.Append(rec, 3);
+      }
+      for (int k = hypre_CSRMatrixI(Ae_offd)[i];
+           k < hypre_CSRMatrixI(Ae_offd)[i+1]; k++)
+      {
+         const HYPRE_Int col = Ae_cmap[hypre_CSRMatrixJ(Ae_offd)[k]];
+         const int rec[3] = { find.Find(i, col), nnz_diag + k, 0 };
+         MFEM_ASSERT(rec[0] >= 0, "invalid eliminated entry");
+         p_elim_map.Append(rec, 3);
+      }
+   }
+   ess_tdof_list.Copy(p_elim_tdofs);
+}
+
+void ParBilinearForm::UpdateParallelValues(const Array<int> &ess_tdof_list)
+{
+   hypre_ParCSRMatrix *A = *p_mat.As<HypreParMatrix>();
+   hypre_CSRMatrix *A_diag = hypre_ParCSRMatrixDiag(A);
+   hypre_CSRMatrix *A_offd = hypre_ParCSRMatrixOffd(A);
+   double *a_diag = hypre_CSRMatrixData(A_diag);
+   double *a_offd = hypre_CSRMatrixData(A_offd);
+   const int nrows = hypre_CSRMatrixNumRows(A_diag);
+   const int nnz_diag = hypre_CSRMatrixI(A_diag)[nrows];
+   const int nnz_offd = hypre_CSRMatrixI(A_offd)[nrows];
+   std::fill(a_diag, a_diag + nnz_diag, 0.0);
+   std::fill(a_offd, a_offd + nnz_offd, 0.0);
+
+   // Send the remote contributions first and add the local ones meanwhile
+   const double *m = mat->GetData();
+   const int nmap = p_map_w.Size();
+   Vector send_buf(p_send_offsets.Last()), recv_buf(p_recv_offsets.Last());
+   send_buf = 0.0;
+   int i = 0;
+   for ( ; i < nmap && p_map[2*i+1] < 0; i++)
+   {
+      send_buf(-1 - p_map[2*i+1]) += p_map_w[i]*m[p_map[2*i]];
+   }
+   MPI_Comm comm = pfes->GetComm();
+   Array<MPI_Request> requests(p_send_ranks.Size() + p_recv_ranks.Size());
+   const int tag = 832;
+   for (int q = 0; q < p_recv_ranks.Size(); q++)
+   {
+      MPI_Irecv(recv_buf.GetData() + p_recv_offsets[q],
+                p_recv_offsets[q+1] - p_recv_offsets[q], MPI_DOUBLE,
+                p_recv_ranks[q], tag, comm, &requests[q]);
+   }
+   for (int q = 0; q < p_send_ranks.Size(); q++)
+   {
+      MPI_Isend(send_buf.GetData() + p_send_offsets[q],
+                p_send_offsets[q+1] - p_send_offsets[q], MPI_DOUBLE,
+                p_send_ranks[q], tag, comm,
+                &requests[p_recv_ranks.Size() + q]);
+   }
+   for ( ; i < nmap; i++)
+   {
+      ParCSREntry(a_diag, a_offd, nnz_diag, p_map[2*i+1]) +=
+         p_map_w[i]*m[p_map[2*i]];
+   }
+   MPI_Waitall(requests.Size(), requests.GetData(), MPI_STATUSES_IGNORE);
+   for (int j = 0; j < p_recv_map.Size(); j++)
+   {
+      ParCSREntry(a_diag, a_offd, nnz_diag, p_recv_map[j]) += recv_buf(j);
+   }
+
+   // Move the eliminated entries to p_mat_e, as in EliminateRowsCols()
+   if (p_map_state != 2 || p_elim_tdofs.Size() != ess_tdof_list.Size() ||
+       !std::equal(ess_tdof_list.begin(), ess_tdof_list.end(),
+                   p_elim_tdofs.begin()))
+   {
+      p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
+      SetupParallelElimMap(ess_tdof_list);
+      p_map_state = 2;
+      return;
+   }
+   hypre_ParCSRMatrix *Ae = *p_mat_e.As<HypreParMatrix>();
+   hypre_CSRMatrix *Ae_diag = hypre_ParCSRMatrixDiag(Ae);
+   double *ae_diag = hypre_CSRMatrixData(Ae_diag);
+   double *ae_offd = hypre_CSRMatrixData(hypre_ParCSRMatrixOffd(Ae));
+   const int nnz_e_diag = hypre_CSRMatrixI(Ae_diag)[nrows];
+   for (int j = 0; j < p_elim_map.Size(); j += 3)
+   {
+      double &a = ParCSREntry(a_diag, a_offd, nnz_diag, p_elim_map[j]);
+      const double d = p_elim_map[j+2];
+      ParCSREntry(ae_diag, ae_offd, nnz_e_diag, p_elim_map[j+1]) = a - d;
+      a = d;
+   }
+}
+
 void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                        OperatorHandle &A)
 {
@@ -368,19 +793,60 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
    }
    else
    {
-      if (mat)
+      if (mat && (!reuse_sparsity || reassembled))
       {
          const int remove_zeros = 0;
          Finalize(remove_zeros);
-         MFEM_VERIFY(p_mat.Ptr() == NULL && p_mat_e.Ptr() == NULL,
-                     "The ParBilinearForm must be updated with Update() before "
-                     "re-assembling the ParBilinearForm.");
-         ParallelAssemble(p_mat, mat);
-         delete mat;
-         mat = NULL;
-         delete mat_e;
-         mat_e = NULL;
-         p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
+         if (reuse_sparsity && p_mat.Ptr() && p_mat_e.Ptr() &&
+             p_mat.Type() == Operator::Hypre_ParCSR && p_map_state == 0)
+         {
+            p_map_state = SetupParallelValuesMap() ? 1 : -1;
+         }
+         if (reuse_sparsity && p_map_state > 0)
+         {
+            // Refill the diag and offd blocks of the parallel matrices
+            UpdateParallelValues(ess_tdof_list);
+         }
+         else if (reuse_sparsity && p_mat.Ptr() &&
+                  p_mat.Type() == Operator::Hypre_ParCSR)
+         {
+            // With face integrators, copy the values of a new triple product
+            OperatorHandle new_mat(p_mat.Type()), new_mat_e(p_mat.Type());
+            ParallelAssemble(new_mat, mat);
+            new_mat_e.EliminateRowsCols(new_mat, ess_tdof_list);
+            if (!CopyParMatrixValues(*new_mat.As<HypreParMatrix>(),
+                                     *p_mat.As<HypreParMatrix>()) ||
+                !CopyParMatrixValues(*new_mat_e.As<HypreParMatrix>(),
+                                     *p_mat_e.As<HypreParMatrix>()))
+            {
+               new_mat.SetOperatorOwner(false);
+               new_mat_e.SetOperatorOwner(false);
+               p_mat.Reset(new_mat.As<HypreParMatrix>());
+               p_mat_e.Reset(new_mat_e.As<HypreParMatrix>());
+            }
+         }
+         else
+         {
+            if (reuse_sparsity)
+            {
+               p_mat.Clear();
+               p_mat_e.Clear();
+            }
+            MFEM_VERIFY(p_mat.Ptr() == NULL && p_mat_e.Ptr() == NULL,
+                        "The ParBilinearForm must be updated with Update() "
+                        "before re-assembling the ParBilinearForm.");
+            ParallelAssemble(p_mat, mat);
+            p_map_state = 0;
+            if (!reuse_sparsity)
+            {
+               delete mat;
+               mat = NULL;
+            }
+            delete mat_e;
+            mat_e = NULL;
+            p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
+         }
+         reassembled = false;
       }
       if (hybridization)
       {
@@ -440,6 +906,7 @@ void ParBilinearForm::Update(FiniteElementSpace *nfes)
 
    p_mat.Clear();
    p_mat_e.Clear();
+   p_map_state = 0;
 }
 
 
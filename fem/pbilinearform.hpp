@@ -37,9 +37,43 @@ protected:
 
    bool keep_nbr_block;
 
+   /** @brief With #reuse_sparsity: the state of the maps updating the values
+       of #p_mat and #p_mat_e in place. */
+   /** 0: not set up, 1: #p_map is set up, 2: #p_map and #p_elim_map are set
+       up, -1: not supported (face integrators), the values are then copied
+       from a new triple product. */
+   int p_map_state;
+   /** @brief Pairs (entry of #mat, entry of #p_mat) with weights #p_map_w:
+       the contributions of #mat to the entries of #p_mat. */
+   /** The entries of #p_mat are numbered with the entries of its diag block
+       first. The contributions to the rows of other ranks come first, with
+       the entry -1-i of the i-th value sent to #p_send_ranks. */
+   Array<int> p_map;
+   Array<double> p_map_w;
+   /// The ranks and the offsets of the values sent and received by #p_map.
+   Array<int> p_send_ranks, p_send_offsets, p_recv_ranks, p_recv_offsets;
+   /// The entries of #p_mat of the received values.
+   Array<int> p_recv_map;
+   /** @brief Triples (entry of #p_mat, entry of #p_mat_e, diagonal) of the
+       entries moved by the elimination of #p_elim_tdofs. */
+   Array<int> p_elim_map;
+   /// The essential true dofs corresponding to #p_elim_map.
+   Array<int> p_elim_tdofs;
+
    // Allocate mat - called when (mat == NULL && fbfi.Size() > 0)
    void pAllocMat();
 
+   /** @brief Set up #p_map for the current #mat and #p_mat. Returns false if
+       the pattern of #p_mat does not contain the triple product of #mat. */
+   bool SetupParallelValuesMap();
+
+   /// Set up #p_elim_map for the current #p_mat and #p_mat_e.
+   void SetupParallelElimMap(const Array<int> &ess_tdof_list);
+
+   /** @brief Refill #p_mat and #p_mat_e with the values of #mat, keeping their
+       sparsity patterns. */
+   void UpdateParallelValues(const Array<int> &ess_tdof_list);
+
    void AssembleSharedFaces(int skip_zeros = 1);
 
 private:
@@ -55,7 +89,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf)
       : BilinearForm(pf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; p_map_state = 0; }
 
    /** @brief Create a ParBilinearForm on the ParFiniteElementSpace @a *pf,
        using the same integrators as the ParBilinearForm @a *bf.
@@ -67,7 +101,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf, ParBilinearForm *bf)
       : BilinearForm(pf, bf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; p_map_state = 0; }
 
    /** When set to true and the ParBilinearForm has interior face integrators,
        the local SparseMatrix will include the rows (in addition to the columns)
@@ -75,6 +109,13 @@ public:
        those rows. Must be called before the first Assemble call. */
    void KeepNbrBlock(bool knb = true) { keep_nbr_block = knb; }
 
+   /** @brief Overlap the exchange of the shared dofs with the local work in
+       the operator returned by FormSystemMatrix() and FormLinearSystem(). */
+   /** Only supported with AssemblyLevel::PARTIAL, must be called after
+       SetAssemblyLevel() and before Assemble(), which then stores the elements
+       that do not touch non-owned dofs first. See ParPAOverlapOperator. */
+   void SetCommunicationOverlap(bool overlap = true);
+
    /** @brief Set the operator type id for the parallel matrix/operator when
        using AssemblyLevel::FULL. */
    /** If using static condensation or hybridization, call this method *after*
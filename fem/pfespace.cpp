@@ -2464,21 +2464,29 @@ HypreParMatrix*
 ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
                                        const Table* old_elem_dof)
 {
-   MFEM_VERIFY(Nonconforming(), "Only supported for nonconforming meshes.");
    MFEM_VERIFY(old_dof_offsets.Size(), "ParFiniteElementSpace::Update needs to "
                "be called before ParFiniteElementSpace::RebalanceMatrix");
 
    HYPRE_Int old_offset = HYPRE_AssumedPartitionCheck()
                           ? old_dof_offsets[0] : old_dof_offsets[MyRank];
 
-   // send old DOFs of elements we used to own
+   // send old DOFs of elements we used to own; the element exchange pattern
+   // is kept by the ParNCMesh or, for conforming meshes, by the ParMesh
    ParNCMesh* pncmesh = pmesh->pncmesh;
-   pncmesh->SendRebalanceDofs(old_ndofs, *old_elem_dof, old_offset, this);
+   if (pncmesh)
+   {
+      pncmesh->SendRebalanceDofs(old_ndofs, *old_elem_dof, old_offset, this);
+   }
+   else
+   {
+      pmesh->SendRebalanceDofs(old_ndofs, *old_elem_dof, old_offset, this);
+   }
 
    Array<int> dofs;
    int vsize = GetVSize();
 
-   const Array<int> &old_index = pncmesh->GetRebalanceOldIndex();
+   const Array<int> &old_index = pncmesh ? pncmesh->GetRebalanceOldIndex()
+                                 : pmesh->GetRebalanceOldIndex();
    MFEM_VERIFY(old_index.Size() == pmesh->GetNE(),
                "Mesh::Rebalance was not called before "
                "ParFiniteElementSpace::RebalanceMatrix");
@@ -2512,7 +2520,14 @@ ParFiniteElementSpace::RebalanceMatrix(int old_ndofs,
    // receive old DOFs for elements we obtained from others in Rebalance
    Array<int> new_elements;
    Array<long> old_remote_dofs;
-   pncmesh->RecvRebalanceDofs(new_elements, old_remote_dofs);
+   if (pncmesh)
+   {
+      pncmesh->RecvRebalanceDofs(new_elements, old_remote_dofs);
+   }
+   else
+   {
+      pmesh->RecvRebalanceDofs(new_elements, old_remote_dofs);
+   }
 
    // create the offdiagonal part of the matrix
    HYPRE_Int* i_offd = make_i_array(vsize);
@@ -3120,6 +3135,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   num_requests = 0;
 }
 
 static void ExtractSubVector(const int N,
@@ -3169,8 +3185,8 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
    SetSubVector(ext_ldof.Size(), ext_ldof, ext_buf, y);
 }
 
-void DeviceConformingProlongationOperator::Mult(const Vector &x,
-                                                Vector &y) const
+void DeviceConformingProlongationOperator::BcastBegin(const Vector &x,
+                                                      Vector &y) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    BcastBeginCopy(x); // copy to 'shr_buf'
@@ -3196,11 +3212,24 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
                    gtopo.GetComm(), &requests[req_counter++]);
       }
    }
+   num_requests = req_counter;
    BcastLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+}
+
+void DeviceConformingProlongationOperator::BcastEnd(Vector &y) const
+{
+   MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   num_requests = 0;
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
+void DeviceConformingProlongationOperator::Mult(const Vector &x,
+                                                Vector &y) const
+{
+   BcastBegin(x, y);
+   BcastEnd(y);
+}
+
 DeviceConformingProlongationOperator::~DeviceConformingProlongationOperator()
 {
    delete [] requests;
@@ -3257,8 +3286,7 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
    AddSubVector(unq_ltdof_size, unq_ltdof, unq_shr_i, unq_shr_j, shr_buf, y);
 }
 
-void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
-                                                         Vector &y) const
+void DeviceConformingProlongationOperator::ReduceBegin(const Vector &x) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    ReduceBeginCopy(x); // copy to 'ext_buf'
@@ -3284,11 +3312,25 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                    gtopo.GetComm(), &requests[req_counter++]);
       }
    }
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::ReduceEnd(const Vector &x,
+                                                     Vector &y) const
+{
    ReduceLocalCopy(x, y);
-   MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+   MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+   num_requests = 0;
    ReduceEndAssemble(y); // assemble from 'shr_buf'
 }
 
+void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
+                                                         Vector &y) const
+{
+   ReduceBegin(x);
+   ReduceEnd(x, y);
+}
+
 } // namespace mfem
 
 #endif
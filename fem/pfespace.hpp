@@ -393,6 +393,9 @@ protected:
 public:
    ConformingProlongationOperator(const ParFiniteElementSpace &pfes);
 
+   /// Return the sorted list of the ldofs that are not owned by this rank.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
@@ -410,6 +413,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_requests;
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
    void BcastBeginCopy(const Vector &src) const;
@@ -439,6 +443,24 @@ public:
 
    virtual ~DeviceConformingProlongationOperator();
 
+   /** @brief Begin the computation of y = P x: start the exchange of the
+       shared dofs and set the owned ldofs of @a y. */
+   /** The external ldofs of @a y are set by BcastEnd(), so work that depends
+       only on the owned ldofs can be done in between. */
+   void BcastBegin(const Vector &x, Vector &y) const;
+
+   /// Finish the computation started by BcastBegin().
+   void BcastEnd(Vector &y) const;
+
+   /** @brief Begin the computation of y = P^T x: start the exchange of the
+       external ldofs of @a x. */
+   /** Only the external ldofs of @a x are used here, the owned ldofs of @a x
+       can be computed before calling ReduceEnd(). */
+   void ReduceBegin(const Vector &x) const;
+
+   /// Finish the computation started by ReduceBegin().
+   void ReduceEnd(const Vector &x, Vector &y) const;
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
@@ -95,6 +95,9 @@ void ParNonlinearForm::Mult(const Vector &x, Vector &y) const
 
 const SparseMatrix &ParNonlinearForm::GetLocalGradient(const Vector &x) const
 {
+   MFEM_VERIFY(NonlinearForm::ext == NULL,
+               "this method is not supported yet with partial assembly");
+
    NonlinearForm::GetGradient(x); // (re)assemble Grad, no b.c.
 
    return *Grad;
@@ -102,6 +105,8 @@ const SparseMatrix &ParNonlinearForm::GetLocalGradient(const Vector &x) const
 
 Operator &ParNonlinearForm::GetGradient(const Vector &x) const
 {
+   if (NonlinearForm::ext) { return NonlinearForm::GetGradient(x); }
+
    ParFiniteElementSpace *pfes = ParFESpace();
 
    pGrad.Clear();
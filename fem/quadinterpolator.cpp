@@ -25,6 +25,8 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    IntRule = &ir;
    q_layout = QVectorLayout::byNODES;
    use_tensor_products = true; // not implemented yet (not used)
+   geom = Geometry::INVALID;
+   geom_ne = geom_el = 0;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -40,6 +42,8 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
    IntRule = NULL;
    q_layout = QVectorLayout::byNODES;
    use_tensor_products = true; // not implemented yet (not used)
+   geom = Geometry::INVALID;
+   geom_ne = geom_el = 0;
 
    if (fespace->GetNE() == 0) { return; }
    const FiniteElement *fe = fespace->GetFE(0);
@@ -47,6 +51,29 @@ QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
                "Only scalar finite elements are supported");
 }
 
+QuadratureInterpolator::QuadratureInterpolator(const FiniteElementSpace &fes,
+                                               const IntegrationRule &ir,
+                                               Geometry::Type geom)
+{
+   fespace = &fes;
+   qspace = NULL;
+   IntRule = &ir;
+   q_layout = QVectorLayout::byNODES;
+   use_tensor_products = true; // not implemented yet (not used)
+   this->geom = geom;
+   geom_ne = geom_el = 0;
+
+   const Mesh *mesh = fespace->GetMesh();
+   for (int e = mesh->GetNE() - 1; e >= 0; e--)
+   {
+      if (mesh->GetElementBaseGeometry(e) == geom) { geom_el = e; geom_ne++; }
+   }
+   if (geom_ne == 0) { return; }
+   const FiniteElement *fe = fespace->GetFE(geom_el);
+   MFEM_VERIFY(dynamic_cast<const ScalarFiniteElement*>(fe) != NULL,
+               "Only scalar finite elements are supported");
+}
+
 template<const int T_VDIM, const int T_ND, const int T_NQ>
 void QuadratureInterpolator::Eval2D(
    const int NE,
@@ -238,6 +265,7 @@ void QuadratureInterpolator::Mult(
 {
    if (q_layout == QVectorLayout::byVDIM)
    {
+      MFEM_VERIFY(geom == Geometry::INVALID, "not supported yet");
       if (eval_flags & VALUES) { Values(e_vec, q_val); }
       if (eval_flags & DERIVATIVES) { Derivatives(e_vec, q_der); }
       if (eval_flags & DETERMINANTS)
@@ -249,11 +277,12 @@ void QuadratureInterpolator::Mult(
    }
 
    // q_layout == QVectorLayout::byNODES
-   const int ne = fespace->GetNE();
+   const bool all = (geom == Geometry::INVALID);
+   const int ne = all ? fespace->GetNE() : geom_ne;
    if (ne == 0) { return; }
    const int vdim = fespace->GetVDim();
    const int dim = fespace->GetMesh()->Dimension();
-   const FiniteElement *fe = fespace->GetFE(0);
+   const FiniteElement *fe = fespace->GetFE(all ? 0 : geom_el);
    const IntegrationRule *ir =
       IntRule ? IntRule : &qspace->GetElementIntRule(0);
    const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
@@ -43,6 +43,10 @@ protected:
    const IntegrationRule *IntRule;     ///< Not owned
    mutable QVectorLayout q_layout;     ///< Output Q-vector layout
 
+   /// Element geometry the interpolator acts on, or Geometry::INVALID for all.
+   Geometry::Type geom;
+   int geom_ne, geom_el; ///< Number of elements of #geom and the first one
+
    mutable bool use_tensor_products;
 
    static const int MAX_NQ2D = 100;
@@ -70,6 +74,14 @@ public:
    QuadratureInterpolator(const FiniteElementSpace &fes,
                           const QuadratureSpace &qs);
 
+   /** @brief Construct an interpolator acting only on the elements with
+       geometry @a geom, on a mesh with several element geometries. */
+   /** The E-vector passed to Mult() is then the part of the E-vector of the
+       ElementRestriction holding the group of elements with geometry @a geom,
+       and the Q-vectors only contain the values of these elements. */
+   QuadratureInterpolator(const FiniteElementSpace &fes,
+                          const IntegrationRule &ir, Geometry::Type geom);
+
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
    /** Currently, tensor product evaluations are not implemented and this method
@@ -18,22 +18,113 @@ namespace mfem
 {
 
 ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
-                                       ElementDofOrdering e_ordering)
+                                       ElementDofOrdering e_ordering,
+                                       const Array<int> *e_order)
    : fes(f),
      ne(fes.GetNE()),
      vdim(fes.GetVDim()),
      byvdim(fes.GetOrdering() == Ordering::byVDIM),
      ndofs(fes.GetNDofs()),
      dof(ne > 0 ? fes.GetFE(0)->GetDof() : 0),
-     nedofs(ne*dof),
+     nedofs(fes.GetElementToDofTable().Size_of_connections()),
      offsets(ndofs+1),
-     indices(ne*dof),
-     gatherMap(ne*dof)
+     indices(nedofs),
+     gatherMap(nedofs)
 {
-   // Assuming all finite elements are the same.
-   height = vdim*ne*dof;
+   height = vdim*nedofs;
    width = fes.GetVSize();
+
+   // Group the elements by geometry, skipping the geometries without local
+   // elements (e.g. on some processors of a ParMesh)
+   const Mesh &mesh = *fes.GetMesh();
+   Array<Geometry::Type> geoms;
+   mesh.GetGeometries(mesh.Dimension(), geoms);
+   for (int g = 0; g < geoms.Size(); g++)
+   {
+      for (int e = 0; e < ne; e++)
+      {
+         if (mesh.GetElementBaseGeometry(e) == geoms[g])
+         {
+            group_geoms.Append(geoms[g]);
+            break;
+         }
+      }
+   }
+   const int ngroups = group_geoms.Size();
+   group_offsets.SetSize(ngroups + 1);
+   group_elements.SetSize(ne);
+   group_dofs.SetSize(ngroups);
+   group_eoffsets.SetSize(ngroups + 1);
+   group_offsets[0] = group_eoffsets[0] = 0;
+   for (int g = 0, k = 0; g < ngroups; g++)
+   {
+      for (int e = 0; e < ne; e++)
+      {
+         if (ngroups == 1 || mesh.GetElementBaseGeometry(e) == group_geoms[g])
+         {
+            group_elements[k++] = e;
+         }
+      }
+      group_offsets[g+1] = k;
+      group_dofs[g] = fes.GetFE(group_elements[group_offsets[g]])->GetDof();
+      group_eoffsets[g+1] = group_eoffsets[g] +
+                            vdim*group_dofs[g]*(k - group_offsets[g]);
+   }
+
    const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
+   const Table& e2dTable = fes.GetElementToDofTable();
+   if (IsMixed())
+   {
+      MFEM_VERIFY(!e_order, "Element reordering is not supported on meshes"
+                  " with several element geometries");
+      MFEM_VERIFY(!dof_reorder, "Lexicographic ordering is not supported on"
+                  " meshes with several element geometries");
+      // Same construction as below, with the elements ordered by group and a
+      // variable number of dofs per element.
+      const int *I = e2dTable.GetI();
+      const int *J = e2dTable.GetJ();
+      e_index.SetSize(nedofs);
+      e_stride.SetSize(nedofs);
+      offsets = 0;
+      for (int k = 0; k < nedofs; ++k)
+      {
+         const int sgid = J[k];
+         const int gid = (sgid >= 0) ? sgid : -1 - sgid;
+         ++offsets[gid + 1];
+      }
+      for (int i = 1; i <= ndofs; ++i)
+      {
+         offsets[i] += offsets[i - 1];
+      }
+      int lid = 0;
+      for (int g = 0; g < ngroups; g++)
+      {
+         const int nd = group_dofs[g];
+         for (int k = group_offsets[g]; k < group_offsets[g+1]; k++)
+         {
+            const int e = group_elements[k];
+            MFEM_VERIFY(I[e+1] - I[e] == nd, "invalid number of element dofs");
+            for (int d = 0; d < nd; ++d, ++lid)
+            {
+               const int sgid = J[I[e] + d];  // signed
+               const int gid = (sgid >= 0) ? sgid : -1-sgid;
+               gatherMap[lid] = sgid;
+               indices[offsets[gid]++] = (sgid >= 0) ? lid : -1-lid;
+               e_index[lid] = group_eoffsets[g] +
+                              d + nd*vdim*(k - group_offsets[g]);
+               e_stride[lid] = nd;
+            }
+         }
+      }
+      for (int i = ndofs; i > 0; --i)
+      {
+         offsets[i] = offsets[i - 1];
+      }
+      offsets[0] = 0;
+      return;
+   }
+
+   // Assuming all finite elements are the same.
    const int *dof_map = NULL;
    if (dof_reorder && ne > 0)
    {
@@ -52,7 +143,6 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
       MFEM_VERIFY(fe_dof_map.Size() > 0, "invalid dof map");
       dof_map = fe_dof_map.GetData();
    }
-   const Table& e2dTable = fes.GetElementToDofTable();
    const int* elementMap = e2dTable.GetJ();
    // We will be keeping a count of how many local nodes point to its global dof
    for (int i = 0; i <= ndofs; ++i)
@@ -76,11 +166,12 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    // For each global dof, fill in all local nodes that point to it
    for (int e = 0; e < ne; ++e)
    {
+      const int me = e_order ? (*e_order)[e] : e; // mesh element
       for (int d = 0; d < dof; ++d)
       {
          const int sdid = dof_reorder ? dof_map[d] : 0;  // signed
          const int did = (!dof_reorder)?d:(sdid >= 0 ? sdid : -1-sdid);
-         const int sgid = elementMap[dof*e + did];  // signed
+         const int sgid = elementMap[dof*me + did];  // signed
          const int gid = (sgid >= 0) ? sgid : -1-sgid;
          const int lid = dof*e + d;
          const bool plus = (sgid >= 0 && sdid >= 0) || (sgid < 0 && sdid < 0);
@@ -99,6 +190,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   if (IsMixed()) { MixedMult(x, y, true); return; }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -121,6 +213,7 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 {
+   if (IsMixed()) { MixedMult(x, y, false); return; }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -140,8 +233,35 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultElements(const Vector& x, Vector& y,
+                                      const int e_begin, const int e_end) const
+{
+   MFEM_VERIFY(!IsMixed(), "not supported with several element geometries");
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int nel = e_end - e_begin;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+   auto d_gatherMap = gatherMap.Read();
+   MFEM_FORALL(i, nd*nel,
+   {
+      const int e = e_begin + i / nd;
+      const int gid = d_gatherMap[nd*e + i % nd];
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(i % nd, c, e) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   if (IsMixed()) { MixedMultTranspose(x, y, true); return; }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -159,7 +279,42 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
          double dofValue = 0;
          for (int j = offset; j < nextOffset; ++j)
          {
-            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] :
+                              -1 - d_indices[j];
+            dofValue += (d_indices[j] >= 0) ? d_x(idx_j % nd, c,
+            idx_j / nd) : -d_x(idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeDofs(const Vector& x, Vector& y,
+                                           const Array<int> &dofs) const
+{
+   MFEM_VERIFY(!IsMixed(), "not supported with several element geometries");
+   // Assumes all elements have the same number of dofs
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int nsub = dofs.Size();
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_dofs = dofs.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(k, nsub,
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] :
+                              -1 - d_indices[j];
             dofValue += (d_indices[j] >= 0) ? d_x(idx_j % nd, c,
             idx_j / nd) : -d_x(idx_j % nd, c, idx_j / nd);
          }
@@ -170,6 +325,7 @@ void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
 {
+   if (IsMixed()) { MixedMultTranspose(x, y, false); return; }
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -195,8 +351,62 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MixedMult(const Vector& x, Vector& y,
+                                   const bool use_signs) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = y.Write();
+   auto d_gatherMap = gatherMap.Read();
+   auto d_e_index = e_index.Read();
+   auto d_e_stride = e_stride.Read();
+   MFEM_FORALL(i, nedofs,
+   {
+      const int gid = d_gatherMap[i];
+      const bool plus = !use_signs || gid >= 0;
+      const int j = gid >= 0 ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y[d_e_index[i] + c*d_e_stride[i]] = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MixedMultTranspose(const Vector& x, Vector& y,
+                                            const bool use_signs) const
+{
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_e_index = e_index.Read();
+   auto d_e_stride = e_stride.Read();
+   auto d_x = x.Read();
+   auto d_y = Reshape(y.Write(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const bool plus = !use_signs || d_indices[j] >= 0;
+            const int lid = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            const double value = d_x[d_e_index[lid] + c*d_e_stride[lid]];
+            dofValue += plus ? value : -value;
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::BooleanMask(Vector& y) const
 {
+   MFEM_VERIFY(!IsMixed(), "not supported with several element geometries");
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -283,6 +493,7 @@ static MFEM_HOST_DEVICE int GetAndIncrementNnzIndex(const int i_L, int* I)
 
 int ElementRestriction::FillI(SparseMatrix &mat) const
 {
+   MFEM_VERIFY(!IsMixed(), "not supported with several element geometries");
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
@@ -357,6 +568,7 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
 void ElementRestriction::FillJAndData(const Vector &ea_data,
                                       SparseMatrix &mat) const
 {
+   MFEM_VERIFY(!IsMixed(), "not supported with several element geometries");
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
    const int vd = vdim;
@@ -453,6 +665,9 @@ L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
      ndof(ne > 0 ? fes.GetFE(0)->GetDof() : 0),
      ndofs(fes.GetNDofs())
 {
+   const Mesh &mesh = *fes.GetMesh();
+   MFEM_VERIFY(mesh.GetNumGeometries(mesh.Dimension()) <= 1, "meshes with "
+               "several element geometries are not supported");
    height = vdim*ne*ndof;
    width = vdim*ne*ndof;
 }
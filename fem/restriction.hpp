@@ -27,7 +27,14 @@ enum class L2FaceValues : bool {SingleValued, DoubleValued};
 
 /// Operator that converts FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
-    objects, see FiniteElementSpace::GetElementRestriction(). */
+    objects, see FiniteElementSpace::GetElementRestriction().
+
+    The elements are stored in groups of elements with the same geometry, in
+    increasing order of Geometry::Type, and in increasing element order within
+    each group. Group g is stored as an (ND_g x VDIM x NE_g) array starting at
+    GetGroupOffset(g), where ND_g is the number of dofs of its elements. When
+    the mesh has only one element geometry, there is a single group and this is
+    the usual (ND x VDIM x NE) layout. */
 class ElementRestriction : public Operator
 {
 private:
@@ -47,8 +54,32 @@ protected:
    Array<int> indices;
    Array<int> gatherMap;
 
+   // Element groups with the same geometry
+   Array<Geometry::Type> group_geoms;
+   Array<int> group_offsets;   // offsets of the groups in group_elements
+   Array<int> group_elements;  // mesh element indices, ordered by group
+   Array<int> group_dofs;      // number of dofs of the elements of each group
+   Array<int> group_eoffsets;  // offsets of the groups in the E-vector
+
+   // Only used on meshes with several geometries: E-vector index of the first
+   // component of each local dof, and the E-vector stride of its components.
+   Array<int> e_index, e_stride;
+
+   bool IsMixed() const { return group_geoms.Size() > 1; }
+
+   void MixedMult(const Vector &x, Vector &y, const bool use_signs) const;
+   void MixedMultTranspose(const Vector &x, Vector &y,
+                           const bool use_signs) const;
+
 public:
-   ElementRestriction(const FiniteElementSpace&, ElementDofOrdering);
+   /** @brief Construct the restriction for the elements of @a fes, in mesh
+       order or, if @a e_order is given, in the order of the mesh elements
+       @a e_order[e]. */
+   /** The element order is not supported on meshes with several element
+       geometries. */
+   ElementRestriction(const FiniteElementSpace &fes,
+                      ElementDofOrdering e_ordering,
+                      const Array<int> *e_order = NULL);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
 
@@ -57,6 +88,30 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /// Return the number of groups of elements with the same geometry.
+   int GetNumGroups() const { return group_geoms.Size(); }
+   /// Return the element geometry of group @a g.
+   Geometry::Type GetGroupGeometry(int g) const { return group_geoms[g]; }
+   /// Return the number of elements in group @a g.
+   int GetGroupNE(int g) const
+   { return group_offsets[g+1] - group_offsets[g]; }
+   /// Return the number of dofs of each element of group @a g.
+   int GetGroupDofs(int g) const { return group_dofs[g]; }
+   /// Return the offset of group @a g in the E-vector.
+   int GetGroupOffset(int g) const { return group_eoffsets[g]; }
+   /// Return the mesh indices of the elements of group @a g.
+   const int *GetGroupElements(int g) const
+   { return group_elements.GetData() + group_offsets[g]; }
+
+   /** @brief Compute the E-vector entries of the elements e_begin <= e < e_end
+       only, the other entries of @a y are not modified. */
+   void MultElements(const Vector &x, Vector &y,
+                     const int e_begin, const int e_end) const;
+   /** @brief Compute the L-vector entries of the given (scalar) @a dofs only,
+       the other entries of @a y are not modified. */
+   void MultTransposeDofs(const Vector &x, Vector &y,
+                          const Array<int> &dofs) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -945,6 +945,26 @@ protected:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   const FiniteElementSpace *fespace; ///< Not owned
+   const DofToQuad *maps;             ///< Not owned
+   const IntegrationRule *pa_ir;      ///< Not owned
+   int pa_dim, pa_ne, pa_nq;
+   // Metric evaluated on the device in AddMultPA(), 0 when it is evaluated on
+   // the host through the TMOP_QualityMetric interface.
+   int pa_metric_id;
+   // pa_Jtr, pa_Jrt: target Jacobians and their inverses at the quadrature
+   //                 points, (dim x dim x nq x ne).
+   // pa_weights: quadrature weights times target Jacobian determinants, times
+   //             the constant weight coefficient, (nq x ne).
+   // pa_grad: reference-space metric Hessians at the linearization state,
+   //          (dim^2 x dim^2 x nq x ne).
+   Vector pa_Jtr, pa_Jrt, pa_weights, pa_grad;
+   // Reference gradients of the input and the quadrature point stresses.
+   mutable Vector pa_jac, pa_stress;
+
+   void PAEvalStressHost(const double normal) const;
+
    void ComputeNormalizationEnergies(const GridFunction &x,
                                      double &metric_energy, double &lim_energy);
 
@@ -1022,7 +1042,9 @@ public:
         lim_dist(NULL), lim_func(NULL), lim_normal(1.0),
         zeta_0(NULL), zeta(NULL), coeff_zeta(NULL), adapt_eval(NULL),
         discr_tc(dynamic_cast<DiscreteAdaptTC *>(tc)),
-        fdflag(false), dxscale(1.0e3), fd_call_flag(false), exact_action(false)
+        fdflag(false), dxscale(1.0e3), fd_call_flag(false), exact_action(false),
+        fespace(NULL), maps(NULL), pa_ir(NULL), pa_dim(0), pa_ne(0), pa_nq(0),
+        pa_metric_id(0)
    { }
 
    ~TMOP_Integrator();
@@ -1100,6 +1122,26 @@ public:
                                     ElementTransformation &T,
                                     const Vector &elfun, DenseMatrix &elmat);
 
+   /** @brief Partial assembly of the metric term on tensor-product meshes.
+
+       The target Jacobians are computed here, so this method has to be called
+       again, e.g. through NonlinearForm::Setup(), when the target nodes
+       change. Limiting, finite differences, exact actions of adaptive targets
+       and non-constant weight coefficients are not supported. The metrics
+       001, 002 (2D) and 302, 303, 321 (3D) are evaluated on the device; all
+       other metrics are evaluated on the host. */
+   using NonlinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
+   /// Assemble the metric Hessians at the quadrature points (on the host).
+   virtual void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes);
+
+   virtual void AddMultGradPA(const Vector &x, Vector &y) const;
+
+   virtual void AssembleGradDiagonalPA(Vector &diag) const;
+
    DiscreteAdaptTC *GetDiscreteAdaptTC() const { return discr_tc; }
 
    /** @brief Computes the normalization factors of the metric and limiting
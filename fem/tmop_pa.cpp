@@ -0,0 +1,331 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "tmop.hpp"
+#include "nonlininteg_pa.hpp"
+
+namespace mfem
+{
+
+// Device versions of TMOP_QualityMetric::EvalP() for the metrics supported by
+// the PA kernels. The matrices are column-major, J is the target->physical
+// Jacobian and K = J^{-1}.
+
+// mu_1 = |J|^2, P = 2 J
+MFEM_HOST_DEVICE static inline
+void TMOPEvalP_001(const double *J, double *P)
+{
+   for (int i = 0; i < 4; i++) { P[i] = 2.0 * J[i]; }
+}
+
+// mu_2 = 0.5 |J|^2 / det(J) - 1, P = J / det(J) - 0.5 |J|^2 / det(J) K^t
+MFEM_HOST_DEVICE static inline
+void TMOPEvalP_002(const double *J, double *P)
+{
+   double K[4];
+   const double det = kernels::Det<2>(J);
+   kernels::CalcInverse<2>(J, K);
+   const double I1 = J[0]*J[0] + J[1]*J[1] + J[2]*J[2] + J[3]*J[3];
+   const double alpha = 1.0 / det, beta = -0.5 * I1 / det;
+   P[0] = alpha * J[0] + beta * K[0];
+   P[1] = alpha * J[1] + beta * K[2];
+   P[2] = alpha * J[2] + beta * K[1];
+   P[3] = alpha * J[3] + beta * K[3];
+}
+
+// Computes B = K^t K K^t = -0.5 d(|K|^2)/dJ for a 3x3 K = J^{-1}.
+MFEM_HOST_DEVICE static inline
+void TMOP_KtKKt3D(const double *K, double *B)
+{
+   double KtK[9];
+   for (int j = 0; j < 3; j++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         double u = 0.0;
+         for (int k = 0; k < 3; k++) { u += K[k+3*i] * K[k+3*j]; }
+         KtK[i+3*j] = u;
+      }
+   }
+   for (int j = 0; j < 3; j++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         double u = 0.0;
+         for (int k = 0; k < 3; k++) { u += KtK[i+3*k] * K[j+3*k]; }
+         B[i+3*j] = u;
+      }
+   }
+}
+
+// mu_302 = |J|^2 |K|^2 / 9 - 1, P = 2/9 (|K|^2 J - |J|^2 K^t K K^t)
+MFEM_HOST_DEVICE static inline
+void TMOPEvalP_302(const double *J, double *P)
+{
+   double K[9], B[9];
+   kernels::CalcInverse<3>(J, K);
+   TMOP_KtKKt3D(K, B);
+   double I1 = 0.0, IK = 0.0;
+   for (int i = 0; i < 9; i++) { I1 += J[i]*J[i]; IK += K[i]*K[i]; }
+   for (int i = 0; i < 9; i++) { P[i] = 2.0/9.0 * (IK*J[i] - I1*B[i]); }
+}
+
+// mu_303 = |J|^2 / (3 det(J)^{2/3}) - 1,
+// P = det(J)^{-2/3} / 3 (2 J - 2/3 |J|^2 K^t)
+MFEM_HOST_DEVICE static inline
+void TMOPEvalP_303(const double *J, double *P)
+{
+   double K[9];
+   const double det = kernels::Det<3>(J);
+   kernels::CalcInverse<3>(J, K);
+   double I1 = 0.0;
+   for (int i = 0; i < 9; i++) { I1 += J[i]*J[i]; }
+   const double c = 1.0 / (3.0 * std::cbrt(det*det));
+   for (int j = 0; j < 3; j++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         P[i+3*j] = c * (2.0*J[i+3*j] - 2.0/3.0 * I1 * K[j+3*i]);
+      }
+   }
+}
+
+// mu_321 = |J|^2 + |K|^2 - 6, P = 2 J - 2 K^t K K^t
+MFEM_HOST_DEVICE static inline
+void TMOPEvalP_321(const double *J, double *P)
+{
+   double K[9], B[9];
+   kernels::CalcInverse<3>(J, K);
+   TMOP_KtKKt3D(K, B);
+   for (int i = 0; i < 9; i++) { P[i] = 2.0 * (J[i] - B[i]); }
+}
+
+// Quadrature point stresses, S = normal W P(Jpr Jrt) Jrt^t, where Jpr are the
+// reference gradients of the positions.
+template<int DIM, int METRIC>
+static void TMOPEvalStressPA(const int NQE,
+                             const double normal,
+                             const Vector &w_,
+                             const Vector &jrt_,
+                             const Vector &jac_,
+                             Vector &s_)
+{
+   constexpr int DD = DIM*DIM;
+   auto W = w_.Read();
+   auto Jrt = Reshape(jrt_.Read(), DD, NQE);
+   auto Jpr = Reshape(jac_.Read(), DD, NQE);
+   auto S = Reshape(s_.Write(), DD, NQE);
+   MFEM_FORALL(p, NQE,
+   {
+      double Jpt[DD], P[DD];
+      kernels::Mult(DIM, DIM, DIM, &Jpr(0,p), &Jrt(0,p), Jpt);
+      if (METRIC == 1) { TMOPEvalP_001(Jpt, P); }
+      if (METRIC == 2) { TMOPEvalP_002(Jpt, P); }
+      if (METRIC == 302) { TMOPEvalP_302(Jpt, P); }
+      if (METRIC == 303) { TMOPEvalP_303(Jpt, P); }
+      if (METRIC == 321) { TMOPEvalP_321(Jpt, P); }
+      const double w = normal * W[p];
+      for (int i = 0; i < DD; i++) { P[i] *= w; }
+      kernels::MultABt(DIM, DIM, DIM, P, &Jrt(0,p), &S(0,p));
+   });
+}
+
+static int GetPAMetricId(const TMOP_QualityMetric *metric, const int dim)
+{
+   if (dim == 2)
+   {
+      if (dynamic_cast<const TMOP_Metric_001*>(metric)) { return 1; }
+      if (dynamic_cast<const TMOP_Metric_002*>(metric)) { return 2; }
+   }
+   if (dim == 3)
+   {
+      if (dynamic_cast<const TMOP_Metric_302*>(metric)) { return 302; }
+      if (dynamic_cast<const TMOP_Metric_303*>(metric)) { return 303; }
+      if (dynamic_cast<const TMOP_Metric_321*>(metric)) { return 321; }
+   }
+   return 0;
+}
+
+void TMOP_Integrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(coeff0 == NULL && zeta == NULL,
+               "PA is not supported with limiting!");
+   MFEM_VERIFY(!fdflag && !exact_action,
+               "PA is not supported with finite differences or exact actions!");
+   MFEM_VERIFY(coeff1 == NULL ||
+               dynamic_cast<ConstantCoefficient*>(coeff1) != NULL,
+               "PA supports only constant weight coefficients!");
+   MFEM_VERIFY(dynamic_cast<const AnalyticAdaptTC*>(targetC) == NULL &&
+               discr_tc == NULL, "PA does not support adaptive targets!");
+
+   Mesh *mesh = fes.GetMesh();
+   const FiniteElement &el = *fes.GetFE(0);
+   MFEM_VERIFY(dynamic_cast<const TensorBasisElement*>(&el) != NULL,
+               "PA is only supported for tensor-product elements!");
+   pa_dim = mesh->Dimension();
+   MFEM_VERIFY(pa_dim == 2 || pa_dim == 3,
+               "dim = " << pa_dim << " is not supported!");
+   MFEM_VERIFY(fes.GetVDim() == pa_dim, "the vector dimension of the space "
+               "must be equal to the mesh dimension!");
+   fespace = &fes;
+   pa_ne = mesh->GetNE();
+   pa_ir = &ActionIntegrationRule(el);
+   pa_nq = pa_ir->GetNPoints();
+   maps = &el.GetDofToQuad(*pa_ir, DofToQuad::TENSOR);
+   pa_metric_id = GetPAMetricId(metric, pa_dim);
+
+   // The supported target constructors do not use the current positions.
+   const int dd = pa_dim*pa_dim;
+   const double c1 = coeff1 ?
+                     static_cast<ConstantCoefficient*>(coeff1)->constant : 1.0;
+   pa_Jtr.SetSize(dd*pa_nq*pa_ne, Device::GetMemoryType());
+   pa_Jrt.SetSize(dd*pa_nq*pa_ne, Device::GetMemoryType());
+   pa_weights.SetSize(pa_nq*pa_ne, Device::GetMemoryType());
+   double *Jtr_data = pa_Jtr.HostWrite();
+   double *Jrt_data = pa_Jrt.HostWrite();
+   double *W = pa_weights.HostWrite();
+   DenseTensor Jtr(pa_dim, pa_dim, pa_nq);
+   DenseMatrix Jrt_q;
+   Vector elfun;
+   for (int e = 0; e < pa_ne; e++)
+   {
+      targetC->ComputeElementTargets(e, el, *pa_ir, elfun, Jtr);
+      for (int q = 0; q < pa_nq; q++)
+      {
+         const int qe = q + pa_nq*e;
+         const DenseMatrix &Jtr_q = Jtr(q);
+         for (int i = 0; i < dd; i++) { Jtr_data[i + dd*qe] = Jtr_q.Data()[i]; }
+         Jrt_q.UseExternalData(Jrt_data + dd*qe, pa_dim, pa_dim);
+         CalcInverse(Jtr_q, Jrt_q);
+         W[qe] = pa_ir->IntPoint(q).weight * Jtr_q.Det() * c1;
+      }
+   }
+   Jrt_q.ClearExternalData();
+
+   pa_jac.SetSize(dd*pa_nq*pa_ne, Device::GetMemoryType());
+   pa_stress.SetSize(dd*pa_nq*pa_ne, Device::GetMemoryType());
+}
+
+void TMOP_Integrator::PAEvalStressHost(const double normal) const
+{
+   const int dd = pa_dim*pa_dim;
+   const double *jac = pa_jac.HostRead();
+   const double *Jtr_data = pa_Jtr.HostRead();
+   const double *Jrt_data = pa_Jrt.HostRead();
+   const double *W = pa_weights.HostRead();
+   double *stress = pa_stress.HostWrite();
+   DenseMatrix Jtr_q, Jpr_q, Jrt_q, S_q, Jpt_q(pa_dim), P_q(pa_dim);
+   for (int qe = 0; qe < pa_nq*pa_ne; qe++)
+   {
+      Jtr_q.UseExternalData(const_cast<double*>(Jtr_data) + dd*qe,
+                            pa_dim, pa_dim);
+      Jpr_q.UseExternalData(const_cast<double*>(jac) + dd*qe, pa_dim, pa_dim);
+      Jrt_q.UseExternalData(const_cast<double*>(Jrt_data) + dd*qe,
+                            pa_dim, pa_dim);
+      S_q.UseExternalData(stress + dd*qe, pa_dim, pa_dim);
+      metric->SetTargetJacobian(Jtr_q);
+      Mult(Jpr_q, Jrt_q, Jpt_q);
+
+      metric->EvalP(Jpt_q, P_q);
+
+      P_q *= normal * W[qe];
+      MultABt(P_q, Jrt_q, S_q);
+   }
+   Jtr_q.ClearExternalData();
+   Jpr_q.ClearExternalData();
+   Jrt_q.ClearExternalData();
+   S_q.ClearExternalData();
+}
+
+void TMOP_Integrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   internal::PAVectorGradient(pa_dim, pa_ne, *maps, x, pa_jac);
+
+   const int NQE = pa_nq*pa_ne;
+   const double mn = metric_normal;
+   switch (pa_metric_id)
+   {
+      case 1:
+         TMOPEvalStressPA<2,1>(NQE, mn, pa_weights, pa_Jrt, pa_jac, pa_stress);
+         break;
+      case 2:
+         TMOPEvalStressPA<2,2>(NQE, mn, pa_weights, pa_Jrt, pa_jac, pa_stress);
+         break;
+      case 302:
+         TMOPEvalStressPA<3,302>(NQE, mn, pa_weights, pa_Jrt, pa_jac,
+                                 pa_stress);
+         break;
+      case 303:
+         TMOPEvalStressPA<3,303>(NQE, mn, pa_weights, pa_Jrt, pa_jac,
+                                 pa_stress);
+         break;
+      case 321:
+         TMOPEvalStressPA<3,321>(NQE, mn, pa_weights, pa_Jrt, pa_jac,
+                                 pa_stress);
+         break;
+      default:
+         PAEvalStressHost(mn);
+   }
+
+   internal::PAVectorGradientTranspose(pa_dim, pa_ne, *maps, pa_stress, y);
+}
+
+void TMOP_Integrator::AssembleGradPA(const Vector &x,
+                                     const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(fespace == &fes, "AssemblePA() must be called first!");
+   internal::PAVectorGradient(pa_dim, pa_ne, *maps, x, pa_jac);
+
+   // Passing Jrt in place of the shape function gradients to AssembleH() gives
+   // the metric Hessians in reference coordinates, see the analogous comment
+   // in HyperelasticNLFIntegrator::AssembleGradPA().
+   const int dd = pa_dim*pa_dim;
+   pa_grad.SetSize(dd*dd*pa_nq*pa_ne, Device::GetMemoryType());
+   const double *jac = pa_jac.HostRead();
+   const double *Jtr_data = pa_Jtr.HostRead();
+   const double *Jrt_data = pa_Jrt.HostRead();
+   const double *W = pa_weights.HostRead();
+   double *H = pa_grad.HostWrite();
+   DenseMatrix Jtr_q, Jpr_q, Jrt_q, Jpt_q(pa_dim), H_q(dd);
+   for (int qe = 0; qe < pa_nq*pa_ne; qe++)
+   {
+      Jtr_q.UseExternalData(const_cast<double*>(Jtr_data) + dd*qe,
+                            pa_dim, pa_dim);
+      Jpr_q.UseExternalData(const_cast<double*>(jac) + dd*qe, pa_dim, pa_dim);
+      Jrt_q.UseExternalData(const_cast<double*>(Jrt_data) + dd*qe,
+                            pa_dim, pa_dim);
+      metric->SetTargetJacobian(Jtr_q);
+      Mult(Jpr_q, Jrt_q, Jpt_q);
+
+      H_q = 0.0;
+      metric->AssembleH(Jpt_q, Jrt_q, metric_normal * W[qe], H_q);
+      internal::PAStoreTangent(pa_dim, H_q, H + dd*dd*qe);
+   }
+   Jtr_q.ClearExternalData();
+   Jpr_q.ClearExternalData();
+   Jrt_q.ClearExternalData();
+}
+
+void TMOP_Integrator::AddMultGradPA(const Vector &x, Vector &y) const
+{
+   internal::PAVectorGradient(pa_dim, pa_ne, *maps, x, pa_jac);
+   internal::PATangentMult(pa_dim, pa_nq*pa_ne, pa_grad, pa_jac, pa_stress);
+   internal::PAVectorGradientTranspose(pa_dim, pa_ne, *maps, pa_stress, y);
+}
+
+void TMOP_Integrator::AssembleGradDiagonalPA(Vector &diag) const
+{
+   internal::PATangentDiagonal(pa_dim, pa_ne, *maps, pa_grad, diag);
+}
+
+} // namespace mfem
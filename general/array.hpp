@@ -19,6 +19,7 @@
 #include "globals.hpp"
 
 #include <iostream>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
@@ -490,6 +491,13 @@ public:
 
    long MemoryUsage() const;
 
+   /// Write the number of items, as int64_t, followed by their raw bytes.
+   /** Only meant for items that can be copied bytewise, see LoadBinary(). */
+   void SaveBinary(std::ostream &os) const;
+
+   /// Replace the contents with the items written by SaveBinary().
+   void LoadBinary(std::istream &is);
+
 protected:
    template <typename cA, typename cT>
    class iterator_base
@@ -1022,6 +1030,32 @@ long BlockArray<T>::MemoryUsage() const
           blocks.MemoryUsage();
 }
 
+template<typename T>
+void BlockArray<T>::SaveBinary(std::ostream &os) const
+{
+   const int64_t num_items = size;
+   os.write((const char*) &num_items, sizeof(num_items));
+   for (int i = 0; i < size; i += mask+1)
+   {
+      os.write((const char*) &At(i), std::min(mask+1, size-i)*sizeof(T));
+   }
+}
+
+template<typename T>
+void BlockArray<T>::LoadBinary(std::istream &is)
+{
+   DeleteAll();
+   int64_t num_items = 0;
+   is.read((char*) &num_items, sizeof(num_items));
+   for (int i = 0; i < num_items && is; i += mask+1)
+   {
+      const int count = std::min<int64_t>(mask+1, num_items-i);
+      Alloc(); // allocates the block of the items i, ..., i+count-1
+      size = i + count;
+      is.read((char*) &At(i), count*sizeof(T));
+   }
+}
+
 template<typename T>
 void BlockArray<T>::Destroy()
 {
@@ -12,6 +12,14 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mfem
 {
 namespace bin_io
@@ -51,5 +59,108 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes)
    }
 }
 
+static int DecodeBase64Char(char c)
+{
+   if (c >= 'A' && c <= 'Z') { return c - 'A'; }
+   if (c >= 'a' && c <= 'z') { return c - 'a' + 26; }
+   if (c >= '0' && c <= '9') { return c - '0' + 52; }
+   if (c == '+') { return 62; }
+   if (c == '/') { return 63; }
+   return -1;
+}
+
+void DecodeBase64(const char *src, size_t len, std::vector<char> &buf)
+{
+   buf.clear();
+   buf.reserve(len/4*3);
+   unsigned int bits = 0;
+   int nbits = 0;
+   for (size_t i = 0; i < len && src[i] != '='; i++)
+   {
+      const int d = DecodeBase64Char(src[i]);
+      MFEM_VERIFY(d >= 0, "invalid base64 character: " << src[i]);
+      bits = (bits << 6) | d;
+      nbits += 6;
+      if (nbits >= 8)
+      {
+         nbits -= 8;
+         buf.push_back(static_cast<char>((bits >> nbits) & 0xff));
+      }
+   }
+}
+
+void WritePadding(std::ostream &os, size_t n)
+{
+   static const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+   for ( ; n > 8; n -= 8) { os.write(zeros, 8); }
+   os.write(zeros, n);
+}
+
+void WriteTable(std::ostream &os, const Table &t)
+{
+   const int rows = std::max(t.Size(), 0);
+   const int nnz = rows ? t.Size_of_connections() : 0;
+   write<int64_t>(os, rows);
+   write<int64_t>(os, nnz);
+   if (rows)
+   {
+      os.write((const char*) t.GetI(), (rows+1)*sizeof(int));
+      os.write((const char*) t.GetJ(), nnz*sizeof(int));
+   }
+}
+
+void ReadTable(std::istream &is, Table &t)
+{
+   const int rows = read<int64_t>(is);
+   const int nnz = read<int64_t>(is);
+   t.SetDims(rows, nnz);
+   if (rows)
+   {
+      is.read((char*) t.GetI(), (rows+1)*sizeof(int));
+      is.read((char*) t.GetJ(), nnz*sizeof(int));
+   }
+}
+
 } // namespace mfem::bin_io
+
+MappedFile::MappedFile(const char *filename)
+   : data(NULL), size(0), mapped(false)
+{
+#ifndef _WIN32
+   int fd = open(filename, O_RDONLY);
+   MFEM_VERIFY(fd >= 0, "cannot open file: " << filename);
+   struct stat st;
+   MFEM_VERIFY(fstat(fd, &st) == 0, "cannot stat file: " << filename);
+   size = st.st_size;
+   if (size > 0)
+   {
+      void *addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+         data = static_cast<char*>(addr);
+         mapped = true;
+      }
+   }
+   close(fd);
+   if (mapped || size == 0) { return; }
+#endif
+   // Fallback: read the whole file into memory
+   std::ifstream in(filename, std::ios::in | std::ios::binary);
+   MFEM_VERIFY(in, "cannot open file: " << filename);
+   in.seekg(0, std::ios::end);
+   size = in.tellg();
+   in.seekg(0, std::ios::beg);
+   data = new char[size];
+   in.read(data, size);
+   MFEM_VERIFY(in, "error reading file: " << filename);
+}
+
+MappedFile::~MappedFile()
+{
+#ifndef _WIN32
+   if (mapped) { munmap(data, size); return; }
+#endif
+   delete [] data;
+}
+
 } // namespace mfem
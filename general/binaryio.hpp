@@ -13,7 +13,10 @@
 #define MFEM_BINARYIO
 
 #include "../config/config.hpp"
+#include "array.hpp"
+#include "table.hpp"
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -50,8 +53,75 @@ void AppendBytes(std::vector<char> &vec, const T &val)
 
 void WriteBase64(std::ostream &out, const void *bytes, size_t length);
 
+/// Decode the @a len base64 characters in @a src into @a buf.
+/** Decoding stops at the first padding character '='. */
+void DecodeBase64(const char *src, size_t len, std::vector<char> &buf);
+
+/// Return the number of base64 characters encoding @a nbytes bytes.
+inline size_t NumBase64Chars(size_t nbytes) { return ((nbytes + 2)/3)*4; }
+
+/// Write the size of @a a, as int64_t, followed by its entries.
+template <typename T>
+inline void WriteArray(std::ostream &os, const Array<T> &a)
+{
+   write<int64_t>(os, a.Size());
+   os.write((const char*) a.HostRead(), a.Size()*sizeof(T));
+}
+
+/// Read an array written with WriteArray().
+template <typename T>
+inline void ReadArray(std::istream &is, Array<T> &a)
+{
+   a.SetSize(read<int64_t>(is));
+   is.read((char*) a.HostWrite(), a.Size()*sizeof(T));
+}
+
+/// Write the dimensions of @a t, as int64_t, followed by its I and J arrays.
+void WriteTable(std::ostream &os, const Table &t);
+
+/// Read a table written with WriteTable().
+void ReadTable(std::istream &is, Table &t);
+
+/// Write @a n bytes of zero padding to the stream.
+void WritePadding(std::ostream &os, size_t n);
+
+/// Return the number of bytes needed to align @a offset to @a alignment.
+inline size_t Padding(size_t offset, size_t alignment = 8)
+{
+   return (alignment - offset % alignment) % alignment;
+}
+
 } // namespace mfem::bin_io
 
+/** @brief Read-only view of a file mapped into memory, see e.g. the binary
+    mesh format in Mesh::PrintBinary(). */
+/** The mapping is private: its contents may be modified in memory without
+    affecting the file. On systems without mmap(), the file is read into a
+    buffer instead. */
+class MappedFile
+{
+protected:
+   char *data;
+   size_t size;
+   bool mapped; ///< Whether #data is mapped or allocated with new[].
+
+public:
+   /// Map the file @a filename; aborts if the file cannot be opened.
+   explicit MappedFile(const char *filename);
+
+   ~MappedFile();
+
+   /// Return the beginning of the mapped file.
+   char *GetData() const { return data; }
+
+   /// Return the size of the mapped file in bytes.
+   size_t Size() const { return size; }
+
+private:
+   MappedFile(const MappedFile &);
+   MappedFile &operator=(const MappedFile &);
+};
+
 } // namespace mfem
 
 #endif
@@ -23,6 +23,7 @@
 #include "sets.hpp"
 #include "communication.hpp"
 #include "text.hpp"
+#include "binaryio.hpp"
 #include "sort_pairs.hpp"
 #include "globals.hpp"
 
@@ -324,6 +325,24 @@ void GroupTopology::Load(istream &in)
    Create(integer_sets, 823);
 }
 
+void GroupTopology::SaveBinary(ostream &out) const
+{
+   bin_io::WriteTable(out, group_lproc);
+   bin_io::WriteArray(out, groupmaster_lproc);
+   bin_io::WriteArray(out, lproc_proc);
+   bin_io::WriteArray(out, group_mgroup);
+}
+
+void GroupTopology::LoadBinary(istream &in)
+{
+   bin_io::ReadTable(in, group_lproc);
+   bin_io::ReadArray(in, groupmaster_lproc);
+   bin_io::ReadArray(in, lproc_proc);
+   bin_io::ReadArray(in, group_mgroup);
+   MFEM_VERIFY(in && lproc_proc.Size() > 0 && lproc_proc[0] == MyRank(),
+               "GroupTopology::LoadBinary - invalid data for this rank.");
+}
+
 void GroupTopology::Copy(GroupTopology& copy) const
 {
    copy.SetComm(MyComm);
@@ -131,6 +131,14 @@ public:
    /// Load the data from a stream.
    void Load(std::istream &in);
 
+   /// Save the complete group data, including the master groups, in binary.
+   void SaveBinary(std::ostream &out) const;
+
+   /** @brief Load the data written by SaveBinary(). Unlike Load(), this method
+       does not communicate, so it has to be called by the same rank (in a
+       communicator of the same size) that saved the data. */
+   void LoadBinary(std::istream &in);
+
    /// Copy the internal data to the external 'copy'.
    void Copy(GroupTopology & copy) const;
 
@@ -41,7 +41,8 @@ static const Backend::Id backend_list[Backend::NUM_BACKENDS] =
    Backend::CEED_CUDA, Backend::OCCA_CUDA, Backend::RAJA_CUDA, Backend::CUDA,
    Backend::HIP, Backend::DEBUG,
    Backend::OCCA_OMP, Backend::RAJA_OMP, Backend::OMP,
-   Backend::CEED_CPU, Backend::OCCA_CPU, Backend::RAJA_CPU, Backend::CPU
+   Backend::CEED_CPU, Backend::OCCA_CPU, Backend::RAJA_CPU, Backend::CPU_SIMD,
+   Backend::CPU
 };
 
 // Backend names listed by priority, high to low:
@@ -50,7 +51,7 @@ static const char *backend_name[Backend::NUM_BACKENDS] =
    "ceed-cuda", "occa-cuda", "raja-cuda", "cuda",
    "hip", "debug",
    "occa-omp", "raja-omp", "omp",
-   "ceed-cpu", "occa-cpu", "raja-cpu", "cpu"
+   "ceed-cpu", "occa-cpu", "raja-cpu", "cpu-simd", "cpu"
 };
 
 } // namespace mfem::internal
@@ -92,6 +93,12 @@ Device::Device() : mode(Device::SEQUENTIAL),
          host_mem_type = MemoryType::HOST_64;
          device_mem_type = MemoryType::HOST_64;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         device_mem_type = MemoryType::HOST_POOL;
+      }
       else if (mem_backend == "umpire")
       {
          mem_host_env = true;
@@ -159,6 +166,7 @@ Device::~Device()
       mm.Destroy();
    }
    Get().ngpu = -1;
+   Get().device_option = NULL;
    Get().mode = SEQUENTIAL;
    Get().backends = Backend::CPU;
    Get().host_mem_type = MemoryType::HOST;
@@ -313,6 +321,12 @@ void Device::UpdateMemoryTypeAndClass()
       device_mem_type = MemoryType::MANAGED;
    }
 
+   // Enable the host memory pool when requested
+   if (device_option && !strcmp(device_option, "pool"))
+   {
+      host_mem_type = MemoryType::HOST_POOL;
+   }
+
    // Enable the DEBUG mode when requested
    if (debug)
    {
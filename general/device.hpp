@@ -65,7 +65,13 @@ struct Backend
           while a device is in use. It allows to test the "device" code-path
           (using separate host/device memory pools and host <-> device
           transfers) without any GPU hardware. */
-      DEBUG = 1 << 12
+      DEBUG = 1 << 12,
+      /** @brief [host] CPU backend with cross-element SIMD vectorization of
+          the partial assembly kernels: sequential execution on each MPI rank,
+          with batches of elements processed in the lanes of AutoSIMD. The
+          kernels use the native SIMD width when MFEM is built with
+          MFEM_USE_SIMD=YES and suitable architecture flags. */
+      CPU_SIMD = 1 << 13
    };
 
    /** @brief Additional useful constants. For example, the *_MASK constants can
@@ -73,10 +79,10 @@ struct Backend
    enum
    {
       /// Number of backends: from (1 << 0) to (1 << (NUM_BACKENDS-1)).
-      NUM_BACKENDS = 13,
+      NUM_BACKENDS = 14,
 
       /// Biwise-OR of all CPU backends
-      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU,
+      CPU_MASK = CPU | RAJA_CPU | OCCA_CPU | CEED_CPU | CPU_SIMD,
       /// Biwise-OR of all CUDA backends
       CUDA_MASK = CUDA | RAJA_CUDA | OCCA_CUDA | CEED_CUDA,
       /// Biwise-OR of all HIP backends
@@ -198,7 +204,7 @@ public:
        * The current backend priority from highest to lowest is:
          'ceed-cuda', 'occa-cuda', 'raja-cuda', 'cuda', 'hip', 'debug',
          'occa-omp', 'raja-omp', 'omp',
-         'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu'.
+         'ceed-cpu', 'occa-cpu', 'raja-cpu', 'cpu-simd', 'cpu'.
        * Multiple backends can be configured at the same time.
        * Only one 'occa-*' backend can be configured at a time.
        * The backend 'occa-cuda' enables the 'cuda' backend unless 'raja-cuda'
@@ -209,6 +215,9 @@ public:
          and evaluation of the operator and enables the 'cuda' backend to avoid
          transfer between host and device.
        * The 'debug' backend should not be combined with other device backends.
+       * The option 'pool' of a backend, e.g. 'cpu:pool', sets the host memory
+         type to MemoryType::HOST_POOL. The same is done by setting the
+         environment variable MFEM_MEMORY to 'pool'.
    */
    void Configure(const std::string &device, const int dev = 0);
 
@@ -357,8 +357,8 @@ inline void ForallWrap(const bool use_dev, const int N,
 #endif
 
 #ifdef MFEM_USE_RAJA
-   // Handle all allowed CPU backends except Backend::CPU
-   if (Device::Allows(Backend::CPU_MASK & ~Backend::CPU))
+   // Handle all allowed CPU backends except Backend::CPU and Backend::CPU_SIMD
+   if (Device::Allows(Backend::CPU_MASK & ~(Backend::CPU | Backend::CPU_SIMD)))
    { return RajaSeqWrap(N, h_body); }
 #endif
 
@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 #include "array.hpp"
+#include "binaryio.hpp"
 #include "globals.hpp"
 
 namespace mfem
@@ -126,6 +127,12 @@ public:
    /// Write details of the memory usage to the mfem output stream.
    void PrintMemoryDetail() const;
 
+   /// Write the items, the hash table and the free ids to a binary stream.
+   void SaveBinary(std::ostream &os) const;
+
+   /// Replace the contents with the data written by SaveBinary().
+   void LoadBinary(std::istream &is);
+
    class iterator : public Base::iterator
    {
    protected:
@@ -475,6 +482,29 @@ void HashTable<T>::Delete(int id)
    unused.Append(id); // add its id to the unused ids
 }
 
+template<typename T>
+void HashTable<T>::SaveBinary(std::ostream &os) const
+{
+   Base::SaveBinary(os);
+   bin_io::write<int64_t>(os, mask+1);
+   os.write((const char*) table, (mask+1)*sizeof(int));
+   bin_io::WriteArray(os, unused);
+}
+
+template<typename T>
+void HashTable<T>::LoadBinary(std::istream &is)
+{
+   Base::LoadBinary(is);
+   const int table_size = bin_io::read<int64_t>(is);
+   MFEM_VERIFY(is && table_size > 0 && !(table_size & (table_size-1)),
+               "invalid binary HashTable");
+   delete [] table;
+   table = new int[table_size];
+   mask = table_size-1;
+   is.read((char*) table, table_size*sizeof(int));
+   bin_io::ReadArray(is, unused);
+}
+
 template<typename T>
 void HashTable<T>::DeleteAll()
 {
@@ -0,0 +1,176 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "jit.hpp"
+
+#ifdef MFEM_USE_JIT
+
+#include "device.hpp"
+#include "error.hpp"
+
+#include <map>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#ifndef MFEM_JIT_CXX
+#define MFEM_JIT_CXX "c++"
+#endif
+#ifndef MFEM_JIT_CXXFLAGS
+#define MFEM_JIT_CXXFLAGS "-O3 -std=c++11"
+#endif
+#ifndef MFEM_JIT_CACHE_DIR
+#define MFEM_JIT_CACHE_DIR ".mfem_jit_cache"
+#endif
+
+namespace mfem
+{
+
+namespace internal
+{
+
+static bool jit_enabled = true;
+
+// In-memory cache of the loaded kernels, keyed by name and definitions. Failed
+// builds are stored as NULL entries so they are not attempted again.
+static std::map<std::string, void*> jit_kernels;
+
+static const char *JitEnv(const char *var, const char *default_value)
+{
+   const char *value = getenv(var);
+   return (value && *value) ? value : default_value;
+}
+
+// 64-bit FNV-1a hash, used to build deterministic cache file names.
+static unsigned long long JitHash(const std::string &str,
+                                  unsigned long long h = 0xcbf29ce484222325ULL)
+{
+   for (std::string::size_type i = 0; i < str.size(); i++)
+   {
+      h ^= (unsigned char) str[i];
+      h *= 0x100000001b3ULL;
+   }
+   return h;
+}
+
+static bool JitFileExists(const std::string &path)
+{
+   struct stat st;
+   return stat(path.c_str(), &st) == 0;
+}
+
+// Compile 'source' into the shared object 'so_file'. The object is first built
+// under a process-unique name and then renamed, so that concurrent processes
+// sharing the cache never load a partially written file.
+static bool JitCompile(const std::string &cache_dir, const std::string &base,
+                       const char *source, const char *defines,
+                       const std::string &cxx, const std::string &flags,
+                       const std::string &so_file)
+{
+   if (mkdir(cache_dir.c_str(), 0755) != 0 && errno != EEXIST)
+   {
+      MFEM_WARNING("cannot create the JIT cache directory " << cache_dir);
+      return false;
+   }
+   std::ostringstream tmp;
+   tmp << cache_dir << '/' << base << '.' << getpid();
+   const std::string cpp_file = tmp.str() + ".cpp";
+   const std::string tmp_file = tmp.str() + ".so";
+   {
+      std::ofstream out(cpp_file.c_str());
+      out << source;
+      if (!out) { return false; }
+   }
+   const std::string cmd = cxx + " " + flags + " -fPIC -shared " + defines +
+                           " -o " + tmp_file + " " + cpp_file;
+   const int status = std::system(cmd.c_str());
+   std::remove(cpp_file.c_str());
+   if (status != 0 || !JitFileExists(tmp_file))
+   {
+      MFEM_WARNING("JIT compilation failed: " << cmd);
+      std::remove(tmp_file.c_str());
+      return false;
+   }
+   if (std::rename(tmp_file.c_str(), so_file.c_str()) != 0)
+   {
+      std::remove(tmp_file.c_str());
+      return JitFileExists(so_file);
+   }
+   return true;
+}
+
+} // namespace internal
+
+bool Jit::Enabled()
+{
+   if (!internal::jit_enabled) { return false; }
+   static const bool env_enabled = strcmp(internal::JitEnv("MFEM_JIT", "1"),
+                                          "0") != 0;
+   if (!env_enabled) { return false; }
+   return !Device::Allows(Backend::DEVICE_MASK | Backend::OMP_MASK |
+                          Backend::OCCA_MASK | Backend::CEED_MASK |
+                          Backend::RAJA_MASK);
+}
+
+void Jit::Enable(bool enable) { internal::jit_enabled = enable; }
+
+void *Jit::Lookup(const char *name, const char *source, const char *defines)
+{
+   const std::string key = std::string(name) + ' ' + defines;
+   std::map<std::string, void*>::iterator it = internal::jit_kernels.find(key);
+   if (it != internal::jit_kernels.end()) { return it->second; }
+
+   const std::string cxx = internal::JitEnv("MFEM_JIT_CXX", MFEM_JIT_CXX);
+   const std::string flags =
+      internal::JitEnv("MFEM_JIT_CXXFLAGS", MFEM_JIT_CXXFLAGS);
+   const std::string cache_dir =
+      internal::JitEnv("MFEM_JIT_CACHE", MFEM_JIT_CACHE_DIR);
+
+   // The hash covers everything that determines the generated code, so stale
+   // cache entries are never picked up after a change of kernel or compiler.
+   unsigned long long h = internal::JitHash(name);
+   h = internal::JitHash(source, h);
+   h = internal::JitHash(defines, h);
+   h = internal::JitHash(cxx, h);
+   h = internal::JitHash(flags, h);
+   char hash[17];
+   snprintf(hash, sizeof(hash), "%016llx", h);
+   const std::string base = std::string(name) + "_" + hash;
+   const std::string so_file = cache_dir + "/" + base + ".so";
+
+   void *kernel = NULL;
+   if (internal::JitFileExists(so_file) ||
+       internal::JitCompile(cache_dir, base, source, defines, cxx, flags,
+                            so_file))
+   {
+      void *handle = dlopen(so_file.c_str(), RTLD_NOW | RTLD_LOCAL);
+      if (handle) { kernel = dlsym(handle, "mfem_jit_kernel"); }
+      if (!kernel)
+      {
+         const char *err = dlerror();
+         MFEM_WARNING("cannot load JIT kernel " << so_file << ": "
+                      << (err ? err : ""));
+      }
+   }
+   internal::jit_kernels[key] = kernel;
+   return kernel;
+}
+
+} // namespace mfem
+
+#endif // MFEM_USE_JIT
@@ -0,0 +1,60 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_JIT_HPP
+#define MFEM_JIT_HPP
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_JIT
+
+namespace mfem
+{
+
+/** @brief Runtime (just-in-time) compilation of specialized kernels.
+
+    A kernel is given as a self-contained C++ source that defines the symbol
+    'extern "C" mfem_jit_kernel' and is specialized through preprocessor
+    definitions, e.g. "-DMFEM_JIT_D1D=5 -DMFEM_JIT_Q1D=7". On first use, the
+    source is compiled with the host compiler into a shared object which is
+    stored in an on-disk cache and loaded with dlopen. The cache file name
+    contains a hash of the kernel name, source, definitions, compiler and flags,
+    so subsequent runs reuse the compiled kernel.
+
+    The compiler, the flags and the cache directory default to the values given
+    at configuration time (JIT_CXX, JIT_CXXFLAGS, JIT_CACHE_DIR) and can be
+    overridden with the environment variables MFEM_JIT_CXX, MFEM_JIT_CXXFLAGS
+    and MFEM_JIT_CACHE. Setting MFEM_JIT=0 disables the runtime compilation. */
+class Jit
+{
+public:
+   /** @brief Return true if runtime compiled kernels can be used with the
+       current Device configuration, i.e. when only host backends (without
+       OpenMP) are enabled. */
+   static bool Enabled();
+
+   /// Globally enable (default) or disable the use of runtime compiled kernels.
+   static void Enable(bool enable = true);
+
+   /** @brief Return the address of the kernel symbol compiled from @a source
+       with the preprocessor @a defines, or NULL if it could not be built. */
+   /** The returned pointer is cached, both in memory and on disk. The caller is
+       expected to fall back to a generic implementation when NULL is
+       returned. */
+   static void *Lookup(const char *name, const char *source,
+                       const char *defines);
+};
+
+} // namespace mfem
+
+#endif // MFEM_USE_JIT
+
+#endif // MFEM_JIT_HPP
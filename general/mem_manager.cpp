@@ -16,6 +16,8 @@
 #include <cstring> // std::memcpy, std::memcmp
 #include <unordered_map>
 #include <algorithm> // std::max
+#include <vector>
+#include <mutex>
 
 // Uncomment to try _WIN32 platform
 //#define _WIN32
@@ -72,6 +74,7 @@ MemoryType MemoryManager::GetDualMemoryType_(MemoryType mt)
       case MemoryType::HOST_64:        return MemoryType::DEVICE;
       case MemoryType::HOST_DEBUG:     return MemoryType::DEVICE_DEBUG;
       case MemoryType::HOST_UMPIRE:    return MemoryType::DEVICE_UMPIRE;
+      case MemoryType::HOST_POOL:      return MemoryType::DEVICE;
       case MemoryType::MANAGED:        return MemoryType::MANAGED;
       case MemoryType::DEVICE:         return MemoryType::HOST;
       case MemoryType::DEVICE_DEBUG:   return MemoryType::HOST_DEBUG;
@@ -92,6 +95,7 @@ static void MFEM_VERIFY_TYPES(const MemoryType h_mt, const MemoryType d_mt)
       (h_mt == MemoryType::MANAGED && d_mt == MemoryType::MANAGED) ||
       (h_mt == MemoryType::HOST_64 && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST_32 && d_mt == MemoryType::DEVICE) ||
+      (h_mt == MemoryType::HOST_POOL && d_mt == MemoryType::DEVICE) ||
       (h_mt == MemoryType::HOST && d_mt == MemoryType::DEVICE);
    MFEM_VERIFY(sync, "");
 }
@@ -229,6 +233,128 @@ public:
    void Dealloc(void *ptr) { mfem_aligned_free(ptr); }
 };
 
+/// The pool host memory space
+/** The freed blocks are cached by size classes and reused by the following
+    allocations of the same class. There are four classes between consecutive
+    powers of two, so that a block is at most 25% larger than requested. Each
+    block starts with a header, storing its class, followed by the 64 bytes
+    aligned user memory. Blocks larger than the largest class are not cached. */
+class PoolHostMemorySpace : public HostMemorySpace
+{
+   static constexpr size_t align = 64;
+   static constexpr int min_log2 = 6, max_log2 = 27;
+   static constexpr int num_classes = 1 + 4*(max_log2 - min_log2);
+
+   struct Header { int size_class; size_t bytes; };
+
+   std::vector<void*> blocks[num_classes];
+   size_t used, cached, peak;
+   std::mutex mutex;
+
+   /// Return the class of @a bytes and the size of its blocks in @a c_bytes,
+   /// or -1 if @a bytes is too large to be cached.
+   static int SizeClass(size_t bytes, size_t &c_bytes)
+   {
+      if (bytes <= (size_t(1) << min_log2))
+      {
+         c_bytes = size_t(1) << min_log2;
+         return 0;
+      }
+      int p = min_log2;
+      while ((size_t(1) << (p+1)) < bytes) { p++; }
+      if (p >= max_log2) { c_bytes = bytes; return -1; }
+      const size_t step = size_t(1) << (p-2);
+      const size_t k = (bytes - (size_t(1) << p) + step - 1) / step;
+      c_bytes = (size_t(1) << p) + k*step;
+      return 1 + 4*(p - min_log2) + int(k - 1);
+   }
+
+   void Free(void *block)
+   {
+      cached -= static_cast<Header*>(block)->bytes;
+      mfem_aligned_free(block);
+   }
+
+public:
+   PoolHostMemorySpace(): HostMemorySpace(), used(0), cached(0), peak(0) { }
+
+   ~PoolHostMemorySpace() { Release(0); }
+
+   void Alloc(void **ptr, size_t bytes)
+   {
+      size_t c_bytes;
+      const int c = SizeClass(bytes, c_bytes);
+      void *block = nullptr;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         if (c >= 0 && !blocks[c].empty())
+         {
+            block = blocks[c].back();
+            blocks[c].pop_back();
+            cached -= c_bytes;
+         }
+         used += c_bytes;
+         peak = std::max(peak, used);
+      }
+      if (!block)
+      {
+         if (mfem_memalign(&block, align, align + c_bytes) != 0)
+         {
+            throw ::std::bad_alloc();
+         }
+         static_cast<Header*>(block)->size_class = c;
+         static_cast<Header*>(block)->bytes = c_bytes;
+      }
+      *ptr = static_cast<char*>(block) + align;
+   }
+
+   void Dealloc(void *ptr)
+   {
+      if (!ptr) { return; }
+      void *block = static_cast<char*>(ptr) - align;
+      const Header &h = *static_cast<Header*>(block);
+      std::lock_guard<std::mutex> lock(mutex);
+      used -= h.bytes;
+      if (h.size_class < 0) { mfem_aligned_free(block); return; }
+      blocks[h.size_class].push_back(block);
+      cached += h.bytes;
+   }
+
+   /// Free the cached blocks, largest first, until the pool holds at most
+   /// max(@a max_bytes, used) bytes.
+   void Release(size_t max_bytes)
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int c = num_classes - 1; c >= 0; c--)
+      {
+         while (!blocks[c].empty() && used + cached > max_bytes)
+         {
+            Free(blocks[c].back());
+            blocks[c].pop_back();
+         }
+      }
+   }
+
+   /// Release the cached blocks above the high-water mark of the usage since
+   /// the previous call, and reset the mark to the current usage.
+   void Trim()
+   {
+      size_t max_bytes;
+      {
+         std::lock_guard<std::mutex> lock(mutex);
+         max_bytes = peak;
+         peak = used;
+      }
+      Release(max_bytes);
+   }
+
+   size_t CachedBytes()
+   {
+      std::lock_guard<std::mutex> lock(mutex);
+      return cached;
+   }
+};
+
 #ifndef _WIN32
 static uintptr_t pagesize = 0;
 static uintptr_t pagemask = 0;
@@ -575,6 +701,7 @@ public:
       // HOST_DEBUG is delayed, as it reroutes signals
       host[static_cast<int>(MT::HOST_DEBUG)] = nullptr;
       host[static_cast<int>(MT::HOST_UMPIRE)] = new UmpireHostMemorySpace();
+      host[static_cast<int>(MT::HOST_POOL)] = new PoolHostMemorySpace();
       host[static_cast<int>(MT::MANAGED)] = new UvmHostMemorySpace();
 
       // Filling the device memory backends, shifting with the device size
@@ -776,12 +903,14 @@ bool MemoryManager::MemoryClassCheck_(MemoryClass mc, void *h_ptr,
       case MemoryClass::HOST_32:
       {
          MFEM_VERIFY(h_mt == MemoryType::HOST_32 ||
-                     h_mt == MemoryType::HOST_64,"");
+                     h_mt == MemoryType::HOST_64 ||
+                     h_mt == MemoryType::HOST_POOL,"");
          return true;
       }
       case MemoryClass::HOST_64:
       {
-         MFEM_VERIFY(h_mt == MemoryType::HOST_64,"");
+         MFEM_VERIFY(h_mt == MemoryType::HOST_64 ||
+                     h_mt == MemoryType::HOST_POOL,"");
          return true;
       }
       case MemoryClass::DEVICE:
@@ -928,6 +1057,21 @@ MemoryType MemoryManager::GetHostMemoryType_(void *h_ptr)
    return MemoryManager::host_mem_type;
 }
 
+void *MemoryManager::HostPoolAlloc_(size_t bytes)
+{
+   MFEM_VERIFY(exists, "the memory manager does not exist!");
+   void *h_ptr;
+   ctrl->Host(MemoryType::HOST_POOL)->Alloc(&h_ptr, bytes);
+   return h_ptr;
+}
+
+void MemoryManager::HostPoolDealloc_(void *h_ptr)
+{
+   // The blocks freed after the destruction of the pool are not reclaimed
+   if (!exists) { return; }
+   ctrl->Host(MemoryType::HOST_POOL)->Dealloc(h_ptr);
+}
+
 void MemoryManager::Copy_(void *dst_h_ptr, const void *src_h_ptr,
                           size_t bytes, unsigned src_flags,
                           unsigned &dst_flags)
@@ -1301,6 +1445,20 @@ void MemoryManager::Destroy()
    exists = false;
 }
 
+void MemoryManager::TrimHostPool()
+{
+   if (!exists) { return; }
+   static_cast<internal::PoolHostMemorySpace*>
+   (ctrl->Host(MemoryType::HOST_POOL))->Trim();
+}
+
+size_t MemoryManager::GetHostPoolCachedBytes()
+{
+   if (!exists) { return 0; }
+   return static_cast<internal::PoolHostMemorySpace*>
+          (ctrl->Host(MemoryType::HOST_POOL))->CachedBytes();
+}
+
 void MemoryManager::RegisterCheck(void *ptr)
 {
    if (ptr != NULL)
@@ -1396,7 +1554,7 @@ MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
 
 const char *MemoryTypeName[MemoryTypeSize] =
 {
-   "host-std", "host-32", "host-64", "host-debug", "host-umpire",
+   "host-std", "host-32", "host-64", "host-debug", "host-umpire", "host-pool",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
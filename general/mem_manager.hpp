@@ -32,6 +32,8 @@ enum class MemoryType
    HOST_64,        ///< Host memory; aligned at 64 bytes
    HOST_DEBUG,     ///< Host memory; allocated from a "host-debug" pool
    HOST_UMPIRE,    ///< Host memory; using Umpire
+   HOST_POOL,      /**< Host memory; allocated from a built-in pool caching
+                        freed blocks by size classes, aligned at 64 bytes */
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
                         and *Free */
    DEVICE,         ///< Device memory; using CUDA or HIP *Malloc and *Free
@@ -58,9 +60,9 @@ extern const char *MemoryTypeName[MemoryTypeSize];
 enum class MemoryClass
 {
    HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, MANAGED } */
-   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
-   HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
+                                 HOST_UMPIRE, HOST_POOL, MANAGED } */
+   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG, HOST_POOL }
+   HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG, HOST_POOL }
    DEVICE,  ///< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE, MANAGED }
    MANAGED  ///< Memory types: { MANAGED }
 };
@@ -293,7 +295,7 @@ public:
           - MANAGED => MANAGED,
           - HOST_DEBUG => DEVICE_DEBUG,
           - HOST_UMPIRE => DEVICE_UMPIRE,
-          - HOST, HOST_32, HOST_64 => DEVICE.
+          - HOST, HOST_32, HOST_64, HOST_POOL => DEVICE.
 
        The parameter @a own determines whether both @a h_ptr and @a d_ptr will
        be deleted when the method Delete() is called.
@@ -553,6 +555,10 @@ private: // Static methods used by the Memory<T> class
    /// Verify that h_mt and h_ptr's h_mt (memory or alias) are equal.
    static void CheckHostMemoryType_(MemoryType h_mt, void *h_ptr);
 
+   /// Allocate and free unregistered MemoryType::HOST_POOL memory.
+   static void *HostPoolAlloc_(size_t bytes);
+   static void HostPoolDealloc_(void *h_ptr);
+
    /// Copy entries from valid memory type to valid memory type.
    ///  Both dest_h_ptr and src_h_ptr are registered host pointers.
    static void Copy_(void *dest_h_ptr, const void *src_h_ptr, size_t bytes,
@@ -652,6 +658,15 @@ public:
    /// returning the number of printed pointers
    int PrintAliases(std::ostream &out = mfem::out);
 
+   /** @brief Release the blocks cached by the MemoryType::HOST_POOL pool
+       that exceed the high-water mark of its usage since the previous call. */
+   /** Calling this method, e.g. once per time step, keeps the size of the
+       pool close to the peak usage of the recent steps. */
+   void TrimHostPool();
+
+   /// Return the number of bytes cached by the MemoryType::HOST_POOL pool.
+   size_t GetHostPoolCachedBytes();
+
    static MemoryType GetHostMemoryType() { return host_mem_type; }
    static MemoryType GetDeviceMemoryType() { return device_mem_type; }
 };
@@ -684,6 +699,8 @@ inline void Memory<T>::New(int size)
    flags = OWNS_HOST | VALID_HOST;
    h_mt = MemoryManager::host_mem_type;
    h_ptr = (h_mt == MemoryType::HOST) ? Alloc<new_align_bytes>::New(size) :
+           (h_mt == MemoryType::HOST_POOL) ?
+           (T*)MemoryManager::HostPoolAlloc_(size*sizeof(T)) :
            (T*)MemoryManager::New_(nullptr, size*sizeof(T), h_mt, flags);
 }
 
@@ -692,6 +709,14 @@ inline void Memory<T>::New(int size, MemoryType mt)
 {
    capacity = size;
    const size_t bytes = size*sizeof(T);
+   if (mt == MemoryType::HOST_POOL)
+   {
+      // Skip the registration, as for HOST
+      flags = OWNS_HOST | VALID_HOST;
+      h_mt = mt;
+      h_ptr = (T*)MemoryManager::HostPoolAlloc_(bytes);
+      return;
+   }
    const bool mt_host = mt == MemoryType::HOST;
    if (mt_host) { flags = OWNS_HOST | VALID_HOST; }
    h_mt = IsHostMemory(mt) ? mt : MemoryManager::GetDualMemoryType_(mt);
@@ -777,6 +802,11 @@ inline void Memory<T>::Delete()
    const bool mt_host = h_mt == MemoryType::HOST;
    const bool std_delete = !registered && mt_host;
 
+   if (!registered && h_mt == MemoryType::HOST_POOL)
+   {
+      if (flags & OWNS_HOST) { MemoryManager::HostPoolDealloc_(h_ptr); }
+      return;
+   }
    if (std_delete ||
        MemoryManager::Delete_((void*)h_ptr, h_mt, flags) == MemoryType::HOST)
    {
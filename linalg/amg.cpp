@@ -0,0 +1,369 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class SmoothedAggregationAMG
+
+#include "amg.hpp"
+#include "solvers.hpp"
+#include "../general/forall.hpp"
+
+#include <cmath>
+
+namespace mfem
+{
+
+SmoothedAggregationAMG::SmoothedAggregationAMG()
+   : Solver(0),
+     strength_threshold(0.08),
+     prolongation_damping(4.0/3.0),
+     max_levels(10),
+     max_coarse_size(50),
+     smoother_type(L1_JACOBI),
+     smoother_sweeps(1),
+     chebyshev_order(2),
+     print_level(0),
+     coarse_direct(false) { }
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A)
+   : SmoothedAggregationAMG()
+{
+   SetOperator(A);
+}
+
+void SmoothedAggregationAMG::Clear()
+{
+   for (int l = 1; l < A.Size(); l++) { delete A[l]; }
+   for (int l = 0; l < P.Size(); l++)
+   {
+      delete P[l];
+      delete R[l];
+   }
+   for (int l = 0; l < smoothers.Size(); l++)
+   {
+      delete smoothers[l];
+      delete smoother_diag[l];
+   }
+   for (int l = 0; l < X.Size(); l++)
+   {
+      delete X[l];
+      delete B[l];
+      delete Res[l];
+      delete Cor[l];
+   }
+   A.SetSize(0);
+   P.SetSize(0);
+   R.SetSize(0);
+   smoothers.SetSize(0);
+   smoother_diag.SetSize(0);
+   X.SetSize(0);
+   B.SetSize(0);
+   Res.SetSize(0);
+   Cor.SetSize(0);
+   coarse_direct = false;
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &A,
+                                      Array<int> &aggregate) const
+{
+   const int n = A.Height();
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   const double *V = A.HostReadData();
+   Vector d;
+   A.GetDiag(d);
+
+   // Graph of the strong connections, |a_ij| >= theta sqrt(|a_ii a_jj|)
+   Array<int> S_I(n+1), S_J;
+   Array<double> S_V;
+   S_I[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         if (j != i && std::abs(V[k]) >=
+             strength_threshold*std::sqrt(std::abs(d(i)*d(j))) && V[k] != 0.0)
+         {
+            S_J.Append(j);
+            S_V.Append(std::abs(V[k]));
+         }
+      }
+      S_I[i+1] = S_J.Size();
+   }
+
+   // Nodes without strong connections are not aggregated (-2)
+   aggregate.SetSize(n);
+   for (int i = 0; i < n; i++)
+   {
+      aggregate[i] = (S_I[i+1] > S_I[i]) ? -1 : -2;
+   }
+
+   // Phase 1: aggregates of the nodes and their strong neighbors, if none of
+   // them is aggregated yet
+   int num_aggregates = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      bool free = true;
+      for (int k = S_I[i]; k < S_I[i+1] && free; k++)
+      {
+         free = (aggregate[S_J[k]] < 0);
+      }
+      if (!free) { continue; }
+      aggregate[i] = num_aggregates;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         aggregate[S_J[k]] = num_aggregates;
+      }
+      num_aggregates++;
+   }
+
+   // Phase 2: add the remaining nodes to the aggregate of phase 1 to which
+   // they are most strongly connected
+   Array<int> aggregate1(aggregate);
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      double max_strength = 0.0;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (aggregate1[S_J[k]] >= 0 && S_V[k] > max_strength)
+         {
+            aggregate[i] = aggregate1[S_J[k]];
+            max_strength = S_V[k];
+         }
+      }
+   }
+
+   // Phase 3: aggregates of the remaining nodes and their remaining strong
+   // neighbors
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      aggregate[i] = num_aggregates;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (aggregate[S_J[k]] == -1) { aggregate[S_J[k]] = num_aggregates; }
+      }
+      num_aggregates++;
+   }
+   return num_aggregates;
+}
+
+Solver *SmoothedAggregationAMG::NewSmoother(int l, double max_eig)
+{
+   const SparseMatrix &Al = *A[l];
+   const int n = Al.Height();
+   Vector *d = new Vector(n);
+   d->UseDevice(true);
+   smoother_diag.Append(d);
+   if (smoother_type == CHEBYSHEV)
+   {
+      Al.GetDiag(*d);
+      return new OperatorChebyshevSmoother(const_cast<SparseMatrix*>(&Al),
+                                           *d, no_ess_tdofs, chebyshev_order,
+                                           max_eig);
+   }
+
+   // l1-Jacobi: the diagonal is the l1 norm of the rows
+   auto I = Al.ReadI();
+   auto V = Al.ReadData();
+   auto D = d->Write();
+   MFEM_FORALL(i, n,
+   {
+      double s = 0.0;
+      for (int k = I[i]; k < I[i+1]; k++) { s += fabs(V[k]); }
+      D[i] = s;
+   });
+   return new OperatorJacobiSmoother(*d, no_ess_tdofs);
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *mat = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(mat && mat->Finalized(), "a finalized SparseMatrix is required");
+   MFEM_VERIFY(mat->Height() == mat->Width(), "the matrix must be square");
+   Clear();
+   height = width = mat->Height();
+
+   A.Append(mat);
+   Array<double> max_eig;
+   while (true)
+   {
+      const SparseMatrix &Al = *A.Last();
+      const int n = Al.Height();
+      if (n <= max_coarse_size)
+      {
+         coarse_direct = true;
+         break;
+      }
+
+      // Estimate of the largest eigenvalue of D^{-1} A
+      Vector d;
+      Al.GetDiag(d);
+      for (int i = 0; i < n; i++)
+      {
+         MFEM_VERIFY(d(i) != 0.0, "zero diagonal entry in row " << i
+                     << " of level " << A.Size()-1);
+      }
+      OperatorJacobiSmoother inv_diag(d, no_ess_tdofs);
+      ProductOperator DinvA(&inv_diag, &Al, false, false);
+      PowerMethod power_method;
+      Vector ev(n);
+      max_eig.Append(power_method.EstimateLargestEigenvalue(DinvA, ev, 20));
+
+      if (A.Size() == max_levels) { break; }
+      Array<int> aggregate;
+      const int nc = Aggregate(Al, aggregate);
+      if (nc == 0 || nc == n) { break; }
+
+      // Tentative prolongation of the constant vector, normalized columns
+      Array<int> aggregate_size(nc);
+      aggregate_size = 0;
+      for (int i = 0; i < n; i++)
+      {
+         if (aggregate[i] >= 0) { aggregate_size[aggregate[i]]++; }
+      }
+      SparseMatrix P0(n, nc);
+      for (int i = 0; i < n; i++)
+      {
+         if (aggregate[i] < 0) { continue; }
+         P0.Set(i, aggregate[i], 1.0/std::sqrt(aggregate_size[aggregate[i]]));
+      }
+      P0.Finalize();
+
+      // Smoothed prolongation P = (I - omega D^{-1} A) P0
+      SparseMatrix *AP0 = mfem::Mult(Al, P0);
+      Vector scale(n);
+      for (int i = 0; i < n; i++)
+      {
+         scale(i) = prolongation_damping/(max_eig.Last()*d(i));
+      }
+      AP0->ScaleRows(scale);
+      SparseMatrix *Pl = Add(1.0, P0, -1.0, *AP0);
+      delete AP0;
+
+      P.Append(Pl);
+      R.Append(Transpose(*Pl));
+      A.Append(RAP(*Pl, Al, *Pl));
+   }
+
+   const int num_levels = A.Size();
+   for (int l = 0; l < num_levels; l++)
+   {
+      if (l < num_levels-1 || !coarse_direct)
+      {
+         smoothers.Append(NewSmoother(l, max_eig[l]));
+      }
+   }
+   if (coarse_direct)
+   {
+      A.Last()->ToDenseMatrix(coarse_matrix);
+      coarse_solver.Factor(coarse_matrix);
+   }
+
+   for (int l = 0; l < num_levels; l++)
+   {
+      const int n = A[l]->Height();
+      X.Append(new Vector(n));
+      B.Append(new Vector(n));
+      Res.Append(new Vector(n));
+      Cor.Append(new Vector(n));
+      X.Last()->UseDevice(true);
+      B.Last()->UseDevice(true);
+      Res.Last()->UseDevice(true);
+      Cor.Last()->UseDevice(true);
+   }
+
+   if (print_level > 0)
+   {
+      mfem::out << "SmoothedAggregationAMG: " << num_levels << " levels\n";
+      for (int l = 0; l < num_levels; l++)
+      {
+         mfem::out << "   level " << l << ": " << A[l]->Height()
+                   << " rows, " << A[l]->NumNonZeroElems() << " nonzeros\n";
+      }
+      mfem::out << "   operator complexity: " << GetOperatorComplexity()
+                << '\n';
+   }
+}
+
+void SmoothedAggregationAMG::Cycle(int l) const
+{
+   const SparseMatrix &Al = *A[l];
+   const Vector &b = *B[l];
+   Vector &x = *X[l], &r = *Res[l], &c = *Cor[l];
+   const bool coarsest = (l == A.Size()-1);
+
+   if (coarsest && coarse_direct)
+   {
+      b.HostRead();
+      x.HostWrite();
+      coarse_solver.Mult(b, x);
+      return;
+   }
+
+   // Pre-smoothing, starting from zero
+   smoothers[l]->Mult(b, x);
+   for (int s = 1; s < smoother_sweeps; s++)
+   {
+      Al.Mult(x, r);
+      subtract(b, r, r);
+      smoothers[l]->Mult(r, c);
+      x += c;
+   }
+
+   // Coarse grid correction
+   if (!coarsest)
+   {
+      Al.Mult(x, r);
+      subtract(b, r, r);
+      R[l]->Mult(r, *B[l+1]);
+      Cycle(l+1);
+      P[l]->Mult(*X[l+1], c);
+      x += c;
+   }
+
+   // Post-smoothing
+   for (int s = 0; s < smoother_sweeps; s++)
+   {
+      Al.Mult(x, r);
+      subtract(b, r, r);
+      smoothers[l]->Mult(r, c);
+      x += c;
+   }
+}
+
+void SmoothedAggregationAMG::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(A.Size() > 0, "SetOperator() must be called first");
+   if (iterative_mode)
+   {
+      A[0]->Mult(x, *B[0]);
+      subtract(b, *B[0], *B[0]);
+      Cycle(0);
+      x += *X[0];
+   }
+   else
+   {
+      *B[0] = b;
+      Cycle(0);
+      x = *X[0];
+   }
+}
+
+double SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   double nnz = 0.0;
+   for (int l = 0; l < A.Size(); l++) { nnz += A[l]->NumNonZeroElems(); }
+   return A.Size() ? nnz/A[0]->NumNonZeroElems() : 0.0;
+}
+
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "../config/config.hpp"
+#include "sparsemat.hpp"
+#include "densemat.hpp"
+
+namespace mfem
+{
+
+/// Smoothed aggregation algebraic multigrid for a SparseMatrix.
+/** The nodes of each level are grouped into aggregates of strongly connected
+    nodes, which define the tentative prolongation of the constant vector
+    (the near null space of scalar elliptic problems). The tentative
+    prolongation P0 is smoothed with one damped Jacobi step,
+    P = (I - 4/(3 rho) D^{-1} A) P0, where rho is an estimate of the largest
+    eigenvalue of D^{-1} A, and the coarse matrix is P^T A P. Nodes without
+    strong connections, e.g. eliminated essential DOFs, are not aggregated and
+    are only treated by the smoother.
+
+    The solve phase applies one symmetric V-cycle with l1-Jacobi or Chebyshev
+    smoothing and a dense direct solve on the coarsest level, so the solver is
+    a symmetric preconditioner for CGSolver if the matrix is symmetric positive
+    definite. The setup is done on the host; the smoothers and the transfers
+    between the levels are applied with the device kernels of SparseMatrix and
+    Vector (e.g. with the OpenMP or CUDA backends of Device). */
+class SmoothedAggregationAMG : public Solver
+{
+public:
+   /// Smoothers applied on each level, except the coarsest one.
+   enum SmootherType
+   {
+      L1_JACOBI, ///< Jacobi with the l1 norms of the rows as diagonal
+      CHEBYSHEV  ///< Chebyshev polynomial of the Jacobi preconditioned matrix
+   };
+
+protected:
+   double strength_threshold;
+   double prolongation_damping;
+   int max_levels, max_coarse_size;
+   SmootherType smoother_type;
+   int smoother_sweeps, chebyshev_order;
+   int print_level;
+
+   /// Matrices of the levels, the first one is not owned.
+   Array<const SparseMatrix*> A;
+   /// Prolongation and restriction matrices between levels l+1 and l.
+   Array<SparseMatrix*> P, R;
+   /// Smoothers of the levels, except a directly solved coarsest level.
+   Array<Solver*> smoothers;
+   /// Diagonals of the smoothers, referenced by the smoothers.
+   Array<Vector*> smoother_diag;
+   /// Empty list of essential DOFs, referenced by the smoothers.
+   const Array<int> no_ess_tdofs;
+   /** @brief Inverse of the coarsest matrix, used if its size is at most
+       max_coarse_size; otherwise the coarsest level is only smoothed. */
+   DenseMatrix coarse_matrix;
+   DenseMatrixInverse coarse_solver;
+   bool coarse_direct;
+
+   mutable Array<Vector*> X, B, Res, Cor;
+
+   /// Group the nodes into aggregates, return the number of aggregates.
+   int Aggregate(const SparseMatrix &A, Array<int> &aggregate) const;
+
+   /** @brief Return a new smoother for level @a l, where @a max_eig is the
+       estimated largest eigenvalue of D^{-1} A. */
+   Solver *NewSmoother(int l, double max_eig);
+
+   void Clear();
+
+   /// Apply the V-cycle on level @a l with a zero initial guess.
+   void Cycle(int l) const;
+
+public:
+   /// Construct the solver, SetOperator() must be called before Mult().
+   SmoothedAggregationAMG();
+
+   /// Construct the solver and set up the hierarchy for @a A.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   virtual ~SmoothedAggregationAMG() { Clear(); }
+
+   /** @brief Set the threshold for strong connections, |a_ij| >= threshold *
+       sqrt(|a_ii a_jj|), default 0.08. */
+   void SetStrengthThreshold(double threshold)
+   { strength_threshold = threshold; }
+
+   /** @brief Set the damping of the prolongation smoothing, relative to the
+       inverse of the estimated largest eigenvalue of D^{-1} A, default 4/3. */
+   void SetProlongationDamping(double damping)
+   { prolongation_damping = damping; }
+
+   /// Set the maximum number of levels, default 10.
+   void SetMaxLevels(int levels) { max_levels = levels; }
+
+   /// Stop coarsening when the size of a level is at most @a size, default 50.
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   /** @brief Set the smoother type, the number of pre- and post-smoothing
+       sweeps and the order of the Chebyshev polynomial. */
+   void SetSmoother(SmootherType type, int sweeps = 1, int order = 2)
+   {
+      smoother_type = type;
+      smoother_sweeps = sweeps;
+      chebyshev_order = order;
+   }
+
+   /// Print the sizes of the levels in SetOperator() if @a level > 0.
+   void SetPrintLevel(int level) { print_level = level; }
+
+   /** @brief Set up the hierarchy for @a op, which must be a finalized
+       SparseMatrix. The parameters above must be set before this call. */
+   virtual void SetOperator(const Operator &op);
+
+   /// Apply one V-cycle.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// The V-cycle is symmetric for symmetric matrices.
+   virtual void MultTranspose(const Vector &b, Vector &x) const { Mult(b, x); }
+
+   /// Return the number of levels.
+   int GetNumLevels() const { return A.Size(); }
+
+   /// Return the matrix of level @a l, the finest level is 0.
+   const SparseMatrix &GetLevelMatrix(int l) const { return *A[l]; }
+
+   /// Return the prolongation from level @a l+1 to level @a l.
+   const SparseMatrix &GetProlongation(int l) const { return *P[l]; }
+
+   /** @brief Return the operator complexity, the sum of the number of
+       nonzeros of all levels divided by the number of nonzeros of level 0. */
+   double GetOperatorComplexity() const;
+};
+
+}
+
+#endif
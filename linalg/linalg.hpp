@@ -26,6 +26,7 @@
 #include "densemat.hpp"
 #include "ode.hpp"
 #include "solvers.hpp"
+#include "amg.hpp"
 #include "handle.hpp"
 #include "invariants.hpp"
 
@@ -12,6 +12,10 @@
 #include "operator.hpp"
 #include "ode.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace mfem
 {
 
@@ -686,6 +690,418 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 }
 
 
+AdaptiveODESolver::AdaptiveODESolver(int order)
+   : q(order),
+     rel_tol(1e-4), abs_tol(1e-8),
+     safety(0.9), min_factor(0.2), max_factor(5.0),
+     dt_min(0.0), dt_max(std::numeric_limits<double>::infinity()),
+     beta1(0.7), beta2(0.4),
+     dt_next(0.0), err_prev(1.0),
+     num_accepted(0), num_rejected(0)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+void AdaptiveODESolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   x_new.SetSize(f->Width(), mem_type);
+   err.SetSize(f->Width(), mem_type);
+   dt_next = 0.0;
+   err_prev = 1.0;
+   num_accepted = num_rejected = 0;
+}
+
+double AdaptiveODESolver::ErrorNorm(const Vector &e, const Vector &x,
+                                    const Vector &y) const
+{
+   const double *de = e.HostRead(), *dx = x.HostRead(), *dy = y.HostRead();
+   double loc[2] = { 0.0, (double) e.Size() };
+   for (int i = 0; i < e.Size(); i++)
+   {
+      const double w = abs_tol + rel_tol*std::max(std::abs(dx[i]),
+                                                  std::abs(dy[i]));
+      loc[0] += (de[i]/w)*(de[i]/w);
+   }
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      double glob[2];
+      MPI_Allreduce(loc, glob, 2, MPI_DOUBLE, MPI_SUM, comm);
+      loc[0] = glob[0];
+      loc[1] = glob[1];
+   }
+#endif
+   return (loc[1] > 0.0) ? std::sqrt(loc[0]/loc[1]) : 0.0;
+}
+
+void AdaptiveODESolver::Step(Vector &x, double &t, double &dt)
+{
+   const double tf = t + dt;
+   if (dt_next <= 0.0) { dt_next = dt; }
+   dt_next = std::min(std::max(dt_next, dt_min), dt_max);
+
+   const double exponent = 1.0/(q+1);
+   double h = dt;
+   while (t < tf)
+   {
+      // Shorten the step to reach tf exactly
+      bool last = (t + dt_next >= tf);
+      h = last ? tf - t : dt_next;
+      bool rejected = false;
+      while (true)
+      {
+         TryStep(x, t, h, x_new, err);
+         const double err_est = ErrorNorm(err, x, x_new);
+         // A non-finite error estimate, e.g. from an overflow in the stages,
+         // rejects the step with the largest reduction of the step size
+         const bool finite = IsFinite(err_est);
+         MFEM_VERIFY(finite || (h > dt_min && t + h > t),
+                     "Non-finite error estimate at the minimum step size, t = "
+                     << t << ", h = " << h);
+         const double err_norm = finite ? std::max(err_est, 1e-10) : infinity();
+         if (err_norm <= 1.0 || h <= dt_min)
+         {
+            num_accepted++;
+            x = x_new;
+            t = last ? tf : t + h;
+            AcceptStep();
+
+            double factor = safety*std::pow(err_norm, -beta1*exponent)*
+                            std::pow(err_prev, beta2*exponent);
+            // Do not increase the step size right after a rejected step
+            factor = std::min(std::max(factor, min_factor),
+                              rejected ? 1.0 : max_factor);
+            const double h_new = std::min(std::max(h*factor, dt_min), dt_max);
+            // A last step shortened to reach tf does not increase the
+            // proposed step size
+            if (h >= dt_next || h_new < dt_next) { dt_next = h_new; }
+            err_prev = err_norm;
+            break;
+         }
+
+         num_rejected++;
+         rejected = true;
+         const double factor = std::max(min_factor,
+                                        safety*std::pow(err_norm, -exponent));
+         h = std::max(h*factor, dt_min);
+         dt_next = h;
+         last = (h >= tf - t);
+         if (last) { h = tf - t; }
+      }
+   }
+   dt = dt_next;
+}
+
+void AdaptiveODESolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   if (t >= tf) { return; }
+   // The first internal step uses the input dt, the following ones the
+   // step size control of Step()
+   if (dt_next <= 0.0) { dt_next = dt; }
+   dt = tf - t;
+   Step(x, t, dt);
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                                   const double *_bh, const double *_c,
+                                   int _q, bool _fsal)
+   : AdaptiveODESolver(_q)
+{
+   s = _s;
+   a = _a;
+   b = _b;
+   bh = _bh;
+   c = _c;
+   fsal = _fsal;
+   k0_valid = false;
+   k = new Vector[s];
+}
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   k0_valid = false;
+}
+
+void EmbeddedRKSolver::TryStep(const Vector &x, double t, double dt,
+                               Vector &y, Vector &e)
+{
+   // The first stage only depends on (x,t), so it is reused after a rejected
+   // step, and after an accepted step if the method is FSAL
+   if (!k0_valid)
+   {
+      f->SetTime(t);
+      f->Mult(x, k[0]);
+      k0_valid = true;
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      add(x, a[l++]*dt, k[0], z);
+      for (int j = 1; j < i; j++)
+      {
+         z.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(z, k[i]);
+   }
+   y = x;
+   e = 0.0;
+   for (int i = 0; i < s; i++)
+   {
+      y.Add(b[i]*dt, k[i]);
+      e.Add((b[i] - bh[i])*dt, k[i]);
+   }
+}
+
+void EmbeddedRKSolver::AcceptStep()
+{
+   if (fsal) { k[0].Swap(k[s-1]); }
+   k0_valid = fsal;
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double BogackiShampineSolver::a[] =
+{
+   1./2.,
+   0., 3./4.,
+   2./9., 1./3., 4./9.
+};
+const double BogackiShampineSolver::b[] = { 2./9., 1./3., 4./9., 0. };
+const double BogackiShampineSolver::bh[] = { 7./24., 1./4., 1./3., 1./8. };
+const double BogackiShampineSolver::c[] = { 1./2., 3./4., 1. };
+
+const double DormandPrinceSolver::a[] =
+{
+   1./5.,
+   3./40., 9./40.,
+   44./45., -56./15., 32./9.,
+   19372./6561., -25360./2187., 64448./6561., -212./729.,
+   9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.,
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.
+};
+const double DormandPrinceSolver::b[] =
+{
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84., 0.
+};
+const double DormandPrinceSolver::bh[] =
+{
+   5179./57600., 0., 7571./16695., 393./640., -92097./339200., 187./2100.,
+   1./40.
+};
+const double DormandPrinceSolver::c[] =
+{
+   1./5., 3./10., 4./5., 8./9., 1., 1.
+};
+
+
+void AdaptiveSDIRK33Solver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveODESolver::Init(_f);
+   k0.SetSize(f->Width(), mem_type);
+   k1.SetSize(f->Width(), mem_type);
+   k2.SetSize(f->Width(), mem_type);
+}
+
+void AdaptiveSDIRK33Solver::TryStep(const Vector &x, double t, double dt,
+                                    Vector &y, Vector &e)
+{
+   //   a  |   a
+   //   c  |  c-a    a
+   //   1  |   b   1-a-b  a
+   // -----+----------------
+   //      |   b   1-a-b  a
+   //      |  bh1   bh2   0
+   // The embedded weights bh1 + bh2 = 1, bh1 a + bh2 c = 1/2 give a second
+   // order method.
+   const double a = 0.435866521508458999416019;
+   const double b = 1.20849664917601007033648;
+   const double c = 0.717933260754229499708010;
+   const double bh2 = (0.5 - a)/(c - a);
+   const double bh1 = 1.0 - bh2;
+
+   f->SetTime(t + a*dt);
+   f->ImplicitSolve(a*dt, x, k0);
+   add(x, (c-a)*dt, k0, y);
+
+   f->SetTime(t + c*dt);
+   f->ImplicitSolve(a*dt, y, k1);
+   add(x, b*dt, k0, y);
+   y.Add((1.-a-b)*dt, k1);
+
+   f->SetTime(t + dt);
+   f->ImplicitSolve(a*dt, y, k2);
+   y.Add(a*dt, k2);
+
+   add((b - bh1)*dt, k0, (1.-a-b - bh2)*dt, k1, e);
+   e.Add(a*dt, k2);
+}
+
+
+IMEXRKSolver::IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                           const double *_be, const double *_bi,
+                           const double *_c)
+{
+   s = _s;
+   ae = _ae;
+   ai = _ai;
+   be = _be;
+   bi = _bi;
+   c = _c;
+   ke = new Vector[s];
+   ki = new Vector[s];
+
+   // The explicit stages of f2 with ai(i,i) = 0 and the stages of f1 are
+   // only evaluated if they are used by a later stage or by the update
+   ke_needed.SetSize(s);
+   ki_needed.SetSize(s);
+   for (int j = 0; j < s; j++)
+   {
+      ke_needed[j] = (be[j] != 0.0);
+      ki_needed[j] = (bi[j] != 0.0);
+      for (int i = j+1; i < s; i++)
+      {
+         ke_needed[j] = ke_needed[j] || (ae[i*s+j] != 0.0);
+         ki_needed[j] = ki_needed[j] || (ai[i*s+j] != 0.0);
+      }
+   }
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   z.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      ke[i].SetSize(n, mem_type);
+      ki[i].SetSize(n, mem_type);
+   }
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   for (int i = 0; i < s; i++)
+   {
+      // z = x + dt sum_{j<i} (ae(i,j) ke[j] + ai(i,j) ki[j])
+      z = x;
+      for (int j = 0; j < i; j++)
+      {
+         if (ae[i*s+j] != 0.0) { z.Add(ae[i*s+j]*dt, ke[j]); }
+         if (ai[i*s+j] != 0.0) { z.Add(ai[i*s+j]*dt, ki[j]); }
+      }
+
+      f->SetTime(t + c[i]*dt);
+      const double aii = ai[i*s+i];
+      if (aii != 0.0)
+      {
+         // ki[i] = f2(z + aii dt ki[i]), the stage value is z + aii dt ki[i]
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->ImplicitSolve(aii*dt, z, ki[i]);
+         z.Add(aii*dt, ki[i]);
+      }
+      else if (ki_needed[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+         f->Mult(z, ki[i]);
+      }
+      if (ke_needed[i])
+      {
+         f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+         f->Mult(z, ke[i]);
+      }
+   }
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+
+   for (int i = 0; i < s; i++)
+   {
+      if (be[i] != 0.0) { x.Add(be[i]*dt, ke[i]); }
+      if (bi[i] != 0.0) { x.Add(bi[i]*dt, ki[i]); }
+   }
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] ke;
+   delete [] ki;
+}
+
+// gamma = (2-sqrt(2))/2, delta = 1-1/(2 gamma)
+const double ARS232Solver::ae[] =
+{
+   0., 0., 0.,
+   0.292893218813452475599155637895, 0., 0.,
+   -0.707106781186547524400844362105, 1.70710678118654752440084436211, 0.
+};
+const double ARS232Solver::ai[] =
+{
+   0., 0., 0.,
+   0., 0.292893218813452475599155637895, 0.,
+   0., 0.707106781186547524400844362105, 0.292893218813452475599155637895
+};
+const double ARS232Solver::be[] =
+{
+   0., 0.707106781186547524400844362105, 0.292893218813452475599155637895
+};
+const double ARS232Solver::bi[] =
+{
+   0., 0.707106781186547524400844362105, 0.292893218813452475599155637895
+};
+const double ARS232Solver::c[] =
+{
+   0., 0.292893218813452475599155637895, 1.
+};
+
+// The implicit part is the SDIRK method of SDIRK33Solver. The entry a32 of the
+// explicit part is the one of Ascher, Ruuth and Spiteri, the other entries are
+// computed from the row sums and the third order condition.
+const double ARS343Solver::ae[] =
+{
+   0., 0., 0., 0.,
+   0.435866521508458999416019, 0., 0., 0.,
+   0.321278886054229499708010, 0.3966543747, 0., 0.,
+   -0.105858296043284007401744, 0.552929148021642003700872,
+   0.552929148021642003700872, 0.
+};
+const double ARS343Solver::ai[] =
+{
+   0., 0., 0., 0.,
+   0., 0.435866521508458999416019, 0., 0.,
+   0., 0.282066739245770500291990, 0.435866521508458999416019, 0.,
+   0., 1.20849664917601007033648, -0.644363170684469069752495,
+   0.435866521508458999416019
+};
+const double ARS343Solver::be[] =
+{
+   0., 1.20849664917601007033648, -0.644363170684469069752495,
+   0.435866521508458999416019
+};
+const double ARS343Solver::bi[] =
+{
+   0., 1.20849664917601007033648, -0.644363170684469069752495,
+   0.435866521508458999416019
+};
+const double ARS343Solver::c[] =
+{
+   0., 0.435866521508458999416019, 0.717933260754229499708010, 1.
+};
+
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -15,6 +15,10 @@
 #include "../config/config.hpp"
 #include "operator.hpp"
 
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace mfem
 {
 
@@ -460,6 +464,251 @@ public:
 };
 
 
+/** @brief Base class for ODE solvers with adaptive time step control based on
+    an embedded error estimate. */
+/** Step() advances the solution from @a t [in] to t [target] = @a t [in] +
+    @a dt [in] using as many internal steps as required by the error control;
+    the last internal step is shortened to reach t [target] exactly, so that
+    @a t [out] = t [target], and @a dt [out] is the size of the next internal
+    step proposed by the controller. The size of the first internal step is
+    @a dt [in] after Init() and the proposed step size afterwards. Run()
+    advances to the final time directly with this step control, so it ends
+    exactly at the final time.
+
+    A step of size h is accepted if the weighted RMS norm of its error
+    estimate,
+        err = sqrt( 1/N sum_i ( e_i / (abs_tol + rel_tol max(|x_i|, |y_i|)) )^2 ),
+    where x and y are the solutions at the beginning and the end of the step,
+    is at most 1. The next step size is given by the PI controller
+        h_new = h safety err^(-beta1/(q+1)) err_prev^(beta2/(q+1)),
+    where q is the order of the embedded (lower order) method and err_prev is
+    the error of the previous accepted step, limited to the factors set with
+    SetStepFactorLimits() and to the step sizes set with SetStepSizeLimits().
+    After a rejected step, the step size is reduced with the I controller,
+    h_new = h safety err^(-1/(q+1)). Steps with a non-finite error estimate are
+    rejected with the minimum factor, and abort at the minimum step size. */
+class AdaptiveODESolver : public ODESolver
+{
+protected:
+   const int q;
+   double rel_tol, abs_tol;
+   double safety, min_factor, max_factor, dt_min, dt_max;
+   double beta1, beta2;
+   double dt_next, err_prev;
+   int num_accepted, num_rejected;
+   Vector x_new, err;
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   /** @brief Compute the solution @a y after a step of size @a dt from @a x at
+       time @a t, and the error estimate @a e. */
+   virtual void TryStep(const Vector &x, double t, double dt,
+                        Vector &y, Vector &e) = 0;
+
+   /// Called after an accepted step, e.g. to reuse the last stage (FSAL).
+   virtual void AcceptStep() { }
+
+   /// Weighted RMS norm of the error estimate @a e, see the class description.
+   double ErrorNorm(const Vector &e, const Vector &x, const Vector &y) const;
+
+public:
+   /// @a order is the order q of the embedded (lower order) method.
+   AdaptiveODESolver(int order);
+
+#ifdef MFEM_USE_MPI
+   /// Set the communicator used in the computation of the error norm.
+   void SetComm(MPI_Comm _comm) { comm = _comm; }
+#endif
+
+   /// Set the relative and absolute tolerances, default 1e-4 and 1e-8.
+   void SetTolerances(double rtol, double atol)
+   { rel_tol = rtol; abs_tol = atol; }
+
+   /// Set the safety factor of the controller, default 0.9.
+   void SetSafetyFactor(double factor) { safety = factor; }
+
+   /// Limit the ratio of consecutive step sizes, default [0.2, 5].
+   void SetStepFactorLimits(double min_f, double max_f)
+   { min_factor = min_f; max_factor = max_f; }
+
+   /** @brief Limit the step size, default [0, inf). Steps of size @a min_dt
+       are accepted regardless of their error estimate. */
+   void SetStepSizeLimits(double min_dt, double max_dt)
+   { dt_min = min_dt; dt_max = max_dt; }
+
+   /** @brief Set the exponents of the PI controller (relative to 1/(q+1)),
+       default 0.7 and 0.4. With @a b2 = 0 and @a b1 = 1 this is the classical
+       I controller. */
+   void SetControllerParameters(double b1, double b2)
+   { beta1 = b1; beta2 = b2; }
+
+   void Init(TimeDependentOperator &_f) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   /** @brief Advance from @a t to @a tf with a single call to Step(), i.e.
+       with as many internal steps as required by the error control. */
+   /** @a dt [in] is used as the first internal step size only after Init(),
+       and @a dt [out] is the proposed size of the next internal step. */
+   void Run(Vector &x, double &t, double &dt, double tf) override;
+
+   /// Return the number of accepted internal steps since Init().
+   int GetNumAcceptedSteps() const { return num_accepted; }
+
+   /// Return the number of rejected internal steps since Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   /// Return the size of the next internal step proposed by the controller.
+   double GetNextStepSize() const { return dt_next; }
+};
+
+
+/** An explicit Runge-Kutta method with an embedded method of lower order q
+    used for the error estimate, defined by the Butcher tableau
+    +--------+----------------------------+
+    | c[0]   | a[0]                       |
+    | c[1]   | a[1] a[2]                  |
+    | ...    |    ...                     |
+    | c[s-2] | ...   a[s(s-1)/2-1]        |
+    +--------+----------------------------+
+    |        | b[0] b[1] ... b[s-1]       |
+    |        | bh[0] bh[1] ... bh[s-1]    |
+    +--------+----------------------------+
+    where the solution is advanced with the weights b and the embedded
+    solution uses the weights bh. If the method is FSAL (first same as last),
+    the last stage of an accepted step is reused as the first stage of the
+    next one, so the solution must not be modified between calls to Step()
+    without calling Init(). */
+class EmbeddedRKSolver : public AdaptiveODESolver
+{
+private:
+   int s;
+   const double *a, *b, *bh, *c;
+   bool fsal, k0_valid;
+   Vector z, *k;
+
+protected:
+   void TryStep(const Vector &x, double t, double dt,
+                Vector &y, Vector &e) override;
+
+   void AcceptStep() override;
+
+public:
+   EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                    const double *_bh, const double *_c, int _q, bool _fsal);
+
+   void Init(TimeDependentOperator &_f) override;
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/// The Bogacki-Shampine 3(2) pair: 4 stages (3 per step with FSAL), order 3.
+class BogackiShampineSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], bh[4], c[3];
+
+public:
+   BogackiShampineSolver() : EmbeddedRKSolver(4, a, b, bh, c, 2, true) { }
+};
+
+
+/// The Dormand-Prince 5(4) pair: 7 stages (6 per step with FSAL), order 5.
+class DormandPrinceSolver : public EmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], bh[7], c[6];
+
+public:
+   DormandPrinceSolver() : EmbeddedRKSolver(7, a, b, bh, c, 4, true) { }
+};
+
+
+/** The L-stable, three stage SDIRK method of order 3 of SDIRK33Solver with an
+    embedded second order method using the first two stages, for adaptive
+    time stepping of stiff problems. */
+class AdaptiveSDIRK33Solver : public AdaptiveODESolver
+{
+protected:
+   Vector k0, k1, k2;
+
+   void TryStep(const Vector &x, double t, double dt,
+                Vector &y, Vector &e) override;
+
+public:
+   AdaptiveSDIRK33Solver() : AdaptiveODESolver(2) { }
+
+   void Init(TimeDependentOperator &_f) override;
+};
+
+
+/** An implicit-explicit (IMEX) additive Runge-Kutta method for the additive
+    split f(x,t) = f1(x,t) + f2(x,t), where f1 is treated explicitly and the
+    stiff term f2 is treated implicitly with a diagonally implicit method.
+    The two Butcher tableaus are given as full s x s matrices (row-major):
+    +------+-------------+   +------+-------------+
+    | c    | ae          |   | c    | ai          |
+    +------+-------------+   +------+-------------+
+    |      | be          |   |      | bi          |
+    +------+-------------+   +------+-------------+
+    where ae is strictly lower triangular and ai is lower triangular.
+
+    The two terms are evaluated with the evaluation modes of
+    TimeDependentOperator: f1 with Mult() in mode
+    TimeDependentOperator::ADDITIVE_TERM_1, and f2 with ImplicitSolve() (or
+    Mult() for the stages with ai(i,i) = 0) in mode
+    TimeDependentOperator::ADDITIVE_TERM_2. For the methods below, all nonzero
+    diagonal entries of ai are equal, so all calls to ImplicitSolve() within a
+    step use the same @a dt and the operator can reuse its linear solver and
+    preconditioner for all stages (and steps, while dt is constant). */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *ae, *ai, *be, *bi, *c;
+   Array<bool> ke_needed, ki_needed;
+   Vector z, *ke, *ki;
+
+public:
+   IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                const double *_be, const double *_bi, const double *_c);
+
+   void Init(TimeDependentOperator &_f) override;
+
+   void Step(Vector &x, double &t, double &dt) override;
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The second order, L-stable ARS(2,3,2) method of Ascher, Ruuth and Spiteri,
+    "Implicit-explicit Runge-Kutta methods for time-dependent partial
+    differential equations", Appl. Numer. Math., 1997. Two implicit solves per
+    step. */
+class ARS232Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[9], ai[9], be[3], bi[3], c[3];
+
+public:
+   ARS232Solver() : IMEXRKSolver(3, ae, ai, be, bi, c) { }
+};
+
+
+/** The third order, L-stable ARS(3,4,3) method of Ascher, Ruuth and Spiteri.
+    Three implicit solves per step. */
+class ARS343Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[16], ai[16], be[4], bi[4], c[4];
+
+public:
+   ARS343Solver() : IMEXRKSolver(4, ae, ai, be, bi, c) { }
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier–Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -15,10 +15,21 @@
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 namespace mfem
 {
 
+void Operator::ArrayMult(const Array<const Vector *> &X,
+                         Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible arrays of vectors");
+   for (int i = 0; i < X.Size(); i++)
+   {
+      Mult(*X[i], *Y[i]);
+   }
+}
+
 void Operator::InitTVectors(const Operator *Po, const Operator *Ri,
                             const Operator *Pi,
                             Vector &x, Vector &b,
@@ -357,6 +368,32 @@ RAPOperator::RAPOperator(const Operator &Rt_, const Operator &A_,
    APx.SetSize(A.Height(), mem_type);
 }
 
+void RAPOperator::ArrayMult(const Array<const Vector *> &X,
+                            Array<Vector *> &Y) const
+{
+   const int nv = X.Size();
+   const int np = P.Height(), na = A.Height();
+   MemoryType mem_type = GetMemoryType(A.GetMemoryClass()*mem_class);
+   Pxb.SetSize(nv*np, mem_type);
+   APxb.SetSize(nv*na, mem_type);
+   std::vector<Vector> px(nv), apx(nv);
+   Array<const Vector *> PX(nv);
+   Array<Vector *> APX(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      px[i].MakeRef(Pxb, i*np, np);
+      apx[i].MakeRef(APxb, i*na, na);
+      P.Mult(*X[i], px[i]);
+      PX[i] = &px[i];
+      APX[i] = &apx[i];
+   }
+   A.ArrayMult(PX, APX);
+   for (int i = 0; i < nv; i++)
+   {
+      Rt.MultTranspose(apx[i], *Y[i]);
+   }
+}
+
 
 TripleProductOperator::TripleProductOperator(
    const Operator *A, const Operator *B, const Operator *C,
@@ -492,6 +529,68 @@ void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void ConstrainedOperator::ArrayMult(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->ArrayMult(X, Y);
+      return;
+   }
+   if (diag_policy == DIAG_KEEP)
+   {
+      // Needs the action of the operator diagonal, as in Mult()
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+
+   const int nv = X.Size();
+   zb.SetSize(nv*height, GetMemoryType(mem_class));
+   zb.UseDevice(true);
+   std::vector<Vector> zv(nv);
+   Array<const Vector *> Z(nv);
+   auto idx = constraint_list.Read();
+   for (int i = 0; i < nv; i++)
+   {
+      zv[i].MakeRef(zb, i*height, height);
+      zv[i] = *X[i];
+      // Use read+write access - we are modifying sub-vector of z
+      auto d_z = zv[i].ReadWrite();
+      MFEM_FORALL(k, csz, d_z[idx[k]] = 0.0;);
+      Z[i] = &zv[i];
+   }
+
+   A->ArrayMult(Z, Y);
+
+   const double val = (diag_policy == DIAG_ONE) ? 1.0 : 0.0;
+   for (int i = 0; i < nv; i++)
+   {
+      auto d_x = X[i]->Read();
+      // Use read+write access - we are modifying sub-vector of y
+      auto d_y = Y[i]->ReadWrite();
+      MFEM_FORALL(k, csz,
+      {
+         const int id = idx[k];
+         d_y[id] = val*d_x[id];
+      });
+   }
+}
+
+void ConstrainedOperator::AssembleDiagonal(Vector &diag) const
+{
+   A->AssembleDiagonal(diag);
+
+   if (diag_policy == DIAG_KEEP) { return; }
+
+   const int csz = constraint_list.Size();
+   const double val = (diag_policy == DIAG_ONE) ? 1.0 : 0.0;
+   auto idx = constraint_list.Read();
+   // Use read+write access - we are modifying sub-vector of diag
+   auto d_diag = diag.ReadWrite();
+   MFEM_FORALL(i, csz, d_diag[idx[i]] = val;);
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
@@ -92,6 +92,15 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Operator application on several vectors: `Y[i]=A(X[i])` for all
+       i = 0, ..., X.Size()-1. */
+   /** The default behavior in class Operator is to call Mult() for each vector.
+       Derived classes can override this method to apply the operator to all
+       the vectors in one pass, e.g. to read the operator data from memory only
+       once per block of vectors. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -100,6 +109,15 @@ public:
       return const_cast<Operator &>(*this);
    }
 
+   /** @brief Computes the diagonal entries into @a diag. Typically, this
+       operation only makes sense for linear Operator%s. In some cases, only an
+       approximation of the diagonal is computed. The default behavior in class
+       Operator is to generate an error. */
+   virtual void AssembleDiagonal(Vector &diag) const
+   {
+      mfem_error("Operator::AssembleDiagonal() is not overloaded!");
+   }
+
    /** @brief Prolongation operator from linear algebra (linear system) vectors,
        to input vectors for the operator. `NULL` means identity. */
    virtual const Operator *GetProlongation() const { return NULL; }
@@ -747,6 +765,7 @@ private:
    const Operator & P;
    mutable Vector Px;
    mutable Vector APx;
+   mutable Vector Pxb, APxb; // used by ArrayMult()
    MemoryClass mem_class;
 
 public:
@@ -762,6 +781,10 @@ public:
    /// Application of the transpose.
    virtual void MultTranspose(const Vector & x, Vector & y) const
    { Rt.Mult(x, APx); A.MultTranspose(APx, Px); P.MultTranspose(Px, y); }
+
+   /// Application on several vectors, using A.ArrayMult().
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
 };
 
 
@@ -804,6 +827,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable Vector zb;           ///< Auxiliary vectors for ArrayMult().
    MemoryClass mem_class;
    DiagonalPolicy diag_policy;  ///< Diagonal policy for constrained dofs
 
@@ -847,6 +871,16 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Constrained operator action on several vectors, using
+       A->ArrayMult(). */
+   /** With DIAG_KEEP, Mult() is called for each vector. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
+   /** @brief Diagonal of A, modified according to the DiagonalPolicy at the
+       constrained indices/dofs. */
+   virtual void AssembleDiagonal(Vector &diag) const;
+
    /// Destructor: destroys the unconstrained Operator, if owned.
    virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
 };
@@ -44,6 +44,10 @@ template <> struct AutoSIMD<double,2,16>
       return vec[i];
    }
 
+   AutoSIMD() = default;
+
+   AutoSIMD(const AutoSIMD &) = default;
+
    inline MFEM_ALWAYS_INLINE AutoSIMD &operator=(const AutoSIMD &v)
    {
       vd = v.vd;
@@ -67,6 +67,27 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::AllReduceBegin(double *data, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Iallreduce(MPI_IN_PLACE, data, n, MPI_DOUBLE, MPI_SUM, comm,
+                     &reduce_request);
+   }
+#endif
+}
+
+void IterativeSolver::AllReduceEnd() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Wait(&reduce_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -124,7 +145,8 @@ OperatorJacobiSmoother::OperatorJacobiSmoother(const BilinearForm &a,
    dinv(N),
    damping(dmpng),
    ess_tdof_list(ess_tdofs),
-   residual(N)
+   residual(N),
+   diag_from_oper(false)
 {
    Vector diag(N);
    a.AssembleDiagonal(diag);
@@ -141,11 +163,36 @@ OperatorJacobiSmoother::OperatorJacobiSmoother(const Vector &d,
    dinv(N),
    damping(dmpng),
    ess_tdof_list(ess_tdofs),
-   residual(N)
+   residual(N),
+   diag_from_oper(false)
 {
    Setup(d);
 }
 
+OperatorJacobiSmoother::OperatorJacobiSmoother(const double dmpng)
+   :
+   Solver(0),
+   N(0),
+   damping(dmpng),
+   ess_tdof_list(no_ess_tdof_list),
+   diag_from_oper(true),
+   oper(NULL)
+{ }
+
+void OperatorJacobiSmoother::SetOperator(const Operator &op)
+{
+   oper = &op;
+   if (!diag_from_oper) { return; }
+
+   MFEM_VERIFY(op.Height() == op.Width(), "the operator must be square!");
+   height = width = N = op.Height();
+   dinv.SetSize(N);
+   residual.SetSize(N);
+   Vector diag(N);
+   op.AssembleDiagonal(diag);
+   Setup(diag);
+}
+
 void OperatorJacobiSmoother::Setup(const Vector &diag)
 {
    residual.UseDevice(true);
@@ -717,6 +764,425 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    Monitor(final_iter, final_norm, r, x, true);
 }
 
+void PipelinedCGSolver::UpdateVectors()
+{
+   for (Vector *v : { &r, &u, &w, &m, &n, &p, &s, &q, &z })
+   {
+      v->SetSize(width);
+      v->UseDevice(true);
+   }
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   else
+   {
+      u = r;
+   }
+   oper->Mult(u, w);    // w = A u
+
+   double gamma = 0.0, gamma0 = 0.0, gamma_old = 0.0, alpha = 0.0, r0 = 0.0;
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; i++)
+   {
+      // gamma = (u, r) = (B r, r) and delta = (w, u), reduced while computing
+      // m = B w and n = A m
+      double dots[2] = { u*r, w*u };
+      AllReduceBegin(dots, 2);
+      if (prec)
+      {
+         prec->Mult(w, m);
+      }
+      else
+      {
+         m = w;
+      }
+      oper->Mult(m, n);
+      AllReduceEnd();
+      gamma = dots[0];
+      const double delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+      MFEM_ASSERT(IsFinite(delta), "delta = " << delta);
+
+      if (gamma < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PipelinedCG: The preconditioner is not positive "
+                      "definite. (Br, r) = " << gamma << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      if (print_level == 1 || (print_level == 3 && i == 0))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << (print_level == 3 ? " ...\n" : "\n");
+      }
+      Monitor(i, gamma, r, x);
+      if (i == 0)
+      {
+         gamma0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (gamma <= r0)
+      {
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i == max_iter) { break; }
+
+      double beta = 0.0, den = delta;
+      if (i > 0)
+      {
+         beta = gamma/gamma_old;
+         den = delta - beta*gamma/alpha;
+      }
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PipelinedCG: The operator is not positive definite. "
+                      "(Ap, p) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = gamma/den;
+
+      if (i == 0)
+      {
+         z = n;
+         q = m;
+         s = w;
+         p = u;
+      }
+      else
+      {
+         add(n, beta, z, z);  // z = n + beta z = A q
+         add(m, beta, q, q);  // q = m + beta q = B s
+         add(w, beta, s, s);  // s = w + beta s = A p
+         add(u, beta, p, p);  // p = u + beta p
+      }
+      x.Add(alpha, p);
+      r.Add(-alpha, s);
+      u.Add(-alpha, q);
+      w.Add(-alpha, z);
+      gamma_old = gamma;
+   }
+
+   if (print_level == 2)
+   {
+      mfem::out << "Number of PipelinedCG iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << gamma << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "PipelinedCG: No convergence!" << '\n';
+   }
+   if (final_iter > 0 && (print_level >= 1 || (print_level >= 0 && !converged)))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/gamma0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(std::max(gamma, 0.0));
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+// Cholesky factorization, G = R^T R, of the Gram matrix G of a set of vectors
+// that skips the vectors which are numerically dependent on the previous ones.
+// The indices of the remaining vectors are returned in 'kept'; the rows of R
+// with indices not in 'kept' are zero.
+static void DroppingCholesky(const DenseMatrix &G, const double tol,
+                             DenseMatrix &R, Array<int> &kept)
+{
+   const int n = G.Height();
+   R.SetSize(n);
+   R = 0.0;
+   kept.SetSize(0);
+   for (int j = 0; j < n; j++)
+   {
+      for (int k = 0; k < kept.Size(); k++)
+      {
+         const int i = kept[k];
+         double d = G(i,j);
+         for (int l = 0; l < k; l++) { d -= R(kept[l],i)*R(kept[l],j); }
+         R(i,j) = d/R(i,i);
+      }
+      double d = G(j,j);
+      for (int k = 0; k < kept.Size(); k++) { d -= R(kept[k],j)*R(kept[k],j); }
+      if (d > tol*G(j,j))
+      {
+         R(j,j) = sqrt(d);
+         kept.Append(j);
+      }
+   }
+}
+
+// Replace the vectors W[kept[k]] by the columns of W_kept R_kept^{-1}, where R
+// is given by DroppingCholesky(), and move them to the front of W.
+static void ApplyCholQR(const DenseMatrix &R, const Array<int> &kept,
+                        Array<Vector *> &W)
+{
+   for (int k = 0; k < kept.Size(); k++)
+   {
+      const int j = kept[k];
+      for (int l = 0; l < k; l++)
+      {
+         W[j]->Add(-R(kept[l],j), *W[kept[l]]);
+      }
+      *W[j] /= R(j,j);
+   }
+   Array<Vector *> W0(W);
+   Array<bool> is_kept(W.Size());
+   is_kept = false;
+   for (int k = 0; k < kept.Size(); k++)
+   {
+      W[k] = W0[kept[k]];
+      is_kept[kept[k]] = true;
+   }
+   for (int j = 0, k = kept.Size(); j < W.Size(); j++)
+   {
+      if (!is_kept[j]) { W[k++] = W0[j]; }
+   }
+}
+
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   Array<const Vector *> B(1);
+   Array<Vector *> X(1);
+   B[0] = &b;
+   X[0] = &x;
+   ArrayMult(B, X);
+}
+
+void BlockCGSolver::ArrayMult(const Array<const Vector *> &B,
+                              Array<Vector *> &X) const
+{
+   // Breakdown-free variant of the preconditioned block CG method: the block
+   // of search directions P is A-orthonormalized in every iteration with a
+   // Cholesky factorization of P^T A P, dropping the directions that are
+   // (numerically) linearly dependent, so that the method can continue when
+   // some of the columns have converged or the right-hand sides are dependent.
+   const int nv = B.Size();
+   MFEM_VERIFY(X.Size() == nv, "incompatible arrays of vectors");
+   const int n = width;
+   const double drop_tol = 1e-12;
+
+   Array<Vector *> R(nv), Z(nv), AZ(nv), P(nv), Q(nv);
+   for (int j = 0; j < nv; j++)
+   {
+      R[j] = new Vector(n);
+      Z[j] = new Vector(n);
+      AZ[j] = new Vector(n);
+      P[j] = new Vector(n);
+      Q[j] = new Vector(n);
+   }
+   Array<const Vector *> Xc(nv), Rc(nv), Zc(nv);
+   for (int j = 0; j < nv; j++) { Xc[j] = X[j]; }
+
+   if (iterative_mode)
+   {
+      oper->ArrayMult(Xc, R);
+      for (int j = 0; j < nv; j++)
+      {
+         subtract(*B[j], *R[j], *R[j]); // r = b - A x
+      }
+   }
+   else
+   {
+      for (int j = 0; j < nv; j++)
+      {
+         *R[j] = *B[j];
+         *X[j] = 0.0;
+      }
+   }
+
+   // Z = B R and nom = (Z, R). The reduction of nom is combined with the one of
+   // beta = Q^T Z = P^T A Z for the sb current search directions, and it is
+   // overlapped with the operator application AZ = A Z for the next
+   // iteration, which is not used in the last one.
+   Vector nom(nv), r0(nv);
+   DenseMatrix beta;
+   auto ApplyPrec = [&](int sb)
+   {
+      for (int j = 0; j < nv; j++) { Rc[j] = R[j]; }
+      if (prec)
+      {
+         prec->ArrayMult(Rc, Z); // z = B r
+      }
+      else
+      {
+         for (int j = 0; j < nv; j++) { *Z[j] = *R[j]; }
+      }
+      DenseMatrix red(sb+1, nv); // red = [ nom^T ; beta ]
+      for (int j = 0; j < nv; j++)
+      {
+         red(0,j) = (*Z[j]) * (*R[j]);
+         for (int k = 0; k < sb; k++) { red(k+1,j) = (*Q[k]) * (*Z[j]); }
+      }
+      AllReduceBegin(red.Data(), (sb+1)*nv);
+      for (int j = 0; j < nv; j++) { Zc[j] = Z[j]; }
+      oper->ArrayMult(Zc, AZ);
+      AllReduceEnd();
+      beta.SetSize(sb, nv);
+      for (int j = 0; j < nv; j++)
+      {
+         nom(j) = red(0,j);
+         for (int k = 0; k < sb; k++) { beta(k,j) = red(k+1,j); }
+      }
+   };
+
+   ApplyPrec(0);
+   for (int j = 0; j < nv; j++)
+   {
+      MFEM_ASSERT(IsFinite(nom(j)), "nom = " << nom(j));
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+   }
+
+   int sb = 0; // current number of search directions
+   double max_nom = 0.0;
+   converged = 0;
+   final_iter = max_iter;
+   for (int i = 0; true; )
+   {
+      bool done = true;
+      max_nom = 0.0;
+      for (int j = 0; j < nv; j++)
+      {
+         if (nom(j) > r0(j)) { done = false; }
+         max_nom = std::max(max_nom, nom(j));
+      }
+      if (print_level == 1 || (print_level == 3 && i == 0))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << max_nom << (print_level == 3 ? " ...\n" : "\n");
+      }
+      if (done)
+      {
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+      if (i >= max_iter) { break; }
+
+      // New search directions: A-orthogonalize Z against the current P
+      for (int j = 0; j < nv; j++)
+      {
+         for (int k = 0; k < sb; k++)
+         {
+            Z[j]->Add(-beta(k,j), *P[k]);
+            AZ[j]->Add(-beta(k,j), *Q[k]);
+         }
+      }
+      Swap(P, Z);
+      Swap(Q, AZ);
+
+      // A-orthonormalize P, with Q = A P, from the Gram matrix G = P^T Q. The
+      // step alpha = P^T R is reduced together with G, before the
+      // orthonormalization, and transformed in the same way as P.
+      DenseMatrix GA(nv, 2*nv), G(nv), Rf;
+      Array<int> kept;
+      GA = 0.0;
+      for (int j = 0; j < nv; j++)
+      {
+         for (int k = 0; k <= j; k++) { GA(k,j) = (*P[k]) * (*Q[j]); }
+         for (int k = 0; k < nv; k++) { GA(k,nv+j) = (*P[k]) * (*R[j]); }
+      }
+      AllReduceBegin(GA.Data(), 2*nv*nv);
+      AllReduceEnd();
+      for (int j = 0; j < nv; j++)
+      {
+         for (int k = 0; k <= j; k++) { G(k,j) = G(j,k) = GA(k,j); }
+      }
+      DroppingCholesky(G, drop_tol, Rf, kept);
+      ApplyCholQR(Rf, kept, P);
+      ApplyCholQR(Rf, kept, Q);
+      sb = kept.Size();
+      if (sb == 0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "BlockCG: No new search directions, the operator or "
+                      "the preconditioner may not be positive definite.\n";
+         }
+         final_iter = i;
+         break;
+      }
+
+      // X += P alpha, R -= Q alpha, where alpha = R_kept^{-T} (P^T R)_kept
+      DenseMatrix alpha(sb, nv);
+      for (int j = 0; j < nv; j++)
+      {
+         for (int k = 0; k < sb; k++)
+         {
+            double a = GA(kept[k],nv+j);
+            for (int l = 0; l < k; l++) { a -= Rf(kept[l],kept[k])*alpha(l,j); }
+            alpha(k,j) = a/Rf(kept[k],kept[k]);
+         }
+      }
+      for (int j = 0; j < nv; j++)
+      {
+         for (int k = 0; k < sb; k++)
+         {
+            X[j]->Add(alpha(k,j), *P[k]);
+            R[j]->Add(-alpha(k,j), *Q[k]);
+         }
+      }
+      i++;
+
+      ApplyPrec(sb);
+   }
+
+   if (print_level == 2)
+   {
+      mfem::out << "Number of BlockCG iterations: " << final_iter << '\n';
+   }
+   else if (print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter
+                << "  max (B r, r) = " << max_nom << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BlockCG: No convergence!" << '\n';
+   }
+   final_norm = sqrt(std::max(max_nom, 0.0));
+
+   for (int j = 0; j < nv; j++)
+   {
+      delete R[j];
+      delete Z[j];
+      delete AZ[j];
+      delete P[j];
+      delete Q[j];
+   }
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
@@ -982,6 +1448,650 @@ finish:
    }
 }
 
+void SStepGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Left preconditioned s-step GMRES. Every block of (at most) s iterations
+   // builds the monomial basis W = [q_k, (MA) q_k, ..., (MA)^s q_k] without
+   // global reductions, orthogonalizes it against the current basis Q with one
+   // block classical Gram-Schmidt step, C = Q^T W, and orthonormalizes the
+   // result with a Cholesky QR factorization, R^T R = W^T W - C^T C. Both C
+   // and W^T W are computed with one global reduction. The new columns of the
+   // Hessenberg matrix are then recovered from the relation
+   //    (MA) W_{0:s-1} = W_{1:s} = Q T_{1:s},  T = [ C ; R ].
+   // While the reduction is in progress, the vector (MA) W_s is computed, and
+   // (MA) q of the first vector q of the next block is then obtained from it
+   // with the new Hessenberg columns, so that the operator application is
+   // overlapped with the communication.
+   MFEM_VERIFY(m > 0 && s > 0, "invalid KDim = " << m << " or step = " << s);
+
+   const int n = width;
+
+   DenseMatrix H(m+1, m), Hr(m+1, m);
+   Vector g(m+1), cs(m+1), sn(m+1);
+   Vector r(n), w(n), z(n);
+   Array<Vector *> q, W;
+
+   double resid;
+   int j, k;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+   }
+   else
+   {
+      x = 0.0;
+   }
+
+   if (prec)
+   {
+      if (iterative_mode)
+      {
+         subtract(b, r, w);
+         prec->Mult(w, r);    // r = M (b - A x)
+      }
+      else
+      {
+         prec->Mult(b, r);
+      }
+   }
+   else
+   {
+      if (iterative_mode)
+      {
+         subtract(b, r, r);
+      }
+      else
+      {
+         r = b;
+      }
+   }
+   double beta = Norm(r);  // beta = ||r||
+   MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+
+   final_norm = std::max(rel_tol*beta, abs_tol);
+
+   if (beta <= final_norm)
+   {
+      final_norm = beta;
+      final_iter = 0;
+      converged = 1;
+      goto finish;
+   }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  ||B r|| = " << beta << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   Monitor(0, beta, r, x);
+
+   q.SetSize(m+1, NULL);
+   W.SetSize(s+1, NULL);
+
+   for (j = 1; j <= max_iter; )
+   {
+      if (q[0] == NULL) { q[0] = new Vector(n); }
+      q[0]->Set(1.0/beta, r);
+      g = 0.0; g(0) = beta;
+      H = 0.0;
+
+      bool breakdown = false;
+      bool have_w1 = false; // W[1] = M A q[k] was computed by the last block
+      for (k = 0; k < m && j <= max_iter && !breakdown; )
+      {
+         const int sb = std::min(std::min(s, m-k), max_iter-j+1);
+
+         // Monomial basis: W[0] = q[k], W[i] = M A W[i-1]
+         W[0] = q[k];
+         for (int i = have_w1 ? 2 : 1; i <= sb; i++)
+         {
+            if (W[i] == NULL) { W[i] = new Vector(n); }
+            if (prec)
+            {
+               oper->Mult(*W[i-1], r);
+               prec->Mult(r, *W[i]);
+            }
+            else
+            {
+               oper->Mult(*W[i-1], *W[i]);
+            }
+         }
+
+         // C = Q^T W_{1:sb} and G = W_{1:sb}^T W_{1:sb}, reduced together in
+         // D = [ C ; G ] while computing z = M A W[sb] for the next block
+         DenseMatrix D(k+1+sb, sb), C(k+1, sb), G(sb), R(sb);
+         D = 0.0;
+         for (int i = 0; i < sb; i++)
+         {
+            for (int l = 0; l <= k; l++)
+            {
+               D(l,i) = (*q[l]) * (*W[i+1]);
+            }
+            for (int l = 0; l <= i; l++)
+            {
+               D(k+1+l,i) = (*W[l+1]) * (*W[i+1]);
+            }
+         }
+         AllReduceBegin(D.Data(), D.Height()*D.Width());
+         const bool next_block = (k+sb < m) && (j+sb <= max_iter);
+         if (next_block)
+         {
+            if (prec)
+            {
+               oper->Mult(*W[sb], r);
+               prec->Mult(r, z);
+            }
+            else
+            {
+               oper->Mult(*W[sb], z);
+            }
+         }
+         AllReduceEnd();
+
+         // Block Gram-Schmidt: W_{1:sb} -= Q C, and with the orthonormal Q,
+         // the Gram matrix of the result is G - C^T C
+         for (int i = 0; i < sb; i++)
+         {
+            for (int l = 0; l <= k; l++)
+            {
+               C(l,i) = D(l,i);
+               W[i+1]->Add(-C(l,i), *q[l]);
+            }
+            for (int l = 0; l <= i; l++)
+            {
+               double g = D(k+1+l,i);
+               for (int t = 0; t <= k; t++) { g -= C(t,l)*C(t,i); }
+               G(l,i) = g;
+            }
+         }
+
+         // Cholesky QR: G = R^T R
+         R = 0.0;
+         int nvalid = sb;
+         for (int i = 0; i < sb; i++)
+         {
+            for (int l = 0; l < i; l++)
+            {
+               double d = G(l,i);
+               for (int t = 0; t < l; t++) { d -= R(t,l)*R(t,i); }
+               R(l,i) = d/R(l,l);
+            }
+            double d = G(i,i);
+            for (int t = 0; t < i; t++) { d -= R(t,i)*R(t,i); }
+            MFEM_ASSERT(IsFinite(d), "d = " << d);
+            if (d <= 1e-14*G(i,i))
+            {
+               // W[i+1] is (numerically) in the span of the previous vectors
+               nvalid = i;
+               break;
+            }
+            R(i,i) = sqrt(d);
+         }
+         // With a breakdown in column nvalid, its part outside the span of Q is
+         // dropped, giving one more (approximate) Hessenberg column; restart
+         // after it.
+         breakdown = (nvalid < sb);
+         const int se = breakdown ? nvalid + 1 : sb;
+
+         for (int i = 0; i < nvalid; i++)
+         {
+            if (q[k+1+i] == NULL) { q[k+1+i] = new Vector(n); }
+            Vector &qi = *q[k+1+i];
+            qi = *W[i+1];
+            for (int l = 0; l < i; l++)
+            {
+               qi.Add(-R(l,i), *q[k+1+l]);
+            }
+            qi /= R(i,i);
+         }
+
+         // T(:,c) are the coefficients of W[c] in the basis q: T(:,0) = e_k,
+         // T(:,c) = [ C(:,c-1) ; R(:,c-1) ] for c > 0.
+         auto T = [&](int l, int c)
+         {
+            if (c == 0) { return (l == k) ? 1.0 : 0.0; }
+            if (l <= k) { return C(l,c-1); }
+            return (l-k-1 < sb) ? R(l-k-1,c-1) : 0.0;
+         };
+
+         // Hessenberg columns k..k+se-1: with P = T(0:k-1,0:se-1) and the
+         // upper triangular U = T(k:k+se-1,0:se-1),
+         //    H(:,k:k+se-1) = (T(:,1:se) - H(:,0:k-1) P) U^{-1}
+         for (int c = 0; c < se; c++)
+         {
+            const int col = k+c;
+            for (int l = 0; l <= col+1; l++)
+            {
+               double h = T(l,c+1);
+               if (c > 0)
+               {
+                  for (int t = std::max(l-1, 0); t < k; t++)
+                  {
+                     h -= H(l,t)*C(t,c-1);
+                  }
+               }
+               for (int i = 0; i < c; i++)
+               {
+                  h -= H(l,k+i)*T(k+i,c);
+               }
+               H(l,col) = h/T(k+c,c);
+            }
+         }
+
+         // M A q[k+sb] = (z - sum_{l<k+sb} T(l,sb) M A q[l])/T(k+sb,sb), where
+         // M A q[l] = Q H(:,l), is the vector W[1] of the next block
+         have_w1 = next_block && !breakdown;
+         if (have_w1)
+         {
+            Vector h(k+sb+1);
+            h = 0.0;
+            for (int l = 0; l < k+sb; l++)
+            {
+               for (int t = 0; t <= l+1; t++) { h(t) += T(l,sb)*H(t,l); }
+            }
+            if (W[1] == NULL) { W[1] = new Vector(n); }
+            *W[1] = z;
+            for (int t = 0; t <= k+sb; t++) { W[1]->Add(-h(t), *q[t]); }
+            *W[1] /= T(k+sb,sb);
+         }
+
+         // Update the least squares problem with the new columns
+         for (int c = 0; c < se; c++, j++)
+         {
+            const int col = k+c;
+            for (int l = 0; l <= col+1; l++) { Hr(l,col) = H(l,col); }
+            for (int l = 0; l < col; l++)
+            {
+               ApplyPlaneRotation(Hr(l,col), Hr(l+1,col), cs(l), sn(l));
+            }
+            GeneratePlaneRotation(Hr(col,col), Hr(col+1,col), cs(col), sn(col));
+            ApplyPlaneRotation(Hr(col,col), Hr(col+1,col), cs(col), sn(col));
+            ApplyPlaneRotation(g(col), g(col+1), cs(col), sn(col));
+
+            resid = fabs(g(col+1));
+            MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+
+            // The residual estimate of the last column after a breakdown is
+            // not reliable; it is checked after the restart.
+            if (resid <= final_norm && !(breakdown && c == se-1))
+            {
+               Update(x, col, Hr, g, q);
+               final_norm = resid;
+               final_iter = j;
+               converged = 1;
+               goto finish;
+            }
+
+            if (print_level == 1)
+            {
+               mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                         << "   Iteration : " << setw(3) << j
+                         << "  ||B r|| = " << resid << '\n';
+            }
+
+            Monitor(j, resid, r, x);
+         }
+         k += se;
+      }
+
+      if (print_level == 1 && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+
+      Update(x, k-1, Hr, g, q);
+
+      oper->Mult(x, r);
+      if (prec)
+      {
+         subtract(b, r, w);
+         prec->Mult(w, r);    // r = M (b - A x)
+      }
+      else
+      {
+         subtract(b, r, r);
+      }
+      beta = Norm(r);         // beta = ||r||
+      MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+      if (beta <= final_norm)
+      {
+         final_norm = beta;
+         final_iter = j-1;
+         converged = 1;
+         goto finish;
+      }
+   }
+
+   final_norm = beta;
+   final_iter = max_iter;
+   converged = 0;
+
+finish:
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  ||B r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "SStepGMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "SStepGMRES: No convergence!\n";
+   }
+
+   Monitor(final_iter, final_norm, r, x, true);
+
+   for (int i = 0; i < q.Size(); i++)
+   {
+      delete q[i];
+   }
+   for (int i = 1; i < W.Size(); i++)
+   {
+      delete W[i];
+   }
+}
+
+void BlockGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   Array<const Vector *> B(1);
+   Array<Vector *> X(1);
+   B[0] = &b;
+   X[0] = &x;
+   ArrayMult(B, X);
+}
+
+void BlockGMRESSolver::ArrayMult(const Array<const Vector *> &B,
+                                 Array<Vector *> &X) const
+{
+   // Left preconditioned block GMRES: the block Arnoldi process uses block
+   // classical Gram-Schmidt with reorthogonalization and Cholesky QR for each
+   // new block, dropping the numerically dependent directions. The banded
+   // Hessenberg matrix is reduced with Givens rotations that are also applied
+   // to the right-hand sides of all the least squares problems.
+   const int nv = B.Size();
+   MFEM_VERIFY(X.Size() == nv, "incompatible arrays of vectors");
+   MFEM_VERIFY(m > 0, "invalid KDim = " << m);
+   const int n = width;
+   const int max_cols = m*nv, max_rows = (m+1)*nv;
+   const double drop_tol = 1e-14;
+
+   DenseMatrix H(max_rows, max_cols), Hr(max_rows, max_cols), Gm(max_rows, nv);
+   Array<int> rot_row;
+   Array<double> rot_c, rot_s;
+   Array<Vector *> V(max_rows), W(nv), T(nv);
+   V = NULL;
+   for (int i = 0; i < nv; i++)
+   {
+      W[i] = new Vector(n);
+      T[i] = new Vector(n);
+   }
+   Array<const Vector *> Xc(nv);
+   for (int i = 0; i < nv; i++) { Xc[i] = X[i]; }
+   Vector tol(nv), res(nv), y;
+
+   // Apply M A to the vectors in 'in', the result is in the first entries of W
+   auto ApplyPrecOper = [&](const Array<const Vector *> &in)
+   {
+      const int k = in.Size();
+      Array<Vector *> Wk(W.GetData(), k), Tk(T.GetData(), k);
+      Array<const Vector *> Tc(k);
+      oper->ArrayMult(in, prec ? Tk : Wk);
+      if (prec)
+      {
+         for (int i = 0; i < k; i++) { Tc[i] = T[i]; }
+         prec->ArrayMult(Tc, Wk);
+      }
+   };
+
+   bool first = true;
+   double max_res = 0.0;
+   int j = 0; // number of block iterations
+   converged = 0;
+   while (true)
+   {
+      // W = M (B - A X)
+      if (first && !iterative_mode)
+      {
+         for (int i = 0; i < nv; i++)
+         {
+            *X[i] = 0.0;
+            *T[i] = *B[i];
+         }
+      }
+      else
+      {
+         oper->ArrayMult(Xc, T);
+         for (int i = 0; i < nv; i++) { subtract(*B[i], *T[i], *T[i]); }
+      }
+      if (prec)
+      {
+         Array<const Vector *> Tc(nv);
+         for (int i = 0; i < nv; i++) { Tc[i] = T[i]; }
+         prec->ArrayMult(Tc, W);
+      }
+      else
+      {
+         for (int i = 0; i < nv; i++) { *W[i] = *T[i]; }
+      }
+
+      // Initial block of the basis, from the Cholesky QR factorization of W
+      DenseMatrix G(nv), Rf;
+      Array<int> kept;
+      for (int i = 0; i < nv; i++)
+      {
+         for (int k = 0; k <= i; k++) { G(k,i) = (*W[k]) * (*W[i]); }
+      }
+      AllReduceBegin(G.Data(), nv*nv);
+      AllReduceEnd();
+      bool done = true;
+      max_res = 0.0;
+      for (int i = 0; i < nv; i++)
+      {
+         for (int k = 0; k < i; k++) { G(i,k) = G(k,i); }
+         res(i) = sqrt(G(i,i));
+         MFEM_ASSERT(IsFinite(res(i)), "res = " << res(i));
+         if (first) { tol(i) = std::max(rel_tol*res(i), abs_tol); }
+         if (res(i) > tol(i)) { done = false; }
+         max_res = std::max(max_res, res(i));
+      }
+      if (first && (print_level == 1 || print_level == 3))
+      {
+         mfem::out << "   Pass : " << setw(2) << 1
+                   << "   Iteration : " << setw(3) << 0
+                   << "  max ||B r|| = " << max_res
+                   << (print_level == 3 ? " ...\n" : "\n");
+      }
+      first = false;
+      if (done)
+      {
+         converged = 1;
+         break;
+      }
+      if (j >= max_iter) { break; }
+      if (print_level == 1 && j > 0)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+
+      DroppingCholesky(G, drop_tol, Rf, kept);
+      ApplyCholQR(Rf, kept, W);
+      int K = kept.Size(); // current size of the basis
+      Gm = 0.0;
+      for (int k = 0; k < K; k++)
+      {
+         if (V[k] == NULL) { V[k] = new Vector(n); }
+         *V[k] = *W[k];
+         for (int i = 0; i < nv; i++) { Gm(k,i) = Rf(kept[k],i); }
+      }
+      H = 0.0;
+      rot_row.SetSize(0);
+      rot_c.SetSize(0);
+      rot_s.SetSize(0);
+
+      int bs = 0; // start of the last block of the basis
+      while (K > bs && K <= max_cols && j < max_iter)
+      {
+         const int bw = K - bs;
+         Array<const Vector *> Vb(bw);
+         for (int c = 0; c < bw; c++) { Vb[c] = V[bs+c]; }
+         ApplyPrecOper(Vb); // W[c] = M A V[bs+c]
+         j++;
+
+         // Block classical Gram-Schmidt, applied twice
+         DenseMatrix C(K, bw);
+         for (int c = 0; c < bw; c++)
+         {
+            for (int l = 0; l < K; l++) { C(l,c) = (*V[l]) * (*W[c]); }
+         }
+         AllReduceBegin(C.Data(), K*bw);
+         AllReduceEnd();
+         for (int c = 0; c < bw; c++)
+         {
+            for (int l = 0; l < K; l++) { W[c]->Add(-C(l,c), *V[l]); }
+         }
+
+         // The second pass C2 = V^T W and the Gram matrix W^T W of the new
+         // block are reduced together in D = [ C2 ; W^T W ]; with the
+         // orthonormal V, the Gram matrix after the pass is W^T W - C2^T C2
+         DenseMatrix D(K+bw, bw), Gw(bw), Rw;
+         Array<int> kept_w;
+         D = 0.0;
+         for (int c = 0; c < bw; c++)
+         {
+            for (int l = 0; l < K; l++) { D(l,c) = (*V[l]) * (*W[c]); }
+            for (int k = 0; k <= c; k++) { D(K+k,c) = (*W[k]) * (*W[c]); }
+         }
+         AllReduceBegin(D.Data(), (K+bw)*bw);
+         AllReduceEnd();
+         for (int c = 0; c < bw; c++)
+         {
+            for (int l = 0; l < K; l++)
+            {
+               W[c]->Add(-D(l,c), *V[l]);
+               C(l,c) += D(l,c);
+            }
+            for (int k = 0; k <= c; k++)
+            {
+               double g = D(K+k,c);
+               for (int l = 0; l < K; l++) { g -= D(l,k)*D(l,c); }
+               Gw(k,c) = Gw(c,k) = g;
+            }
+         }
+
+         // Cholesky QR of the new block
+         Array<Vector *> Wb(W.GetData(), bw);
+         DroppingCholesky(Gw, drop_tol, Rw, kept_w);
+         ApplyCholQR(Rw, kept_w, Wb);
+         const int nn = kept_w.Size();
+         for (int k = 0; k < nn; k++)
+         {
+            if (V[K+k] == NULL) { V[K+k] = new Vector(n); }
+            *V[K+k] = *W[k];
+         }
+
+         // New Hessenberg columns and their QR factorization
+         const int rows = K + nn;
+         for (int c = 0; c < bw; c++)
+         {
+            const int col = bs + c;
+            for (int l = 0; l < K; l++) { H(l,col) = C(l,c); }
+            for (int k = 0; k < nn; k++) { H(K+k,col) = Rw(kept_w[k],c); }
+            for (int l = 0; l < rows; l++) { Hr(l,col) = H(l,col); }
+            for (int r = 0; r < rot_row.Size(); r++)
+            {
+               const int l = rot_row[r];
+               ApplyPlaneRotation(Hr(l,col), Hr(l+1,col), rot_c[r], rot_s[r]);
+            }
+            for (int l = rows-2; l >= col; l--)
+            {
+               if (Hr(l+1,col) == 0.0) { continue; }
+               double cs, sn;
+               GeneratePlaneRotation(Hr(l,col), Hr(l+1,col), cs, sn);
+               ApplyPlaneRotation(Hr(l,col), Hr(l+1,col), cs, sn);
+               for (int i = 0; i < nv; i++)
+               {
+                  ApplyPlaneRotation(Gm(l,i), Gm(l+1,i), cs, sn);
+               }
+               rot_row.Append(l);
+               rot_c.Append(cs);
+               rot_s.Append(sn);
+            }
+         }
+         bs = K;
+         K = rows;
+
+         // Residual norm estimates
+         done = true;
+         max_res = 0.0;
+         for (int i = 0; i < nv; i++)
+         {
+            double r2 = 0.0;
+            for (int l = bs; l < rows; l++) { r2 += Gm(l,i)*Gm(l,i); }
+            res(i) = sqrt(r2);
+            MFEM_ASSERT(IsFinite(res(i)), "res = " << res(i));
+            if (res(i) > tol(i)) { done = false; }
+            max_res = std::max(max_res, res(i));
+         }
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  max ||B r|| = " << max_res << '\n';
+         }
+         // The dropped directions make the estimates inexact, so convergence
+         // is confirmed with the true residual after the update.
+         if (done) { break; }
+      }
+
+      // X += V Y, with Y the solution of the triangular system Hr Y = Gm
+      const int ncols = bs;
+      y.SetSize(ncols);
+      for (int i = 0; i < nv; i++)
+      {
+         for (int l = 0; l < ncols; l++) { y(l) = Gm(l,i); }
+         for (int l = ncols-1; l >= 0; l--)
+         {
+            y(l) /= Hr(l,l);
+            for (int k = 0; k < l; k++) { y(k) -= Hr(k,l)*y(l); }
+         }
+         for (int l = 0; l < ncols; l++) { X[i]->Add(y(l), *V[l]); }
+      }
+   }
+
+   final_iter = j;
+   final_norm = max_res;
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  max ||B r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "BlockGMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "BlockGMRES: No convergence!\n";
+   }
+
+   for (int i = 0; i < V.Size(); i++)
+   {
+      delete V[i];
+   }
+   for (int i = 0; i < nv; i++)
+   {
+      delete W[i];
+      delete T[i];
+   }
+}
+
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
    DenseMatrix H(m+1,m);
@@ -67,6 +67,7 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   mutable MPI_Request reduce_request;
 #endif
 
 protected:
@@ -83,6 +84,14 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+
+   /** @brief Start the global sum of the @a n local values in @a data (in
+       place) over the communicator, if any, with a non-blocking reduction. */
+   /** The values in @a data are available after AllReduceEnd(). At most one
+       reduction can be active at a time. */
+   void AllReduceBegin(double *data, int n) const;
+   /// Finish the reduction started by AllReduceBegin().
+   void AllReduceEnd() const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -143,19 +152,29 @@ public:
    OperatorJacobiSmoother(const Vector &d,
                           const Array<int> &ess_tdof_list,
                           const double damping=1.0);
+
+   /** Setup a Jacobi smoother whose diagonal is obtained by calling
+       Operator::AssembleDiagonal() on the operator given to SetOperator().
+       Essential dofs are expected to be handled by the operator itself, e.g.
+       by a ConstrainedOperator with the DIAG_ONE policy. This is convenient
+       when the operator changes, e.g. as the preconditioner of a Newton solver
+       with a partially assembled gradient. */
+   OperatorJacobiSmoother(const double damping=1.0);
    ~OperatorJacobiSmoother() {}
 
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const { Mult(x, y); }
-   void SetOperator(const Operator &op) { oper = &op; }
+   void SetOperator(const Operator &op);
    void Setup(const Vector &diag);
 
 private:
-   const int N;
+   int N;
    Vector dinv;
    const double damping;
    const Array<int> &ess_tdof_list;
    mutable Vector residual;
+   const Array<int> no_ess_tdof_list;
+   const bool diag_from_oper;
 
    const Operator *oper;
 };
@@ -275,6 +294,63 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// Pipelined conjugate gradient method.
+/** The preconditioned variant of the pipelined CG method of P. Ghysels and
+    W. Vanroose, "Hiding global synchronization latency in the preconditioned
+    Conjugate Gradient algorithm", Parallel Computing, 2014. The two inner
+    products of each iteration are combined in a single non-blocking global
+    reduction, which is overlapped with the application of the preconditioner
+    and the operator. In exact arithmetic the iterates are the same as the ones
+    of CGSolver; the method uses more vectors and its recurrences are somewhat
+    less stable in finite precision. */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, p, s, q, z;
+
+   void UpdateVectors();
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   virtual void SetOperator(const Operator &op)
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/// Block conjugate gradient method for several right-hand sides.
+/** ArrayMult() solves the systems for all the given right-hand sides with a
+    common block Krylov space, applying the operator and the preconditioner
+    with their ArrayMult() methods, so that e.g. a partially assembled operator
+    reads its data only once per block of vectors. The block of search
+    directions is A-orthonormalized in each iteration, dropping directions that
+    are numerically dependent, which also handles dependent right-hand sides.
+    The iterations stop when the relative (or absolute) tolerance, applied to
+    the preconditioned residual norm as in CGSolver, is reached for all the
+    right-hand sides. The operator and the preconditioner must be symmetric
+    positive definite. */
+class BlockCGSolver : public IterativeSolver
+{
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Solve with a single right-hand side, see ArrayMult().
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve the systems with right-hand sides @a B and solutions @a X.
+   virtual void ArrayMult(const Array<const Vector *> &B,
+                          Array<Vector *> &X) const;
+};
+
 /// Conjugate gradient method. (tolerances are squared)
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter = 0, int max_num_iter = 1000,
@@ -305,6 +381,69 @@ public:
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
+/// s-step (communication-avoiding) GMRES method
+/** Left preconditioned GMRES, like GMRESSolver, where each block of s
+    iterations computes the monomial Krylov basis w, (B A) w, ..., (B A)^s w
+    without global reductions, followed by a block classical Gram-Schmidt
+    orthogonalization and a Cholesky QR factorization of the new block, which
+    share one global reduction. The Hessenberg matrix is recovered from the
+    change of basis, so that only 1 reduction is needed per s iterations,
+    instead of i+2 reductions in iteration i of GMRESSolver, and it is
+    overlapped with the operator and preconditioner application for the next
+    block. Since the monomial basis becomes ill-conditioned for large s, small
+    values of s (e.g. 2-8) should be used. If the new block is numerically
+    rank deficient, the method restarts. */
+class SStepGMRESSolver : public IterativeSolver
+{
+protected:
+   int m, s; // see SetKDim() and SetStepSize()
+
+public:
+   SStepGMRESSolver() { m = 50; s = 4; }
+
+#ifdef MFEM_USE_MPI
+   SStepGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; s = 4; }
+#endif
+
+   /// Set the number of iteration to perform between restarts, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /// Set the number of iterations per block, default is 4.
+   void SetStepSize(int step) { s = step; }
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/// Block GMRES method for several right-hand sides
+/** Left preconditioned, like GMRESSolver. ArrayMult() builds one block Krylov
+    space for all the given right-hand sides, applying the operator and the
+    preconditioner with their ArrayMult() methods. The block Arnoldi process
+    drops numerically dependent directions. The basis of a cycle has at most
+    KDim blocks of (at most) as many vectors as the number of right-hand sides,
+    and each block is one iteration. */
+class BlockGMRESSolver : public IterativeSolver
+{
+protected:
+   int m; // see SetKDim()
+
+public:
+   BlockGMRESSolver() { m = 50; }
+
+#ifdef MFEM_USE_MPI
+   BlockGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+#endif
+
+   /// Set the number of block iterations between restarts, default is 50.
+   void SetKDim(int dim) { m = dim; }
+
+   /// Solve with a single right-hand side, see ArrayMult().
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Solve the systems with right-hand sides @a B and solutions @a X.
+   virtual void ArrayMult(const Array<const Vector *> &B,
+                          Array<Vector *> &X) const;
+};
+
 /// FGMRES method
 class FGMRESSolver : public IterativeSolver
 {
@@ -3336,132 +3336,211 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 }
 
 
-SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
-                    SparseMatrix *OAB)
-{
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
-   const double *A_data, *B_data;
-   double *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
-   SparseMatrix *C;
-
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
-
-   MFEM_VERIFY(ncolsA == nrowsB,
-               "number of columns of A (" << ncolsA
-               << ") must equal number of rows of B (" << nrowsB << ")");
-
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-   B_i    = B.GetI();
-   B_j    = B.GetJ();
-   B_data = B.GetData();
-
-   B_marker = new int[ncolsB];
+// Returns true if the sparse matrix products below should use OpenMP threads:
+// always with MFEM_USE_LEGACY_OPENMP and, with MFEM_USE_OPENMP, when the
+// OpenMP device backend is enabled.
+static bool SparseProductUseThreads()
+{
+#if defined(MFEM_USE_LEGACY_OPENMP)
+   return true;
+#elif defined(MFEM_USE_OPENMP)
+   return Device::Allows(Backend::OMP_MASK);
+#else
+   return false;
+#endif
+}
 
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
+#if defined(MFEM_USE_OPENMP) || defined(MFEM_USE_LEGACY_OPENMP)
+#define MFEM_SPARSE_PRODUCT_OMP
+#endif
 
-   if (OAB == NULL)
+// Compute the sparse row y = x.B with Gustavson's algorithm. The row x is given
+// by its 'nx' column indices 'xj' and its values 'xv', which may be NULL for a
+// symbolic product. The column j is present in y if mark[j] == row, in which
+// case its position in y is where[j]. New columns are appended to y at
+// position 'ny', storing the index in 'yj' and the value in 'yv' (if they are
+// not NULL), unless 'fixed' is true, in which case -1 is returned. Otherwise,
+// the new number of entries in y is returned.
+static inline int SparseRowProduct(const int nx, const int *xj,
+                                   const double *xv, const int *B_i,
+                                   const int *B_j, const double *B_data,
+                                   const int row, int *mark, int *where,
+                                   int ny, int *yj, double *yv,
+                                   const bool fixed)
+{
+   for (int s = 0; s < nx; s++)
    {
-      C_i = Memory<int>(nrowsA+1);
-
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+      const int k = xj[s];
+      const double x_entry = xv ? xv[s] : 0.0;
+      for (int ib = B_i[k]; ib < B_i[k+1]; ib++)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         const int j = B_j[ib];
+         if (mark[j] != row)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
-            {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
-               {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
-               }
-            }
+            if (fixed) { return -1; }
+            mark[j] = row;
+            where[j] = ny;
+            if (yj) { yj[ny] = j; }
+            if (yv) { yv[ny] = x_entry*B_data[ib]; }
+            ny++;
+         }
+         else if (yv)
+         {
+            yv[where[j]] += x_entry*B_data[ib];
          }
-         C_i[ic+1] = num_nonzeros;
       }
+   }
+   return ny;
+}
 
-      C_j    = Memory<int>(num_nonzeros);
-      C_data = Memory<double>(num_nonzeros);
+// Compute the product C = R.A.B when R is not NULL, or C = A.B otherwise. The
+// rows of C are computed independently (in parallel, if enabled), first
+// symbolically to find the number of entries in each row and then numerically.
+// In the triple product, the row i of C is computed as (R(i,:).A).B, without
+// forming R.A or A.B. If OC is not NULL, it must contain the sparsity pattern
+// of the product (in any order within its rows) and only the values of OC are
+// computed.
+static SparseMatrix *SparseProduct(const SparseMatrix *R, const SparseMatrix &A,
+                                   const SparseMatrix &B, SparseMatrix *OC)
+{
+   const SparseMatrix &X = R ? *R : A; // the first factor
+   const int nrows = X.Height();
+   const int ncols = B.Width();
+   const int nmid = R ? A.Width() : 0;
 
-      C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
+   MFEM_VERIFY(X.Width() == (R ? A.Height() : B.Height()) &&
+               (!R || A.Width() == B.Height()),
+               "incompatible matrix sizes: the number of columns of each factor"
+               " must equal the number of rows of the next one");
 
-      for (ib = 0; ib < ncolsB; ib++)
-      {
-         B_marker[ib] = -1;
-      }
+   const int *X_i = X.GetI(), *X_j = X.GetJ();
+   const double *X_data = X.GetData();
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const double *A_data = A.GetData();
+   const int *B_i = B.GetI(), *B_j = B.GetJ();
+   const double *B_data = B.GetData();
+
+   int *C_i, *C_j;
+   double *C_data;
+   if (OC)
+   {
+      MFEM_VERIFY(nrows == OC->Height() && ncols == OC->Width(),
+                  "Input matrix sizes do not match output sizes"
+                  << " nrows = " << nrows
+                  << ", OC->Height() = " << OC->Height()
+                  << " ncols = " << ncols
+                  << ", OC->Width() = " << OC->Width());
+      C_i    = OC->GetI();
+      C_j    = OC->GetJ();
+      C_data = OC->GetData();
    }
    else
    {
-      C = OAB;
-
-      MFEM_VERIFY(nrowsA == C -> Height() && ncolsB == C -> Width(),
-                  "Input matrix sizes do not match output sizes"
-                  << " nrowsA = " << nrowsA
-                  << ", C->Height() = " << C->Height()
-                  << " ncolsB = " << ncolsB
-                  << ", C->Width() = " << C->Width());
-
-      // C_i    = C -> GetI(); // not used
-      C_j    = C -> GetJ();
-      C_data = C -> GetData();
+      C_i = Memory<int>(nrows+1);
+      C_j = NULL;
+      C_data = NULL;
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   int missing = 0;
+   const bool use_threads = SparseProductUseThreads();
+   MFEM_CONTRACT_VAR(use_threads);
+
+#ifdef MFEM_SPARSE_PRODUCT_OMP
+   #pragma omp parallel if (use_threads) reduction(+:missing)
+#endif
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+      // thread-local work space; the rows are marked with 'i' in the symbolic
+      // pass and with 'nrows + i' in the numeric pass
+      Array<int> mark(ncols), where(ncols);
+      Array<int> t_mark(nmid), t_where(nmid), t_j(nmid);
+      Array<double> t_data(nmid);
+      mark = -1;
+      t_mark = -1;
+
+      // Return the entries of the row i of the first factor, or of R(i,:).A
+      // in the triple product
+      auto first_row = [&](const int i, const int stamp, const bool values,
+                           int &nx, const int *&xj, const double *&xv)
+      {
+         const int xs = X_i[i];
+         if (!R)
+         {
+            nx = X_i[i+1] - xs;
+            xj = X_j + xs;
+            xv = X_data + xs;
+            return;
+         }
+         nx = SparseRowProduct(X_i[i+1] - xs, X_j + xs,
+                               values ? X_data + xs : NULL,
+                               A_i, A_j, A_data, stamp, t_mark, t_where, 0,
+                               t_j, values ? t_data.GetData() : NULL, false);
+         xj = t_j;
+         xv = t_data;
+      };
+
+      int nx;
+      const int *xj;
+      const double *xv;
+
+      if (!OC)
+      {
+#ifdef MFEM_SPARSE_PRODUCT_OMP
+         #pragma omp for schedule(dynamic, 64)
+#endif
+         for (int i = 0; i < nrows; i++)
+         {
+            first_row(i, i, false, nx, xj, xv);
+            C_i[i+1] = SparseRowProduct(nx, xj, NULL, B_i, B_j, B_data, i,
+                                        mark, where, 0, NULL, NULL, false);
+         }
+
+#ifdef MFEM_SPARSE_PRODUCT_OMP
+         #pragma omp single
+#endif
+         {
+            C_i[0] = 0;
+            for (int i = 0; i < nrows; i++) { C_i[i+1] += C_i[i]; }
+            C_j    = Memory<int>(C_i[nrows]);
+            C_data = Memory<double>(C_i[nrows]);
+         }
+      }
+
+#ifdef MFEM_SPARSE_PRODUCT_OMP
+      #pragma omp for schedule(dynamic, 64)
+#endif
+      for (int i = 0; i < nrows; i++)
       {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         const int stamp = nrows + i;
+         const int cs = C_i[i], nc = C_i[i+1] - cs;
+         first_row(i, stamp, true, nx, xj, xv);
+         if (OC)
          {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
-            {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
-               {
-                  C_j[counter] = jb;
-               }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
+            for (int k = 0; k < nc; k++)
             {
-               C_data[B_marker[jb]] += a_entry*b_entry;
+               mark[C_j[cs+k]] = stamp;
+               where[C_j[cs+k]] = k;
+               C_data[cs+k] = 0.0;
             }
          }
+         const int n = SparseRowProduct(nx, xj, xv, B_i, B_j, B_data, stamp,
+                                        mark, where, 0, OC ? NULL : C_j + cs,
+                                        C_data + cs, OC != NULL);
+         if (n < 0) { missing++; }
+         MFEM_ASSERT(n < 0 || OC || n == nc, "internal error");
       }
    }
 
-   MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
+   MFEM_VERIFY(missing == 0, "With pre-allocated output matrix, the sparsity "
+               "pattern does not contain all entries of the product in "
+               << missing << " rows");
 
-   delete [] B_marker;
+   return OC ? OC : new SparseMatrix(C_i, C_j, C_data, nrows, ncols);
+}
 
-   return C;
+SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
+                    SparseMatrix *OAB)
+{
+   return SparseProduct(NULL, A, B, OAB);
 }
 
 SparseMatrix * TransposeMult(const SparseMatrix &A, const SparseMatrix &B)
@@ -3608,22 +3687,18 @@ DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P)
 SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
                    SparseMatrix *ORAP)
 {
-   SparseMatrix *P  = Transpose (R);
-   SparseMatrix *AP = Mult (A, *P);
+   SparseMatrix *P = Transpose (R);
+   SparseMatrix *_RAP = SparseProduct (&R, A, *P, ORAP);
    delete P;
-   SparseMatrix *_RAP = Mult (R, *AP, ORAP);
-   delete AP;
    return _RAP;
 }
 
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P)
+                  const SparseMatrix &P, SparseMatrix *ORAP)
 {
    SparseMatrix * R = Transpose(Rt);
-   SparseMatrix * RA = Mult(*R,A);
+   SparseMatrix * out = SparseProduct(R, A, P, ORAP);
    delete R;
-   SparseMatrix * out = Mult(*RA, P);
-   delete RA;
    return out;
 }
 
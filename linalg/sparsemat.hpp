@@ -284,6 +284,9 @@ public:
    /// Returns the Diagonal of A
    void GetDiag(Vector & d) const;
 
+   /// Same as GetDiag(); overrides Operator::AssembleDiagonal().
+   virtual void AssembleDiagonal(Vector &diag) const { GetDiag(diag); }
+
    /// Produces a DenseMatrix from a SparseMatrix
    DenseMatrix *ToDenseMatrix() const;
 
@@ -646,7 +649,13 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 /// Matrix product A.B.
 /** If @a OAB is not NULL, we assume it has the structure of A.B and store the
     result in @a OAB. If @a OAB is NULL, we create a new SparseMatrix to store
-    the result and return a pointer to it.
+    the result and return a pointer to it. The structure of @a OAB may come from
+    a previous product with the same A and B, e.g. when only the values of the
+    matrices change; the order of the entries within its rows is not relevant.
+
+    The rows of the product are computed in parallel when MFEM is built with
+    MFEM_USE_LEGACY_OPENMP, or with MFEM_USE_OPENMP and the OpenMP device
+    backend is enabled.
 
     All matrices must be finalized. */
 SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B,
@@ -673,9 +682,12 @@ DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P);
 SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
                   SparseMatrix *ORAP = NULL);
 
-/// General RAP with given R^T, A and P
+/** General RAP with given R^T, A and P. ORAP is like OAB above.
+    All matrices must be finalized. */
+/** The triple product is computed row by row, without forming the
+    intermediate products R.A or A.P. */
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P);
+                  const SparseMatrix &P, SparseMatrix *ORAP = NULL);
 
 /// Matrix multiplication A^t D A. All matrices must be finalized.
 SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bbox_tree.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+BoundingBoxTree::BoundingBoxTree(const DenseMatrix &bmin,
+                                 const DenseMatrix &bmax)
+   : dim(bmin.Height()), box_min(bmin), box_max(bmax)
+{
+   MFEM_VERIFY(1 <= dim && dim <= 3, "invalid space dimension: " << dim);
+   MFEM_VERIFY(bmax.Height() == dim && bmax.Width() == bmin.Width(),
+               "incompatible box matrices");
+
+   const int nboxes = bmin.Width();
+   box_ids.SetSize(nboxes);
+   for (int i = 0; i < nboxes; i++) { box_ids[i] = i; }
+
+   nodes.Reserve(nboxes > 0 ? 2*((nboxes + max_leaf_size - 1)/max_leaf_size)
+                 : 0);
+   if (nboxes > 0) { Build(0, nboxes); }
+}
+
+int BoundingBoxTree::Build(int begin, int end)
+{
+   const int id = nodes.Append(Node()) - 1;
+   Node node;
+   for (int d = 0; d < 3; d++)
+   {
+      node.min[d] = std::numeric_limits<double>::infinity();
+      node.max[d] = -std::numeric_limits<double>::infinity();
+   }
+   for (int i = begin; i < end; i++)
+   {
+      const double *lo = box_min.GetColumn(box_ids[i]);
+      const double *hi = box_max.GetColumn(box_ids[i]);
+      for (int d = 0; d < dim; d++)
+      {
+         node.min[d] = std::min(node.min[d], lo[d]);
+         node.max[d] = std::max(node.max[d], hi[d]);
+      }
+   }
+   node.begin = begin;
+   node.end = end;
+   node.left = node.right = -1;
+
+   if (end - begin > max_leaf_size)
+   {
+      // Split at the median box center along the longest axis
+      int axis = 0;
+      for (int d = 1; d < dim; d++)
+      {
+         if (node.max[d] - node.min[d] > node.max[axis] - node.min[axis])
+         {
+            axis = d;
+         }
+      }
+      const DenseMatrix &lo = box_min, &hi = box_max;
+      const int mid = (begin + end)/2;
+      std::nth_element(box_ids.GetData() + begin, box_ids.GetData() + mid,
+                       box_ids.GetData() + end, [&](int a, int b)
+      {
+         return lo(axis,a) + hi(axis,a) < lo(axis,b) + hi(axis,b);
+      });
+      node.left = Build(begin, mid);
+      node.right = Build(mid, end);
+   }
+   nodes[id] = node;
+   return id;
+}
+
+void BoundingBoxTree::FindBoxes(const double *pt, Array<int> &ids) const
+{
+   ids.SetSize(0);
+   if (nodes.Size() == 0) { return; }
+
+   int stack[128];
+   int top = 0;
+   stack[top++] = 0;
+   while (top > 0)
+   {
+      const Node &node = nodes[stack[--top]];
+      if (!Contains(node.min, node.max, pt)) { continue; }
+      if (node.left >= 0)
+      {
+         stack[top++] = node.left;
+         stack[top++] = node.right;
+      }
+      else
+      {
+         for (int i = node.begin; i < node.end; i++)
+         {
+            const int b = box_ids[i];
+            if (Contains(box_min.GetColumn(b), box_max.GetColumn(b), pt))
+            {
+               ids.Append(b);
+            }
+         }
+      }
+   }
+}
+
+} // namespace mfem
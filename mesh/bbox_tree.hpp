@@ -0,0 +1,84 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BBOX_TREE
+#define MFEM_BBOX_TREE
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../linalg/densemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Bounding volume hierarchy over a set of axis-aligned boxes.
+
+    The tree is built once, in O(n log n) time, by recursively splitting the
+    boxes at the median of their centers along the longest axis of the
+    enclosing box. A point query then visits only the O(log n) subtrees whose
+    boxes contain the point.
+
+    The class is used by Mesh::FindPoints() to select the candidate elements
+    for a given point, see Mesh::GetElementBoundingBoxTree(). */
+class BoundingBoxTree
+{
+protected:
+   struct Node
+   {
+      double min[3], max[3]; ///< Bounding box of the node.
+      int left, right;       ///< Child node indices; left < 0 for leaves.
+      int begin, end;        ///< Range in #box_ids for leaves.
+   };
+
+   int dim;
+   DenseMatrix box_min, box_max;
+   Array<int> box_ids;
+   Array<Node> nodes;
+
+   static const int max_leaf_size = 4;
+
+   int Build(int begin, int end);
+
+   bool Contains(const double *bmin, const double *bmax, const double *pt) const
+   {
+      for (int d = 0; d < dim; d++)
+      {
+         if (pt[d] < bmin[d] || pt[d] > bmax[d]) { return false; }
+      }
+      return true;
+   }
+
+public:
+   /** @brief Construct the tree for the boxes given by the columns of
+       @a bmin and @a bmax (lower and upper corners, respectively).
+
+       The space dimension, equal to the height of the matrices, must be 1, 2,
+       or 3. The matrices are copied. */
+   BoundingBoxTree(const DenseMatrix &bmin, const DenseMatrix &bmax);
+
+   /// Return the space dimension of the boxes.
+   int Dimension() const { return dim; }
+
+   /// Return the number of boxes in the tree.
+   int GetNBoxes() const { return box_ids.Size(); }
+
+   /// Return the lower and upper corners of box @a i.
+   const double *GetBoxMin(int i) const { return box_min.GetColumn(i); }
+   const double *GetBoxMax(int i) const { return box_max.GetColumn(i); }
+
+   /** @brief Return in @a ids the indices of all boxes containing the point
+       @a pt, given by Dimension() coordinates. The order is unspecified. */
+   void FindBoxes(const double *pt, Array<int> &ids) const;
+};
+
+} // namespace mfem
+
+#endif
@@ -766,12 +766,16 @@ void Mesh::GetLocalQuadToWdgTransformation(
 }
 
 const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
-                                                  const int flags)
+                                                  const int flags,
+                                                  Geometry::Type geom)
 {
+   // With a single element geometry, 'geom' selects all the elements
+   if (GetNumGeometries(Dim) <= 1) { geom = Geometry::INVALID; }
    for (int i = 0; i < geom_factors.Size(); i++)
    {
       GeometricFactors *gf = geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
+      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags &&
+          gf->geom == geom)
       {
          return gf;
       }
@@ -779,7 +783,7 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
 
    this->EnsureNodes();
 
-   GeometricFactors *gf = new GeometricFactors(this, ir, flags);
+   GeometricFactors *gf = new GeometricFactors(this, ir, flags, geom);
    geom_factors.Append(gf);
    return gf;
 }
@@ -819,6 +823,85 @@ void Mesh::DeleteGeometricFactors()
    face_geom_factors.SetSize(0);
 }
 
+void Mesh::NodesUpdated()
+{
+   DeleteGeometricFactors();
+   DeleteElementBoundingBoxTree();
+}
+
+void Mesh::DeleteElementBoundingBoxTree()
+{
+   delete elem_bbox_tree;
+   elem_bbox_tree = NULL;
+}
+
+const BoundingBoxTree &Mesh::GetElementBoundingBoxTree()
+{
+   if (elem_bbox_tree && elem_bbox_sequence == sequence &&
+       elem_bbox_tree->GetNBoxes() == GetNE())
+   {
+      return *elem_bbox_tree;
+   }
+   DeleteElementBoundingBoxTree();
+
+   // The nodes of curved elements do not bound the element, so their boxes
+   // are padded generously; the same is done for lower-dimensional elements
+   // (surfaces, curves) to capture nearby points that project onto them.
+   const bool curved = Nodes && Nodes->FESpace()->GetOrder(0) > 1;
+   const double rel_pad = (curved || Dim < spaceDim) ? 0.1 : 1e-8;
+
+   const int NE = GetNE();
+   DenseMatrix bmin(spaceDim, NE), bmax(spaceDim, NE);
+   Array<int> vdofs;
+   Vector coords;
+   for (int i = 0; i < NE; i++)
+   {
+      int npts;
+      if (Nodes)
+      {
+         Nodes->FESpace()->GetElementVDofs(i, vdofs);
+         Nodes->GetSubVector(vdofs, coords);
+         npts = vdofs.Size()/spaceDim;
+      }
+      else
+      {
+         GetElementVertices(i, vdofs);
+         npts = vdofs.Size();
+         coords.SetSize(npts*spaceDim);
+         for (int j = 0; j < npts; j++)
+         {
+            for (int d = 0; d < spaceDim; d++)
+            {
+               coords(j + d*npts) = vertices[vdofs[j]](d);
+            }
+         }
+      }
+      double *lo = bmin.GetColumn(i), *hi = bmax.GetColumn(i);
+      double ext = 0.0;
+      for (int d = 0; d < spaceDim; d++)
+      {
+         const double *c = coords.GetData() + d*npts;
+         lo[d] = hi[d] = c[0];
+         for (int j = 1; j < npts; j++)
+         {
+            lo[d] = std::min(lo[d], c[j]);
+            hi[d] = std::max(hi[d], c[j]);
+         }
+         ext = std::max(ext, hi[d] - lo[d]);
+      }
+      const double pad = rel_pad*ext;
+      for (int d = 0; d < spaceDim; d++)
+      {
+         lo[d] -= pad;
+         hi[d] += pad;
+      }
+   }
+
+   elem_bbox_tree = new BoundingBoxTree(bmin, bmax);
+   elem_bbox_sequence = sequence;
+   return *elem_bbox_tree;
+}
+
 void Mesh::GetLocalFaceTransformation(
    int face_type, int elem_type, IsoparametricTransformation &Transf, int info)
 {
@@ -1077,6 +1160,7 @@ void Mesh::Init()
    sequence = 0;
    Nodes = NULL;
    own_nodes = 1;
+   mapped_file = NULL;
    NURBSext = NULL;
    ncmesh = NULL;
    last_operation = Mesh::NONE;
@@ -1086,6 +1170,7 @@ void Mesh::InitTables()
 {
    el_to_edge =
       el_to_face = el_to_el = bel_to_edge = face_edge = edge_vertex = NULL;
+   elem_bbox_tree = NULL;
 }
 
 void Mesh::SetEmpty()
@@ -1108,12 +1193,15 @@ void Mesh::DestroyTables()
 
    delete face_edge;
    delete edge_vertex;
+   delete elem_bbox_tree;
 }
 
 void Mesh::DestroyPointers()
 {
    if (own_nodes) { delete Nodes; }
 
+   delete mapped_file;
+
    delete ncmesh;
 
    delete NURBSext;
@@ -1171,6 +1259,7 @@ void Mesh::ResetLazyData()
    delete face_edge;    face_edge = NULL;
    delete edge_vertex;  edge_vertex = NULL;
    DeleteGeometricFactors();
+   DeleteElementBoundingBoxTree();
    nbInteriorFaces = -1;
    nbBoundaryFaces = -1;
 }
@@ -3023,6 +3112,9 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    // Do NOT copy the face-to-edge Table, face_edge
    face_edge = NULL;
 
+   // Do NOT copy the element bounding box tree
+   elem_bbox_tree = NULL;
+
    // Copy the edge-to-vertex Table, edge_vertex
    edge_vertex = (mesh.edge_vertex) ? new Table(*mesh.edge_vertex) : NULL;
 
@@ -3076,6 +3168,7 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
       Nodes = mesh.Nodes;
       own_nodes = 0;
    }
+   mapped_file = NULL;
 }
 
 Mesh::Mesh(const char *filename, int generate_edges, int refine,
@@ -3356,6 +3449,17 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    {
       ReadGmshMesh(input, curved, read_gf);
    }
+   else if (mesh_type == "MFEM binary mesh v1.0" ||
+            mesh_type == "MFEM binary mesh v1.1")
+   {
+      const bool nonconforming = (mesh_type == "MFEM binary mesh v1.1");
+      ReadBinaryMesh(input, nonconforming, curved, read_gf, finalize_topo);
+   }
+   else if (mesh_type.compare(0, 5, "<?xml") == 0 ||
+            mesh_type.compare(0, 8, "<VTKFile") == 0) // VTK XML formats
+   {
+      ReadXML_VTKMesh(input, curved, read_gf, finalize_topo, mesh_type);
+   }
    else if
    ((mesh_type.size() > 2 &&
      mesh_type[0] == 'C' && mesh_type[1] == 'D' && mesh_type[2] == 'F') ||
@@ -6397,6 +6501,7 @@ void Mesh::MoveVertices(const Vector &displacements)
       {
          vertices[i](j) += displacements(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetVertices(Vector &vert_coord) const
@@ -6417,6 +6522,7 @@ void Mesh::SetVertices(const Vector &vert_coord)
       {
          vertices[i](j) = vert_coord(j*nv+i);
       }
+   NodesUpdated();
 }
 
 void Mesh::GetNode(int i, double *coord) const
@@ -6463,6 +6569,7 @@ void Mesh::MoveNodes(const Vector &displacements)
    if (Nodes)
    {
       (*Nodes) += displacements;
+      NodesUpdated();
    }
    else
    {
@@ -6487,6 +6594,7 @@ void Mesh::SetNodes(const Vector &node_coord)
    if (Nodes)
    {
       (*Nodes) = node_coord;
+      NodesUpdated();
    }
    else
    {
@@ -6506,12 +6614,14 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
       delete NURBSext;
       NURBSext = nodes.FESpace()->StealNURBSext();
    }
+   NodesUpdated();
 }
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
+   NodesUpdated();
    // TODO:
    // if (nodes)
    //    nodes->FESpace()->MakeNURBSextOwner();
@@ -7765,6 +7875,8 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
    mfem::Swap(geom_factors, other.geom_factors);
+   mfem::Swap(elem_bbox_tree, other.elem_bbox_tree);
+   mfem::Swap(elem_bbox_sequence, other.elem_bbox_sequence);
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -7778,6 +7890,20 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
       mfem::Swap(Nodes, other.Nodes);
       mfem::Swap(own_nodes, other.own_nodes);
    }
+   else
+   {
+      // The Nodes stay while the file mapping follows the vertices
+      Mesh *meshes[2] = { this, &other };
+      for (Mesh *m : meshes)
+      {
+         if (m->mapped_file && m->Nodes)
+         {
+            Vector nodes_copy(*m->Nodes);
+            m->Nodes->Swap(nodes_copy);
+         }
+      }
+   }
+   mfem::Swap(mapped_file, other.mapped_file);
 }
 
 void Mesh::GetElementData(const Array<Element*> &elem_array, int geom,
@@ -8671,6 +8797,91 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+void Mesh::PrintBinary(std::ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext, "NURBS meshes are not supported by the binary mesh "
+               "format");
+
+   const char *mesh_type =
+      ncmesh ? "MFEM binary mesh v1.1\n" : "MFEM binary mesh v1.0\n";
+   out << mesh_type;
+   bin_io::WritePadding(out, bin_io::Padding(strlen(mesh_type)));
+   if (ncmesh)
+   {
+      ncmesh->SaveBinary(out);
+   }
+
+   // Gather the element and boundary element data
+   Array<int> data[2][3]; // [elements/boundary][geometry/attribute/vertices]
+   for (int k = 0; k < 2; k++)
+   {
+      const Array<Element*> &elems = k ? boundary : elements;
+      const int ne = k ? NumOfBdrElements : NumOfElements;
+      data[k][0].SetSize(ne);
+      data[k][1].SetSize(ne);
+      data[k][2].SetSize(0);
+      for (int i = 0; i < ne; i++)
+      {
+         data[k][0][i] = elems[i]->GetGeometryType();
+         data[k][1][i] = elems[i]->GetAttribute();
+         data[k][2].Append(elems[i]->GetVertices(), elems[i]->GetNVertices());
+      }
+   }
+   const std::string fec_name = Nodes ? Nodes->FESpace()->FEColl()->Name() : "";
+
+   // Compute the size of the section
+   const int num_header = 13;
+   size_t size = num_header*sizeof(int64_t);
+   for (int k = 0; k < 2; k++)
+   {
+      for (int j = 0; j < 3; j++)
+      {
+         size += data[k][j].Size()*sizeof(int);
+      }
+      size += bin_io::Padding(size);
+   }
+   size += 3*NumOfVertices*sizeof(double);
+   if (Nodes)
+   {
+      size += fec_name.size() + bin_io::Padding(fec_name.size());
+      size += Nodes->Size()*sizeof(double);
+   }
+
+   const int64_t header[num_header] =
+   {
+      0x0102030405060708, // byte order mark
+      (int64_t) size, Dim, spaceDim,
+      NumOfVertices, NumOfElements, NumOfBdrElements,
+      data[0][2].Size(), data[1][2].Size(),
+      (int64_t) fec_name.size(),
+      Nodes ? Nodes->FESpace()->GetVDim() : 0,
+      Nodes ? Nodes->FESpace()->GetOrdering() : 0,
+      Nodes ? Nodes->Size() : 0
+   };
+   out.write((const char*) header, sizeof(header));
+   size_t offset = sizeof(header);
+   for (int k = 0; k < 2; k++)
+   {
+      for (int j = 0; j < 3; j++)
+      {
+         const size_t bytes = data[k][j].Size()*sizeof(int);
+         out.write((const char*) data[k][j].GetData(), bytes);
+         offset += bytes;
+      }
+      bin_io::WritePadding(out, bin_io::Padding(offset));
+      offset += bin_io::Padding(offset);
+   }
+   out.write((const char*) vertices.GetData(),
+             3*NumOfVertices*sizeof(double));
+   if (Nodes)
+   {
+      out.write(fec_name.c_str(), fec_name.size());
+      bin_io::WritePadding(out, bin_io::Padding(fec_name.size()));
+      out.write((const char*) Nodes->HostRead(), Nodes->Size()*sizeof(double));
+   }
+   out.flush();
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
    int i;
@@ -10161,6 +10372,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
       xnew.ProjectCoefficient(f_pert);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::Transform(VectorCoefficient &deformation)
@@ -10185,6 +10397,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
       xnew.ProjectCoefficient(deformation);
       *Nodes = xnew;
    }
+   NodesUpdated();
 }
 
 void Mesh::RemoveUnusedVertices()
@@ -10423,94 +10636,46 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    InverseElementTransformation *inv_tr = inv_trans;
    inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
 
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
-
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
-   {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
-      {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
-      }
-   }
+   const BoundingBoxTree &bbox_tree = GetElementBoundingBoxTree();
 
-   // Checks if the points lie in the closest element
+   // For each point in 'point_mat', try the elements whose bounding boxes
+   // contain the point, in the order of increasing distance from the point to
+   // the box centers.
    int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
+   Array<int> cand;
+   Array<Pair<double,int> > cand_dist;
+   Vector pt(NULL, spaceDim);
    for (int k = 0; k < npts; k++)
    {
       pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
-   }
-   if (pts_found != npts)
-   {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
+      bbox_tree.FindBoxes(pt.GetData(), cand);
+      cand_dist.SetSize(cand.Size());
+      for (int c = 0; c < cand.Size(); c++)
       {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
+         const double *lo = bbox_tree.GetBoxMin(cand[c]);
+         const double *hi = bbox_tree.GetBoxMax(cand[c]);
+         double dist = 0.0;
+         for (int d = 0; d < spaceDim; d++)
          {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
-            {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
-            }
+            const double dx = pt(d) - 0.5*(lo[d] + hi[d]);
+            dist += dx*dx;
          }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
+         cand_dist[c] = Pair<double,int>(dist, cand[c]);
+      }
+      SortPairs<double,int>(cand_dist, cand_dist.Size());
+
+      for (int c = 0; c < cand_dist.Size(); c++)
+      {
+         const int e = cand_dist[c].two;
+         inv_tr->SetTransformation(*GetElementTransformation(e));
+         int res = inv_tr->Transform(pt, ips[k]);
+         if (res == InverseElementTransformation::Inside)
          {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
-            {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
-            }
+            elem_ids[k] = e;
+            pts_found++;
+            break;
          }
-      next_point: ;
       }
-      delete vtoel;
    }
    if (inv_trans == NULL) { delete inv_tr; }
 
@@ -10523,25 +10688,45 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
 
 
 GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
-                                   int flags)
+                                   int flags, Geometry::Type geom)
 {
    this->mesh = mesh;
    IntRule = &ir;
    computed_factors = flags;
+   this->geom = geom;
 
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
-   const FiniteElement *fe = fespace->GetFE(0);
-   const int dim  = fe->GetDim();
-   const int vdim = fespace->GetVDim();
-   const int NE   = fespace->GetNE();
-   const int ND   = fe->GetDof();
-   const int NQ   = ir.GetNPoints();
 
    // For now, we are not using tensor product evaluation
    const Operator *elem_restr = fespace->GetElementRestriction(
                                    ElementDofOrdering::NATIVE);
 
+   // On meshes with several geometries, only the group of elements of the
+   // given geometry in the nodal E-vector is used.
+   const ElementRestriction *er =
+      dynamic_cast<const ElementRestriction*>(elem_restr);
+   int group = -1;
+   if (mesh->GetNumGeometries(mesh->Dimension()) > 1)
+   {
+      MFEM_VERIFY(geom != Geometry::INVALID, "the element geometry must be"
+                  " given on meshes with several element geometries");
+      MFEM_VERIFY(er, "discontinuous mesh nodes are not supported on meshes"
+                  " with several element geometries");
+      for (int g = 0; g < er->GetNumGroups(); g++)
+      {
+         if (er->GetGroupGeometry(g) == geom) { group = g; }
+      }
+      MFEM_VERIFY(group >= 0, "the mesh has no elements of geometry " << geom);
+   }
+   const FiniteElement *fe =
+      fespace->GetFE(group < 0 ? 0 : er->GetGroupElements(group)[0]);
+   const int dim  = fe->GetDim();
+   const int vdim = fespace->GetVDim();
+   const int NE   = group < 0 ? fespace->GetNE() : er->GetGroupNE(group);
+   const int ND   = fe->GetDof();
+   const int NQ   = ir.GetNPoints();
+
    unsigned eval_flags = 0;
    if (flags & GeometricFactors::COORDINATES)
    {
@@ -10559,6 +10744,18 @@ GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
       eval_flags |= QuadratureInterpolator::DETERMINANTS;
    }
 
+   if (group >= 0)
+   {
+      QuadratureInterpolator qi(*fespace, ir, geom);
+      qi.DisableTensorProducts();
+      qi.SetOutputLayout(QVectorLayout::byNODES);
+      Vector Enodes(er->Height()), Egroup;
+      er->Mult(*nodes, Enodes);
+      Egroup.MakeRef(Enodes, er->GetGroupOffset(group), vdim*ND*NE);
+      qi.Mult(Egroup, eval_flags, X, J, detJ);
+      return;
+   }
+
    const QuadratureInterpolator *qi = fespace->GetQuadratureInterpolator(ir);
    // For now, we are not using tensor product evaluation (not implemented)
    qi->DisableTensorProducts();
@@ -20,9 +20,11 @@
 #include "vertex.hpp"
 #include "vtk.hpp"
 #include "ncmesh.hpp"
+#include "bbox_tree.hpp"
 #include "../fem/eltrans.hpp"
 #include "../fem/coefficient.hpp"
 #include "../general/zstr.hpp"
+#include "../general/binaryio.hpp"
 #ifdef MFEM_USE_ADIOS2
 #include "../general/adios2stream.hpp"
 #endif
@@ -176,6 +178,10 @@ protected:
    GridFunction *Nodes;
    int own_nodes;
 
+   /** File mapping referenced by the vertices and the Nodes of a mesh loaded
+       from a binary mesh file, see PrintBinary(). Owned. */
+   MappedFile *mapped_file;
+
    static const int vtk_quadratic_tet[10];
    static const int vtk_quadratic_wedge[18];
    static const int vtk_quadratic_hex[27];
@@ -214,6 +220,12 @@ public:
 protected:
    Operation last_operation;
 
+   /// Optional element bounding box tree, see GetElementBoundingBoxTree().
+   BoundingBoxTree *elem_bbox_tree;
+   long elem_bbox_sequence; ///< Value of #sequence when the tree was built.
+
+   void DeleteElementBoundingBoxTree();
+
    void Init();
    void InitTables();
    void SetEmpty();  // Init all data members with empty values
@@ -238,9 +250,42 @@ protected:
    void ReadTrueGridMesh(std::istream &input);
    void ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
                     bool &finalize_topo);
+   // Read a VTU or PVTU mesh, the first line of which was already read into
+   // xml_prefix. Reading a PVTU mesh requires a named_ifgzstream input, used to
+   // locate the pieces.
+   void ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
+                        bool &finalize_topo, const std::string &xml_prefix = "");
+   // Create the mesh from the points and cells of a legacy or XML VTK file.
+   // The offsets of the cells in cell_data are given as in a CSR matrix and
+   // the cell attributes may be empty.
+   void CreateVTKMesh(const Vector &points, const Array<int> &cell_data,
+                      const Array<int> &cell_offsets,
+                      const Array<int> &cell_types,
+                      const Array<int> &cell_attributes,
+                      int &curved, int &read_gf, bool &finalize_topo);
+   // Number the points (x,y,z triplets) identifying the ones closer than 'tol'
+   // in every coordinate, in the order of their first occurrence. Returns the
+   // number of distinct points.
+   static int FindCoincidentPoints(const Vector &points, const double tol,
+                                   Array<int> &point_map);
+   // Merge the coincident points of a VTK mesh, renumbering cell_data.
+   static void MergeVTKPoints(Vector &points, Array<int> &cell_data);
+   // Read the block of pieces of 'rank' out of 'nranks' of a PVTU file.
+   void ReadPVTUMesh(const std::string &filename, const int rank,
+                     const int nranks);
    void ReadNURBSMesh(std::istream &input, int &curved, int &read_gf);
    void ReadInlineMesh(std::istream &input, bool generate_edges = false);
    void ReadGmshMesh(std::istream &input, int &curved, int &read_gf);
+   void ReadBinaryMesh(std::istream &input, bool nonconforming, int &curved,
+                       int &read_gf, bool &finalize_topo);
+   // Create the NCMesh of a nonconforming binary mesh from the data written by
+   // NCMesh::SaveBinary(). ParMesh overrides this to create a ParNCMesh.
+   virtual NCMesh *LoadBinaryNCMesh(std::istream &input)
+   { return new NCMesh(input); }
+   // Set up the mesh from the binary section written by PrintBinary(). If
+   // zerocopy is true, the vertices and the Nodes reference the section data.
+   void ReadBinaryMeshSection(const char *section, bool zerocopy,
+                              int &curved, int &read_gf, bool &finalize_topo);
    /* Note NetCDF (optional library) is used for reading cubit files */
 #ifdef MFEM_USE_NETCDF
    void ReadCubit(const char *filename, int &curved, int &read_gf);
@@ -692,6 +737,26 @@ public:
       Finalize(refine, fix_orientation);
    }
 
+   /** @brief Load the VTU file @a filename, optionally merging its coincident
+       points. */
+   /** The VTU files written by PrintVTU() duplicate the points shared by the
+       elements: they are connected again with @a merge_points = true. The Mesh
+       constructor does not merge the points of VTU files. */
+   void LoadVTU(const std::string &filename, bool merge_points,
+                int refine = 1, bool fix_orientation = true);
+
+   /** @brief Serial import of the PVTU file @a filename, e.g. written by
+       ParaViewDataCollection: all pieces are loaded in this Mesh, merging the
+       points they share. */
+   /** The piece of each element is returned in @a partitioning, so that the
+       partitioned mesh can be created with
+       ParMesh(comm, mesh, partitioning.GetData()). Every rank calling this
+       method reads all the pieces, so it is meant for meshes that fit in the
+       memory of one rank; see ParMesh(MPI_Comm, const std::string &, bool,
+       bool) for the parallel reader. */
+   void LoadPVTU(const std::string &filename, Array<int> &partitioning,
+                 int refine = 1, bool fix_orientation = true);
+
    /// Clear the contents of the Mesh.
    void Clear() { Destroy(); SetEmpty(); }
 
@@ -741,8 +806,12 @@ public:
 
    /** @brief Return the mesh geometric factors corresponding to the given
        integration rule. */
-   const GeometricFactors* GetGeometricFactors(const IntegrationRule& ir,
-                                               const int flags);
+   /** On meshes with several element geometries, the geometry @a geom of the
+       elements for which the factors are computed must be given, see class
+       GeometricFactors. */
+   const GeometricFactors* GetGeometricFactors(
+      const IntegrationRule& ir, const int flags,
+      Geometry::Type geom = Geometry::INVALID);
 
    /** @brief Return the mesh geometric factors for the faces corresponding
         to the given integration rule. */
@@ -755,6 +824,22 @@ public:
        for example, after the mesh nodes are modified externally. */
    void DeleteGeometricFactors();
 
+   /** @brief Notify the Mesh that its vertex or node coordinates have been
+       modified externally.
+
+       This method destroys all data derived from the mesh geometry, i.e. the
+       GeometricFactors and the element bounding box tree. It is called
+       automatically by the Mesh methods that move the vertices or nodes, e.g.
+       Transform(), MoveNodes(), SetNodes(), etc. */
+   void NodesUpdated();
+
+   /** @brief Return a BoundingBoxTree over the (padded) bounding boxes of all
+       mesh elements, where the index of each box is the element index.
+
+       The tree is constructed on first use and reused until the mesh is
+       refined, derefined, or its geometry is modified, see NodesUpdated(). */
+   const BoundingBoxTree &GetElementBoundingBoxTree();
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -1210,6 +1295,34 @@ public:
    /// \see mfem::ofgzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format, which is detected automatically when loading a mesh. */
+   /** The format consists of the line "MFEM binary mesh v1.0", padded to 8
+       bytes, followed by a section of raw (native byte order) data:
+       - a header of 13 64-bit integers: a byte order mark, the size of the
+         section in bytes, the dimension, the space dimension, the numbers of
+         vertices, elements and boundary elements, the sizes of the element and
+         boundary element vertex index arrays, the length of the name of the
+         FiniteElementCollection of the Nodes (0 if there are no Nodes), and the
+         vector dimension, the ordering and the size of the Nodes;
+       - the geometry types, the attributes and the vertex indices of the
+         elements, then of the boundary elements, as 32-bit integers;
+       - the vertex coordinates, as 3 doubles per vertex;
+       - the name of the Nodes FiniteElementCollection and the Nodes data.
+
+       Each array is aligned to 8 bytes. When the mesh is the only content of
+       an uncompressed file opened with named_ifgzstream (e.g. by the
+       constructor Mesh(const char*)), the file is mapped into memory and the
+       vertices and the Nodes reference the mapped data directly. In that case,
+       the Nodes should not be used after the Mesh is destroyed, even if they
+       are taken over with SwapNodes(). The output can be compressed with
+       ofgzstream.
+
+       Nonconforming meshes use the line "MFEM binary mesh v1.1" and write the
+       refinement hierarchy with NCMesh::SaveBinary() before the section, which
+       is then not mapped into memory. NURBS meshes are not supported. */
+   void PrintBinary(std::ostream &out) const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &out) const;
@@ -1324,6 +1437,10 @@ public:
        completely overwritten by deriving custom classes that override the
        Transform() method.
 
+       The candidate elements for each point are selected using the element
+       bounding box tree, see GetElementBoundingBoxTree(), so the cost of the
+       search is roughly proportional to npts*log(NE), once the tree is built.
+
        If no element is found for the i-th point, elem_ids[i] is set to -1.
 
        In the ParMesh implementation, the @a point_mat is expected to be the
@@ -1364,6 +1481,12 @@ public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
    int computed_factors;
+   /** @brief Geometry of the elements for which the factors are computed, or
+       Geometry::INVALID for all elements of a mesh with a single geometry. */
+   /** With a valid @a geom, NE below is the number of elements with geometry
+       @a geom, in increasing element order, as in the corresponding group of
+       the E-vectors of ElementRestriction. */
+   Geometry::Type geom;
 
    enum FactorFlags
    {
@@ -1372,7 +1495,8 @@ public:
       DETERMINANTS = 1 << 2,
    };
 
-   GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags);
+   GeometricFactors(const Mesh *mesh, const IntegrationRule &ir, int flags,
+                    Geometry::Type geom = Geometry::INVALID);
 
    /// Mapped (physical) coordinates of all quadrature points.
    /** This array uses a column-major layout with dimensions (NQ x SDIM x NE)
@@ -12,15 +12,25 @@
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
 #include "../general/text.hpp"
+#include "../general/binaryio.hpp"
 #include "gmsh.hpp"
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
 #endif
 
+#ifdef MFEM_USE_ZLIB
+#include <zlib.h>
+#endif
+
 using namespace std;
 
 namespace mfem
@@ -114,6 +124,140 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+void Mesh::ReadBinaryMesh(std::istream &input, bool nonconforming,
+                          int &curved, int &read_gf, bool &finalize_topo)
+{
+   // Read the binary format written by PrintBinary()
+   const char *mesh_type = "MFEM binary mesh v1.0\n";
+   const size_t type_len = strlen(mesh_type);
+   const int num_header = 13;
+   input.ignore(bin_io::Padding(type_len));
+
+   if (nonconforming)
+   {
+      // The refinement hierarchy precedes the section of the leaf elements,
+      // FinalizeTopology() then connects the NCMesh to this mesh
+      ncmesh = LoadBinaryNCMesh(input);
+   }
+
+   // Map the file into memory, if it contains only the (uncompressed) mesh
+   named_ifgzstream *named_input = dynamic_cast<named_ifgzstream*>(&input);
+   if (named_input && !nonconforming)
+   {
+      MappedFile *file = new MappedFile(named_input->filename.c_str());
+      const size_t offset = type_len + bin_io::Padding(type_len);
+      const int64_t *header =
+         reinterpret_cast<const int64_t*>(file->GetData() + offset);
+      if (file->Size() >= offset + num_header*sizeof(int64_t) &&
+          strncmp(file->GetData(), mesh_type, type_len) == 0 &&
+          header[0] == 0x0102030405060708 &&
+          file->Size() == offset + header[1])
+      {
+         ReadBinaryMeshSection(file->GetData() + offset, true,
+                               curved, read_gf, finalize_topo);
+         mapped_file = file;
+         return;
+      }
+      delete file;
+   }
+
+   int64_t header[num_header];
+   input.read(reinterpret_cast<char*>(header), sizeof(header));
+   MFEM_VERIFY(input, "invalid binary mesh");
+   MFEM_VERIFY(header[0] == 0x0102030405060708,
+               "unsupported byte order in binary mesh");
+   // Read the section into an 8-byte aligned buffer
+   Array<int64_t> buffer((header[1] + 7)/8);
+   char *section = reinterpret_cast<char*>(buffer.GetData());
+   memcpy(section, header, sizeof(header));
+   input.read(section + sizeof(header), header[1] - sizeof(header));
+   MFEM_VERIFY(input, "invalid binary mesh");
+   ReadBinaryMeshSection(section, false, curved, read_gf, finalize_topo);
+}
+
+void Mesh::ReadBinaryMeshSection(const char *section, bool zerocopy,
+                                 int &curved, int &read_gf,
+                                 bool &finalize_topo)
+{
+   const int64_t *header = reinterpret_cast<const int64_t*>(section);
+   MFEM_VERIFY(header[0] == 0x0102030405060708,
+               "unsupported byte order in binary mesh");
+   Dim = header[2];
+   spaceDim = header[3];
+   NumOfVertices = header[4];
+   NumOfElements = header[5];
+   NumOfBdrElements = header[6];
+   size_t offset = 13*sizeof(int64_t);
+
+   for (int k = 0; k < 2; k++)
+   {
+      Array<Element*> &elems = k ? boundary : elements;
+      const int ne = k ? NumOfBdrElements : NumOfElements;
+      const int *geom = reinterpret_cast<const int*>(section + offset);
+      const int *attr = geom + ne;
+      const int *vert = attr + ne;
+      offset += (2*ne + header[7+k])*sizeof(int);
+      offset += bin_io::Padding(offset);
+      elems.SetSize(ne);
+      for (int i = 0; i < ne; i++)
+      {
+         elems[i] = NewElement(geom[i]);
+         elems[i]->SetVertices(vert);
+         elems[i]->SetAttribute(attr[i]);
+         vert += elems[i]->GetNVertices();
+      }
+   }
+
+   double *vert_data =
+      reinterpret_cast<double*>(const_cast<char*>(section + offset));
+   if (zerocopy)
+   {
+      vertices.MakeRef(reinterpret_cast<Vertex*>(vert_data), NumOfVertices);
+   }
+   else
+   {
+      vertices.SetSize(NumOfVertices);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int d = 0; d < 3; d++) { vertices[i](d) = vert_data[3*i+d]; }
+      }
+   }
+   offset += 3*NumOfVertices*sizeof(double);
+
+   const size_t fec_len = header[9];
+   if (fec_len > 0)
+   {
+      const std::string fec_name(section + offset, fec_len);
+      offset += fec_len + bin_io::Padding(fec_len);
+
+      // The Nodes FE space requires the edges and the faces
+      FinalizeTopology();
+      finalize_topo = false;
+
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      FiniteElementSpace *fes =
+         new FiniteElementSpace(this, fec, header[10],
+                                static_cast<Ordering::Type>(header[11]));
+      MFEM_VERIFY(fes->GetVSize() == header[12], "invalid binary mesh nodes");
+      double *nodes_data =
+         reinterpret_cast<double*>(const_cast<char*>(section + offset));
+      if (zerocopy)
+      {
+         Nodes = new GridFunction(fes, nodes_data);
+      }
+      else
+      {
+         Nodes = new GridFunction(fes);
+         memcpy(Nodes->HostWrite(), nodes_data, header[12]*sizeof(double));
+      }
+      Nodes->MakeOwner(fec); // Nodes will destroy 'fec' and 'fes'
+      own_nodes = 1;
+      curved = 1;
+      read_gf = 0;
+   }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
@@ -382,7 +526,7 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
    //   * https://lorensen.github.io/VTKExamples/site/VTKFileFormats
    //   * https://www.kitware.com/products/books/VTKUsersGuide.pdf
 
-   int i, j, n, attr;
+   int i, j, n;
 
    string buff;
    getline(input, buff); // comment line
@@ -424,110 +568,34 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
       }
    }
 
-   // Read the cells
-   NumOfElements = n = 0;
-   Array<int> cells_data;
+   // Read the cells, stored as the number of points followed by the points
+   Array<int> cell_data, cell_offsets(1), cell_types, cell_attributes;
+   cell_offsets[0] = 0;
+   int num_cells = 0;
    input >> ws >> buff;
    if (buff == "CELLS")
    {
-      input >> NumOfElements >> n >> ws;
-      cells_data.SetSize(n);
-      for (i = 0; i < n; i++)
+      input >> num_cells >> n >> ws;
+      cell_data.Reserve(n - num_cells);
+      for (i = 0; i < num_cells; i++)
       {
-         input >> cells_data[i];
+         int nv, v;
+         input >> nv;
+         for (j = 0; j < nv; j++)
+         {
+            input >> v;
+            cell_data.Append(v);
+         }
+         cell_offsets.Append(cell_data.Size());
       }
    }
 
    // Read the cell types
-   Dim = -1;
-   int order = -1;
    input >> ws >> buff;
    if (buff == "CELL_TYPES")
    {
-      input >> NumOfElements;
-      elements.SetSize(NumOfElements);
-      for (j = i = 0; i < NumOfElements; i++)
-      {
-         int ct, elem_dim, elem_order = 1;
-         input >> ct;
-         switch (ct)
-         {
-            case 5:   // triangle
-               elem_dim = 2;
-               elements[i] = new Triangle(&cells_data[j+1]);
-               break;
-            case 9:   // quadrilateral
-               elem_dim = 2;
-               elements[i] = new Quadrilateral(&cells_data[j+1]);
-               break;
-            case 10:  // tetrahedron
-               elem_dim = 3;
-#ifdef MFEM_USE_MEMALLOC
-               elements[i] = TetMemory.Alloc();
-               elements[i]->SetVertices(&cells_data[j+1]);
-#else
-               elements[i] = new Tetrahedron(&cells_data[j+1]);
-#endif
-               break;
-            case 12:  // hexahedron
-               elem_dim = 3;
-               elements[i] = new Hexahedron(&cells_data[j+1]);
-               break;
-            case 13:  // wedge
-               elem_dim = 3;
-               // switch between vtk vertex ordering and mfem vertex ordering:
-               // swap vertices (1,2) and (4,5)
-               elements[i] =
-                  new Wedge(cells_data[j+1], cells_data[j+3], cells_data[j+2],
-                            cells_data[j+4], cells_data[j+6], cells_data[j+5]);
-               break;
-
-            case 22:  // quadratic triangle
-               elem_dim = 2;
-               elem_order = 2;
-               elements[i] = new Triangle(&cells_data[j+1]);
-               break;
-            case 28:  // biquadratic quadrilateral
-               elem_dim = 2;
-               elem_order = 2;
-               elements[i] = new Quadrilateral(&cells_data[j+1]);
-               break;
-            case 24:  // quadratic tetrahedron
-               elem_dim = 3;
-               elem_order = 2;
-#ifdef MFEM_USE_MEMALLOC
-               elements[i] = TetMemory.Alloc();
-               elements[i]->SetVertices(&cells_data[j+1]);
-#else
-               elements[i] = new Tetrahedron(&cells_data[j+1]);
-#endif
-               break;
-            case 32: // biquadratic-quadratic wedge
-               elem_dim = 3;
-               elem_order = 2;
-               // switch between vtk vertex ordering and mfem vertex ordering:
-               // swap vertices (1,2) and (4,5)
-               elements[i] =
-                  new Wedge(cells_data[j+1], cells_data[j+3], cells_data[j+2],
-                            cells_data[j+4], cells_data[j+6], cells_data[j+5]);
-               break;
-            case 29:  // triquadratic hexahedron
-               elem_dim = 3;
-               elem_order = 2;
-               elements[i] = new Hexahedron(&cells_data[j+1]);
-               break;
-            default:
-               MFEM_ABORT("VTK mesh : cell type " << ct << " is not supported!");
-               return;
-         }
-         MFEM_VERIFY(Dim == -1 || Dim == elem_dim,
-                     "elements with different dimensions are not supported");
-         MFEM_VERIFY(order == -1 || order == elem_order,
-                     "elements with different orders are not supported");
-         Dim = elem_dim;
-         order = elem_order;
-         j += cells_data[j] + 1;
-      }
+      input >> num_cells;
+      cell_types.Load(num_cells, input);
    }
 
    // Read attributes
@@ -542,11 +610,7 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
       if (!strncmp(buff.c_str(), "SCALARS material", 16))
       {
          getline(input, buff); // "LOOKUP_TABLE default"
-         for (i = 0; i < NumOfElements; i++)
-         {
-            input >> attr;
-            elements[i]->SetAttribute(attr);
-         }
+         cell_attributes.Load(num_cells, input);
       }
       else
       {
@@ -558,9 +622,181 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
       input.seekg(sp);
    }
 
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+}
+
+// Map the points of a VTK Lagrange cell of the given order to the nodes of the
+// corresponding H1 finite element with closed uniform points.
+static void GetVTKLagrangeToNodeMap(const FiniteElement &fe, int order,
+                                    Array<int> &vtk_node)
+{
+   const Geometry::Type geom = fe.GetGeomType();
+   Array<int> con;
+   CreateVTKElementConnectivity(con, geom, order);
+   // The VTK Lagrange points are uniformly spaced, as in Mesh::PrintVTU()
+   GeometryRefiner refiner;
+   refiner.SetType(Quadrature1D::ClosedUniform);
+   const IntegrationRule &ref_pts = refiner.Refine(geom, order, 1)->RefPts;
+   const IntegrationRule &nodes = fe.GetNodes();
+   vtk_node.SetSize(con.Size());
+   for (int k = 0; k < con.Size(); k++)
+   {
+      const IntegrationPoint &ip = ref_pts.IntPoint(con[k]);
+      vtk_node[k] = -1;
+      for (int j = 0; j < nodes.GetNPoints(); j++)
+      {
+         const IntegrationPoint &jp = nodes.IntPoint(j);
+         if (fabs(ip.x - jp.x) + fabs(ip.y - jp.y) + fabs(ip.z - jp.z) < 1e-12)
+         {
+            vtk_node[k] = j;
+            break;
+         }
+      }
+      MFEM_VERIFY(vtk_node[k] >= 0, "VTK Lagrange point not found");
+   }
+}
+
+void Mesh::CreateVTKMesh(const Vector &points, const Array<int> &cell_data,
+                         const Array<int> &cell_offsets,
+                         const Array<int> &cell_types,
+                         const Array<int> &cell_attributes,
+                         int &curved, int &read_gf, bool &finalize_topo)
+{
+   int i, j, n;
+   const int np = points.Size()/3;
+
+   NumOfElements = cell_types.Size();
+   MFEM_VERIFY(cell_offsets.Size() == NumOfElements + 1,
+               "VTK mesh : invalid cells");
+   elements.SetSize(NumOfElements);
+   Dim = -1;
+   int order = -1;
+   bool quadratic_cells = false, lagrange_cells = false;
+   for (i = 0; i < NumOfElements; i++)
+   {
+      const int *v = cell_data.GetData() + cell_offsets[i];
+      const int nv = cell_offsets[i+1] - cell_offsets[i];
+      int ct = cell_types[i], elem_dim, elem_order = 1;
+      switch (ct)
+      {
+         case 3:   // line
+            elem_dim = 1;
+            elements[i] = new Segment(v);
+            break;
+         case 5:   // triangle
+            elem_dim = 2;
+            elements[i] = new Triangle(v);
+            break;
+         case 9:   // quadrilateral
+            elem_dim = 2;
+            elements[i] = new Quadrilateral(v);
+            break;
+         case 10:  // tetrahedron
+            elem_dim = 3;
+#ifdef MFEM_USE_MEMALLOC
+            elements[i] = TetMemory.Alloc();
+            elements[i]->SetVertices(v);
+#else
+            elements[i] = new Tetrahedron(v);
+#endif
+            break;
+         case 12:  // hexahedron
+            elem_dim = 3;
+            elements[i] = new Hexahedron(v);
+            break;
+         case 13:  // wedge
+            elem_dim = 3;
+            // switch between vtk vertex ordering and mfem vertex ordering:
+            // swap vertices (1,2) and (4,5)
+            elements[i] = new Wedge(v[0], v[2], v[1], v[3], v[5], v[4]);
+            break;
+
+         case 22:  // quadratic triangle
+            elem_dim = 2;
+            elem_order = 2;
+            elements[i] = new Triangle(v);
+            break;
+         case 28:  // biquadratic quadrilateral
+            elem_dim = 2;
+            elem_order = 2;
+            elements[i] = new Quadrilateral(v);
+            break;
+         case 24:  // quadratic tetrahedron
+            elem_dim = 3;
+            elem_order = 2;
+#ifdef MFEM_USE_MEMALLOC
+            elements[i] = TetMemory.Alloc();
+            elements[i]->SetVertices(v);
+#else
+            elements[i] = new Tetrahedron(v);
+#endif
+            break;
+         case 32: // biquadratic-quadratic wedge
+            elem_dim = 3;
+            elem_order = 2;
+            // switch between vtk vertex ordering and mfem vertex ordering:
+            // swap vertices (1,2) and (4,5)
+            elements[i] = new Wedge(v[0], v[2], v[1], v[3], v[5], v[4]);
+            break;
+         case 29:  // triquadratic hexahedron
+            elem_dim = 3;
+            elem_order = 2;
+            elements[i] = new Hexahedron(v);
+            break;
+
+         case 68:  // Lagrange curve
+         case 69:  // Lagrange triangle
+         case 70:  // Lagrange quadrilateral
+         case 71:  // Lagrange tetrahedron
+         case 72:  // Lagrange hexahedron
+         case 73:  // Lagrange wedge
+         {
+            // The corners of the Lagrange cells come first, in the order of
+            // the mfem vertices, see CreateVTKElementConnectivity()
+            static const Geometry::Type lagrange_geom[] =
+            {
+               Geometry::SEGMENT, Geometry::TRIANGLE, Geometry::SQUARE,
+               Geometry::TETRAHEDRON, Geometry::CUBE, Geometry::PRISM
+            };
+            const Geometry::Type geom = lagrange_geom[ct - 68];
+            elem_dim = Geometry::Dimension[geom];
+            elem_order =
+               GlobGeometryRefiner.GetRefinementLevelFromPoints(geom, nv);
+            MFEM_VERIFY(elem_order > 0, "VTK mesh : invalid Lagrange cell"
+                        " with " << nv << " points");
+            elements[i] = NewElement(geom);
+            elements[i]->SetVertices(v);
+            lagrange_cells = true;
+            break;
+         }
+         default:
+            MFEM_ABORT("VTK mesh : cell type " << ct << " is not supported!");
+            return;
+      }
+      MFEM_VERIFY(Dim == -1 || Dim == elem_dim,
+                  "elements with different dimensions are not supported");
+      MFEM_VERIFY(order == -1 || order == elem_order,
+                  "elements with different orders are not supported");
+      Dim = elem_dim;
+      order = elem_order;
+      quadratic_cells = quadratic_cells || (ct < 68 && elem_order == 2);
+   }
+   MFEM_VERIFY(!quadratic_cells || !lagrange_cells, "VTK mesh : quadratic and"
+               " Lagrange cells can not be mixed");
+
+   if (cell_attributes.Size())
+   {
+      MFEM_VERIFY(cell_attributes.Size() == NumOfElements,
+                  "VTK mesh : invalid number of cell attributes");
+      for (i = 0; i < NumOfElements; i++)
+      {
+         elements[i]->SetAttribute(cell_attributes[i]);
+      }
+   }
+
    if (order == 1)
    {
-      cells_data.DeleteAll();
       NumOfVertices = np;
       vertices.SetSize(np);
       for (i = 0; i < np; i++)
@@ -569,12 +805,11 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
          vertices[i](1) = points(3*i+1);
          vertices[i](2) = points(3*i+2);
       }
-      points.Destroy();
 
       // No boundary is defined in a VTK mesh
       NumOfBdrElements = 0;
    }
-   else if (order == 2)
+   else if (order >= 2)
    {
       curved = 1;
 
@@ -623,13 +858,22 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
       // No boundary is defined in a VTK mesh
       NumOfBdrElements = 0;
 
-      // Generate faces and edges so that we can define quadratic
-      // FE space on the mesh
+      // Generate faces and edges so that we can define the high-order FE
+      // space on the mesh
       FinalizeTopology();
       finalize_topo = false;
 
-      // Define quadratic FE space
-      FiniteElementCollection *fec = new QuadraticFECollection;
+      // Define the quadratic FE space or, for Lagrange cells, the H1 space
+      // with uniformly spaced nodes
+      FiniteElementCollection *fec;
+      if (lagrange_cells)
+      {
+         fec = new H1_FECollection(order, Dim, BasisType::ClosedUniform);
+      }
+      else
+      {
+         fec = new QuadraticFECollection;
+      }
       FiniteElementSpace *fes = new FiniteElementSpace(this, fec, Dim);
       Nodes = new GridFunction(fes);
       Nodes->MakeOwner(fec); // Nodes will destroy 'fec' and 'fes'
@@ -637,37 +881,54 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
 
       // Map vtk points to edge/face/element dofs
       Array<int> dofs;
-      for (n = i = 0; i < NumOfElements; i++)
+      Array<int> lagrange_map[Geometry::NumGeom];
+      for (i = 0; i < NumOfElements; i++)
       {
          fes->GetElementDofs(i, dofs);
+         const Geometry::Type geom = elements[i]->GetGeometryType();
          const int *vtk_mfem;
-         switch (elements[i]->GetGeometryType())
-         {
-            case Geometry::TRIANGLE:
-            case Geometry::SQUARE:
-               vtk_mfem = vtk_quadratic_hex; break; // identity map
-            case Geometry::TETRAHEDRON:
-               vtk_mfem = vtk_quadratic_tet; break;
-            case Geometry::CUBE:
-               vtk_mfem = vtk_quadratic_hex; break;
-            case Geometry::PRISM:
-               vtk_mfem = vtk_quadratic_wedge; break;
-            default:
-               vtk_mfem = NULL; // suppress a warning
-               break;
+         if (lagrange_cells)
+         {
+            if (lagrange_map[geom].Size() == 0)
+            {
+               GetVTKLagrangeToNodeMap(*fes->GetFE(i), order,
+                                       lagrange_map[geom]);
+            }
+            vtk_mfem = lagrange_map[geom].GetData();
          }
+         else
+         {
+            switch (geom)
+            {
+               case Geometry::TRIANGLE:
+               case Geometry::SQUARE:
+                  vtk_mfem = vtk_quadratic_hex; break; // identity map
+               case Geometry::TETRAHEDRON:
+                  vtk_mfem = vtk_quadratic_tet; break;
+               case Geometry::CUBE:
+                  vtk_mfem = vtk_quadratic_hex; break;
+               case Geometry::PRISM:
+                  vtk_mfem = vtk_quadratic_wedge; break;
+               default:
+                  vtk_mfem = NULL; // suppress a warning
+                  break;
+            }
+         }
+         MFEM_VERIFY(cell_offsets[i+1] - cell_offsets[i] == dofs.Size(),
+                     "VTK mesh : invalid number of cell points");
 
-         for (n++, j = 0; j < dofs.Size(); j++, n++)
+         const int *cell = cell_data.GetData() + cell_offsets[i];
+         for (j = 0; j < dofs.Size(); j++)
          {
-            if (pts_dof[cells_data[n]] == -1)
+            if (pts_dof[cell[j]] == -1)
             {
-               pts_dof[cells_data[n]] = dofs[vtk_mfem[j]];
+               pts_dof[cell[j]] = dofs[vtk_mfem[j]];
             }
             else
             {
-               if (pts_dof[cells_data[n]] != dofs[vtk_mfem[j]])
+               if (pts_dof[cell[j]] != dofs[vtk_mfem[j]])
                {
-                  MFEM_ABORT("VTK mesh : inconsistent quadratic mesh!");
+                  MFEM_ABORT("VTK mesh : inconsistent high-order mesh!");
                }
             }
          }
@@ -691,6 +952,582 @@ void Mesh::ReadVTKMesh(std::istream &input, int &curved, int &read_gf,
    }
 }
 
+// Helpers for reading the VTK XML formats, see ReadXML_VTKMesh().
+
+// Find the start tag of the next XML element 'name' in the range [pos,end) of
+// 'xml'. Return the position after the start tag, or string::npos if there is
+// no such element; the start tag is returned in 'tag'.
+static size_t FindXMLElement(const string &xml, const string &name,
+                             size_t pos, size_t end, string &tag)
+{
+   const string open = "<" + name;
+   while (true)
+   {
+      pos = xml.find(open, pos);
+      if (pos == string::npos || pos >= end) { return string::npos; }
+      const char c = xml[pos + open.size()];
+      if (isspace(c) || c == '>' || c == '/') { break; }
+      pos += open.size();
+   }
+   const size_t tag_end = xml.find('>', pos);
+   MFEM_VERIFY(tag_end != string::npos, "invalid XML tag <" << name);
+   tag = xml.substr(pos, tag_end + 1 - pos);
+   return tag_end + 1;
+}
+
+// Return the value of the attribute 'name' of the XML start tag 'tag', or
+// 'def' if the tag does not have the attribute.
+static string GetXMLAttribute(const string &tag, const string &name,
+                              const string &def = "")
+{
+   for (size_t pos = tag.find(name); pos != string::npos;
+        pos = tag.find(name, pos + name.size()))
+   {
+      size_t p = pos + name.size();
+      if (!isspace(tag[pos-1])) { continue; }
+      while (p < tag.size() && isspace(tag[p])) { p++; }
+      if (p == tag.size() || tag[p] != '=') { continue; }
+      p++;
+      while (p < tag.size() && isspace(tag[p])) { p++; }
+      const char quote = tag[p];
+      const size_t value_end = tag.find(quote, p+1);
+      MFEM_VERIFY((quote == '"' || quote == '\'') &&
+                  value_end != string::npos,
+                  "invalid XML attribute " << name << " in " << tag);
+      return tag.substr(p+1, value_end-p-1);
+   }
+   return def;
+}
+
+// The properties of a VTK XML file needed to decode its data arrays
+struct VTKXMLFile
+{
+   const string &xml;
+   size_t appended;   // start of the appended data, or string::npos
+   bool appended_raw; // appended data encoding: raw or base64
+   bool compressed;   // zlib compressed data arrays
+   int header_size;   // size of the binary headers: 4 (UInt32) or 8 (UInt64)
+
+   VTKXMLFile(const string &xml_) : xml(xml_) { }
+
+   size_t ReadHeader(const char *header, int i) const
+   {
+      if (header_size == 4)
+      {
+         uint32_t value;
+         memcpy(&value, header + i*header_size, header_size);
+         return value;
+      }
+      uint64_t value;
+      memcpy(&value, header + i*header_size, header_size);
+      return value;
+   }
+
+   // Decompress the blocks following the compression header.
+   void Decompress(const char *header, const char *blocks,
+                   vector<char> &data) const;
+   // Decode the data of a binary data array, written either raw or in base64,
+   // with the header and the data encoded separately.
+   void Decode(const char *src, size_t len, bool raw, vector<char> &data) const;
+};
+
+void VTKXMLFile::Decompress(const char *header, const char *blocks,
+                            vector<char> &data) const
+{
+#ifdef MFEM_USE_ZLIB
+   const size_t num_blocks = ReadHeader(header, 0);
+   const size_t block_size = ReadHeader(header, 1);
+   const size_t last_size = ReadHeader(header, 2);
+   data.resize(num_blocks == 0 ? 0 : (num_blocks-1)*block_size +
+               (last_size ? last_size : block_size));
+   size_t offset = 0;
+   for (size_t b = 0; b < num_blocks; b++)
+   {
+      const size_t comp_size = ReadHeader(header, 3+b);
+      uLongf size = (b == num_blocks-1 && last_size) ? last_size : block_size;
+      const int err =
+         uncompress(reinterpret_cast<Bytef*>(&data[b*block_size]), &size,
+                    reinterpret_cast<const Bytef*>(blocks + offset), comp_size);
+      MFEM_VERIFY(err == Z_OK, "error decompressing VTK data");
+      offset += comp_size;
+   }
+#else
+   MFEM_ABORT("MFEM must be compiled with ZLib support to read compressed"
+              " VTK data");
+#endif
+}
+
+void VTKXMLFile::Decode(const char *src, size_t len, bool raw,
+                        vector<char> &data) const
+{
+   const int hs = header_size;
+   vector<char> header_buf, blocks;
+   const char *header = src;
+   size_t header_len = compressed ? 3*hs : hs;
+   if (!raw)
+   {
+      MFEM_VERIFY(bin_io::NumBase64Chars(header_len) <= len,
+                  "invalid VTK data array");
+      bin_io::DecodeBase64(src, bin_io::NumBase64Chars(header_len), header_buf);
+      header = header_buf.data();
+   }
+   if (compressed)
+   {
+      header_len = (3 + ReadHeader(header, 0))*hs;
+      if (!raw)
+      {
+         MFEM_VERIFY(bin_io::NumBase64Chars(header_len) <= len,
+                     "invalid VTK data array");
+         bin_io::DecodeBase64(src, bin_io::NumBase64Chars(header_len),
+                              header_buf);
+         header = header_buf.data();
+      }
+   }
+   size_t data_len = 0;
+   const int num_sizes = compressed ? ReadHeader(header, 0) : 1;
+   for (int b = 0; b < num_sizes; b++)
+   {
+      data_len += ReadHeader(header, compressed ? 3+b : 0);
+   }
+   const size_t data_begin =
+      raw ? header_len : bin_io::NumBase64Chars(header_len);
+   const size_t data_end =
+      data_begin + (raw ? data_len : bin_io::NumBase64Chars(data_len));
+   MFEM_VERIFY(data_end <= len, "invalid VTK data array");
+   const char *data_src = src + data_begin;
+   if (!raw)
+   {
+      bin_io::DecodeBase64(data_src, data_end - data_begin, blocks);
+      data_src = blocks.data();
+   }
+   if (compressed)
+   {
+      Decompress(header, data_src, data);
+   }
+   else
+   {
+      data.assign(data_src, data_src + data_len);
+   }
+}
+
+// Convert the values of type S in 'bytes' to the type T
+template <typename S, typename T>
+static void ConvertVTKValues(const vector<char> &bytes, Array<T> &values)
+{
+   values.SetSize(bytes.size()/sizeof(S));
+   for (int i = 0; i < values.Size(); i++)
+   {
+      S value;
+      memcpy(&value, &bytes[i*sizeof(S)], sizeof(S));
+      values[i] = static_cast<T>(value);
+   }
+}
+
+// Read the VTK data array with start tag 'tag' and contents starting at 'pos'
+template <typename T>
+static void ReadVTKDataArray(const VTKXMLFile &file, const string &tag,
+                             size_t pos, Array<T> &values)
+{
+   const string &xml = file.xml;
+   const string format = GetXMLAttribute(tag, "format", "ascii");
+   if (format == "ascii")
+   {
+      const size_t end = xml.find("</DataArray>", pos);
+      istringstream in(xml.substr(pos, end - pos));
+      double value;
+      values.SetSize(0);
+      while (in >> value) { values.Append(static_cast<T>(value)); }
+      return;
+   }
+
+   vector<char> bytes;
+   if (format == "binary")
+   {
+      const size_t end = xml.find("</DataArray>", pos);
+      string data;
+      for (size_t i = pos; i < end; i++)
+      {
+         if (!isspace(xml[i])) { data += xml[i]; }
+      }
+      file.Decode(data.data(), data.size(), false, bytes);
+   }
+   else if (format == "appended")
+   {
+      MFEM_VERIFY(file.appended != string::npos,
+                  "VTK mesh : missing AppendedData");
+      const size_t offset = file.appended +
+                            atol(GetXMLAttribute(tag, "offset", "0").c_str());
+      MFEM_VERIFY(offset <= xml.size(), "invalid VTK data array offset");
+      file.Decode(xml.data() + offset, xml.size() - offset, file.appended_raw,
+                  bytes);
+   }
+   else
+   {
+      MFEM_ABORT("VTK mesh : unknown data array format: " << format);
+   }
+
+   const string type = GetXMLAttribute(tag, "type");
+   if (type == "Int8") { ConvertVTKValues<int8_t>(bytes, values); }
+   else if (type == "UInt8") { ConvertVTKValues<uint8_t>(bytes, values); }
+   else if (type == "Int16") { ConvertVTKValues<int16_t>(bytes, values); }
+   else if (type == "UInt16") { ConvertVTKValues<uint16_t>(bytes, values); }
+   else if (type == "Int32") { ConvertVTKValues<int32_t>(bytes, values); }
+   else if (type == "UInt32") { ConvertVTKValues<uint32_t>(bytes, values); }
+   else if (type == "Int64") { ConvertVTKValues<int64_t>(bytes, values); }
+   else if (type == "UInt64") { ConvertVTKValues<uint64_t>(bytes, values); }
+   else if (type == "Float32") { ConvertVTKValues<float>(bytes, values); }
+   else if (type == "Float64") { ConvertVTKValues<double>(bytes, values); }
+   else { MFEM_ABORT("VTK mesh : unknown data array type: " << type); }
+}
+
+// Read the points, cells and cell attributes of the piece of the VTU file
+// with contents 'xml'.
+static void ReadVTUPiece(const string &xml, Vector &points,
+                         Array<int> &cell_data, Array<int> &cell_offsets,
+                         Array<int> &cell_types, Array<int> &cell_attributes)
+{
+   VTKXMLFile file(xml);
+   string tag;
+
+   // The tags are searched for before the appended (possibly raw) data
+   const size_t end = xml.find("<AppendedData");
+   file.appended = string::npos;
+   if (end != string::npos)
+   {
+      size_t pos = FindXMLElement(xml, "AppendedData", end, xml.size(), tag);
+      file.appended_raw = (GetXMLAttribute(tag, "encoding", "raw") == "raw");
+      pos = xml.find('_', pos);
+      MFEM_VERIFY(pos != string::npos, "VTK mesh : invalid AppendedData");
+      file.appended = pos + 1;
+   }
+
+   size_t pos = FindXMLElement(xml, "VTKFile", 0, end, tag);
+   MFEM_VERIFY(pos != string::npos, "VTK mesh : missing VTKFile element");
+   MFEM_VERIFY(GetXMLAttribute(tag, "type") == "UnstructuredGrid",
+               "VTK mesh : only UnstructuredGrid files are supported");
+   MFEM_VERIFY(GetXMLAttribute(tag, "byte_order", VTKByteOrder()) ==
+               VTKByteOrder(), "VTK mesh : unsupported byte order");
+   file.header_size =
+      (GetXMLAttribute(tag, "header_type", "UInt32") == "UInt64") ? 8 : 4;
+   const string compressor = GetXMLAttribute(tag, "compressor");
+   MFEM_VERIFY(compressor == "" || compressor == "vtkZLibDataCompressor",
+               "VTK mesh : unsupported compressor " << compressor);
+   file.compressed = (compressor != "");
+
+   pos = FindXMLElement(xml, "Piece", pos, end, tag);
+   MFEM_VERIFY(pos != string::npos, "VTK mesh : missing Piece element");
+   const int np = atoi(GetXMLAttribute(tag, "NumberOfPoints").c_str());
+   const int nc = atoi(GetXMLAttribute(tag, "NumberOfCells").c_str());
+   const size_t piece_end = xml.find("</Piece>", pos);
+   MFEM_VERIFY(FindXMLElement(xml, "Piece", pos, end, tag) == string::npos,
+               "VTK mesh : files with multiple pieces are not supported");
+
+   // Read the points
+   size_t p = FindXMLElement(xml, "Points", pos, piece_end, tag);
+   p = (p == string::npos) ? p : FindXMLElement(xml, "DataArray", p,
+                                                piece_end, tag);
+   MFEM_VERIFY(p != string::npos, "VTK mesh : missing Points");
+   MFEM_VERIFY(GetXMLAttribute(tag, "NumberOfComponents", "1") == "3",
+               "VTK mesh : points must have 3 components");
+   Array<double> point_values;
+   ReadVTKDataArray(file, tag, p, point_values);
+   MFEM_VERIFY(point_values.Size() == 3*np, "VTK mesh : invalid points");
+   points.SetSize(3*np);
+   for (int i = 0; i < 3*np; i++) { points(i) = point_values[i]; }
+
+   // Read the cells and the attributes
+   Array<int> connectivity, offsets;
+   cell_types.SetSize(0);
+   cell_attributes.SetSize(0);
+   const char *sections[2] = { "Cells", "CellData" };
+   for (int s = 0; s < 2; s++)
+   {
+      p = FindXMLElement(xml, sections[s], pos, piece_end, tag);
+      if (p == string::npos || tag[tag.size()-2] == '/') { continue; }
+      const size_t section_end = xml.find(string("</") + sections[s], p);
+      while ((p = FindXMLElement(xml, "DataArray", p, section_end, tag))
+             != string::npos)
+      {
+         const string name = GetXMLAttribute(tag, "Name");
+         if (s == 0 && name == "connectivity")
+         {
+            ReadVTKDataArray(file, tag, p, connectivity);
+         }
+         else if (s == 0 && name == "offsets")
+         {
+            ReadVTKDataArray(file, tag, p, offsets);
+         }
+         else if (s == 0 && name == "types")
+         {
+            ReadVTKDataArray(file, tag, p, cell_types);
+         }
+         else if (s == 1 && (name == "material" || name == "attribute"))
+         {
+            ReadVTKDataArray(file, tag, p, cell_attributes);
+         }
+      }
+   }
+   MFEM_VERIFY(cell_types.Size() == nc && offsets.Size() == nc,
+               "VTK mesh : invalid cells");
+
+   connectivity.Copy(cell_data);
+   cell_offsets.SetSize(nc + 1);
+   cell_offsets[0] = 0;
+   for (int i = 0; i < nc; i++) { cell_offsets[i+1] = offsets[i]; }
+}
+
+// Return the contents of the file 'filename'.
+static string ReadFileContents(const string &filename)
+{
+   ifstream in(filename.c_str(), ios::in | ios::binary);
+   MFEM_VERIFY(in, "unable to open file: " << filename);
+   return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+// Read and concatenate the pieces of the PVTU file 'filename' with contents
+// 'xml'. The piece of each cell is returned in 'cell_piece'. With nranks > 1,
+// only the block of pieces of 'rank' is read, see ParMesh(MPI_Comm, const
+// std::string &, bool, bool).
+static void ReadPVTUPieces(const string &filename, const string &xml,
+                           Vector &points, Array<int> &cell_data,
+                           Array<int> &cell_offsets, Array<int> &cell_types,
+                           Array<int> &cell_attributes, Array<int> &cell_piece,
+                           const int rank = 0, const int nranks = 1)
+{
+   string tag;
+   size_t pos = FindXMLElement(xml, "VTKFile", 0, xml.size(), tag);
+   MFEM_VERIFY(pos != string::npos &&
+               GetXMLAttribute(tag, "type") == "PUnstructuredGrid",
+               "VTK mesh : not a PUnstructuredGrid file: " << filename);
+
+   const size_t dir_end = filename.find_last_of('/');
+   const string dir =
+      (dir_end == string::npos) ? "" : filename.substr(0, dir_end + 1);
+
+   vector<string> sources;
+   while ((pos = FindXMLElement(xml, "Piece", pos, xml.size(), tag))
+          != string::npos)
+   {
+      const string source = GetXMLAttribute(tag, "Source");
+      MFEM_VERIFY(source != "", "VTK mesh : Piece without Source");
+      sources.push_back((source[0] == '/') ? source : dir + source);
+   }
+   const int npieces = sources.size();
+   MFEM_VERIFY(npieces > 0, "VTK mesh : no pieces in " << filename);
+   MFEM_VERIFY(npieces >= nranks, "VTK mesh : " << npieces << " pieces in "
+               << filename << " cannot be read by " << nranks << " ranks");
+
+   Array<double> all_points;
+   cell_data.SetSize(0);
+   cell_offsets.SetSize(1);
+   cell_offsets[0] = 0;
+   cell_types.SetSize(0);
+   cell_attributes.SetSize(0);
+   cell_piece.SetSize(0);
+   bool have_attributes = true;
+   const int piece_begin = (rank*(long long)npieces)/nranks;
+   const int piece_end = ((rank+1)*(long long)npieces)/nranks;
+   for (int piece = piece_begin; piece < piece_end; piece++)
+   {
+      Vector pts;
+      Array<int> data, offsets, types, attributes;
+      ReadVTUPiece(ReadFileContents(sources[piece]), pts, data, offsets, types,
+                   attributes);
+
+      const int point_offset = all_points.Size()/3;
+      all_points.Append(pts.GetData(), pts.Size());
+      for (int i = 0; i < data.Size(); i++) { data[i] += point_offset; }
+      const int data_offset = cell_data.Size();
+      cell_data.Append(data);
+      for (int i = 1; i < offsets.Size(); i++)
+      {
+         cell_offsets.Append(data_offset + offsets[i]);
+      }
+      cell_types.Append(types);
+      cell_attributes.Append(attributes);
+      have_attributes = have_attributes && (attributes.Size() == types.Size());
+      for (int i = 0; i < types.Size(); i++) { cell_piece.Append(piece); }
+   }
+   if (!have_attributes) { cell_attributes.SetSize(0); }
+   points.SetSize(all_points.Size());
+   for (int i = 0; i < all_points.Size(); i++) { points(i) = all_points[i]; }
+}
+
+// Sort the points [begin, end) of the permutation 'perm' by their coordinate
+// 'd' and, within the runs of points closer than 'tol' in this coordinate, by
+// their next coordinates. The coincident points are then consecutive.
+static void SortPoints(const Vector &points, const double tol, const int d,
+                       int *begin, int *end)
+{
+   std::sort(begin, end, [&](int i, int j)
+   { return points(3*i+d) < points(3*j+d); });
+   if (d == 2) { return; }
+   for (int *b = begin; b < end; )
+   {
+      int *e = b + 1;
+      while (e < end && points(3*e[0]+d) - points(3*e[-1]+d) <= tol) { e++; }
+      if (e - b > 1) { SortPoints(points, tol, d+1, b, e); }
+      b = e;
+   }
+}
+
+int Mesh::FindCoincidentPoints(const Vector &points, const double tol,
+                               Array<int> &point_map)
+{
+   const int np = points.Size()/3;
+   Array<int> perm(np), first(np);
+   for (int i = 0; i < np; i++) { perm[i] = i; }
+   SortPoints(points, tol, 0, perm.GetData(), perm.GetData() + np);
+
+   // The first (lowest) index of the run of coincident points of each point
+   for (int b = 0, e; b < np; b = e)
+   {
+      const int pb = perm[b];
+      int min_i = pb;
+      for (e = b+1; e < np; e++)
+      {
+         const int pe = perm[e];
+         if (std::abs(points(3*pe) - points(3*pb)) > tol ||
+             std::abs(points(3*pe+1) - points(3*pb+1)) > tol ||
+             std::abs(points(3*pe+2) - points(3*pb+2)) > tol) { break; }
+         min_i = std::min(min_i, pe);
+      }
+      for (int k = b; k < e; k++) { first[perm[k]] = min_i; }
+   }
+
+   point_map.SetSize(np);
+   int num_points = 0;
+   for (int i = 0; i < np; i++)
+   {
+      point_map[i] = (first[i] == i) ? num_points++ : point_map[first[i]];
+   }
+   return num_points;
+}
+
+void Mesh::MergeVTKPoints(Vector &points, Array<int> &cell_data)
+{
+   const int np = points.Size()/3;
+   double bbox = 0.0;
+   for (int i = 0; i < np; i++)
+   {
+      for (int d = 0; d < 3; d++)
+      {
+         bbox = std::max(bbox, std::abs(points(3*i+d) - points(d)));
+      }
+   }
+   const double tol = 1e-12*std::max(bbox, 1.0);
+   Array<int> point_map;
+   const int num_points = FindCoincidentPoints(points, tol, point_map);
+   if (num_points == np) { return; }
+   Vector merged(3*num_points);
+   for (int i = 0; i < np; i++)
+   {
+      for (int d = 0; d < 3; d++)
+      {
+         merged(3*point_map[i]+d) = points(3*i+d);
+      }
+   }
+   points.Swap(merged);
+   for (int i = 0; i < cell_data.Size(); i++)
+   {
+      cell_data[i] = point_map[cell_data[i]];
+   }
+}
+
+void Mesh::ReadPVTUMesh(const std::string &filename, const int rank,
+                        const int nranks)
+{
+   Vector points;
+   Array<int> cell_data, cell_offsets, cell_types, cell_attributes, cell_piece;
+   ReadPVTUPieces(filename, ReadFileContents(filename), points, cell_data,
+                  cell_offsets, cell_types, cell_attributes, cell_piece, rank,
+                  nranks);
+   MergeVTKPoints(points, cell_data);
+
+   int curved = 0, read_gf = 0;
+   bool finalize_topo = true;
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+   MFEM_VERIFY(!curved && finalize_topo, "VTK mesh : only the linear cells"
+               " are supported by the parallel PVTU reader");
+}
+
+void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
+                           bool &finalize_topo, const std::string &xml_prefix)
+{
+   // Read the rest of the file, possibly containing raw binary data
+   const string xml = xml_prefix + '\n' +
+                      string(istreambuf_iterator<char>(input),
+                             istreambuf_iterator<char>());
+
+   Vector points;
+   Array<int> cell_data, cell_offsets, cell_types, cell_attributes;
+   string tag;
+   const size_t end = xml.find("<AppendedData");
+   FindXMLElement(xml, "VTKFile", 0, end, tag);
+   if (GetXMLAttribute(tag, "type") == "PUnstructuredGrid")
+   {
+      named_ifgzstream *named_input = dynamic_cast<named_ifgzstream*>(&input);
+      MFEM_VERIFY(named_input, "reading a PVTU mesh requires the file name,"
+                  " use mfem::named_ifgzstream for the input");
+      Array<int> cell_piece;
+      ReadPVTUPieces(named_input->filename, xml, points, cell_data,
+                     cell_offsets, cell_types, cell_attributes, cell_piece);
+      MergeVTKPoints(points, cell_data);
+   }
+   else
+   {
+      ReadVTUPiece(xml, points, cell_data, cell_offsets, cell_types,
+                   cell_attributes);
+   }
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+}
+
+void Mesh::LoadVTU(const std::string &filename, bool merge_points,
+                   int refine, bool fix_orientation)
+{
+   Clear();
+
+   Vector points;
+   Array<int> cell_data, cell_offsets, cell_types, cell_attributes;
+   ReadVTUPiece(ReadFileContents(filename), points, cell_data, cell_offsets,
+                cell_types, cell_attributes);
+   if (merge_points) { MergeVTKPoints(points, cell_data); }
+
+   int curved = 0, read_gf = 0;
+   bool finalize_topo = true;
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+   if (finalize_topo)
+   {
+      FinalizeTopology();
+   }
+   Finalize(refine, fix_orientation);
+}
+
+void Mesh::LoadPVTU(const std::string &filename, Array<int> &partitioning,
+                    int refine, bool fix_orientation)
+{
+   Clear();
+
+   Vector points;
+   Array<int> cell_data, cell_offsets, cell_types, cell_attributes;
+   ReadPVTUPieces(filename, ReadFileContents(filename), points, cell_data,
+                  cell_offsets, cell_types, cell_attributes, partitioning);
+   MergeVTKPoints(points, cell_data);
+
+   int curved = 0, read_gf = 0;
+   bool finalize_topo = true;
+   CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
+                 curved, read_gf, finalize_topo);
+   if (finalize_topo)
+   {
+      FinalizeTopology();
+   }
+   Finalize(refine, fix_orientation);
+}
+
 void Mesh::ReadNURBSMesh(std::istream &input, int &curved, int &read_gf)
 {
    NURBSext = new NURBSExtension(input);
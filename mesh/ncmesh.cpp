@@ -201,6 +201,38 @@ NCMesh::NCMesh(const NCMesh &other)
    Update();
 }
 
+NCMesh::NCMesh(std::istream &input)
+   : shadow(1024, 2048)
+{
+   int64_t header[3];
+   input.read((char*) header, sizeof(header));
+   Dim = header[0];
+   spaceDim = header[1];
+   Iso = header[2];
+
+   nodes.LoadBinary(input);
+   faces.LoadBinary(input);
+   elements.LoadBinary(input);
+   bin_io::ReadArray(input, free_element_ids);
+   bin_io::ReadArray(input, root_state);
+   bin_io::ReadArray(input, top_vertex_pos);
+   MFEM_VERIFY(input, "invalid binary NCMesh");
+
+   InitGeomFlags();
+   for (int geom = 0; geom < Geometry::NumGeom; geom++)
+   {
+      if (Geoms & (1 << geom))
+      {
+         // initialize edge/face tables for this type of element
+         mfem::Element *elem = NewMeshElement(geom);
+         GI[geom].Initialize(elem);
+         delete elem;
+      }
+   }
+
+   Update();
+}
+
 void NCMesh::InitGeomFlags()
 {
    Geoms = 0;
@@ -4948,6 +4980,19 @@ int NCMesh::PrintElements(std::ostream &out, int elem, int &coarse_id) const
    }
 }
 
+void NCMesh::SaveBinary(std::ostream &out) const
+{
+   const int64_t header[3] = { Dim, spaceDim, Iso };
+   out.write((const char*) header, sizeof(header));
+
+   nodes.SaveBinary(out);
+   faces.SaveBinary(out);
+   elements.SaveBinary(out);
+   bin_io::WriteArray(out, free_element_ids);
+   bin_io::WriteArray(out, root_state);
+   bin_io::WriteArray(out, top_vertex_pos);
+}
+
 void NCMesh::PrintCoarseElements(std::ostream &out) const
 {
    // print the number of non-leaf elements
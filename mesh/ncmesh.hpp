@@ -107,6 +107,9 @@ public:
 
    NCMesh(const NCMesh &other); // deep copy
 
+   /// Load the refinement hierarchy written by SaveBinary().
+   explicit NCMesh(std::istream &input);
+
    virtual ~NCMesh();
 
    int Dimension() const { return Dim; }
@@ -349,6 +352,12 @@ public:
    /// I/O: Load the element refinement hierarchy from a mesh file.
    void LoadCoarseElements(std::istream &input);
 
+   /** I/O: Write the refinement hierarchy, i.e. the primary data, as raw
+       (native byte order) data, see Mesh::PrintBinary(). Loading it with
+       NCMesh(std::istream&) restores the same numbering of the leaf elements,
+       vertices, edges and faces. */
+   void SaveBinary(std::ostream &out) const;
+
    /// I/O: Set positions of all vertices (used by mesh loader).
    void SetVertexPositions(const Array<mfem::Vertex> &vertices);
 
@@ -22,6 +22,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 using namespace std;
 
@@ -930,6 +931,21 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
 
    // read the group topology
    input >> ident;
+   if (ident == "binary_parallel_data")
+   {
+      input.get(); // '\n'
+      if (pncmesh)
+      {
+         // as in NonconformingRefinement(), the ParNCMesh is already connected
+         // to this mesh by Loader()
+         pncmesh->GetConformingSharedStructures(*this);
+         return;
+      }
+      ReadBinaryParallelData(input);
+      const bool fix_orientation = false;
+      Finalize(refine, fix_orientation);
+      return;
+   }
    MFEM_VERIFY(ident == "communication_groups",
                "input stream is not a parallel MFEM mesh");
    gtopo.Load(input);
@@ -1077,6 +1093,399 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+NCMesh *ParMesh::LoadBinaryNCMesh(istream &input)
+{
+   pncmesh = new ParNCMesh(MyComm, input);
+   return pncmesh;
+}
+
+void ParMesh::ReadBinaryParallelData(istream &input)
+{
+   // see ParPrintBinary()
+   gtopo.LoadBinary(input);
+
+   bin_io::ReadArray(input, svert_lvert);
+   bin_io::ReadTable(input, group_svert);
+
+   Array<int> sedge_vert;
+   bin_io::ReadArray(input, sedge_vert);
+   shared_edges.SetSize(sedge_vert.Size()/2);
+   for (int se = 0; se < shared_edges.Size(); se++)
+   {
+      shared_edges[se] = new Segment(sedge_vert[2*se], sedge_vert[2*se+1], 1);
+   }
+   bin_io::ReadTable(input, group_sedge);
+
+   bin_io::ReadArray(input, shared_trias);
+   bin_io::ReadTable(input, group_stria);
+   bin_io::ReadArray(input, shared_quads);
+   bin_io::ReadTable(input, group_squad);
+   MFEM_VERIFY(input, "invalid binary parallel mesh");
+   // sedge_ledge and sface_lface are set by FinalizeParTopo()
+}
+
+// Gather the items of all the ranks of 'comm', with 'nc' entries each, into
+// 'all_items' in rank order. The rank of each gathered item is returned in
+// 'item_rank' and the index of the first item of this rank in 'offset'.
+template <typename T>
+static void GatherItems(MPI_Comm comm, const Array<T> &items, const int nc,
+                        MPI_Datatype type, Array<T> &all_items,
+                        Array<int> &item_rank, int &offset)
+{
+   int nranks, rank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &rank);
+   Array<int> counts(nranks), displs(nranks+1);
+   int count = items.Size();
+   MPI_Allgather(&count, 1, MPI_INT, counts.GetData(), 1, MPI_INT, comm);
+   displs[0] = 0;
+   for (int r = 0; r < nranks; r++) { displs[r+1] = displs[r] + counts[r]; }
+   all_items.SetSize(displs[nranks]);
+   MPI_Allgatherv(const_cast<T*>(items.GetData()), count, type,
+                  all_items.GetData(), counts.GetData(), displs.GetData(),
+                  type, comm);
+   item_rank.SetSize(displs[nranks]/nc);
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int i = displs[r]/nc; i < displs[r+1]/nc; i++) { item_rank[i] = r; }
+   }
+   offset = displs[rank]/nc;
+}
+
+// Return in 'perm' the order of the records of 'rs' consecutive entries of
+// 'records', sorted lexicographically.
+static void SortRecords(const Array<int> &records, const int rs,
+                        Array<int> &perm)
+{
+   const int n = records.Size()/rs;
+   const int *r = records.GetData();
+   perm.SetSize(n);
+   for (int i = 0; i < n; i++) { perm[i] = i; }
+   std::sort(perm.GetData(), perm.GetData() + n, [&](int i, int j)
+   {
+      return std::lexicographical_compare(r + rs*i, r + rs*(i+1),
+                                          r + rs*j, r + rs*(j+1));
+   });
+}
+
+// For each of the local entities with the global 'keys', 4 per entity, return
+// in row i of 'entity_ranks' the ranks of 'comm' with an entity of the same
+// key.
+static void FindEntityRanks(MPI_Comm comm, const Array<int> &keys,
+                            Table &entity_ranks)
+{
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+   Array<int> all_keys, key_rank, perm;
+   int offset;
+   GatherItems(comm, keys, 4, MPI_INT, all_keys, key_rank, offset);
+   SortRecords(all_keys, 4, perm);
+
+   const int *k = all_keys.GetData();
+   entity_ranks.MakeI(keys.Size()/4);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int b = 0, e; b < perm.Size(); b = e)
+      {
+         for (e = b+1; e < perm.Size() &&
+              std::equal(k + 4*perm[b], k + 4*perm[b] + 4, k + 4*perm[e]); e++)
+         { }
+         for (int i = b; i < e; i++)
+         {
+            if (key_rank[perm[i]] != rank) { continue; }
+            const int le = perm[i] - offset;
+            if (pass == 0) { entity_ranks.AddColumnsInRow(le, e-b); }
+            else
+            {
+               for (int j = b; j < e; j++)
+               {
+                  entity_ranks.AddConnection(le, key_rank[perm[j]]);
+               }
+            }
+         }
+      }
+      if (pass == 0) { entity_ranks.MakeJ(); }
+   }
+   entity_ranks.ShiftUpI();
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const std::string &pvtu_filename, bool refine,
+                 bool fix_orientation)
+   : glob_elem_offset(-1)
+   , glob_offset_sequence(-1)
+   , gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   // The local mesh of the block of pieces of this rank, the boundary elements
+   // are generated below, without the shared faces
+   ReadPVTUMesh(pvtu_filename, MyRank, NRanks);
+   const bool generate_bdr = false;
+   FinalizeTopology(generate_bdr);
+   ReduceMeshGen(); // determine the global 'meshgen'
+
+   // Number the vertices of the exterior faces of the local meshes by their
+   // coordinates: vert_gid is the same on the ranks sharing a vertex
+   const int nfaces = GetNumFaces();
+   Array<int> vert_gid(NumOfVertices), fv, ext_verts;
+   vert_gid = -1;
+   for (int f = 0; f < nfaces; f++)
+   {
+      if (faces_info[f].Elem2No >= 0) { continue; }
+      GetFaceVertices(f, fv);
+      for (int j = 0; j < fv.Size(); j++) { vert_gid[fv[j]] = 0; }
+   }
+   Array<double> coords;
+   for (int v = 0; v < NumOfVertices; v++)
+   {
+      if (vert_gid[v] < 0) { continue; }
+      ext_verts.Append(v);
+      coords.Append(vertices[v](), 3);
+   }
+   Array<double> all_coords;
+   Array<int> coord_rank, point_gid;
+   int offset;
+   GatherItems(MyComm, coords, 3, MPI_DOUBLE, all_coords, coord_rank, offset);
+   Vector all_points(all_coords.GetData(), all_coords.Size());
+   double bbox = 0.0;
+   for (int i = 0; i < all_points.Size(); i++)
+   {
+      bbox = std::max(bbox, std::abs(all_points(i) - all_points(i%3)));
+   }
+   const int num_gids = FindCoincidentPoints(all_points,
+                                             1e-12*std::max(bbox, 1.0),
+                                             point_gid);
+   Table gid_ranks;
+   gid_ranks.MakeI(num_gids);
+   for (int i = 0; i < point_gid.Size(); i++)
+   {
+      gid_ranks.AddAColumnInRow(point_gid[i]);
+   }
+   gid_ranks.MakeJ();
+   for (int i = 0; i < point_gid.Size(); i++)
+   {
+      gid_ranks.AddConnection(point_gid[i], coord_rank[i]);
+   }
+   gid_ranks.ShiftUpI();
+   for (int i = 0; i < ext_verts.Size(); i++)
+   {
+      vert_gid[ext_verts[i]] = point_gid[offset + i];
+   }
+   auto shared_vert = [&](int v)
+   { return vert_gid[v] >= 0 && gid_ranks.RowSize(vert_gid[v]) > 1; };
+
+   // The exterior faces and, in 3D, their edges with shared vertices may be
+   // shared: they are identified by the sorted global numbers of their vertices
+   Array<int> cand_faces, face_keys, cand_edges, edge_keys, fe, fo, ev;
+   Array<bool> edge_seen(NumOfEdges);
+   edge_seen = false;
+   for (int f = 0; Dim > 1 && f < nfaces; f++)
+   {
+      if (faces_info[f].Elem2No >= 0) { continue; }
+      GetFaceVertices(f, fv);
+      bool shared = true;
+      int key[4] = { -1, -1, -1, -1 };
+      for (int j = 0; j < fv.Size(); j++)
+      {
+         shared = shared && shared_vert(fv[j]);
+         key[j] = vert_gid[fv[j]];
+      }
+      if (shared)
+      {
+         std::sort(key, key + fv.Size());
+         cand_faces.Append(f);
+         face_keys.Append(key, 4);
+      }
+      if (Dim < 3) { continue; }
+      GetFaceEdges(f, fe, fo);
+      for (int j = 0; j < fe.Size(); j++)
+      {
+         if (edge_seen[fe[j]]) { continue; }
+         edge_seen[fe[j]] = true;
+         GetEdgeVertices(fe[j], ev);
+         if (!shared_vert(ev[0]) || !shared_vert(ev[1])) { continue; }
+         const int g0 = vert_gid[ev[0]], g1 = vert_gid[ev[1]];
+         const int ekey[4] = { std::min(g0, g1), std::max(g0, g1), -1, -1 };
+         cand_edges.Append(fe[j]);
+         edge_keys.Append(ekey, 4);
+      }
+   }
+   Table face_ranks, edge_ranks;
+   FindEntityRanks(MyComm, face_keys, face_ranks);
+   FindEntityRanks(MyComm, edge_keys, edge_ranks);
+
+   // The groups of the shared entities, and the shared entities sorted by group
+   // and by global vertex numbers, as on the other ranks of their group
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+   Array<bool> face_shared(nfaces);
+   face_shared = false;
+   Array<int> sverts, sedges, sfaces; // records of the shared entities
+   for (int i = 0; i < ext_verts.Size(); i++)
+   {
+      const int v = ext_verts[i], gid = vert_gid[v];
+      if (!shared_vert(v)) { continue; }
+      group.Recreate(gid_ranks.RowSize(gid), gid_ranks.GetRow(gid));
+      const int rec[3] = { groups.Insert(group) - 1, gid, v };
+      sverts.Append(rec, 3);
+      if (Dim == 1) { face_shared[v] = true; }
+   }
+   for (int i = 0; i < cand_faces.Size(); i++)
+   {
+      if (face_ranks.RowSize(i) < 2) { continue; }
+      const int f = cand_faces[i];
+      face_shared[f] = true;
+      group.Recreate(face_ranks.RowSize(i), face_ranks.GetRow(i));
+      const int g = groups.Insert(group) - 1;
+      GetFaceVertices(f, fv);
+      if (Dim == 2)
+      {
+         if (vert_gid[fv[0]] > vert_gid[fv[1]]) { mfem::Swap(fv[0], fv[1]); }
+         const int rec[5] = { g, vert_gid[fv[0]], vert_gid[fv[1]], fv[0],
+                              fv[1]
+                            };
+         sedges.Append(rec, 5);
+         continue;
+      }
+      MFEM_VERIFY(face_ranks.RowSize(i) == 2, "VTK mesh : a face is shared by"
+                  " more than two ranks");
+      // Canonical vertex order: increasing for triangles, starting from the
+      // lowest global number towards its lowest neighbor for quadrilaterals
+      int rec[9] = { g, -1, -1, -1, -1, -1, -1, -1, -1 };
+      const int nv = fv.Size();
+      int m = 0;
+      for (int j = 1; j < nv; j++)
+      {
+         if (vert_gid[fv[j]] < vert_gid[fv[m]]) { m = j; }
+      }
+      if (nv == 3)
+      {
+         for (int j = 0; j < 3; j++) { rec[1+j] = vert_gid[fv[j]]; }
+         std::sort(rec + 1, rec + 4);
+         for (int j = 0; j < 3; j++)
+         {
+            for (int l = 0; l < 3; l++)
+            {
+               if (vert_gid[fv[l]] == rec[1+j]) { rec[5+j] = fv[l]; }
+            }
+         }
+      }
+      else
+      {
+         const int dir =
+            (vert_gid[fv[(m+1)%4]] < vert_gid[fv[(m+3)%4]]) ? 1 : 3;
+         for (int j = 0; j < 4; j++)
+         {
+            rec[5+j] = fv[(m + dir*j)%4];
+            rec[1+j] = vert_gid[rec[5+j]];
+         }
+      }
+      sfaces.Append(rec, 9);
+   }
+   for (int i = 0; i < cand_edges.Size(); i++)
+   {
+      if (edge_ranks.RowSize(i) < 2) { continue; }
+      group.Recreate(edge_ranks.RowSize(i), edge_ranks.GetRow(i));
+      GetEdgeVertices(cand_edges[i], ev);
+      if (vert_gid[ev[0]] > vert_gid[ev[1]]) { mfem::Swap(ev[0], ev[1]); }
+      const int rec[5] = { groups.Insert(group) - 1, vert_gid[ev[0]],
+                           vert_gid[ev[1]], ev[0], ev[1]
+                         };
+      sedges.Append(rec, 5);
+   }
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   // fill out group_svert, group_sedge, group_{stria,squad} and the shared
+   // entities, in the sorted order of their records
+   Array<int> perm;
+   SortRecords(sverts, 3, perm);
+   svert_lvert.SetSize(perm.Size());
+   group_svert.MakeI(ngroups);
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      group_svert.AddAColumnInRow(sverts[3*i]);
+   }
+   group_svert.MakeJ();
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      group_svert.AddConnection(sverts[3*perm[i]], i);
+      svert_lvert[i] = sverts[3*perm[i]+2];
+   }
+   group_svert.ShiftUpI();
+
+   SortRecords(sedges, 5, perm);
+   shared_edges.SetSize(perm.Size());
+   group_sedge.MakeI(ngroups);
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      group_sedge.AddAColumnInRow(sedges[5*i]);
+   }
+   group_sedge.MakeJ();
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      const int *rec = sedges.GetData() + 5*perm[i];
+      group_sedge.AddConnection(rec[0], i);
+      shared_edges[i] = new Segment(rec[3], rec[4], 1);
+   }
+   group_sedge.ShiftUpI();
+
+   SortRecords(sfaces, 9, perm);
+   group_stria.MakeI(ngroups);
+   group_squad.MakeI(ngroups);
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      const int *rec = sfaces.GetData() + 9*perm[i];
+      if (rec[8] < 0) { group_stria.AddAColumnInRow(rec[0]); }
+      else { group_squad.AddAColumnInRow(rec[0]); }
+   }
+   group_stria.MakeJ();
+   group_squad.MakeJ();
+   for (int i = 0; i < perm.Size(); i++)
+   {
+      const int *rec = sfaces.GetData() + 9*perm[i];
+      if (rec[8] < 0)
+      {
+         group_stria.AddConnection(rec[0], shared_trias.Size());
+         shared_trias.Append(Vert3(rec[5], rec[6], rec[7]));
+      }
+      else
+      {
+         group_squad.AddConnection(rec[0], shared_quads.Size());
+         shared_quads.Append(Vert4(rec[5], rec[6], rec[7], rec[8]));
+      }
+   }
+   group_stria.ShiftUpI();
+   group_squad.ShiftUpI();
+
+   // The boundary elements are the exterior faces that are not shared
+   GenerateBoundaryElements();
+   Array<int> &be2face = (Dim == 2) ? be_to_edge : be_to_face;
+   int nbe = 0;
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      if (face_shared[be2face[i]]) { FreeElement(boundary[i]); continue; }
+      boundary[nbe] = boundary[i];
+      be2face[nbe++] = be2face[i];
+   }
+   NumOfBdrElements = nbe;
+   boundary.SetSize(nbe);
+   be2face.SetSize(nbe);
+   if (Dim == 3) { GetElementToFaceTable(); } // update be_to_face
+   SetAttributes();
+
+   Finalize(refine, fix_orientation);
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -1338,7 +1747,7 @@ long ParMesh::GetGlobalElementNum(int local_element_num) const
 void ParMesh::DistributeAttributes(Array<int> &attr)
 {
    // Determine the largest attribute number across all processors
-   int max_attr = attr.Max();
+   int max_attr = attr.Size() ? attr.Max() : 1;
    int glb_max_attr = -1;
    MPI_Allreduce(&max_attr, &glb_max_attr, 1, MPI_INT, MPI_MAX, MyComm);
 
@@ -3388,12 +3797,6 @@ void ParMesh::Rebalance(const Array<int> &partition)
 
 void ParMesh::RebalanceImpl(const Array<int> *partition)
 {
-   if (Conforming())
-   {
-      MFEM_ABORT("Load balancing is currently not supported for conforming"
-                 " meshes.");
-   }
-
    // Make sure the Nodes use a ParFiniteElementSpace
    if (Nodes && dynamic_cast<ParFiniteElementSpace*>(Nodes->FESpace()) == NULL)
    {
@@ -3413,6 +3816,12 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
 
    DeleteFaceNbrData();
 
+   if (Conforming())
+   {
+      RebalanceConforming(partition);
+      return;
+   }
+
    pncmesh->Rebalance(partition);
 
    ParMesh* pmesh2 = new ParMesh(*pncmesh);
@@ -3434,6 +3843,736 @@ void ParMesh::RebalanceImpl(const Array<int> *partition)
    UpdateNodes();
 }
 
+// Exchange variable-size messages between all ranks of 'comm': 'send_buf'
+// contains the messages to all ranks, in rank order, with sizes 'send_cnt'.
+template <typename T>
+static void AllToAllV(MPI_Comm comm, const Array<int> &send_cnt,
+                      const Array<T> &send_buf, Array<int> &recv_cnt,
+                      Array<T> &recv_buf)
+{
+   const int nranks = send_cnt.Size();
+   recv_cnt.SetSize(nranks);
+   MPI_Alltoall(const_cast<int*>(send_cnt.GetData()), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+
+   Array<int> send_displ(nranks), recv_displ(nranks);
+   send_displ[0] = recv_displ[0] = 0;
+   for (int r = 1; r < nranks; r++)
+   {
+      send_displ[r] = send_displ[r-1] + send_cnt[r-1];
+      recv_displ[r] = recv_displ[r-1] + recv_cnt[r-1];
+   }
+   recv_buf.SetSize(recv_displ[nranks-1] + recv_cnt[nranks-1]);
+
+   MPI_Alltoallv(const_cast<T*>(send_buf.GetData()),
+                 const_cast<int*>(send_cnt.GetData()), send_displ.GetData(),
+                 MPITypeMap<T>::mpi_type, recv_buf.GetData(),
+                 recv_cnt.GetData(), recv_displ.GetData(),
+                 MPITypeMap<T>::mpi_type, comm);
+}
+
+// For each key 'i' of length 'klen', stored in 'keys' starting at klen*i, find
+// the sorted list of all ranks that have the same key and return it in row 'i'
+// of 'key_ranks'. The keys are matched on rank 'owner[i]', which must be the
+// same on all ranks that have the key.
+static void FindKeyRanks(MPI_Comm comm, int klen, const Array<int> &keys,
+                         const Array<int> &owner, Table &key_ranks)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int nkeys = owner.Size();
+
+   // send the keys to their owners
+   Array<int> send_cnt(nranks), pos(nranks);
+   send_cnt = 0;
+   for (int i = 0; i < nkeys; i++) { send_cnt[owner[i]] += klen; }
+   pos[0] = 0;
+   for (int r = 1; r < nranks; r++) { pos[r] = pos[r-1] + send_cnt[r-1]; }
+
+   Array<int> send_buf(klen*nkeys), slot_key(nkeys);
+   for (int i = 0; i < nkeys; i++)
+   {
+      const int p = pos[owner[i]];
+      pos[owner[i]] += klen;
+      slot_key[p/klen] = i;
+      for (int j = 0; j < klen; j++) { send_buf[p+j] = keys[klen*i+j]; }
+   }
+
+   Array<int> recv_cnt, recv_buf;
+   AllToAllV(comm, send_cnt, send_buf, recv_cnt, recv_buf);
+
+   // sort the received keys, grouping equal keys in the order of their source
+   const int nrecv = recv_buf.Size()/klen;
+   Array<int> src(nrecv), sorted(nrecv);
+   for (int r = 0, k = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < recv_cnt[r]/klen; j++) { src[k++] = r; }
+   }
+   for (int k = 0; k < nrecv; k++) { sorted[k] = k; }
+
+   const int *rk = recv_buf.GetData();
+   std::sort(sorted.GetData(), sorted.GetData() + nrecv, [&](int a, int b)
+   {
+      for (int j = 0; j < klen; j++)
+      {
+         if (rk[klen*a+j] != rk[klen*b+j])
+         {
+            return rk[klen*a+j] < rk[klen*b+j];
+         }
+      }
+      return a < b; // 'src' is nondecreasing
+   });
+
+   // for each received key, find the range of equal keys in 'sorted'
+   Array<int> run_begin(nrecv), run_size(nrecv);
+   for (int b = 0, e; b < nrecv; b = e)
+   {
+      for (e = b+1; e < nrecv; e++)
+      {
+         if (memcmp(rk + klen*sorted[b], rk + klen*sorted[e],
+                    klen*sizeof(int))) { break; }
+      }
+      for (int k = b; k < e; k++)
+      {
+         run_begin[sorted[k]] = b;
+         run_size[sorted[k]] = e - b;
+      }
+   }
+
+   // reply with the list of ranks for each key, in the order received
+   Array<int> reply_cnt(nranks), reply_buf;
+   reply_cnt = 0;
+   for (int k = 0; k < nrecv; k++)
+   {
+      reply_cnt[src[k]] += 1 + run_size[k];
+      reply_buf.Append(run_size[k]);
+      for (int j = 0; j < run_size[k]; j++)
+      {
+         reply_buf.Append(src[sorted[run_begin[k] + j]]);
+      }
+   }
+
+   Array<int> ans_cnt, ans_buf;
+   AllToAllV(comm, reply_cnt, reply_buf, ans_cnt, ans_buf);
+
+   // the answers arrive in the order of the slots in 'send_buf'
+   key_ranks.MakeI(nkeys);
+   for (int s = 0, p = 0; s < nkeys; s++)
+   {
+      key_ranks.AddColumnsInRow(slot_key[s], ans_buf[p]);
+      p += 1 + ans_buf[p];
+   }
+   key_ranks.MakeJ();
+   for (int s = 0, p = 0; s < nkeys; s++)
+   {
+      key_ranks.AddConnections(slot_key[s], &ans_buf[p+1], ans_buf[p]);
+      p += 1 + ans_buf[p];
+   }
+   key_ranks.ShiftUpI();
+}
+
+void ParMesh::RebalanceConforming(const Array<int> *partition)
+{
+   MFEM_VERIFY(NURBSext == NULL,
+               "Load balancing of NURBS meshes is not supported.");
+
+   const int nv = GetNV(), ne = GetNE(), nbe = GetNBE();
+
+   // determine the new rank of each element
+   Array<int> new_rank(ne);
+   if (partition)
+   {
+      MFEM_VERIFY(partition->Size() == ne, "invalid partition size: "
+                  << partition->Size() << ", expected " << ne);
+      for (int i = 0; i < ne; i++)
+      {
+         new_rank[i] = (*partition)[i];
+         MFEM_VERIFY(new_rank[i] >= 0 && new_rank[i] < NRanks,
+                     "invalid rank in partition: " << new_rank[i]);
+      }
+   }
+   else
+   {
+      // split the sequence of all elements, ordered by rank and then along a
+      // local Hilbert curve, into parts of equal size
+      const long glob_ne = ReduceInt(ne);
+      ComputeGlobalElementOffset();
+      Array<int> ordering;
+      if (ne) { GetHilbertElementOrdering(ordering); }
+      for (int i = 0; i < ne; i++)
+      {
+         new_rank[i] = ((glob_elem_offset + ordering[i]) * NRanks) / glob_ne;
+      }
+   }
+
+   // number the vertices globally: each vertex is numbered by the master of
+   // its group and the numbers are broadcast to the other ranks in the group
+   Array<int> vert_gid(nv), vert_offsets(NRanks+1);
+   {
+      vert_gid = 0;
+      for (int g = 1; g < GetNGroups(); g++)
+      {
+         if (gtopo.IAmMaster(g)) { continue; }
+         const int *sv = group_svert.GetRow(g-1);
+         for (int j = 0; j < group_svert.RowSize(g-1); j++)
+         {
+            vert_gid[svert_lvert[sv[j]]] = -1;
+         }
+      }
+      int num_owned = 0;
+      for (int v = 0; v < nv; v++) { if (vert_gid[v] == 0) { num_owned++; } }
+
+      MPI_Allgather(&num_owned, 1, MPI_INT, vert_offsets.GetData() + 1, 1,
+                    MPI_INT, MyComm);
+      vert_offsets[0] = 0;
+      for (int r = 0; r < NRanks; r++) { vert_offsets[r+1] += vert_offsets[r]; }
+
+      for (int v = 0, k = vert_offsets[MyRank]; v < nv; v++)
+      {
+         if (vert_gid[v] == 0) { vert_gid[v] = k++; }
+      }
+
+      GroupCommunicator gcomm(gtopo);
+      Table &group_ldof = gcomm.GroupLDofTable();
+      group_ldof.MakeI(GetNGroups());
+      for (int g = 1; g < GetNGroups(); g++)
+      {
+         group_ldof.AddColumnsInRow(g, group_svert.RowSize(g-1));
+      }
+      group_ldof.MakeJ();
+      for (int g = 1; g < GetNGroups(); g++)
+      {
+         const int *sv = group_svert.GetRow(g-1);
+         for (int j = 0; j < group_svert.RowSize(g-1); j++)
+         {
+            group_ldof.AddConnection(g, svert_lvert[sv[j]]);
+         }
+      }
+      group_ldof.ShiftUpI();
+      gcomm.Finalize();
+      gcomm.Bcast(vert_gid);
+   }
+   // rank that numbered the global vertex 'gid', used to match shared entities
+   const int *vo_begin = vert_offsets.GetData(), *vo_end = vo_begin + NRanks;
+   auto vert_owner = [&](int gid)
+   {
+      return int(std::upper_bound(vo_begin, vo_end, gid) - vo_begin) - 1;
+   };
+
+   // assign the boundary elements to the ranks of their adjacent elements
+   Table send_elems, send_bdr;
+   send_elems.MakeI(NRanks);
+   send_bdr.MakeI(NRanks);
+   Array<int> bdr_rank(nbe);
+   for (int i = 0; i < ne; i++) { send_elems.AddAColumnInRow(new_rank[i]); }
+   for (int i = 0; i < nbe; i++)
+   {
+      bdr_rank[i] = new_rank[faces_info[GetBdrElementEdgeIndex(i)].Elem1No];
+      send_bdr.AddAColumnInRow(bdr_rank[i]);
+   }
+   send_elems.MakeJ();
+   send_bdr.MakeJ();
+   for (int i = 0; i < ne; i++) { send_elems.AddConnection(new_rank[i], i); }
+   for (int i = 0; i < nbe; i++) { send_bdr.AddConnection(bdr_rank[i], i); }
+   send_elems.ShiftUpI();
+   send_bdr.ShiftUpI();
+
+   // pack the message for each rank: the elements (geometry, attribute, tet
+   // refinement flag, global vertices), the boundary elements (geometry,
+   // attribute, global vertices) and the global vertices with coordinates
+   Array<int> send_cnt(NRanks), dsend_cnt(NRanks), send_buf, verts;
+   Array<double> dsend_buf;
+   Array<int> vert_mark(nv);
+   vert_mark = -1;
+   for (int r = 0; r < NRanks; r++)
+   {
+      const int start = send_buf.Size(), dstart = dsend_buf.Size();
+      const int nel = send_elems.RowSize(r);
+      if (nel)
+      {
+         const int *el = send_elems.GetRow(r);
+         send_buf.Append(nel);
+         verts.SetSize(0);
+         for (int k = 0; k < nel; k++)
+         {
+            Element *elem = elements[el[k]];
+            const int *v = elem->GetVertices();
+            int flag = 0;
+            if (elem->GetType() == Element::TETRAHEDRON)
+            {
+               flag = static_cast<Tetrahedron*>(elem)->GetRefinementFlag();
+            }
+            send_buf.Append(elem->GetGeometryType());
+            send_buf.Append(elem->GetAttribute());
+            send_buf.Append(flag);
+            for (int j = 0; j < elem->GetNVertices(); j++)
+            {
+               send_buf.Append(vert_gid[v[j]]);
+               if (vert_mark[v[j]] != r)
+               {
+                  vert_mark[v[j]] = r;
+                  verts.Append(v[j]);
+               }
+            }
+         }
+
+         const int *be = send_bdr.GetRow(r);
+         send_buf.Append(send_bdr.RowSize(r));
+         for (int k = 0; k < send_bdr.RowSize(r); k++)
+         {
+            const Element *elem = boundary[be[k]];
+            const int *v = elem->GetVertices();
+            send_buf.Append(elem->GetGeometryType());
+            send_buf.Append(elem->GetAttribute());
+            for (int j = 0; j < elem->GetNVertices(); j++)
+            {
+               send_buf.Append(vert_gid[v[j]]);
+            }
+         }
+
+         send_buf.Append(verts.Size());
+         for (int k = 0; k < verts.Size(); k++)
+         {
+            send_buf.Append(vert_gid[verts[k]]);
+            dsend_buf.Append(vertices[verts[k]](), spaceDim);
+         }
+      }
+      send_cnt[r] = send_buf.Size() - start;
+      dsend_cnt[r] = dsend_buf.Size() - dstart;
+   }
+
+   Array<int> recv_cnt, recv_buf, drecv_cnt;
+   Array<double> drecv_buf;
+   AllToAllV(MyComm, send_cnt, send_buf, recv_cnt, recv_buf);
+   AllToAllV(MyComm, dsend_cnt, dsend_buf, drecv_cnt, drecv_buf);
+
+   // count the received entities; the new vertices are numbered in the order
+   // of their global numbers, which preserves the global vertex ordering
+   Array<int> new_vert_gid, recv_ne(NRanks);
+   int new_ne = 0, new_nbe = 0;
+   recv_ne = 0;
+   for (int r = 0, p = 0; r < NRanks; r++)
+   {
+      if (recv_cnt[r] == 0) { continue; }
+      const int n = recv_ne[r] = recv_buf[p++];
+      new_ne += n;
+      for (int k = 0; k < n; k++)
+      {
+         p += 3 + Geometry::NumVerts[recv_buf[p]];
+      }
+      const int nb = recv_buf[p++];
+      new_nbe += nb;
+      for (int k = 0; k < nb; k++)
+      {
+         p += 2 + Geometry::NumVerts[recv_buf[p]];
+      }
+      const int nrv = recv_buf[p++];
+      new_vert_gid.Append(&recv_buf[p], nrv);
+      p += nrv;
+   }
+   new_vert_gid.Sort();
+   new_vert_gid.Unique();
+
+   const int *nvg_begin = new_vert_gid.GetData();
+   const int *nvg_end = nvg_begin + new_vert_gid.Size();
+   auto local_vertex = [&](int gid)
+   {
+      return int(std::lower_bound(nvg_begin, nvg_end, gid) - nvg_begin);
+   };
+
+   // create the new local mesh
+   ParMesh *pmesh2 = new ParMesh;
+   pmesh2->MyComm = MyComm;
+   pmesh2->NRanks = NRanks;
+   pmesh2->MyRank = MyRank;
+   pmesh2->gtopo.SetComm(MyComm);
+   pmesh2->InitMesh(Dim, spaceDim, new_vert_gid.Size(), new_ne, new_nbe);
+   pmesh2->NumOfVertices = new_vert_gid.Size();
+
+   // save the element exchange pattern for Send/RecvRebalanceDofs()
+   rebalance_send_ranks.SetSize(0);
+   rebalance_recv_ranks.SetSize(0);
+   for (int r = 0; r < NRanks; r++)
+   {
+      if (r == MyRank) { continue; }
+      if (send_elems.RowSize(r)) { rebalance_send_ranks.Append(r); }
+      if (recv_ne[r]) { rebalance_recv_ranks.Append(r); }
+   }
+   rebalance_send_elems.MakeI(rebalance_send_ranks.Size());
+   rebalance_recv_elems.MakeI(rebalance_recv_ranks.Size());
+   for (int i = 0; i < rebalance_send_ranks.Size(); i++)
+   {
+      rebalance_send_elems.AddColumnsInRow(
+         i, send_elems.RowSize(rebalance_send_ranks[i]));
+   }
+   for (int i = 0; i < rebalance_recv_ranks.Size(); i++)
+   {
+      rebalance_recv_elems.AddColumnsInRow(i, recv_ne[rebalance_recv_ranks[i]]);
+   }
+   rebalance_send_elems.MakeJ();
+   rebalance_recv_elems.MakeJ();
+   for (int i = 0; i < rebalance_send_ranks.Size(); i++)
+   {
+      const int r = rebalance_send_ranks[i];
+      rebalance_send_elems.AddConnections(i, send_elems.GetRow(r),
+                                          send_elems.RowSize(r));
+   }
+   rebalance_old_index.SetSize(new_ne);
+
+   // unpack the messages, in rank order
+   for (int r = 0, p = 0, dp = 0, ri = 0; r < NRanks; r++)
+   {
+      if (recv_cnt[r] == 0) { continue; }
+      const int n = recv_buf[p++];
+      for (int k = 0; k < n; k++)
+      {
+         const int geom = recv_buf[p++];
+         Element *elem = pmesh2->NewElement(geom);
+         elem->SetAttribute(recv_buf[p++]);
+         const int flag = recv_buf[p++];
+         if (geom == Geometry::TETRAHEDRON)
+         {
+            static_cast<Tetrahedron*>(elem)->SetRefinementFlag(flag);
+         }
+         int *v = elem->GetVertices();
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            v[j] = local_vertex(recv_buf[p++]);
+         }
+         const int new_index = pmesh2->NumOfElements;
+         if (r == MyRank)
+         {
+            rebalance_old_index[new_index] = send_elems.GetRow(r)[k];
+         }
+         else
+         {
+            rebalance_old_index[new_index] = -1;
+            rebalance_recv_elems.AddConnection(ri, new_index);
+         }
+         pmesh2->AddElement(elem);
+      }
+      if (r != MyRank) { ri++; }
+
+      const int nb = recv_buf[p++];
+      for (int k = 0; k < nb; k++)
+      {
+         const int geom = recv_buf[p++];
+         Element *elem = pmesh2->NewElement(geom);
+         elem->SetAttribute(recv_buf[p++]);
+         int *v = elem->GetVertices();
+         for (int j = 0; j < Geometry::NumVerts[geom]; j++)
+         {
+            v[j] = local_vertex(recv_buf[p++]);
+         }
+         pmesh2->AddBdrElement(elem);
+      }
+
+      const int nrv = recv_buf[p++];
+      for (int k = 0; k < nrv; k++, dp += spaceDim)
+      {
+         double *x = pmesh2->vertices[local_vertex(recv_buf[p++])]();
+         for (int d = 0; d < spaceDim; d++) { x[d] = drecv_buf[dp+d]; }
+      }
+   }
+   rebalance_send_elems.ShiftUpI();
+   rebalance_recv_elems.ShiftUpI();
+
+   pmesh2->FinalizeTopology(false);
+   pmesh2->meshgen = meshgen; // global 'meshgen' of the mesh
+
+   // find the ranks sharing each vertex
+   const int new_nv = pmesh2->GetNV();
+   Table vert_ranks;
+   {
+      Array<int> owner(new_nv);
+      for (int v = 0; v < new_nv; v++)
+      {
+         owner[v] = vert_owner(new_vert_gid[v]);
+      }
+      FindKeyRanks(MyComm, 1, new_vert_gid, owner, vert_ranks);
+   }
+
+   // find the ranks sharing each edge (in 2D and 3D) and each face (in 3D)
+   // whose vertices are all shared; the entities are identified by the sorted
+   // global numbers of their vertices, padded with -1
+   const int new_nedges = (Dim > 1) ? pmesh2->GetNEdges() : 0;
+   Array<int> ent_id, ent_keys, ent_owner;
+   Table ent_ranks;
+   {
+      Array<int> ev;
+      for (int e = 0; e < new_nedges; e++)
+      {
+         pmesh2->GetEdgeVertices(e, ev);
+         if (vert_ranks.RowSize(ev[0]) < 2 ||
+             vert_ranks.RowSize(ev[1]) < 2) { continue; }
+         if (ev[0] > ev[1]) { std::swap(ev[0], ev[1]); }
+         ent_id.Append(e);
+         ent_keys.Append(new_vert_gid[ev[0]]);
+         ent_keys.Append(new_vert_gid[ev[1]]);
+         ent_keys.Append(-1);
+         ent_keys.Append(-1);
+      }
+      for (int f = 0; Dim == 3 && f < pmesh2->GetNumFaces(); f++)
+      {
+         if (pmesh2->faces_info[f].Elem2No >= 0) { continue; }
+         pmesh2->faces[f]->GetVertices(ev);
+         bool all_shared = true;
+         for (int j = 0; j < ev.Size(); j++)
+         {
+            all_shared = all_shared && (vert_ranks.RowSize(ev[j]) > 1);
+         }
+         if (!all_shared) { continue; }
+         ev.Sort();
+         ent_id.Append(new_nedges + f);
+         for (int j = 0; j < 4; j++)
+         {
+            ent_keys.Append(j < ev.Size() ? new_vert_gid[ev[j]] : -1);
+         }
+      }
+      ent_owner.SetSize(ent_id.Size());
+      for (int i = 0; i < ent_id.Size(); i++)
+      {
+         ent_owner[i] = vert_owner(ent_keys[4*i]);
+      }
+      FindKeyRanks(MyComm, 4, ent_keys, ent_owner, ent_ranks);
+   }
+
+   // order the shared edges and faces by their keys, consistently on all ranks
+   Array<int> ent_order;
+   for (int i = 0; i < ent_id.Size(); i++)
+   {
+      if (ent_ranks.RowSize(i) > 1) { ent_order.Append(i); }
+   }
+   const int *ek = ent_keys.GetData();
+   ent_order.Sort([&](int a, int b)
+   {
+      return std::lexicographical_compare(ek + 4*a, ek + 4*a + 4,
+                                          ek + 4*b, ek + 4*b + 4);
+   });
+
+   // create the communication groups
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+
+   Array<int> vert_group(new_nv), ent_group(ent_order.Size());
+   for (int v = 0; v < new_nv; v++)
+   {
+      vert_group[v] = -1;
+      if (vert_ranks.RowSize(v) > 1)
+      {
+         group.Recreate(vert_ranks.RowSize(v), vert_ranks.GetRow(v));
+         vert_group[v] = groups.Insert(group) - 1;
+      }
+   }
+   for (int k = 0; k < ent_order.Size(); k++)
+   {
+      const int i = ent_order[k];
+      group.Recreate(ent_ranks.RowSize(i), ent_ranks.GetRow(i));
+      ent_group[k] = groups.Insert(group) - 1;
+   }
+   const int ngroups = groups.Size() - 1;
+   pmesh2->gtopo.Create(groups, 822);
+
+   // fill the shared vertices, edges and faces of each group; the entities are
+   // listed in each group in the order of their keys
+   Table &g_svert = pmesh2->group_svert, &g_sedge = pmesh2->group_sedge;
+   Table &g_stria = pmesh2->group_stria, &g_squad = pmesh2->group_squad;
+   g_svert.MakeI(ngroups);
+   g_sedge.MakeI(ngroups);
+   g_stria.MakeI(ngroups);
+   g_squad.MakeI(ngroups);
+   for (int v = 0; v < new_nv; v++)
+   {
+      if (vert_group[v] >= 0) { g_svert.AddAColumnInRow(vert_group[v]); }
+   }
+   for (int k = 0; k < ent_order.Size(); k++)
+   {
+      const int id = ent_id[ent_order[k]];
+      if (id < new_nedges) { g_sedge.AddAColumnInRow(ent_group[k]); }
+      else if (pmesh2->faces[id - new_nedges]->GetType() ==
+               Element::TRIANGLE) { g_stria.AddAColumnInRow(ent_group[k]); }
+      else { g_squad.AddAColumnInRow(ent_group[k]); }
+   }
+   g_svert.MakeJ();
+   g_sedge.MakeJ();
+   g_stria.MakeJ();
+   g_squad.MakeJ();
+   for (int v = 0; v < new_nv; v++)
+   {
+      if (vert_group[v] >= 0) { g_svert.AddConnection(vert_group[v], v); }
+   }
+   for (int k = 0; k < ent_order.Size(); k++)
+   {
+      const int id = ent_id[ent_order[k]];
+      if (id < new_nedges) { g_sedge.AddConnection(ent_group[k], k); }
+      else if (pmesh2->faces[id - new_nedges]->GetType() ==
+               Element::TRIANGLE) { g_stria.AddConnection(ent_group[k], k); }
+      else { g_squad.AddConnection(ent_group[k], k); }
+   }
+   g_svert.ShiftUpI();
+   g_sedge.ShiftUpI();
+   g_stria.ShiftUpI();
+   g_squad.ShiftUpI();
+
+   // number the shared entities group by group
+   pmesh2->svert_lvert.SetSize(g_svert.Size_of_connections());
+   for (int j = 0; j < g_svert.Size_of_connections(); j++)
+   {
+      pmesh2->svert_lvert[j] = g_svert.GetJ()[j];
+      g_svert.GetJ()[j] = j;
+   }
+
+   Array<int> ev;
+   pmesh2->shared_edges.SetSize(g_sedge.Size_of_connections());
+   for (int j = 0; j < g_sedge.Size_of_connections(); j++)
+   {
+      const int k = g_sedge.GetJ()[j];
+      pmesh2->GetEdgeVertices(ent_id[ent_order[k]], ev);
+      pmesh2->shared_edges[j] = new Segment(std::min(ev[0], ev[1]),
+                                            std::max(ev[0], ev[1]), 1);
+      g_sedge.GetJ()[j] = j;
+   }
+
+   pmesh2->shared_trias.SetSize(g_stria.Size_of_connections());
+   for (int j = 0; j < g_stria.Size_of_connections(); j++)
+   {
+      const int k = g_stria.GetJ()[j];
+      const int f = ent_id[ent_order[k]] - new_nedges;
+      int *v = pmesh2->shared_trias[j].v;
+      pmesh2->shared_trias[j].Set(pmesh2->faces[f]->GetVertices());
+      std::sort(v, v + 3);
+      if (meshgen == 1) // Tet-only mesh
+      {
+         // orient the shared face according to the refinement flag of its
+         // tetrahedron, flipping it on the rank with the larger number
+         const Mesh::FaceInfo &fi = pmesh2->faces_info[f];
+         Tetrahedron *tet =
+            static_cast<Tetrahedron*>(pmesh2->elements[fi.Elem1No]);
+         if (tet->GetRefinementFlag())
+         {
+            tet->GetMarkedFace(fi.Elem1Inf/64, v);
+            if (MyRank == ent_ranks.GetRow(ent_order[k])[1])
+            {
+               std::swap(v[0], v[1]);
+            }
+         }
+      }
+      g_stria.GetJ()[j] = j;
+   }
+
+   pmesh2->shared_quads.SetSize(g_squad.Size_of_connections());
+   for (int j = 0; j < g_squad.Size_of_connections(); j++)
+   {
+      const int k = g_squad.GetJ()[j];
+      const int f = ent_id[ent_order[k]] - new_nedges;
+      const int *fv = pmesh2->faces[f]->GetVertices();
+      // start at the smallest vertex and continue towards its smaller neighbor
+      int m = 0;
+      for (int i = 1; i < 4; i++) { if (fv[i] < fv[m]) { m = i; } }
+      const int dir = (fv[(m+1)%4] < fv[(m+3)%4]) ? 1 : 3;
+      int *v = pmesh2->shared_quads[j].v;
+      for (int i = 0; i < 4; i++) { v[i] = fv[(m + dir*i)%4]; }
+      g_squad.GetJ()[j] = j;
+   }
+
+   const bool refine = false, fix_orientation = false;
+   pmesh2->Finalize(refine, fix_orientation); // sets sedge_ledge, sface_lface
+
+   // replace the mesh and its parallel topology by the new ones
+   attributes.Copy(pmesh2->attributes);
+   bdr_attributes.Copy(pmesh2->bdr_attributes);
+
+   Swap(*pmesh2, false);
+   pmesh2->gtopo.Copy(gtopo);
+   mfem::Swap(shared_edges, pmesh2->shared_edges);
+   mfem::Swap(shared_trias, pmesh2->shared_trias);
+   mfem::Swap(shared_quads, pmesh2->shared_quads);
+   mfem::Swap(group_svert, pmesh2->group_svert);
+   mfem::Swap(group_sedge, pmesh2->group_sedge);
+   mfem::Swap(group_stria, pmesh2->group_stria);
+   mfem::Swap(group_squad, pmesh2->group_squad);
+   mfem::Swap(svert_lvert, pmesh2->svert_lvert);
+   mfem::Swap(sedge_ledge, pmesh2->sedge_ledge);
+   mfem::Swap(sface_lface, pmesh2->sface_lface);
+   delete pmesh2;
+
+   ResetLazyData();
+
+   last_operation = Mesh::REBALANCE;
+   sequence++;
+
+   UpdateNodes();
+}
+
+void ParMesh::SendRebalanceDofs(int old_ndofs, const Table &old_element_dofs,
+                                long old_global_offset,
+                                FiniteElementSpace *space)
+{
+   MFEM_VERIFY(Conforming(), "wrong code path");
+
+   const Table &elems = rebalance_send_elems;
+   const int vdim = space->GetVDim();
+   Array<int> dofs;
+
+   int size = 0;
+   for (int j = 0; j < elems.Size_of_connections(); j++)
+   {
+      size += old_element_dofs.RowSize(elems.GetJ()[j]) * vdim;
+   }
+   rebalance_send_dofs.SetSize(size);
+   rebalance_requests.SetSize(rebalance_send_ranks.Size());
+
+   // send the old global (unsigned) DOFs of the elements we used to own
+   for (int i = 0, pos = 0; i < rebalance_send_ranks.Size(); i++)
+   {
+      const int start = pos;
+      for (int k = 0; k < elems.RowSize(i); k++)
+      {
+         old_element_dofs.GetRow(elems.GetRow(i)[k], dofs);
+         space->DofsToVDofs(dofs, old_ndofs);
+         for (int j = 0; j < dofs.Size(); j++)
+         {
+            const int d = (dofs[j] >= 0) ? dofs[j] : (-1 - dofs[j]);
+            rebalance_send_dofs[pos++] = old_global_offset + d;
+         }
+      }
+      MPI_Isend(&rebalance_send_dofs[start], pos - start, MPI_LONG,
+                rebalance_send_ranks[i], 159, MyComm, &rebalance_requests[i]);
+   }
+}
+
+void ParMesh::RecvRebalanceDofs(Array<int> &elements, Array<long> &dofs)
+{
+   MFEM_VERIFY(Conforming(), "wrong code path");
+
+   const Table &elems = rebalance_recv_elems;
+   elements.SetSize(elems.Size_of_connections());
+   for (int j = 0; j < elements.Size(); j++)
+   {
+      elements[j] = elems.GetJ()[j];
+   }
+
+   // receive from the ranks we got elements from, in rank order
+   dofs.SetSize(0);
+   for (int i = 0; i < rebalance_recv_ranks.Size(); i++)
+   {
+      MPI_Status status;
+      int count;
+      MPI_Probe(rebalance_recv_ranks[i], 159, MyComm, &status);
+      MPI_Get_count(&status, MPI_LONG, &count);
+
+      const int start = dofs.Size();
+      dofs.SetSize(start + count);
+      MPI_Recv(dofs.GetData() + start, count, MPI_LONG,
+               rebalance_recv_ranks[i], 159, MyComm, MPI_STATUS_IGNORE);
+   }
+
+   MPI_Waitall(rebalance_requests.Size(), rebalance_requests.GetData(),
+               MPI_STATUSES_IGNORE);
+}
+
 void ParMesh::RefineGroups(const DSTable &v_to_v, int *middle)
 {
    // Refine groups after LocalRefinement in 2D (triangle meshes)
@@ -5365,6 +6504,42 @@ void ParMesh::ParPrint(ostream &out) const
    out << "\nmfem_mesh_end" << endl;
 }
 
+void ParMesh::ParPrintBinary(ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext, "NURBS meshes are not supported by the binary "
+               "parallel mesh format");
+
+   PrintBinary(out);
+
+   out << "\nbinary_parallel_data\n";
+   if (pncmesh)
+   {
+      // the shared entities are recomputed from the ParNCMesh when loading
+      out.flush();
+      return;
+   }
+   gtopo.SaveBinary(out);
+
+   bin_io::WriteArray(out, svert_lvert);
+   bin_io::WriteTable(out, group_svert);
+
+   Array<int> sedge_vert(2*shared_edges.Size());
+   for (int se = 0; se < shared_edges.Size(); se++)
+   {
+      const int *v = shared_edges[se]->GetVertices();
+      sedge_vert[2*se] = v[0];
+      sedge_vert[2*se+1] = v[1];
+   }
+   bin_io::WriteArray(out, sedge_vert);
+   bin_io::WriteTable(out, group_sedge);
+
+   bin_io::WriteArray(out, shared_trias);
+   bin_io::WriteTable(out, group_stria);
+   bin_io::WriteArray(out, shared_quads);
+   bin_io::WriteTable(out, group_squad);
+   out.flush();
+}
+
 int ParMesh::FindPoints(DenseMatrix& point_mat, Array<int>& elem_id,
                         Array<IntegrationPoint>& ip, bool warn,
                         InverseElementTransformation *inv_trans)
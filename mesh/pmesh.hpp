@@ -93,6 +93,12 @@ protected:
    // Determine sedge_ledge and sface_lface.
    void FinalizeParTopo();
 
+   // Read the parallel data written by ParPrintBinary().
+   void ReadBinaryParallelData(std::istream &input);
+
+   // Create the ParNCMesh of a nonconforming binary mesh, see Loader().
+   virtual NCMesh *LoadBinaryNCMesh(std::istream &input);
+
    // Mark all tets to ensure consistency across MPI tasks; also mark the
    // shared and boundary triangle faces using the consistently marked tets.
    virtual void MarkTetMeshForRefinement(DSTable &v_to_v);
@@ -150,6 +156,21 @@ protected:
 
    void RebalanceImpl(const Array<int> *partition);
 
+   /// Migrate the elements of a conforming mesh, see Rebalance().
+   void RebalanceConforming(const Array<int> *partition);
+
+   /** Data from the last conforming Rebalance(): previous indices of the
+       current elements, and the old (sent) and new (received) indices of the
+       elements exchanged with each of the ranks in rebalance_send_ranks and
+       rebalance_recv_ranks, respectively. */
+   Array<int> rebalance_old_index;
+   Array<int> rebalance_send_ranks, rebalance_recv_ranks;
+   Table rebalance_send_elems, rebalance_recv_elems;
+
+   /// Buffers for Send/RecvRebalanceDofs().
+   Array<long> rebalance_send_dofs;
+   Array<MPI_Request> rebalance_requests;
+
    void DeleteFaceNbrData();
 
    bool WantSkipSharedMaster(const NCMesh::Master &master) const;
@@ -213,9 +234,19 @@ public:
            int part_method = 1);
 
    /// Read a parallel mesh, each MPI rank from its own file/stream.
-   /** The @a refine parameter is passed to the method Mesh::Finalize(). */
+   /** The @a refine parameter is passed to the method Mesh::Finalize(). Both
+       the formats of ParPrint() and ParPrintBinary() are supported. */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /// Read a parallel mesh from the pieces of the PVTU file @a pvtu_filename.
+   /** The pieces are distributed in contiguous blocks over the ranks, which
+       must not be more than the pieces, and each rank reads only its own
+       pieces. The shared vertices, edges and faces are identified by the
+       coordinates of the vertices on the exterior of the local meshes. Only
+       linear, conforming meshes are supported. */
+   ParMesh(MPI_Comm comm, const std::string &pvtu_filename,
+           bool refine = true, bool fix_orientation = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -318,14 +349,36 @@ public:
    virtual long ReduceInt(int value) const;
 
    /** Load balance the mesh by equipartitioning the global space-filling
-       sequence of elements. Works for nonconforming meshes only. */
+       sequence of elements. For conforming meshes, the sequence is formed by
+       the elements of all ranks, in rank order, each ordered along a local
+       Hilbert curve. */
    void Rebalance();
 
-   /** Load balance a nonconforming mesh using a user-defined partition.
-       Each local element 'i' is migrated to processor rank 'partition[i]',
-       for 0 <= i < GetNE(). */
+   /** Load balance the mesh using a user-defined partition. Each local
+       element 'i' is migrated to processor rank 'partition[i]', for
+       0 <= i < GetNE(). For conforming meshes, the boundary elements follow
+       their adjacent elements and the shared entities are recomputed.
+
+       After rebalancing, ParFiniteElementSpace::Update() and
+       ParGridFunction::Update() migrate the data of the spaces and grid
+       functions defined on the mesh. NURBS meshes are not supported. */
    void Rebalance(const Array<int> &partition);
 
+   /** Get the previous indices (before the last conforming Rebalance()) of
+       the current elements, or -1 for elements received from other ranks. */
+   const Array<int>& GetRebalanceOldIndex() const
+   { return rebalance_old_index; }
+
+   /** Use the communication pattern from the last conforming Rebalance() to
+       send the (global) DOFs of the migrated elements. */
+   void SendRebalanceDofs(int old_ndofs, const Table &old_element_dofs,
+                          long old_global_offset, FiniteElementSpace *space);
+
+   /** Receive the element DOFs sent by SendRebalanceDofs(). The received
+       elements (new indices) are returned in @a elements and their DOFs, in
+       the same order, in @a dofs. */
+   void RecvRebalanceDofs(Array<int> &elements, Array<long> &dofs);
+
    /** Print the part of the mesh in the calling processor adding the interface
        as boundary (for visualization purposes) using the mfem v1.0 format. */
    virtual void Print(std::ostream &out = mfem::out) const;
@@ -362,6 +415,17 @@ public:
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
+   /** @brief Save the mesh in a binary parallel mesh format, which is read
+       back by the constructor ParMesh(MPI_Comm, std::istream &, bool). */
+   /** The serial part of the mesh is written with Mesh::PrintBinary() and is
+       followed by the complete group topology and the shared entities. When
+       loading, they are restored as is: the group topology is not recomputed,
+       which requires the same number of MPI ranks as when saving. For
+       nonconforming meshes, the serial part includes the refinement hierarchy
+       of the ParNCMesh, from which the shared entities are recomputed when
+       loading. NURBS meshes are not supported. */
+   void ParPrintBinary(std::ostream &out) const;
+
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
                           InverseElementTransformation *inv_trans = NULL);
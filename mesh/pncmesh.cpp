@@ -56,6 +56,16 @@ ParNCMesh::ParNCMesh(const ParNCMesh &other)
    Update(); // mark all secondary stuff for recalculation
 }
 
+ParNCMesh::ParNCMesh(MPI_Comm comm, std::istream &input)
+   : NCMesh(input)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   Update();
+}
+
 ParNCMesh::~ParNCMesh()
 {
    ClearAuxPM();
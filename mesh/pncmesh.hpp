@@ -68,6 +68,11 @@ public:
 
    ParNCMesh(const ParNCMesh &other);
 
+   /** Load the refinement hierarchy written by NCMesh::SaveBinary(), on the
+       same number of MPI ranks that saved it. The element ranks and the ghost
+       layer are restored as saved. */
+   ParNCMesh(MPI_Comm comm, std::istream &input);
+
    virtual ~ParNCMesh();
 
    /** An override of NCMesh::Refine, which is called eventually, after making
@@ -28,6 +28,7 @@
 #include "general/adios2stream.hpp"
 #endif
 #include "general/isockstream.hpp"
+#include "general/jit.hpp"
 #include "general/osockstream.hpp"
 #include "general/socketstream.hpp"
 #include "general/optparser.hpp"
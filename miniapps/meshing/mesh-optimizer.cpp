@@ -78,6 +78,8 @@
 //     mesh-optimizer -o 3 -rs 0 -mid 1 -tid 1 -ni 1000 -ls 2 -li 100 -bnd -qt 1 -qo 8 -cmb 1
 //   Mixed tet / cube / hex mesh with limiting:
 //     mesh-optimizer -m ../../data/fichera-mixed-p2.mesh -o 4 -rs 1 -mid 301 -tid 1 -fix-bnd -qo 6 -nor -lc 0.25
+//   Partially assembled Newton iterations with Jacobi-preconditioned MINRES:
+//     mesh-optimizer -m cube.mesh -o 2 -rs 1 -ji 0.1 -mid 303 -tid 1 -ni 20 -ls 3 -li 100 -fix-bnd -qt 2 -pa
 //   3D pinched sphere shape (the mesh is in the mfem/data GitHub repository):
 //   * mesh-optimizer -m ../../../mfem_data/ball-pert.mesh -o 4 -rs 0 -mid 303 -tid 1 -ni 20 -ls 2 -li 500 -fix-bnd
 //   2D non-conforming shape and equal size:
@@ -119,6 +121,7 @@ int main(int argc, char *argv[])
    bool fdscheme         = false;
    int adapt_eval        = 0;
    bool exactaction      = false;
+   bool pa               = false;
 
    // 1. Parse command-line options.
    OptionsParser args(argc, argv);
@@ -176,7 +179,8 @@ int main(int argc, char *argv[])
    args.AddOption(&solver_rtol, "-rtol", "--newton-rel-tolerance",
                   "Relative tolerance for the Newton solver.");
    args.AddOption(&lin_solver, "-ls", "--lin-solver",
-                  "Linear solver: 0 - l1-Jacobi, 1 - CG, 2 - MINRES.");
+                  "Linear solver: 0 - l1-Jacobi, 1 - CG, 2 - MINRES,\n\t"
+                  "3 - MINRES with Jacobi preconditioner.");
    args.AddOption(&max_lin_iter, "-li", "--lin-iter",
                   "Maximum number of iterations in the linear solve.");
    args.AddOption(&move_bnd, "-bnd", "--move-boundary", "-fix-bnd",
@@ -203,6 +207,8 @@ int main(int argc, char *argv[])
                   "Set the verbosity level - 0, 1, or 2.");
    args.AddOption(&adapt_eval, "-ae", "--adaptivity-evaluator",
                   "0 - Advection based (DEFAULT), 1 - GSLIB.");
+   args.AddOption(&pa, "-pa", "--partial-assembly", "-no-pa",
+                  "--no-partial-assembly", "Enable Partial Assembly.");
    args.Parse();
    if (!args.Good())
    {
@@ -623,6 +629,14 @@ int main(int argc, char *argv[])
    //     command-line options for the weights and the type of the second
    //     metric; one should update those in the code.
    NonlinearForm a(fespace);
+   if (pa)
+   {
+      MFEM_VERIFY(combomet == 0, "Combinations of metrics are not supported "
+                  "with partial assembly, use -cmb 0.");
+      MFEM_VERIFY(lin_solver != 0, "The l1-Jacobi solver requires an "
+                  "assembled matrix, use -ls 1, 2 or 3 with -pa.");
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   }
    ConstantCoefficient *coeff1 = NULL;
    TMOP_QualityMetric *metric2 = NULL;
    TargetConstructor *target_c2 = NULL;
@@ -727,10 +741,11 @@ int main(int argc, char *argv[])
       }
       a.SetEssentialVDofs(ess_vdofs);
    }
+   if (pa) { a.Setup(); }
 
    // 14. As we use the Newton method to solve the resulting nonlinear system,
    //     here we setup the linear solver for the system's Jacobian.
-   Solver *S = NULL;
+   Solver *S = NULL, *S_prec = NULL;
    const double linsol_rtol = 1e-12;
    if (lin_solver == 0)
    {
@@ -752,6 +767,12 @@ int main(int argc, char *argv[])
       minres->SetRelTol(linsol_rtol);
       minres->SetAbsTol(0.0);
       minres->SetPrintLevel(verbosity_level >= 2 ? 3 : -1);
+      if (lin_solver == 3)
+      {
+         if (pa) { S_prec = new OperatorJacobiSmoother; }
+         else    { S_prec = new DSmoother; }
+         minres->SetPreconditioner(*S_prec);
+      }
       S = minres;
    }
 
@@ -854,6 +875,7 @@ int main(int argc, char *argv[])
 
    // 19. Free the used memory.
    delete S;
+   delete S_prec;
    delete target_c2;
    delete metric2;
    delete coeff1;
@@ -65,3 +65,327 @@ TEST_CASE("Test order of boundary integrators",
       delete D;
    }
 }
+
+TEST_CASE("Test precomputed sparsity pattern",
+          "[BilinearForm]")
+{
+   const int order = 2;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 2, Element::TRIANGLE, true) :
+                   new Mesh(2, 2, 1, Element::HEXAHEDRON, true);
+
+      H1_FECollection h1_fec(order, dim);
+      ND_FECollection nd_fec(order, dim);
+      RT_FECollection rt_fec(order-1, dim);
+      FiniteElementSpace h1_nodes(mesh, &h1_fec, dim, Ordering::byNODES);
+      FiniteElementSpace h1_vdim(mesh, &h1_fec, dim, Ordering::byVDIM);
+      FiniteElementSpace nd_fes(mesh, &nd_fec);
+      FiniteElementSpace rt_fes(mesh, &rt_fec);
+      FiniteElementSpace *spaces[] = { &h1_nodes, &h1_vdim, &nd_fes, &rt_fes };
+
+      ConstantCoefficient one(1.0);
+      for (FiniteElementSpace *fes : spaces)
+      {
+         BilinearForm a_ref(fes), a(fes);
+         for (BilinearForm *bf : { &a_ref, &a })
+         {
+            if (fes == &h1_nodes || fes == &h1_vdim)
+            {
+               bf->AddDomainIntegrator(new ElasticityIntegrator(one, one));
+               bf->AddBoundaryIntegrator(new VectorMassIntegrator(one));
+            }
+            else if (fes == &nd_fes)
+            {
+               bf->AddDomainIntegrator(new CurlCurlIntegrator(one));
+               bf->AddDomainIntegrator(new VectorFEMassIntegrator(one));
+            }
+            else
+            {
+               bf->AddDomainIntegrator(new DivDivIntegrator(one));
+               bf->AddDomainIntegrator(new VectorFEMassIntegrator(one));
+            }
+         }
+         a.UsePrecomputedSparsity();
+         a_ref.Assemble();
+         a_ref.Finalize();
+         a.Assemble();
+         a.Finalize();
+
+         const SparseMatrix &A_ref = a_ref.SpMat();
+         const SparseMatrix &A = a.SpMat();
+         REQUIRE(A.NumNonZeroElems() >= A_ref.NumNonZeroElems());
+
+         SparseMatrix *D = Add(1.0, A_ref, -1.0, A);
+         REQUIRE(D->MaxNorm() < 1e-12 * A_ref.MaxNorm());
+         delete D;
+      }
+      delete mesh;
+   }
+}
+
+// Check that 'colors' contains each element of 'fes' exactly once and that
+// the elements of the same color do not share any degrees of freedom.
+static void check_element_colors(const FiniteElementSpace &fes,
+                                 const Table &colors)
+{
+   Array<int> elem_color(fes.GetNE()), dof_color(fes.GetNDofs()), dofs;
+   elem_color = -1;
+   dof_color = -1;
+   for (int c = 0; c < colors.Size(); c++)
+   {
+      REQUIRE(colors.RowSize(c) > 0);
+      for (int k = 0; k < colors.RowSize(c); k++)
+      {
+         const int e = colors.GetRow(c)[k];
+         REQUIRE(elem_color[e] == -1);
+         elem_color[e] = c;
+         fes.GetElementDofs(e, dofs);
+         for (int d : dofs)
+         {
+            if (d < 0) { d = -1-d; }
+            REQUIRE(dof_color[d] != c);
+            dof_color[d] = c;
+         }
+      }
+   }
+   REQUIRE(elem_color.Min() >= 0);
+}
+
+TEST_CASE("Test element coloring",
+          "[BilinearForm]")
+{
+   const int order = 2;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (bool simplex : { false, true })
+      {
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(4, 3, simplex ? Element::TRIANGLE :
+                               Element::QUADRILATERAL, true) :
+                      new Mesh(3, 2, 2, simplex ? Element::TETRAHEDRON :
+                               Element::HEXAHEDRON, true);
+         // The ND space requires consistently oriented tetrahedra
+         if (dim == 3 && simplex) { mesh->ReorientTetMesh(); }
+
+         H1_FECollection h1_fec(order, dim);
+         ND_FECollection nd_fec(order, dim);
+         L2_FECollection l2_fec(order, dim);
+         FiniteElementSpace h1_fes(mesh, &h1_fec, dim);
+         FiniteElementSpace nd_fes(mesh, &nd_fec);
+         FiniteElementSpace l2_fes(mesh, &l2_fec);
+         FiniteElementSpace *spaces[] = { &h1_fes, &nd_fes, &l2_fes };
+
+         ConstantCoefficient one(1.0);
+         for (FiniteElementSpace *fes : spaces)
+         {
+            BilinearForm a_ref(fes), a(fes);
+            for (BilinearForm *bf : { &a_ref, &a })
+            {
+               if (fes == &h1_fes)
+               {
+                  bf->AddDomainIntegrator(new ElasticityIntegrator(one, one));
+               }
+               else if (fes == &nd_fes)
+               {
+                  bf->AddDomainIntegrator(new CurlCurlIntegrator(one));
+                  bf->AddDomainIntegrator(new VectorFEMassIntegrator(one));
+               }
+               else
+               {
+                  bf->AddDomainIntegrator(new MassIntegrator(one));
+               }
+            }
+
+            const Table &colors = a.GetElementColors();
+            check_element_colors(*fes, colors);
+            // The elements of a discontinuous space share no dofs
+            if (fes == &l2_fes) { REQUIRE(colors.Size() == 1); }
+
+            // Assemble the colors one after the other
+            a.UseColoring();
+            a_ref.Assemble();
+            a_ref.Finalize();
+            a.Assemble();
+            a.Finalize();
+
+            SparseMatrix *D = Add(1.0, a_ref.SpMat(), -1.0, a.SpMat());
+            REQUIRE(D->MaxNorm() < 1e-12 * a_ref.SpMat().MaxNorm());
+            delete D;
+         }
+
+         // The coloring is recomputed after the space is updated
+         BilinearForm a(&h1_fes);
+         a.GetElementColors();
+         mesh->UniformRefinement();
+         h1_fes.Update();
+         check_element_colors(h1_fes, a.GetElementColors());
+
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("Test sparsity pattern reuse",
+          "[BilinearForm]")
+{
+   const int order = 2;
+   for (int nc = 0; nc <= 1; nc++)
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      if (nc)
+      {
+         mesh.EnsureNCMesh();
+         Array<int> refs;
+         refs.Append(0);
+         refs.Append(4);
+         mesh.GeneralRefinement(refs);
+      }
+      H1_FECollection fec(order, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec);
+
+      Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      GridFunction x(&fes);
+      FunctionCoefficient x0([](const Vector &p) { return p(0) + p(1); });
+      x.ProjectCoefficient(x0);
+      ConstantCoefficient one(1.0);
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+
+      for (Matrix::DiagonalPolicy dpolicy : { Matrix::DIAG_KEEP,
+                                              Matrix::DIAG_ONE })
+      {
+         ConstantCoefficient kappa(1.0), sigma(1.0);
+         BilinearForm a(&fes);
+         a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+         a.AddDomainIntegrator(new MassIntegrator(sigma));
+         a.SetDiagonalPolicy(dpolicy);
+         a.ReuseSparsityPattern();
+
+         const SparseMatrix *A_first = NULL;
+         for (int step = 1; step <= 3; step++)
+         {
+            kappa.constant = 1.0 + step;
+            sigma.constant = 1.0 / step;
+
+            BilinearForm a_ref(&fes);
+            a_ref.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+            a_ref.AddDomainIntegrator(new MassIntegrator(sigma));
+            a_ref.SetDiagonalPolicy(dpolicy);
+            a_ref.Assemble();
+            // FormLinearSystem() may modify x and b, so use copies
+            GridFunction x_ref(x), x_a(x);
+            Vector b_ref(b), b_a(b);
+            SparseMatrix A_ref;
+            Vector X_ref, B_ref;
+            a_ref.FormLinearSystem(ess_tdof_list, x_ref, b_ref, A_ref,
+                                   X_ref, B_ref);
+
+            a.Assemble();
+            SparseMatrix A;
+            Vector X, B;
+            // The second call must not eliminate the essential dofs again
+            for (int i = 0; i < 2; i++)
+            {
+               x_a = x;
+               b_a = b;
+               a.FormLinearSystem(ess_tdof_list, x_a, b_a, A, X, B);
+            }
+            if (step == 1) { A_first = &a.SpMat(); }
+            REQUIRE(&a.SpMat() == A_first);
+
+            SparseMatrix *D = Add(1.0, A_ref, -1.0, A);
+            REQUIRE(D->MaxNorm() < 1e-12 * A_ref.MaxNorm());
+            delete D;
+            B -= B_ref;
+            REQUIRE(B.Normlinf() < 1e-12 * B_ref.Normlinf());
+         }
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Test parallel sparsity pattern reuse",
+          "[BilinearForm], [Parallel]")
+{
+   const int order = 2;
+   for (int nc = 0; nc <= 1; nc++)
+   {
+      Mesh mesh(4, 4, Element::QUADRILATERAL, true);
+      if (nc) { mesh.EnsureNCMesh(); }
+      ParMesh pmesh(MPI_COMM_WORLD, mesh);
+      if (nc)
+      {
+         // The conforming triple product P^T A P uses the hanging dofs
+         Array<int> refs;
+         refs.Append(0);
+         pmesh.GeneralRefinement(refs);
+      }
+      H1_FECollection fec(order, pmesh.Dimension());
+      ParFiniteElementSpace fes(&pmesh, &fec);
+
+      Array<int> ess_tdof_list, ess_bdr(pmesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient kappa(1.0), sigma(1.0);
+      ParBilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+      a.AddDomainIntegrator(new MassIntegrator(sigma));
+      a.ReuseSparsityPattern();
+
+      const HypreParMatrix *A_first = NULL;
+      for (int step = 1; step <= 3; step++)
+      {
+         kappa.constant = 1.0 + step;
+         sigma.constant = 1.0 / step;
+
+         ParBilinearForm a_ref(&fes);
+         a_ref.AddDomainIntegrator(new DiffusionIntegrator(kappa));
+         a_ref.AddDomainIntegrator(new MassIntegrator(sigma));
+         a_ref.Assemble();
+         a_ref.Finalize();
+         HypreParMatrix *A_ref = a_ref.ParallelAssemble();
+         HypreParMatrix *A_ref_e = A_ref->EliminateRowsCols(ess_tdof_list);
+
+         a.Assemble();
+         OperatorHandle A;
+         // The second call must not eliminate the essential dofs again
+         for (int i = 0; i < 2; i++)
+         {
+            a.FormSystemMatrix(ess_tdof_list, A);
+         }
+         // The values of the parallel matrix are updated in place
+         if (step == 1) { A_first = A.As<HypreParMatrix>(); }
+         REQUIRE(A.As<HypreParMatrix>() == A_first);
+
+         Vector X(fes.GetTrueVSize()), Y(X.Size()), Y_ref(X.Size());
+         X.Randomize(step);
+         A->Mult(X, Y);
+         A_ref->Mult(X, Y_ref);
+         Y -= Y_ref;
+         REQUIRE(Y.Normlinf() < 1e-12 * Y_ref.Normlinf());
+
+         // The eliminated part is updated too, see EliminateBC()
+         Vector x(fes.GetVSize()), b(fes.GetVSize()), B, B_ref(X.Size());
+         x.Randomize(step + 10);
+         b = 0.0;
+         a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+         fes.GetRestrictionMatrix()->Mult(x, X);
+         B_ref = 0.0;
+         EliminateBC(*A_ref, *A_ref_e, ess_tdof_list, X, B_ref);
+         B -= B_ref;
+         REQUIRE(B.Normlinf() < 1e-12 * B_ref.Normlinf());
+         delete A_ref_e;
+         delete A_ref;
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,279 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace coefficient
+{
+
+double scalar_func(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += (d + 1)*sin(x(d)); }
+   return f;
+}
+
+double td_scalar_func(const Vector &x, double t)
+{
+   return t*scalar_func(x);
+}
+
+void vector_func(const Vector &x, Vector &v)
+{
+   for (int i = 0; i < v.Size(); i++)
+   {
+      v(i) = cos((i + 1)*x(i % x.Size())) + x(0);
+   }
+}
+
+void matrix_func(const Vector &x, DenseMatrix &m)
+{
+   for (int i = 0; i < m.Height(); i++)
+   {
+      for (int j = 0; j < m.Width(); j++)
+      {
+         m(i,j) = (i + 1)*x(0) - (j + 2)*x(x.Size() - 1);
+      }
+   }
+}
+
+// Evaluate the coefficient point by point, as a reference.
+static void EvalPointwise(Coefficient &c, Mesh &mesh,
+                          const IntegrationRule &ir, Vector &val)
+{
+   const int nq = ir.GetNPoints();
+   val.SetSize(nq*mesh.GetNE());
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         val(q + nq*e) = c.Eval(T, ir.IntPoint(q));
+      }
+   }
+}
+
+static void EvalPointwise(VectorCoefficient &c, Mesh &mesh,
+                          const IntegrationRule &ir, Vector &val)
+{
+   const int nq = ir.GetNPoints(), vdim = c.GetVDim();
+   val.SetSize(vdim*nq*mesh.GetNE());
+   Vector V;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         c.Eval(V, T, ir.IntPoint(q));
+         for (int i = 0; i < vdim; i++) { val(i + vdim*(q + nq*e)) = V(i); }
+      }
+   }
+}
+
+static void EvalPointwise(MatrixCoefficient &c, Mesh &mesh,
+                          const IntegrationRule &ir, Vector &val)
+{
+   const int nq = ir.GetNPoints();
+   const int hw = c.GetHeight()*c.GetWidth();
+   val.SetSize(hw*nq*mesh.GetNE());
+   DenseMatrix M;
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&ir.IntPoint(q));
+         c.Eval(M, T, ir.IntPoint(q));
+         for (int i = 0; i < hw; i++) { val(i + hw*(q + nq*e)) = M.Data()[i]; }
+      }
+   }
+}
+
+template <typename Coeff>
+static double EvalAllError(Coeff &c, Mesh &mesh, const IntegrationRule &ir)
+{
+   Vector val_all, val_ref;
+   c.EvalAll(val_all, mesh, ir);
+   EvalPointwise(c, mesh, ir, val_ref);
+   REQUIRE(val_all.Size() == val_ref.Size());
+   val_all.HostRead();
+   val_all -= val_ref;
+   return val_all.Normlinf();
+}
+
+static void TestEvalAll(Mesh &mesh)
+{
+   const int dim = mesh.Dimension();
+   const int sdim = mesh.SpaceDimension();
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 5);
+   const double tol = 1e-12;
+
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      mesh.SetAttribute(e, 1 + e % 3);
+   }
+   mesh.SetAttributes();
+
+   SECTION("Scalar coefficients")
+   {
+      ConstantCoefficient const_coeff(2.5);
+      REQUIRE(EvalAllError(const_coeff, mesh, ir) == 0.0);
+
+      Vector pw(3);
+      pw(0) = 1.0; pw(1) = -2.0; pw(2) = 3.0;
+      PWConstCoefficient pw_coeff(pw);
+      REQUIRE(EvalAllError(pw_coeff, mesh, ir) == 0.0);
+
+      FunctionCoefficient func_coeff(scalar_func);
+      REQUIRE(EvalAllError(func_coeff, mesh, ir) < tol);
+
+      FunctionCoefficient td_func_coeff(td_scalar_func);
+      td_func_coeff.SetTime(0.5);
+      REQUIRE(EvalAllError(td_func_coeff, mesh, ir) < tol);
+
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      GridFunction x(&fes);
+      x.ProjectCoefficient(func_coeff);
+      GridFunctionCoefficient gf_coeff(&x);
+      REQUIRE(EvalAllError(gf_coeff, mesh, ir) < tol);
+
+      FiniteElementSpace vfes(&mesh, &fec, dim);
+      GridFunction vx(&vfes);
+      VectorFunctionCoefficient vfunc_coeff(dim, vector_func);
+      vx.ProjectCoefficient(vfunc_coeff);
+      GridFunctionCoefficient vgf_coeff(&vx, dim);
+      REQUIRE(EvalAllError(vgf_coeff, mesh, ir) < tol);
+
+      SumCoefficient sum_coeff(func_coeff, gf_coeff, 2.0, -0.5);
+      REQUIRE(EvalAllError(sum_coeff, mesh, ir) < tol);
+
+      SumCoefficient sum_const_coeff(1.5, pw_coeff, 2.0, -0.5);
+      REQUIRE(EvalAllError(sum_const_coeff, mesh, ir) < tol);
+
+      ProductCoefficient prod_coeff(func_coeff, pw_coeff);
+      REQUIRE(EvalAllError(prod_coeff, mesh, ir) < tol);
+
+      ProductCoefficient prod_const_coeff(3.0, gf_coeff);
+      REQUIRE(EvalAllError(prod_const_coeff, mesh, ir) < tol);
+   }
+
+   SECTION("Vector coefficients")
+   {
+      Vector v(sdim);
+      for (int d = 0; d < sdim; d++) { v(d) = d + 1.0; }
+      VectorConstantCoefficient const_coeff(v);
+      REQUIRE(EvalAllError(const_coeff, mesh, ir) == 0.0);
+
+      VectorFunctionCoefficient func_coeff(sdim, vector_func);
+      REQUIRE(EvalAllError(func_coeff, mesh, ir) < tol);
+
+      FunctionCoefficient q(scalar_func);
+      VectorFunctionCoefficient func_q_coeff(sdim, vector_func, &q);
+      REQUIRE(EvalAllError(func_q_coeff, mesh, ir) < tol);
+
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace vfes(&mesh, &fec, dim, Ordering::byVDIM);
+      GridFunction vx(&vfes);
+      VectorFunctionCoefficient vfunc_coeff(dim, vector_func);
+      vx.ProjectCoefficient(vfunc_coeff);
+      VectorGridFunctionCoefficient gf_coeff(&vx);
+      REQUIRE(EvalAllError(gf_coeff, mesh, ir) < tol);
+   }
+
+   SECTION("Matrix coefficients")
+   {
+      DenseMatrix m(dim, dim+1);
+      for (int i = 0; i < m.Height()*m.Width(); i++) { m.Data()[i] = i - 2.0; }
+      MatrixConstantCoefficient const_coeff(m);
+      REQUIRE(EvalAllError(const_coeff, mesh, ir) == 0.0);
+
+      MatrixFunctionCoefficient func_coeff(dim, matrix_func);
+      REQUIRE(EvalAllError(func_coeff, mesh, ir) < tol);
+   }
+}
+
+TEST_CASE("Batched coefficient evaluation", "[Coefficient]")
+{
+   SECTION("Quadrilateral mesh")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true, 2.0, 3.0);
+      TestEvalAll(mesh);
+   }
+
+   SECTION("Curved quadrilateral mesh")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true, 2.0, 3.0);
+      mesh.SetCurvature(3);
+      GridFunction &nodes = *mesh.GetNodes();
+      for (int i = 0; i < nodes.Size(); i++)
+      {
+         nodes(i) += 0.05*sin(3.0*nodes(i));
+      }
+      TestEvalAll(mesh);
+   }
+
+   SECTION("Triangular mesh")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true, 2.0, 3.0);
+      mesh.EnsureNodes();
+      TestEvalAll(mesh);
+   }
+
+   SECTION("Hexahedral mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 2.0, 3.0);
+      mesh.EnsureNodes();
+      TestEvalAll(mesh);
+   }
+
+   SECTION("Mixed mesh")
+   {
+      Mesh mesh("../../data/fichera-mixed.mesh");
+      TestEvalAll(mesh);
+   }
+}
+
+TEST_CASE("Batched coefficient evaluation in PA setup", "[Coefficient], [PA]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   GridFunction x(&fes), y_pa(&fes), y_fa(&fes);
+   FunctionCoefficient func_coeff(scalar_func);
+   x.ProjectCoefficient(func_coeff);
+   GridFunctionCoefficient gf_coeff(&x);
+   ProductCoefficient coeff(func_coeff, gf_coeff);
+
+   BilinearForm a_pa(&fes), a_fa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a_pa.AddDomainIntegrator(new MassIntegrator(coeff));
+   a_fa.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a_fa.AddDomainIntegrator(new MassIntegrator(coeff));
+   a_pa.Assemble();
+   a_fa.Assemble();
+   a_fa.Finalize();
+
+   a_pa.Mult(x, y_pa);
+   a_fa.Mult(x, y_fa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1e-10);
+}
+
+} // namespace coefficient
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "mfem.hpp"
+#include "general/text.hpp"
 #include "catch.hpp"
 #include <stdio.h>
 
@@ -227,3 +228,316 @@ TEST_CASE("Save and load from collections", "[DataCollection]")
    }
 
 }
+
+TEST_CASE("Save and load restart collections", "[DataCollection]")
+{
+   Mesh mesh(2, 3, 2, Element::HEXAHEDRON, true, 2.0, 3.0, 1.0);
+   mesh.SetCurvature(2);
+
+   H1_FECollection h1_fec(2, 3);
+   ND_FECollection nd_fec(1, 3);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec, 3);
+   FiniteElementSpace nd_fes(&mesh, &nd_fec);
+   GridFunction u(&h1_fes), e(&nd_fes);
+   for (int i = 0; i < u.Size(); i++) { u(i) = sin(double(i)); }
+   for (int i = 0; i < e.Size(); i++) { e(i) = 1.0/(i+1); }
+
+   QuadratureSpace qspace(&mesh, 3);
+   QuadratureFunction q(&qspace, 2);
+   for (int i = 0; i < q.Size(); i++) { q(i) = cos(double(i)); }
+
+   for (int compress = 0; compress <= 1; compress++)
+   {
+#ifndef MFEM_USE_ZLIB
+      if (compress) { continue; }
+#endif
+      RestartDataCollection dc("restart", &mesh);
+      dc.RegisterField("u", &u);
+      dc.RegisterField("e", &e);
+      dc.RegisterQField("q", &q);
+      dc.SetCycle(7);
+      dc.SetTime(0.1);
+      dc.SetTimeStep(1.0/3.0);
+      dc.SetPadDigits(5);
+      dc.SetCompression(compress);
+      dc.Save();
+      REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+      RestartDataCollection dc_new("restart");
+      dc_new.SetPadDigits(5);
+      dc_new.Load(7);
+      REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+      REQUIRE(dc_new.GetCycle() == 7);
+      REQUIRE(dc_new.GetTime() == dc.GetTime());
+      REQUIRE(dc_new.GetTimeStep() == dc.GetTimeStep());
+
+      Mesh *mesh_new = dc_new.GetMesh();
+      REQUIRE(mesh_new);
+      REQUIRE(mesh_new->GetNE() == mesh.GetNE());
+      REQUIRE(mesh_new->GetNBE() == mesh.GetNBE());
+      Vector nodes_diff(*mesh_new->GetNodes());
+      nodes_diff -= *mesh.GetNodes();
+      REQUIRE(nodes_diff.Normlinf() == 0.0);
+
+      // The data is restored exactly
+      GridFunction *u_new = dc_new.GetField("u");
+      GridFunction *e_new = dc_new.GetField("e");
+      QuadratureFunction *q_new = dc_new.GetQField("q");
+      REQUIRE(u_new);
+      REQUIRE(e_new);
+      REQUIRE(q_new);
+      REQUIRE(u_new->FESpace()->GetOrdering() == h1_fes.GetOrdering());
+      REQUIRE(u_new->FESpace()->GetVDim() == 3);
+      Vector u_diff(*u_new), e_diff(*e_new), q_diff(*q_new);
+      u_diff -= u;
+      e_diff -= e;
+      q_diff -= q;
+      REQUIRE(u_diff.Normlinf() == 0.0);
+      REQUIRE(e_diff.Normlinf() == 0.0);
+      REQUIRE(q_diff.Normlinf() == 0.0);
+
+      REQUIRE(remove("restart_00007/restart.00000") == 0);
+      REQUIRE(rmdir("restart_00007") == 0);
+   }
+}
+
+TEST_CASE("Save and load nonconforming restart collections",
+          "[DataCollection]")
+{
+   Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true, 2.0, 3.0, 1.0);
+   mesh.EnsureNCMesh();
+   mesh.SetCurvature(2);
+   Array<int> refs(2);
+   refs[0] = 0;
+   refs[1] = 5;
+   mesh.GeneralRefinement(refs);
+
+   H1_FECollection fec(2, 3);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   Vector U(fes.GetTrueVSize());
+   U.Randomize(1);
+   u.SetFromTrueDofs(U);
+
+   RestartDataCollection dc("ncrestart", &mesh);
+   dc.RegisterField("u", &u);
+   dc.SetPadDigits(5);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   RestartDataCollection dc_new("ncrestart");
+   dc_new.SetPadDigits(5);
+   dc_new.Load(0);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   Mesh *mesh_new = dc_new.GetMesh();
+   REQUIRE(mesh_new);
+   REQUIRE(mesh_new->Nonconforming());
+   REQUIRE(mesh_new->GetNE() == mesh.GetNE());
+   REQUIRE(mesh_new->GetNV() == mesh.GetNV());
+   REQUIRE(mesh_new->GetNFaces() == mesh.GetNFaces());
+   Vector nodes_diff(*mesh_new->GetNodes());
+   nodes_diff -= *mesh.GetNodes();
+   REQUIRE(nodes_diff.Normlinf() == 0.0);
+
+   // The field and its true dofs are restored exactly, which requires the
+   // hanging node constraints of the restored refinement hierarchy
+   GridFunction *u_new = dc_new.GetField("u");
+   REQUIRE(u_new);
+   const FiniteElementSpace *fes_new = u_new->FESpace();
+   REQUIRE(fes_new->GetTrueVSize() == fes.GetTrueVSize());
+   Vector u_diff(*u_new), U_new(fes_new->GetTrueVSize());
+   u_diff -= u;
+   REQUIRE(u_diff.Normlinf() == 0.0);
+   fes_new->GetRestrictionMatrix()->Mult(*u_new, U_new);
+   U_new -= U;
+   REQUIRE(U_new.Normlinf() == 0.0);
+
+   // Both meshes can be refined further in the same way
+   Array<int> refs2(1);
+   refs2[0] = mesh.GetNE() - 1;
+   mesh.GeneralRefinement(refs2);
+   mesh_new->GeneralRefinement(refs2);
+   REQUIRE(mesh_new->GetNE() == mesh.GetNE());
+   REQUIRE(mesh_new->GetNV() == mesh.GetNV());
+   nodes_diff = *mesh_new->GetNodes();
+   nodes_diff -= *mesh.GetNodes();
+   REQUIRE(nodes_diff.Normlinf() == 0.0);
+
+   REQUIRE(remove("ncrestart_00000/restart.00000") == 0);
+   REQUIRE(rmdir("ncrestart_00000") == 0);
+}
+
+#ifdef MFEM_USE_MPI
+
+// Compare the shared entities of the groups of two parallel meshes
+static void test_same_groups(ParMesh &pm1, ParMesh &pm2)
+{
+   REQUIRE(pm1.GetNGroups() == pm2.GetNGroups());
+   for (int g = 1; g < pm1.GetNGroups(); g++)
+   {
+      const int size = pm1.gtopo.GetGroupSize(g);
+      REQUIRE(pm2.gtopo.GetGroupSize(g) == size);
+      REQUIRE(pm1.gtopo.GetGroupMasterRank(g) ==
+              pm2.gtopo.GetGroupMasterRank(g));
+      for (int j = 0; j < size; j++)
+      {
+         const int p1 = pm1.gtopo.GetGroup(g)[j], p2 = pm2.gtopo.GetGroup(g)[j];
+         REQUIRE(pm1.gtopo.GetNeighborRank(p1) ==
+                 pm2.gtopo.GetNeighborRank(p2));
+      }
+      REQUIRE(pm1.GroupNVertices(g) == pm2.GroupNVertices(g));
+      for (int i = 0; i < pm1.GroupNVertices(g); i++)
+      {
+         REQUIRE(pm1.GroupVertex(g, i) == pm2.GroupVertex(g, i));
+      }
+      REQUIRE(pm1.GroupNEdges(g) == pm2.GroupNEdges(g));
+      for (int i = 0; i < pm1.GroupNEdges(g); i++)
+      {
+         int e1, o1, e2, o2;
+         pm1.GroupEdge(g, i, e1, o1);
+         pm2.GroupEdge(g, i, e2, o2);
+         REQUIRE(e1 == e2);
+         REQUIRE(o1 == o2);
+      }
+      REQUIRE(pm1.GroupNQuadrilaterals(g) == pm2.GroupNQuadrilaterals(g));
+      for (int i = 0; i < pm1.GroupNQuadrilaterals(g); i++)
+      {
+         int f1, o1, f2, o2;
+         pm1.GroupQuadrilateral(g, i, f1, o1);
+         pm2.GroupQuadrilateral(g, i, f2, o2);
+         REQUIRE(f1 == f2);
+         REQUIRE(o1 == o2);
+      }
+   }
+}
+
+TEST_CASE("Save and load parallel restart collections",
+          "[DataCollection], [Parallel]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   Mesh mesh(3, 3, 2, Element::HEXAHEDRON, true, 2.0, 3.0, 1.0);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   pmesh.SetCurvature(2);
+
+   H1_FECollection fec(2, 3);
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   ParGridFunction u(&pfes);
+   Vector U(pfes.GetTrueVSize());
+   U.Randomize(rank + 1);
+   u.SetFromTrueDofs(U);
+
+   RestartDataCollection dc("prestart", &pmesh);
+   dc.RegisterField("u", &u);
+   dc.SetCycle(3);
+   dc.SetPadDigits(5);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   RestartDataCollection dc_new(MPI_COMM_WORLD, "prestart");
+   dc_new.SetPadDigits(5);
+   dc_new.Load(3);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   ParMesh *pmesh_new = dynamic_cast<ParMesh*>(dc_new.GetMesh());
+   REQUIRE(pmesh_new);
+   REQUIRE(pmesh_new->GetNE() == pmesh.GetNE());
+   test_same_groups(pmesh, *pmesh_new);
+
+   // The field has the same true dofs, and the parallel matrices of the
+   // original and the loaded mesh give the same products
+   ParGridFunction *u_new =
+      dynamic_cast<ParGridFunction*>(dc_new.GetField("u"));
+   REQUIRE(u_new);
+   ParFiniteElementSpace *pfes_new = u_new->ParFESpace();
+   REQUIRE(pfes_new->GlobalTrueVSize() == pfes.GlobalTrueVSize());
+   Vector U_new(pfes_new->GetTrueVSize());
+   u_new->GetTrueDofs(U_new);
+   U_new -= U;
+   REQUIRE(U_new.Normlinf() == 0.0);
+
+   ConstantCoefficient one(1.0);
+   ParBilinearForm a(&pfes), a_new(pfes_new);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a_new.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   a_new.Assemble();
+   a.Finalize();
+   a_new.Finalize();
+   HypreParMatrix *A = a.ParallelAssemble();
+   HypreParMatrix *A_new = a_new.ParallelAssemble();
+   Vector Y(U.Size()), Y_new(U.Size());
+   A->Mult(U, Y);
+   A_new->Mult(U, Y_new);
+   Y_new -= Y;
+   REQUIRE(Y_new.Normlinf() <= 1e-12*Y.Normlinf());
+   delete A;
+   delete A_new;
+
+   const std::string file_name =
+      "prestart_00003/restart." + to_padded_string(rank, 5);
+   REQUIRE(remove(file_name.c_str()) == 0);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0) { REQUIRE(rmdir("prestart_00003") == 0); }
+}
+
+TEST_CASE("Save and load nonconforming parallel restart collections",
+          "[DataCollection], [Parallel]")
+{
+   int rank;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   Mesh mesh(3, 3, 2, Element::HEXAHEDRON, true, 2.0, 3.0, 1.0);
+   mesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   Array<int> refs(1);
+   refs[0] = 0;
+   pmesh.GeneralRefinement(refs);
+
+   H1_FECollection fec(2, 3);
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   ParGridFunction u(&pfes);
+   Vector U(pfes.GetTrueVSize());
+   U.Randomize(rank + 1);
+   u.SetFromTrueDofs(U);
+
+   RestartDataCollection dc("pncrestart", &pmesh);
+   dc.RegisterField("u", &u);
+   dc.SetPadDigits(5);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   RestartDataCollection dc_new(MPI_COMM_WORLD, "pncrestart");
+   dc_new.SetPadDigits(5);
+   dc_new.Load(0);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   ParMesh *pmesh_new = dynamic_cast<ParMesh*>(dc_new.GetMesh());
+   REQUIRE(pmesh_new);
+   REQUIRE(pmesh_new->pncmesh);
+   REQUIRE(pmesh_new->GetNE() == pmesh.GetNE());
+   test_same_groups(pmesh, *pmesh_new);
+
+   // The field has the same true dofs, which requires the parallel hanging
+   // node constraints of the restored ParNCMesh
+   ParGridFunction *u_new =
+      dynamic_cast<ParGridFunction*>(dc_new.GetField("u"));
+   REQUIRE(u_new);
+   ParFiniteElementSpace *pfes_new = u_new->ParFESpace();
+   REQUIRE(pfes_new->GlobalTrueVSize() == pfes.GlobalTrueVSize());
+   Vector U_new(pfes_new->GetTrueVSize());
+   u_new->GetTrueDofs(U_new);
+   U_new -= U;
+   REQUIRE(U_new.Normlinf() == 0.0);
+
+   // Both meshes can be refined further in the same way
+   pmesh.GeneralRefinement(refs);
+   pmesh_new->GeneralRefinement(refs);
+   REQUIRE(pmesh_new->GetGlobalNE() == pmesh.GetGlobalNE());
+   REQUIRE(pmesh_new->GetNE() == pmesh.GetNE());
+
+   const std::string file_name =
+      "pncrestart_00000/restart." + to_padded_string(rank, 5);
+   REQUIRE(remove(file_name.c_str()) == 0);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0) { REQUIRE(rmdir("pncrestart_00000") == 0); }
+}
+
+#endif // MFEM_USE_MPI
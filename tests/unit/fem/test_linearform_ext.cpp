@@ -0,0 +1,186 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace linearform_ext
+{
+
+static double f_scalar(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += (d+1) * sin(M_PI*x(d)); }
+   return s;
+}
+
+static void f_vector(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = f_scalar(x) + d*x(0); }
+}
+
+static void perturb(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05 * sin(M_PI * x(1));
+   y(1) += 0.05 * x(0) * x(0);
+}
+
+enum Problem { Domain, VectorDomain, Boundary, VectorBoundary };
+
+static void AddIntegrators(LinearForm &lf, const Problem pb,
+                           Coefficient &q, VectorCoefficient &vq,
+                           Array<int> &bdr_marker)
+{
+   switch (pb)
+   {
+      case Domain:
+         lf.AddDomainIntegrator(new DomainLFIntegrator(q));
+         break;
+      case VectorDomain:
+         lf.AddDomainIntegrator(new VectorDomainLFIntegrator(vq));
+         break;
+      case Boundary:
+         lf.AddDomainIntegrator(new DomainLFIntegrator(q));
+         lf.AddBoundaryIntegrator(new BoundaryLFIntegrator(q));
+         lf.AddBoundaryIntegrator(new BoundaryLFIntegrator(q, 2, 0),
+                                  bdr_marker);
+         break;
+      case VectorBoundary:
+         lf.AddBoundaryIntegrator(new VectorBoundaryLFIntegrator(vq),
+                                  bdr_marker);
+         break;
+   }
+}
+
+// Compare the fast and the legacy assembly of the problem 'pb'. With
+// 'pw_coeff', the coefficients are piecewise constant in the boundary
+// attributes instead of smooth functions of the coordinates.
+static void test_linearform_ext(Mesh &mesh, const int order, const Problem pb,
+                                const bool supported,
+                                const bool pw_coeff = false)
+{
+   const int dim = mesh.Dimension();
+   const bool vector = (pb == VectorDomain || pb == VectorBoundary);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vector ? dim : 1);
+
+   const int nattr = mesh.bdr_attributes.Max();
+   FunctionCoefficient f_q(f_scalar);
+   VectorFunctionCoefficient f_vq(dim, f_vector);
+   Vector attr_values(nattr);
+   for (int i = 0; i < nattr; i++) { attr_values(i) = i + 1.0; }
+   PWConstCoefficient pw_q(attr_values);
+   VectorArrayCoefficient pw_vq(dim);
+   for (int d = 0; d < dim; d++)
+   {
+      Vector values(attr_values);
+      values += d;
+      pw_vq.Set(d, new PWConstCoefficient(values));
+   }
+   Coefficient &q = pw_coeff ? static_cast<Coefficient&>(pw_q) : f_q;
+   VectorCoefficient &vq =
+      pw_coeff ? static_cast<VectorCoefficient&>(pw_vq) : f_vq;
+   Array<int> bdr_marker(nattr);
+   bdr_marker = 0;
+   bdr_marker[0] = 1;
+   bdr_marker[2] = 1;
+
+   LinearForm lf_ref(&fes), lf_fa(&fes);
+   AddIntegrators(lf_ref, pb, q, vq, bdr_marker);
+   AddIntegrators(lf_fa, pb, q, vq, bdr_marker);
+   lf_fa.UseFastAssembly(true);
+   REQUIRE(lf_fa.SupportsDevice() == supported);
+
+   lf_ref.Assemble();
+   lf_fa.Assemble();
+
+   lf_fa -= lf_ref;
+   REQUIRE(lf_ref.Normlinf() > 0.0);
+   REQUIRE(lf_fa.Normlinf() < 1.e-12 * lf_ref.Normlinf());
+}
+
+TEST_CASE("LinearForm fast assembly", "[LinearForm], [PartialAssembly]")
+{
+   const Problem problems[] = { Domain, VectorDomain, Boundary, VectorBoundary };
+
+   SECTION("2D quadrilaterals")
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (Problem pb : problems)
+         {
+            Mesh mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+            mesh.SetCurvature(2);
+            mesh.Transform(perturb);
+            test_linearform_ext(mesh, order, pb, true);
+         }
+      }
+   }
+
+   SECTION("3D hexahedra")
+   {
+      for (int order = 1; order <= 2; order++)
+      {
+         for (Problem pb : problems)
+         {
+            Mesh mesh(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+            mesh.SetCurvature(2);
+            mesh.Transform(perturb);
+            test_linearform_ext(mesh, order, pb, true);
+         }
+      }
+   }
+
+   SECTION("Piecewise constant boundary coefficients")
+   {
+      for (Problem pb : { Boundary, VectorBoundary })
+      {
+         Mesh mesh2d(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+         test_linearform_ext(mesh2d, 2, pb, true, true);
+         Mesh mesh3d(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+         test_linearform_ext(mesh3d, 2, pb, true, true);
+      }
+   }
+
+   SECTION("Simplices")
+   {
+      for (int order = 1; order <= 2; order++)
+      {
+         for (Problem pb : problems)
+         {
+            // Boundary integrators fall back to the legacy assembly
+            const bool bdr = (pb == Boundary || pb == VectorBoundary);
+            Mesh mesh2d(3, 4, Element::TRIANGLE, true, 1.0, 1.0);
+            test_linearform_ext(mesh2d, order, pb, !bdr);
+            Mesh mesh3d(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+            test_linearform_ext(mesh3d, order, pb, !bdr);
+         }
+      }
+   }
+
+   SECTION("Scalar integrators in vector spaces")
+   {
+      // These fall back to the legacy assembly instead of aborting
+      Mesh mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec, 2);
+      ConstantCoefficient one(1.0);
+      LinearForm lf(&fes);
+      lf.AddDomainIntegrator(new DomainLFIntegrator(one));
+      lf.UseFastAssembly(true);
+      REQUIRE(!lf.SupportsDevice());
+   }
+}
+
+} // namespace linearform_ext
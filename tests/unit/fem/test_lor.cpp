@@ -0,0 +1,275 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace lor
+{
+
+static double f_scalar(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += (d+1) * sin(M_PI*x(d)); }
+   return s;
+}
+
+static void f_vector(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = f_scalar(x) + d*x(0); }
+}
+
+static void f_const(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = d + 1.0; }
+}
+
+static Mesh *make_mesh(int dim)
+{
+   return (dim == 2) ?
+          new Mesh(3, 2, Element::QUADRILATERAL, true, 1.0, 1.0) :
+          new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+}
+
+TEST_CASE("LOR DOF permutation", "[LOR]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      for (int order = 2; order <= 3; order++)
+      {
+         SECTION("H1, dim = " + std::to_string(dim) +
+                 ", order = " + std::to_string(order))
+         {
+            // The H1 DOFs are the values at the refined vertices
+            for (int vdim = 1; vdim <= 2; vdim++)
+            {
+               H1_FECollection fec(order, dim);
+               FiniteElementSpace fes(mesh, &fec, vdim, Ordering::byVDIM);
+               BilinearForm a(&fes);
+               a.AddDomainIntegrator(new MassIntegrator);
+               Array<int> ess_tdof_list;
+               LORDiscretization lor(a, ess_tdof_list);
+               REQUIRE(lor.GetFESpace().GetTrueVSize() == fes.GetTrueVSize());
+
+               GridFunction x(&fes), x_lor(&lor.GetFESpace());
+               FunctionCoefficient f(f_scalar);
+               VectorFunctionCoefficient vf(vdim, f_vector);
+               if (vdim == 1)
+               {
+                  x.ProjectCoefficient(f);
+                  x_lor.ProjectCoefficient(f);
+               }
+               else
+               {
+                  x.ProjectCoefficient(vf);
+                  x_lor.ProjectCoefficient(vf);
+               }
+               Vector y_lor, y;
+               lor.PermuteToLOR(x, y_lor);
+               y_lor -= x_lor;
+               REQUIRE(y_lor.Normlinf() < 1e-12);
+               lor.PermuteFromLOR(x_lor, y);
+               y -= x;
+               REQUIRE(y.Normlinf() < 1e-12);
+            }
+         }
+
+         SECTION("ND and RT, dim = " + std::to_string(dim) +
+                 ", order = " + std::to_string(order))
+         {
+            // The ND and RT DOFs of a constant field differ by the (positive)
+            // size of the refined edges or faces
+            for (int k = 0; k < 2; k++)
+            {
+               FiniteElementCollection *fec =
+                  (k == 0) ? (FiniteElementCollection*)
+                  new ND_FECollection(order, dim) :
+                  new RT_FECollection(order-1, dim);
+               FiniteElementSpace fes(mesh, fec);
+               BilinearForm a(&fes);
+               a.AddDomainIntegrator(new VectorFEMassIntegrator);
+               Array<int> ess_tdof_list;
+               LORDiscretization lor(a, ess_tdof_list);
+
+               GridFunction x(&fes), x_lor(&lor.GetFESpace());
+               VectorFunctionCoefficient f(dim, f_const);
+               x.ProjectCoefficient(f);
+               x_lor.ProjectCoefficient(f);
+               Vector y_lor;
+               lor.PermuteToLOR(x, y_lor);
+               for (int i = 0; i < y_lor.Size(); i++)
+               {
+                  REQUIRE(std::abs(y_lor(i)) > 1e-12);
+                  REQUIRE(y_lor(i)*x_lor(i) > 0.0);
+               }
+               delete fec;
+            }
+         }
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("LOR preconditioner", "[LOR]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      mesh->UniformRefinement();
+      const int order = (dim == 2) ? 4 : 3;
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      Array<int> ess_tdof_list, ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient one(1.0);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      LinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+      GridFunction x(&fes);
+      x = 0.0;
+
+      // FormLinearSystem() may modify the right-hand side
+      Vector b_copy(b);
+      OperatorHandle A;
+      Vector B, X;
+      a.FormLinearSystem(ess_tdof_list, x, b_copy, A, X, B);
+
+      // Solve the LOR system (almost) exactly, the number of iterations of
+      // the preconditioned high-order solver is bounded independently of the
+      // mesh size.
+      LORSolver<CGSolver> lor(a, ess_tdof_list);
+      lor.GetSolver().SetRelTol(1e-14);
+      lor.GetSolver().SetMaxIter(1000);
+
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(100);
+      cg.SetOperator(*A);
+      cg.SetPreconditioner(lor);
+      cg.Mult(B, X);
+      REQUIRE(cg.GetConverged());
+      REQUIRE(cg.GetNumIterations() < 30);
+
+      // Compare with the legacy assembly solution
+      const Vector X_pa(X);
+      BilinearForm a_fa(&fes);
+      a_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a_fa.Assemble();
+      OperatorHandle A_fa;
+      Vector B_fa, X_fa;
+      x = 0.0;
+      a_fa.FormLinearSystem(ess_tdof_list, x, b, A_fa, X_fa, B_fa);
+      Vector R(B_fa);
+      A_fa->Mult(X_pa, R);
+      R -= B_fa;
+      REQUIRE(R.Normlinf() < 1e-8*B_fa.Normlinf());
+      delete mesh;
+   }
+}
+
+TEST_CASE("LOR face integrators", "[LOR]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      const int order = 3;
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      Array<int> bdr_marker(mesh->bdr_attributes.Max());
+      bdr_marker = 0;
+      bdr_marker[0] = 1;
+
+      // Nitsche boundary terms on a part of the boundary and interior
+      // penalty terms, which vanish for continuous functions
+      ConstantCoefficient one(1.0);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(one, -1.0, 2.0));
+      a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(one, -1.0, 2.0),
+                             bdr_marker);
+      Array<int> ess_tdof_list;
+      LORDiscretization lor(a, ess_tdof_list);
+
+      BilinearForm a_lor(&lor.GetFESpace());
+      a_lor.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a_lor.AddInteriorFaceIntegrator(
+         new DGDiffusionIntegrator(one, -1.0, 2.0));
+      a_lor.AddBdrFaceIntegrator(new DGDiffusionIntegrator(one, -1.0, 2.0),
+                                 bdr_marker);
+      a_lor.Assemble();
+      a_lor.Finalize();
+
+      SparseMatrix *D = Add(1.0, lor.GetAssembledMatrix(),
+                            -1.0, a_lor.SpMat());
+      REQUIRE(D->MaxNorm() < 1e-12 * a_lor.SpMat().MaxNorm());
+      delete D;
+      delete mesh;
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel LOR preconditioner", "[LOR], [Parallel]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = make_mesh(dim);
+      mesh->UniformRefinement();
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+      const int order = 3;
+      H1_FECollection fec(order, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      Array<int> ess_tdof_list, ess_bdr(pmesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient one(1.0);
+      ParBilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      ParLinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+      ParGridFunction x(&fes);
+      x = 0.0;
+
+      OperatorHandle A;
+      Vector B, X;
+      a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+      LORSolver<HypreBoomerAMG> lor(a, ess_tdof_list);
+      lor.GetSolver().SetPrintLevel(0);
+
+      CGSolver cg(MPI_COMM_WORLD);
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(100);
+      cg.SetOperator(*A);
+      cg.SetPreconditioner(lor);
+      cg.Mult(B, X);
+      REQUIRE(cg.GetConverged());
+      REQUIRE(cg.GetNumIterations() < 50);
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace lor
@@ -0,0 +1,120 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace mf_kernels
+{
+
+static double coeff_function(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+static void perturb_function(const Vector &x, Vector &p)
+{
+   p = x;
+   p(0) += 0.05*sin(M_PI*x(1));
+   p(1) += 0.05*sin(M_PI*x(0));
+}
+
+enum class Integ { MASS, DIFFUSION };
+
+static void AddIntegrator(BilinearForm &a, Integ integ, Coefficient &coeff)
+{
+   if (integ == Integ::MASS)
+   {
+      a.AddDomainIntegrator(new MassIntegrator(coeff));
+   }
+   else
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   }
+}
+
+static void test_mf(int dim, int order, int geom_order, Integ integ)
+{
+   Mesh *mesh;
+   if (dim == 2)
+   {
+      mesh = new Mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0);
+   }
+   else
+   {
+      mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   }
+   // geom_order == 0 keeps a mesh with vertices only
+   if (geom_order > 0) { mesh->SetCurvature(geom_order); }
+   mesh->Transform(perturb_function);
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+
+   FunctionCoefficient coeff(coeff_function);
+
+   BilinearForm a_fa(&fes), a_mf(&fes);
+   AddIntegrator(a_fa, integ, coeff);
+   AddIntegrator(a_mf, integ, coeff);
+
+   a_fa.Assemble();
+   a_fa.Finalize();
+
+   a_mf.SetAssemblyLevel(AssemblyLevel::NONE);
+   a_mf.Assemble();
+   // The setup must not add nodes to the mesh
+   if (geom_order == 0) { REQUIRE(mesh->GetNodes() == NULL); }
+
+   GridFunction x(&fes), y_fa(&fes), y_mf(&fes);
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+   a_mf.Mult(x, y_mf);
+   y_mf -= y_fa;
+   REQUIRE(y_mf.Normlinf() < 1.e-12);
+
+   Vector diag_fa(fes.GetVSize()), diag_mf(fes.GetVSize());
+   a_fa.SpMat().GetDiag(diag_fa);
+   a_mf.AssembleDiagonal(diag_mf);
+   diag_mf -= diag_fa;
+   REQUIRE(diag_mf.Normlinf() < 1.e-12);
+
+   delete mesh;
+}
+
+TEST_CASE("MF Mass", "[MatrixFree]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 4; order++)
+      {
+         test_mf(dim, order, 0, Integ::MASS);
+         test_mf(dim, order, 1, Integ::MASS);
+         test_mf(dim, order, 2, Integ::MASS);
+      }
+   }
+}
+
+TEST_CASE("MF Diffusion", "[MatrixFree]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 4; order++)
+      {
+         test_mf(dim, order, 0, Integ::DIFFUSION);
+         test_mf(dim, order, 1, Integ::DIFFUSION);
+         test_mf(dim, order, 2, Integ::DIFFUSION);
+      }
+   }
+}
+
+} // namespace mf_kernels
@@ -148,4 +148,59 @@ TEST_CASE("operatorjacobifichera")
    }
 }
 
+TEST_CASE("operatorjacobismoother from operator diagonal")
+{
+   for (int dimension = 2; dimension < 4; ++dimension)
+   {
+      Mesh *mesh = (dimension == 2) ?
+                   new Mesh(2, 2, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+      H1_FECollection h1_fec(2, dimension);
+      FiniteElementSpace h1_fespace(mesh, &h1_fec);
+      Array<int> ess_tdof_list;
+      Array<int> ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      h1_fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient one(1.0);
+      GridFunction x(&h1_fespace), b(&h1_fespace);
+      x = 0.0;
+      b = 1.0;
+
+      BilinearForm faform(&h1_fespace);
+      faform.AddDomainIntegrator(new DiffusionIntegrator(one));
+      faform.SetDiagonalPolicy(Matrix::DIAG_ONE);
+      faform.Assemble();
+      faform.Finalize();
+      OperatorPtr A_fa;
+      Vector B, X;
+      faform.FormLinearSystem(ess_tdof_list, x, b, A_fa, X, B);
+      DSmoother fa_smoother((SparseMatrix&)(*A_fa));
+
+      // The diagonal of the constrained partially assembled operator is
+      // obtained through Operator::AssembleDiagonal() in SetOperator().
+      BilinearForm paform(&h1_fespace);
+      paform.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      paform.AddDomainIntegrator(new DiffusionIntegrator(one));
+      paform.Assemble();
+      OperatorPtr A_pa;
+      paform.FormSystemMatrix(ess_tdof_list, A_pa);
+      OperatorJacobiSmoother pa_smoother;
+      pa_smoother.SetOperator(*A_pa);
+
+      Vector xin(h1_fespace.GetTrueVSize());
+      xin.Randomize();
+      Vector y_fa(xin), y_pa(xin);
+      y_fa = 0.0;
+      y_pa = 0.0;
+      fa_smoother.Mult(xin, y_fa);
+      pa_smoother.Mult(xin, y_pa);
+
+      y_fa -= y_pa;
+      REQUIRE(y_fa.Norml2() < 1.e-12);
+
+      delete mesh;
+   }
+}
+
 } // namespace operatorjacobismoother
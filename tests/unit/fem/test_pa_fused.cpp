@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "unit_test_problems.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+using namespace unit_test_problems;
+
+namespace pa_fused
+{
+
+static void AddIntegrators(BilinearForm &a, bool mass, bool diff, bool conv,
+                           Coefficient &q, VectorCoefficient &vel,
+                           const IntegrationRule &ir)
+{
+   BilinearFormIntegrator *integ;
+   if (mass)
+   {
+      integ = new MassIntegrator(q);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+   }
+   if (diff)
+   {
+      integ = new DiffusionIntegrator(q);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+   }
+   if (conv)
+   {
+      integ = new ConvectionIntegrator(vel);
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+   }
+}
+
+// Compare the action, and the transposed action without convection, of the
+// partially assembled form with and without fusion of the integrators with the
+// ones of the fully assembled form.
+static void TestFused(Mesh &mesh, int order, bool mass, bool diff, bool conv)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient q(coeff);
+   VectorFunctionCoefficient vel(dim, smooth_velocity);
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*order + 1);
+
+   BilinearForm a_fa(&fes), a_pa(&fes), a_fused(&fes);
+   AddIntegrators(a_fa, mass, diff, conv, q, vel, ir);
+   AddIntegrators(a_pa, mass, diff, conv, q, vel, ir);
+   AddIntegrators(a_fused, mass, diff, conv, q, vel, ir);
+   a_fa.Assemble();
+   a_fa.Finalize();
+
+   // The extensions are used directly to check that all the integrators are
+   // fused, and for their transposed action
+   PABilinearFormExtension pa_ext(&a_pa), fused_ext(&a_fused);
+   pa_ext.Assemble();
+   fused_ext.SetIntegratorFusion(true);
+   fused_ext.Assemble();
+   REQUIRE(pa_ext.GetFusedIntegrators().Size() == 0);
+   REQUIRE(fused_ext.GetFusedIntegrators().Size() == mass + diff + conv);
+   REQUIRE(fused_ext.GetFusedIntegrators().IsSymmetric() == !conv);
+
+   const int n = fes.GetVSize();
+   Vector x(n), y_fa(n), y_pa(n), y_fused(n);
+   x.Randomize(1);
+   // ConvectionIntegrator has no partially assembled transpose
+   for (int transpose = 0; transpose <= !conv; transpose++)
+   {
+      if (transpose)
+      {
+         a_fa.MultTranspose(x, y_fa);
+         pa_ext.MultTranspose(x, y_pa);
+         fused_ext.MultTranspose(x, y_fused);
+      }
+      else
+      {
+         a_fa.Mult(x, y_fa);
+         pa_ext.Mult(x, y_pa);
+         fused_ext.Mult(x, y_fused);
+      }
+      y_pa -= y_fused;
+      REQUIRE(y_pa.Normlinf() <= 1e-12 * y_fa.Normlinf());
+      y_fused -= y_fa;
+      REQUIRE(y_fused.Normlinf() <= 1e-12 * y_fa.Normlinf());
+   }
+}
+
+static void TestAllCombinations(Mesh &mesh, int order)
+{
+   TestFused(mesh, order, true, true, false);
+   TestFused(mesh, order, true, false, true);
+   TestFused(mesh, order, false, true, true);
+   TestFused(mesh, order, true, true, true);
+}
+
+TEST_CASE("PA Fused Integrators", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 4; order++)
+   {
+      Mesh quad(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+      quad.EnsureNodes();
+      GridFunction *nodes = quad.GetNodes();
+      for (int i = 0; i < nodes->Size(); i++)
+      {
+         (*nodes)(i) += 0.01*sin(5.0*i);
+      }
+      TestAllCombinations(quad, order);
+
+      Mesh hex(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      TestAllCombinations(hex, order);
+   }
+}
+
+} // namespace pa_fused
@@ -0,0 +1,108 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+#ifdef MFEM_USE_JIT
+
+namespace pa_jit
+{
+
+static const char *jit_axpy = R"_(
+extern "C" void mfem_jit_kernel(const int n, const double *x, double *y)
+{
+   for (int i = 0; i < n; i++) { y[i] += MFEM_JIT_A * x[i]; }
+}
+)_";
+
+TEST_CASE("Jit Lookup", "[PartialAssembly], [JIT]")
+{
+   REQUIRE(Jit::Enabled());
+   void *ptr = Jit::Lookup("test_axpy", jit_axpy, "-DMFEM_JIT_A=3.0");
+   REQUIRE(ptr != NULL);
+   // The second lookup is served from the in-memory cache
+   REQUIRE(Jit::Lookup("test_axpy", jit_axpy, "-DMFEM_JIT_A=3.0") == ptr);
+
+   void (*axpy)(const int, const double*, double*);
+   *reinterpret_cast<void**>(&axpy) = ptr;
+   double x[3] = {1.0, 2.0, 3.0}, y[3] = {1.0, 1.0, 1.0};
+   axpy(3, x, y);
+   REQUIRE(y[0] == 4.0);
+   REQUIRE(y[2] == 10.0);
+}
+
+static double jit_coeff(const Vector &x) { return 1.0 + x(0)*x(1); }
+
+// Compare the action and the diagonal of the runtime compiled kernels with the
+// generic kernels, for (D1D,Q1D) combinations without an instantiation.
+static void CompareJit(const int dim, const int order, const int q1d,
+                       const bool diffusion)
+{
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->EnsureNodes();
+   GridFunction *nodes = mesh->GetNodes();
+   for (int i = 0; i < nodes->Size(); i++)
+   {
+      (*nodes)(i) += 0.02*sin(7.0*i);
+   }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   const IntegrationRule &ir = IntRules.Get(geom, 2*q1d - 1);
+
+   FunctionCoefficient coeff(jit_coeff);
+   Vector x(fes.GetVSize()), y[2], diag[2];
+   x.Randomize(1);
+   for (int jit = 0; jit < 2; jit++)
+   {
+      Jit::Enable(jit == 1);
+      BilinearForm a(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      BilinearFormIntegrator *integ =
+         diffusion ? static_cast<BilinearFormIntegrator*>(
+            new DiffusionIntegrator(coeff)) :
+         static_cast<BilinearFormIntegrator*>(new MassIntegrator(coeff));
+      integ->SetIntRule(&ir);
+      a.AddDomainIntegrator(integ);
+      a.Assemble();
+      y[jit].SetSize(fes.GetVSize());
+      a.Mult(x, y[jit]);
+      diag[jit].SetSize(fes.GetVSize());
+      a.AssembleDiagonal(diag[jit]);
+   }
+   Jit::Enable();
+
+   y[1] -= y[0];
+   diag[1] -= diag[0];
+   REQUIRE(y[1].Normlinf() <= 1e-12 * y[0].Normlinf());
+   REQUIRE(diag[1].Normlinf() <= 1e-12 * diag[0].Normlinf());
+   delete mesh;
+}
+
+TEST_CASE("PA JIT kernels", "[PartialAssembly], [JIT]")
+{
+   for (int diffusion = 0; diffusion < 2; diffusion++)
+   {
+      CompareJit(2, 3, 7, diffusion);
+      CompareJit(2, 1, 5, diffusion);
+      CompareJit(3, 2, 5, diffusion);
+      CompareJit(3, 1, 5, diffusion);
+   }
+}
+
+} // namespace pa_jit
+
+#endif // MFEM_USE_JIT
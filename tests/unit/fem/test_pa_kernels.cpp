@@ -288,6 +288,189 @@ TEST_CASE("Nonlinear Convection", "[PartialAssembly], [NonlinearPA]")
    }
 }
 
+void identity_field(const Vector &x, Vector &u)
+{
+   u = x;
+}
+
+// Compare the partially assembled residual and gradient action of a
+// hyperelastic form with their fully assembled counterparts, at a perturbed
+// state and with essential boundary conditions.
+double test_nl_hyperelastic_nd(int dim, HyperelasticModel &model)
+{
+   Mesh *mesh =
+      (dim == 2) ?
+      new Mesh(3, 3, Element::QUADRILATERAL, 0, 1.0, 1.0):
+      new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 1.0);
+
+   int order = 2;
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+
+   GridFunction x(&fes), dx(&fes), v(&fes);
+   VectorFunctionCoefficient identity(dim, identity_field);
+   x.ProjectCoefficient(identity);
+   dx.Randomize(5);
+   x.Add(0.05, dx);
+   v.Randomize(7);
+
+   NonlinearForm nlf_fa(&fes);
+   nlf_fa.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+   nlf_fa.SetEssentialBC(ess_bdr);
+
+   NonlinearForm nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(&model));
+   nlf_pa.SetEssentialBC(ess_bdr);
+   nlf_pa.Setup();
+
+   Vector y_fa(fes.GetTrueVSize()), y_pa(fes.GetTrueVSize());
+   nlf_fa.Mult(x, y_fa);
+   nlf_pa.Mult(x, y_pa);
+   y_fa -= y_pa;
+   double difference = y_fa.Normlinf();
+
+   Operator &grad_fa = nlf_fa.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_fa -= y_pa;
+   difference = std::max(difference, y_fa.Normlinf());
+
+   grad_fa.AssembleDiagonal(y_fa);
+   grad_pa.AssembleDiagonal(y_pa);
+   y_fa -= y_pa;
+   difference = std::max(difference, y_fa.Normlinf());
+
+   delete mesh;
+
+   return difference;
+}
+
+TEST_CASE("Nonlinear Hyperelasticity", "[PartialAssembly], [NonlinearPA]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      NeoHookeanModel neo_hookean(0.25, 5.0);
+      REQUIRE(test_nl_hyperelastic_nd(dim, neo_hookean) < 1e-12);
+
+      ConstantCoefficient mu(0.5), K(2.0);
+      NeoHookeanModel neo_hookean_coeff(mu, K);
+      REQUIRE(test_nl_hyperelastic_nd(dim, neo_hookean_coeff) < 1e-12);
+
+      InverseHarmonicModel inverse_harmonic;
+      REQUIRE(test_nl_hyperelastic_nd(dim, inverse_harmonic) < 1e-12);
+   }
+}
+
+// Same comparison as above for the TMOP integrator on a perturbed mesh, which
+// includes the diagonal of the gradient.
+double test_nl_tmop_nd(int dim, TMOP_QualityMetric &metric,
+                       TargetConstructor::TargetType ttype, bool use_coeff)
+{
+   Mesh *mesh =
+      (dim == 2) ?
+      new Mesh(3, 3, Element::QUADRILATERAL, 0, 1.0, 1.0):
+      new Mesh(2, 2, 2, Element::HEXAHEDRON, 0, 1.0, 1.0, 1.0);
+
+   int order = 2;
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec, dim);
+
+   Array<int> ess_bdr(mesh->bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+
+   // As in the mesh optimization miniapps, the target constructor expects
+   // the mesh nodes to be in the space of the positions.
+   mesh->SetNodalFESpace(&fes);
+   GridFunction x0(&fes), x(&fes), dx(&fes), v(&fes);
+   x0 = *mesh->GetNodes();
+   dx.Randomize(5);
+   x = x0;
+   x.Add(0.05, dx);
+   v.Randomize(7);
+
+   TargetConstructor tc(ttype);
+   tc.SetNodes(x0);
+   ConstantCoefficient coeff(2.5);
+
+   TMOP_Integrator *ti_fa = new TMOP_Integrator(&metric, &tc);
+   TMOP_Integrator *ti_pa = new TMOP_Integrator(&metric, &tc);
+   if (use_coeff)
+   {
+      ti_fa->SetCoefficient(coeff);
+      ti_pa->SetCoefficient(coeff);
+   }
+
+   NonlinearForm nlf_fa(&fes);
+   nlf_fa.AddDomainIntegrator(ti_fa);
+   nlf_fa.SetEssentialBC(ess_bdr);
+
+   NonlinearForm nlf_pa(&fes);
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.AddDomainIntegrator(ti_pa);
+   nlf_pa.SetEssentialBC(ess_bdr);
+   nlf_pa.Setup();
+
+   Vector y_fa(fes.GetTrueVSize()), y_pa(fes.GetTrueVSize());
+   nlf_fa.Mult(x, y_fa);
+   nlf_pa.Mult(x, y_pa);
+   y_fa -= y_pa;
+   double difference = y_fa.Normlinf();
+
+   Operator &grad_fa = nlf_fa.GetGradient(x);
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_fa -= y_pa;
+   difference = std::max(difference, y_fa.Normlinf());
+
+   grad_fa.AssembleDiagonal(y_fa);
+   grad_pa.AssembleDiagonal(y_pa);
+   y_fa -= y_pa;
+   difference = std::max(difference, y_fa.Normlinf());
+
+   delete mesh;
+
+   return difference;
+}
+
+TEST_CASE("Nonlinear TMOP", "[PartialAssembly], [NonlinearPA]")
+{
+   const TargetConstructor::TargetType unit_size =
+      TargetConstructor::IDEAL_SHAPE_UNIT_SIZE;
+   const TargetConstructor::TargetType equal_size =
+      TargetConstructor::IDEAL_SHAPE_EQUAL_SIZE;
+
+   SECTION("2D")
+   {
+      TMOP_Metric_001 metric_001;
+      TMOP_Metric_002 metric_002;
+      TMOP_Metric_007 metric_007; // evaluated on the host
+      REQUIRE(test_nl_tmop_nd(2, metric_001, unit_size, false) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(2, metric_002, equal_size, false) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(2, metric_002, unit_size, true) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(2, metric_007, equal_size, false) < 1e-12);
+   }
+
+   SECTION("3D")
+   {
+      TMOP_Metric_302 metric_302;
+      TMOP_Metric_303 metric_303;
+      TMOP_Metric_321 metric_321;
+      TMOP_Metric_301 metric_301; // evaluated on the host
+      REQUIRE(test_nl_tmop_nd(3, metric_302, unit_size, false) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(3, metric_303, equal_size, true) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(3, metric_321, unit_size, false) < 1e-12);
+      REQUIRE(test_nl_tmop_nd(3, metric_301, equal_size, false) < 1e-12);
+   }
+}
+
 template <typename INTEGRATOR>
 double test_vector_pa_integrator(int dim)
 {
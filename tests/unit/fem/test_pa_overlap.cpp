@@ -0,0 +1,235 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "unit_test_problems.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+using namespace unit_test_problems;
+
+namespace pa_overlap
+{
+
+TEST_CASE("ElementRestriction subsets", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int vdim = 1; vdim <= 2; vdim++)
+      {
+         Mesh *mesh = (dim == 2) ?
+                      new Mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                      new Mesh(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+         H1_FECollection fec(2, dim);
+         FiniteElementSpace fes(mesh, &fec, vdim, Ordering::byVDIM);
+         const ElementRestriction *R = dynamic_cast<const ElementRestriction*>(
+            fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC));
+         REQUIRE(R != NULL);
+
+         // The union of the element and dof subsets gives the full operator
+         const int ne = fes.GetNE();
+         Array<int> dofs[2];
+         for (int i = 0; i < fes.GetNDofs(); i++) { dofs[i % 2].Append(i); }
+
+         Vector x(fes.GetVSize()), y(fes.GetVSize()), y_sub(fes.GetVSize());
+         Vector ex(R->Height()), ex_sub(R->Height());
+         x.Randomize(1);
+         R->Mult(x, ex);
+         ex_sub = 0.0;
+         R->MultElements(x, ex_sub, 0, ne/3);
+         R->MultElements(x, ex_sub, ne/3, ne);
+         ex_sub -= ex;
+         REQUIRE(ex_sub.Normlinf() == 0.0);
+
+         // With an element order, E-vector element e is mesh element order[e]
+         Array<int> order(ne);
+         for (int e = 0; e < ne; e++) { order[e] = (5*e + 2) % ne; }
+         ElementRestriction R_order(fes, ElementDofOrdering::LEXICOGRAPHIC,
+                                    &order);
+         R_order.Mult(x, ex_sub);
+         const int esize = R->Height()/ne;
+         for (int e = 0; e < ne; e++)
+         {
+            for (int i = 0; i < esize; i++)
+            {
+               REQUIRE(ex_sub(e*esize + i) == ex(order[e]*esize + i));
+            }
+         }
+         ex_sub.Randomize(3);
+         ex = ex_sub;
+         BilinearFormIntegrator::ReorderElementData(ex, order);
+         R->MultTranspose(ex_sub, y);
+         R_order.MultTranspose(ex, y_sub);
+         y_sub -= y;
+         REQUIRE(y_sub.Normlinf() <= 1e-14*y.Normlinf());
+
+         ex.Randomize(2);
+         R->MultTranspose(ex, y);
+         y_sub = 0.0;
+         R->MultTransposeDofs(ex, y_sub, dofs[0]);
+         R->MultTransposeDofs(ex, y_sub, dofs[1]);
+         y_sub -= y;
+         REQUIRE(y_sub.Normlinf() == 0.0);
+         delete mesh;
+      }
+   }
+}
+
+TEST_CASE("PA element ranges", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 4, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(2, 3, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      const Operator *R =
+         fes.GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+      FunctionCoefficient q(coeff);
+      VectorFunctionCoefficient vel(dim, smooth_velocity);
+      const IntegrationRule &ir =
+         IntRules.Get(mesh->GetElementBaseGeometry(0), 5);
+
+      MassIntegrator mass(q);
+      DiffusionIntegrator diff(q);
+      ConvectionIntegrator conv(vel);
+      BilinearFormIntegrator *integs[3] = { &mass, &diff, &conv };
+      PAFusedIntegrators fused;
+      for (BilinearFormIntegrator *integ : integs)
+      {
+         integ->SetIntRule(&ir);
+         integ->AssemblePA(fes);
+         REQUIRE(integ->SupportsPARange());
+         REQUIRE(fused.Add(*integ));
+      }
+
+      // The ranges, including an empty one, cover all the elements
+      const int ne = fes.GetNE();
+      const int ranges[] = { 0, 1, 1, 1, 1, ne/2, ne/2, ne };
+
+      Vector x(R->Height()), y(R->Height()), y_range(R->Height());
+      x.Randomize(1);
+      for (int i = 0; i < 4; i++)
+      {
+         y = 0.0;
+         y_range = 0.0;
+         if (i < 3) { integs[i]->AddMultPA(x, y); }
+         else { fused.AddMultPA(x, y); }
+         for (int r = 0; r < 8; r += 2)
+         {
+            const int e_begin = ranges[r], e_end = ranges[r+1];
+            if (i < 3)
+            {
+               integs[i]->AddMultPARange(x, y_range, e_begin, e_end);
+            }
+            else { fused.AddMultPARange(x, y_range, e_begin, e_end); }
+         }
+         y_range -= y;
+         REQUIRE(y_range.Normlinf() <= 1e-12*y.Normlinf());
+      }
+
+      // The mass and diffusion operators are symmetric
+      for (int i = 0; i < 2; i++)
+      {
+         Vector y_transp(R->Height());
+         y = 0.0;
+         y_range = 0.0;
+         y_transp = 0.0;
+         integs[i]->AddMultPA(x, y);
+         integs[i]->AddMultTransposePA(x, y_transp);
+         for (int r = 0; r < 8; r += 2)
+         {
+            integs[i]->AddMultTransposePARange(x, y_range, ranges[r],
+                                               ranges[r+1]);
+         }
+         y_transp -= y;
+         REQUIRE(y_transp.Normlinf() == 0.0);
+         y_range -= y;
+         REQUIRE(y_range.Normlinf() <= 1e-12*y.Normlinf());
+      }
+      delete mesh;
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel PA communication overlap",
+          "[PartialAssembly], [Parallel]")
+{
+   // The overlap operator is also set up with a single rank
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                   new Mesh(4, 4, 4, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+      H1_FECollection fec(3, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      Array<int> ess_tdof_list, ess_bdr(pmesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient one(1.0);
+      ParBilinearForm a(&fes), a_overlap(&fes);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_overlap.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_overlap.SetCommunicationOverlap();
+      for (ParBilinearForm *form : {&a, &a_overlap})
+      {
+         form->AddDomainIntegrator(new DiffusionIntegrator(one));
+         form->AddDomainIntegrator(new MassIntegrator(one));
+         form->Assemble();
+      }
+
+      OperatorHandle A, A_overlap;
+      a.FormSystemMatrix(ess_tdof_list, A);
+      a_overlap.FormSystemMatrix(ess_tdof_list, A_overlap);
+
+      Vector X(fes.GetTrueVSize()), Y(X.Size()), Y_overlap(X.Size());
+      X.Randomize(1);
+      A->Mult(X, Y);
+      A_overlap->Mult(X, Y_overlap);
+      Y_overlap -= Y;
+      REQUIRE(Y_overlap.Normlinf() < 1e-12*Y.Normlinf());
+
+      A->MultTranspose(X, Y);
+      A_overlap->MultTranspose(X, Y_overlap);
+      Y_overlap -= Y;
+      REQUIRE(Y_overlap.Normlinf() < 1e-12*Y.Normlinf());
+
+      // The unconstrained overlap operator of an extension is P^T A P
+      ParBilinearForm a_ext(&fes);
+      a_ext.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a_ext.AddDomainIntegrator(new MassIntegrator(one));
+      PABilinearFormExtension ext(&a_ext);
+      ext.SetCommunicationOverlap(true);
+      ext.Assemble();
+      ParPAOverlapOperator A_rap(ext, fes);
+      Array<int> no_tdofs;
+      a.FormSystemMatrix(no_tdofs, A);
+
+      A->Mult(X, Y);
+      A_rap.Mult(X, Y_overlap);
+      Y_overlap -= Y;
+      REQUIRE(Y_overlap.Normlinf() < 1e-12*Y.Normlinf());
+
+      A->MultTranspose(X, Y);
+      A_rap.MultTranspose(X, Y_overlap);
+      Y_overlap -= Y;
+      REQUIRE(Y_overlap.Normlinf() < 1e-12*Y.Normlinf());
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace pa_overlap
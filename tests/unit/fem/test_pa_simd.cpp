@@ -0,0 +1,90 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace pa_simd
+{
+
+static double simd_coeff(const Vector &x) { return 1.0 + x(0)*x(1); }
+
+// Apply the PA mass or diffusion operator to two vectors, with Mult and with
+// ArrayMult, and return the results in y.
+static void ApplyPA(const int dim, const int order, const bool diffusion,
+                    Vector &y)
+{
+   // The number of elements is not a multiple of the SIMD width, so that the
+   // last batch of elements is padded.
+   Mesh *mesh = (dim == 2) ?
+                new Mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                new Mesh(3, 1, 3, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+   mesh->EnsureNodes();
+   GridFunction *nodes = mesh->GetNodes();
+   for (int i = 0; i < nodes->Size(); i++)
+   {
+      (*nodes)(i) += 0.02*sin(7.0*i);
+   }
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(mesh, &fec);
+   FunctionCoefficient coeff(simd_coeff);
+
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   if (diffusion) { a.AddDomainIntegrator(new DiffusionIntegrator(coeff)); }
+   else { a.AddDomainIntegrator(new MassIntegrator(coeff)); }
+   a.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x0(n), x1(n);
+   y.SetSize(4*n);
+   x0.Randomize(1);
+   x1.Randomize(2);
+   Vector y0, y1, yb0, yb1;
+   y0.MakeRef(y, 0, n);
+   y1.MakeRef(y, n, n);
+   yb0.MakeRef(y, 2*n, n);
+   yb1.MakeRef(y, 3*n, n);
+   a.Mult(x0, y0);
+   a.Mult(x1, y1);
+   Array<const Vector*> X(2);
+   Array<Vector*> Y(2);
+   X[0] = &x0; X[1] = &x1;
+   Y[0] = &yb0; Y[1] = &yb1;
+   a.ArrayMult(X, Y);
+   y.HostRead();
+   delete mesh;
+}
+
+TEST_CASE("PA cpu-simd kernels", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= 3; order++)
+      {
+         for (int diffusion = 0; diffusion < 2; diffusion++)
+         {
+            Vector y_cpu, y_simd;
+            ApplyPA(dim, order, diffusion, y_cpu);
+            {
+               Device device("cpu-simd");
+               ApplyPA(dim, order, diffusion, y_simd);
+            }
+            y_simd -= y_cpu;
+            REQUIRE(y_simd.Normlinf() <= 1e-12 * y_cpu.Normlinf());
+         }
+      }
+   }
+}
+
+} // namespace pa_simd
@@ -0,0 +1,132 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+namespace pa_simplex
+{
+
+enum class Integ { Mass, Diffusion, Convection, VectorMass, VectorDiffusion };
+
+static double coeff_fn(const Vector &x) { return 1.0 + x(0)*x(0) + 0.5*x(1); }
+
+static void velocity_fn(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   v(0) = 1.0 + x(1);
+   v(1) = -0.5 + x(0);
+   if (x.Size() == 3) { v(2) = 0.25 - x(0)*x(1); }
+}
+
+static void AddIntegrator(BilinearForm &a, Integ integ, Coefficient &q,
+                          VectorCoefficient &vel)
+{
+   switch (integ)
+   {
+      case Integ::Mass: a.AddDomainIntegrator(new MassIntegrator(q)); break;
+      case Integ::Diffusion:
+         a.AddDomainIntegrator(new DiffusionIntegrator(q)); break;
+      case Integ::Convection:
+         a.AddDomainIntegrator(new ConvectionIntegrator(vel)); break;
+      case Integ::VectorMass:
+         a.AddDomainIntegrator(new VectorMassIntegrator(q)); break;
+      case Integ::VectorDiffusion:
+         a.AddDomainIntegrator(new VectorDiffusionIntegrator(q)); break;
+   }
+}
+
+// Compare the action and the diagonal of the partially assembled form with the
+// ones of the fully assembled form.
+static void TestPA(Mesh &mesh, int order, Integ integ)
+{
+   const int dim = mesh.Dimension();
+   const bool vector = (integ == Integ::VectorMass ||
+                        integ == Integ::VectorDiffusion);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vector ? dim : 1);
+   FunctionCoefficient q(coeff_fn);
+   VectorFunctionCoefficient vel(dim, velocity_fn);
+
+   BilinearForm a_fa(&fes), a_pa(&fes);
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   AddIntegrator(a_fa, integ, q, vel);
+   AddIntegrator(a_pa, integ, q, vel);
+   a_fa.Assemble();
+   a_fa.Finalize();
+   a_pa.Assemble();
+
+   const int n = fes.GetVSize();
+   Vector x(n), y_fa(n), y_pa(n);
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() <= 1e-12 * y_fa.Normlinf());
+
+   if (integ != Integ::Convection)
+   {
+      Vector d_fa(n), d_pa(n);
+      a_fa.SpMat().GetDiag(d_fa);
+      a_pa.AssembleDiagonal(d_pa);
+      d_pa -= d_fa;
+      REQUIRE(d_pa.Normlinf() <= 1e-12 * d_fa.Normlinf());
+   }
+}
+
+static void TestAllIntegrators(Mesh &mesh, int order)
+{
+   TestPA(mesh, order, Integ::Mass);
+   TestPA(mesh, order, Integ::Diffusion);
+   TestPA(mesh, order, Integ::Convection);
+   TestPA(mesh, order, Integ::VectorMass);
+   TestPA(mesh, order, Integ::VectorDiffusion);
+}
+
+static void PerturbNodes(Mesh &mesh)
+{
+   mesh.EnsureNodes();
+   GridFunction *nodes = mesh.GetNodes();
+   for (int i = 0; i < nodes->Size(); i++)
+   {
+      (*nodes)(i) += 0.01*sin(5.0*i);
+   }
+}
+
+TEST_CASE("PA on simplices", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      Mesh tri(3, 3, Element::TRIANGLE, true, 1.0, 1.0);
+      PerturbNodes(tri);
+      TestAllIntegrators(tri, order);
+
+      Mesh tet(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      PerturbNodes(tet);
+      TestAllIntegrators(tet, order);
+   }
+}
+
+TEST_CASE("PA on mixed meshes", "[PartialAssembly]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      Mesh star("../../data/star-mixed.mesh", 1, 1);
+      TestAllIntegrators(star, order);
+
+      Mesh fichera("../../data/fichera-mixed.mesh", 1, 1);
+      TestAllIntegrators(fichera, order);
+   }
+}
+
+} // namespace pa_simplex
@@ -111,4 +111,52 @@ TEST_CASE("MemoryManager", "[MemoryManager]")
    }
 }
 
+TEST_CASE("HostPool", "[MemoryManager]")
+{
+   // The memory manager may have been destroyed by a previous Device
+   mm.Init();
+
+   SECTION("MemoryType")
+   {
+      TestMemoryTypes(MemoryType::HOST_POOL, false);
+      TestMemoryTypes(MemoryType::HOST_POOL, true);
+      TestMemoryTypes(MemoryType::HOST_POOL, true, 1);
+      TestMemoryTypes(MemoryType::HOST_POOL, false, 1<<25);
+   }
+
+   SECTION("Reuse")
+   {
+      double *data;
+      {
+         Vector x(1000, MemoryType::HOST_POOL);
+         data = x.GetData();
+         REQUIRE(uintptr_t(data) % 64 == 0);
+         x = 1.0;
+      }
+      REQUIRE(mm.GetHostPoolCachedBytes() > 0);
+      {
+         // A slightly smaller size uses a block of the same size class
+         Vector y(990, MemoryType::HOST_POOL);
+         REQUIRE(y.GetData() == data);
+      }
+      // The first call keeps the blocks below the high-water mark
+      mm.TrimHostPool();
+      mm.TrimHostPool();
+      REQUIRE(mm.GetHostPoolCachedBytes() == 0);
+   }
+
+   SECTION("Device")
+   {
+      Device device("cpu:pool");
+      REQUIRE(mm.GetHostMemoryType() == MemoryType::HOST_POOL);
+      {
+         Vector x(100);
+         REQUIRE(x.GetMemory().GetMemoryType() == MemoryType::HOST_POOL);
+         x.UseDevice(true);
+         x = 2.0;
+         REQUIRE(x*x == Approx(400.0));
+      }
+   }
+}
+
 #endif // _WIN32
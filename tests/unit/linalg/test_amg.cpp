@@ -0,0 +1,103 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+// Solve a Poisson problem with CG preconditioned by SmoothedAggregationAMG,
+// return the number of iterations.
+static int amg_poisson(Mesh &mesh, int order,
+                       SmoothedAggregationAMG::SmootherType smoother)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   SmoothedAggregationAMG amg;
+   amg.SetSmoother(smoother, 1, 2);
+   amg.SetOperator(A);
+   REQUIRE(amg.GetNumLevels() > 1);
+   REQUIRE(amg.GetLevelMatrix(amg.GetNumLevels()-1).Height() <= 50);
+   REQUIRE(amg.GetOperatorComplexity() < 2.0);
+
+   // The V-cycle is symmetric
+   const int n = A.Height();
+   Vector u(n), v(n), Mu(n), Mv(n);
+   u.Randomize(1);
+   v.Randomize(2);
+   amg.Mult(u, Mu);
+   amg.Mult(v, Mv);
+   REQUIRE(std::abs(u*Mv - v*Mu) < 1e-10*std::abs(u*Mv));
+
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(200);
+   cg.SetOperator(A);
+   cg.SetPreconditioner(amg);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+
+   Vector R(n);
+   A.Mult(X, R);
+   R -= B;
+   REQUIRE(R.Normlinf() < 1e-8*B.Normlinf());
+   return cg.GetNumIterations();
+}
+
+TEST_CASE("SmoothedAggregationAMG", "[AMG]")
+{
+   const SmoothedAggregationAMG::SmootherType smoothers[] =
+   {
+      SmoothedAggregationAMG::L1_JACOBI,
+      SmoothedAggregationAMG::CHEBYSHEV
+   };
+   for (auto smoother : smoothers)
+   {
+      SECTION("2D, smoother " + std::to_string(smoother))
+      {
+         // The number of iterations is bounded under mesh refinement
+         int its[2];
+         for (int r = 0; r < 2; r++)
+         {
+            const int n = 32 << r;
+            Mesh mesh(n, n, Element::QUADRILATERAL, true, 1.0, 1.0);
+            its[r] = amg_poisson(mesh, 1, smoother);
+         }
+         REQUIRE(its[0] < 30);
+         REQUIRE(its[1] < 1.5*its[0]);
+      }
+
+      SECTION("3D, smoother " + std::to_string(smoother))
+      {
+         Mesh mesh(6, 6, 6, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+         REQUIRE(amg_poisson(mesh, 2, smoother) < 40);
+      }
+   }
+}
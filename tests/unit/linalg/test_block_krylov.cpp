@@ -0,0 +1,220 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+#include "unit_test_problems.hpp"
+
+using namespace mfem;
+using namespace unit_test_problems;
+
+TEST_CASE("PA ArrayMult", "[PartialAssembly][ArrayMult]")
+{
+   const int nv = 3;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      for (int order = 1; order <= (dim == 2 ? 6 : 3); order++)
+      {
+         for (int integ = 0; integ < 2; integ++)
+         {
+            Mesh *mesh = (dim == 2) ?
+                         new Mesh(3, 3, Element::QUADRILATERAL, true) :
+                         new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+            H1_FECollection fec(order, dim);
+            FiniteElementSpace fes(mesh, &fec);
+            FunctionCoefficient q(coeff);
+
+            BilinearForm a(&fes);
+            a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            if (integ == 0) { a.AddDomainIntegrator(new MassIntegrator(q)); }
+            else { a.AddDomainIntegrator(new DiffusionIntegrator(q)); }
+            a.Assemble();
+
+            const int n = fes.GetVSize();
+            Array<Vector *> X(nv), Y(nv);
+            Array<const Vector *> Xc(nv);
+            for (int i = 0; i < nv; i++)
+            {
+               X[i] = new Vector(n);
+               X[i]->Randomize(i+1);
+               Xc[i] = X[i];
+               Y[i] = new Vector(n);
+            }
+            a.ArrayMult(Xc, Y);
+
+            Vector y(n);
+            for (int i = 0; i < nv; i++)
+            {
+               a.Mult(*X[i], y);
+               y -= *Y[i];
+               REQUIRE(y.Normlinf() < 1e-12*Y[i]->Normlinf());
+            }
+
+            for (int i = 0; i < nv; i++)
+            {
+               delete X[i];
+               delete Y[i];
+            }
+            delete mesh;
+         }
+      }
+   }
+}
+
+TEST_CASE("BlockCGSolver", "[BlockCGSolver]")
+{
+   const int nv = 4;
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(3, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   FunctionCoefficient q(coeff);
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a.AddDomainIntegrator(new DiffusionIntegrator(q));
+   a.Assemble();
+
+   OperatorHandle A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+   OperatorJacobiSmoother jacobi(a, ess_tdof_list);
+
+   const int n = A->Height();
+   // The last right-hand side is a combination of the first two
+   Array<Vector *> B(nv), X(nv);
+   Array<const Vector *> Bc(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      B[i] = new Vector(n);
+      if (i < nv-1)
+      {
+         B[i]->Randomize(i+1);
+      }
+      else
+      {
+         add(*B[0], -2.0, *B[1], *B[i]);
+      }
+      B[i]->SetSubVector(ess_tdof_list, 0.0);
+      Bc[i] = B[i];
+      X[i] = new Vector(n);
+      *X[i] = 0.0;
+   }
+
+   for (int use_prec = 0; use_prec < 2; use_prec++)
+   {
+      CGSolver cg;
+      BlockCGSolver bcg;
+      for (IterativeSolver *solver : { (IterativeSolver*) &cg,
+                                       (IterativeSolver*) &bcg
+                                     })
+      {
+         solver->SetRelTol(1e-10);
+         solver->SetAbsTol(0.0);
+         solver->SetMaxIter(1000);
+         solver->SetPrintLevel(-1);
+         if (use_prec) { solver->SetPreconditioner(jacobi); }
+         solver->SetOperator(*A);
+      }
+
+      for (int i = 0; i < nv; i++) { *X[i] = 0.0; }
+      bcg.ArrayMult(Bc, X);
+      REQUIRE(bcg.GetConverged());
+
+      int max_cg_iter = 0;
+      for (int i = 0; i < nv; i++)
+      {
+         Vector x(n);
+         x = 0.0;
+         cg.Mult(*B[i], x);
+         REQUIRE(cg.GetConverged());
+         max_cg_iter = std::max(max_cg_iter, cg.GetNumIterations());
+         REQUIRE(Residual(*A, *B[i], *X[i]) < 1e-8);
+      }
+      // The block Krylov space is larger, so fewer iterations are needed
+      REQUIRE(bcg.GetNumIterations() <= max_cg_iter);
+   }
+
+   for (int i = 0; i < nv; i++)
+   {
+      delete B[i];
+      delete X[i];
+   }
+}
+
+TEST_CASE("BlockGMRESSolver", "[BlockGMRESSolver]")
+{
+   const int nv = 3;
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   VectorFunctionCoefficient vel(2, velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(vel));
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix A(a.SpMat());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      A.EliminateRowCol(ess_tdof_list[i]);
+   }
+   DSmoother jacobi(A);
+
+   const int n = A.Height();
+   Array<Vector *> B(nv), X(nv);
+   Array<const Vector *> Bc(nv);
+   for (int i = 0; i < nv; i++)
+   {
+      B[i] = new Vector(n);
+      B[i]->Randomize(i+1);
+      B[i]->SetSubVector(ess_tdof_list, 0.0);
+      Bc[i] = B[i];
+      X[i] = new Vector(n);
+   }
+
+   for (int use_prec = 0; use_prec < 2; use_prec++)
+   {
+      for (int kdim : { 10, 50 })
+      {
+         BlockGMRESSolver bgmres;
+         bgmres.SetKDim(kdim);
+         bgmres.SetRelTol(1e-10);
+         bgmres.SetAbsTol(0.0);
+         bgmres.SetMaxIter(1000);
+         bgmres.SetPrintLevel(-1);
+         if (use_prec) { bgmres.SetPreconditioner(jacobi); }
+         bgmres.SetOperator(A);
+
+         for (int i = 0; i < nv; i++) { *X[i] = 0.0; }
+         bgmres.ArrayMult(Bc, X);
+         REQUIRE(bgmres.GetConverged());
+         for (int i = 0; i < nv; i++)
+         {
+            REQUIRE(Residual(A, *B[i], *X[i]) < 1e-7);
+         }
+      }
+   }
+
+   for (int i = 0; i < nv; i++)
+   {
+      delete B[i];
+      delete X[i];
+   }
+}
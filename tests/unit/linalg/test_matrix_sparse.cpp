@@ -85,5 +85,117 @@ TEST_CASE("SparseMatrixAbsMult", "[SparseMatrixAbsMult]")
    }
 }
 
+static SparseMatrix *RandomSparseMatrix(int height, int width, int row_nnz,
+                                        int seed)
+{
+   srand(seed);
+   SparseMatrix *S = new SparseMatrix(height, width);
+   for (int i = 0; i < height; i++)
+   {
+      for (int k = 0; k < row_nnz; k++)
+      {
+         S->Add(i, rand() % width, 2.0*rand()/RAND_MAX - 1.0);
+      }
+   }
+   S->Finalize();
+   return S;
+}
+
+static double ProductError(const SparseMatrix &S, const DenseMatrix &D)
+{
+   DenseMatrix Sd;
+   S.ToDenseMatrix(Sd);
+   REQUIRE(Sd.Height() == D.Height());
+   REQUIRE(Sd.Width() == D.Width());
+   Sd -= D;
+   return Sd.MaxMaxNorm();
+}
+
+TEST_CASE("SparseMatrixProducts", "[SparseMatrix]")
+{
+   SparseMatrix *A = RandomSparseMatrix(60, 50, 5, 1);
+   SparseMatrix *B = RandomSparseMatrix(50, 40, 4, 2);
+   SparseMatrix *P = RandomSparseMatrix(50, 20, 3, 3);
+   SparseMatrix *Q = RandomSparseMatrix(60, 20, 3, 4);
+   SparseMatrix *S = RandomSparseMatrix(50, 50, 6, 5);
+
+   DenseMatrix Ad, Bd, Pd, Qd, Sd, Dd;
+   A->ToDenseMatrix(Ad);
+   B->ToDenseMatrix(Bd);
+   P->ToDenseMatrix(Pd);
+   Q->ToDenseMatrix(Qd);
+   S->ToDenseMatrix(Sd);
+
+   SECTION("Mult")
+   {
+      SparseMatrix *AB = Mult(*A, *B);
+      DenseMatrix ABd(60, 40);
+      Mult(Ad, Bd, ABd);
+      REQUIRE(ProductError(*AB, ABd) < EPS);
+
+      // reuse the sparsity pattern, also with sorted column indices
+      AB->SortColumnIndices();
+      *A *= 2.0;
+      Mult(*A, *B, AB);
+      ABd *= 2.0;
+      REQUIRE(ProductError(*AB, ABd) < EPS);
+      delete AB;
+   }
+
+   SECTION("RAP")
+   {
+      // R S R^T with R = P^T
+      SparseMatrix *R = Transpose(*P);
+      SparseMatrix *RSRt = RAP(*S, *R);
+      DenseMatrix SPd(50, 20), PtSPd(20, 20);
+      Mult(Sd, Pd, SPd);
+      MultAtB(Pd, SPd, PtSPd);
+      REQUIRE(ProductError(*RSRt, PtSPd) < EPS);
+
+      *S *= -3.0;
+      RAP(*S, *R, RSRt);
+      PtSPd *= -3.0;
+      REQUIRE(ProductError(*RSRt, PtSPd) < EPS);
+      delete RSRt;
+      delete R;
+
+      // Q^T A P
+      SparseMatrix *QtAP = RAP(*Q, *A, *P);
+      DenseMatrix APd(60, 20), QtAPd(20, 20);
+      Mult(Ad, Pd, APd);
+      MultAtB(Qd, APd, QtAPd);
+      REQUIRE(ProductError(*QtAP, QtAPd) < EPS);
+
+      QtAP->SortColumnIndices();
+      *A *= 0.5;
+      RAP(*Q, *A, *P, QtAP);
+      QtAPd *= 0.5;
+      REQUIRE(ProductError(*QtAP, QtAPd) < EPS);
+      delete QtAP;
+   }
+
+   SECTION("Mult_AtDA")
+   {
+      Vector D(60);
+      D.Randomize(6);
+      SparseMatrix *AtDA = Mult_AtDA(*A, D);
+      DenseMatrix DAd(Ad), AtDAd(50, 50);
+      DAd.LeftScaling(D);
+      MultAtB(Ad, DAd, AtDAd);
+      REQUIRE(ProductError(*AtDA, AtDAd) < EPS);
+
+      D *= 4.0;
+      Mult_AtDA(*A, D, AtDA);
+      AtDAd *= 4.0;
+      REQUIRE(ProductError(*AtDA, AtDAd) < EPS);
+      delete AtDA;
+   }
+
+   delete S;
+   delete Q;
+   delete P;
+   delete B;
+   delete A;
+}
 
 } // namespace mfem
@@ -12,6 +12,7 @@
 #include "mfem.hpp"
 #include "catch.hpp"
 #include <cmath>
+#include <set>
 
 using namespace mfem;
 
@@ -365,3 +366,266 @@ TEST_CASE("First order ODE methods",
    }
 }
 
+
+TEST_CASE("Adaptive ODE methods",
+          "[ODE1]")
+{
+   // du/dt = -lambda (u - cos(t)) + (0, u0) for the first and second component
+   // of u. The first component is stiff for large lambda, the second one is
+   // a harmonic oscillator with the first one.
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      double lambda;
+   public:
+      mutable int num_mult;
+
+      ODE(double _lambda) : TimeDependentOperator(3, 0.0), lambda(_lambda),
+         num_mult(0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         num_mult++;
+         dudt(0) = -lambda*(u(0) - cos(GetTime()));
+         dudt(1) = u(2);
+         dudt(2) = -u(1);
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+      {
+         // dudt = f(u + dt dudt, t)
+         dudt(0) = -lambda*(u(0) - cos(GetTime()))/(1.0 + lambda*dt);
+         dudt(1) = (u(2) - dt*u(1))/(1.0 + dt*dt);
+         dudt(2) = (-u(1) - dt*u(2))/(1.0 + dt*dt);
+      }
+   };
+
+   auto error = [](const Vector &u, double t, double lambda)
+   {
+      // Exact solution with u(0) = (lambda^2/(1+lambda^2), 0, 1)
+      const double l2 = lambda*lambda;
+      const double u0 = l2/(1.0 + l2)*cos(t) + lambda/(1.0 + l2)*sin(t);
+      return std::max(std::abs(u(0) - u0),
+                      std::max(std::abs(u(1) - sin(t)),
+                               std::abs(u(2) - cos(t))));
+   };
+
+   auto run = [&](AdaptiveODESolver &solver, double lambda, double tol,
+                  double &err)
+   {
+      ODE ode(lambda);
+      Vector u(3);
+      u(0) = lambda*lambda/(1.0 + lambda*lambda);
+      u(1) = 0.0;
+      u(2) = 1.0;
+      double t = 0.0;
+      solver.Init(ode);
+      solver.SetTolerances(tol, tol);
+      // Steps of fixed size dt_out with internal adaptive steps
+      const double dt_out = 0.5;
+      for (int i = 0; i < 8; i++)
+      {
+         double dt_step = dt_out;
+         solver.Step(u, t, dt_step);
+         REQUIRE(std::abs(t - (i+1)*dt_out) < 1e-14);
+         REQUIRE(dt_step == solver.GetNextStepSize());
+      }
+      err = error(u, t, lambda);
+      return ode.num_mult;
+   };
+
+   SECTION("Explicit embedded pairs")
+   {
+      BogackiShampineSolver bs;
+      DormandPrinceSolver dp;
+      for (int k = 0; k < 2; k++)
+      {
+         AdaptiveODESolver &solver = k ? (AdaptiveODESolver&) dp : bs;
+         const int stages = k ? 7 : 4;
+         double err[2];
+         int its[2];
+         for (int l = 0; l < 2; l++)
+         {
+            const double tol = l ? 1e-8 : 1e-5;
+            const int num_mult = run(solver, 1.0, tol, err[l]);
+            const int steps = solver.GetNumAcceptedSteps() +
+                              solver.GetNumRejectedSteps();
+            // FSAL: one evaluation per step is reused
+            REQUIRE(num_mult == (stages-1)*steps + 1);
+            REQUIRE(err[l] < 100*tol);
+            its[l] = solver.GetNumAcceptedSteps();
+         }
+         REQUIRE(err[1] < err[0]);
+         REQUIRE(its[1] > its[0]);
+      }
+   }
+
+   SECTION("Adaptive SDIRK")
+   {
+      // The explicit pairs are limited by stability for the stiff problem
+      AdaptiveSDIRK33Solver sdirk;
+      DormandPrinceSolver dp;
+      const double lambda = 1e4, tol = 1e-5;
+      double err_sdirk, err_dp;
+      run(sdirk, lambda, tol, err_sdirk);
+      const int steps_sdirk = sdirk.GetNumAcceptedSteps();
+      run(dp, lambda, tol, err_dp);
+      const int steps_dp = dp.GetNumAcceptedSteps();
+      REQUIRE(err_sdirk < 100*tol);
+      REQUIRE(err_dp < 100*tol);
+      REQUIRE(10*steps_sdirk < steps_dp);
+   }
+
+   SECTION("Returned step size")
+   {
+      // Feeding the returned dt back into Run() or Step() lets the step size
+      // grow from a tiny initial step, also after a tiny last step
+      const double lambda = 1.0, tol = 1e-5, tf = 4.0;
+      ODE ode(lambda);
+      DormandPrinceSolver dp;
+      Vector u(3);
+      for (int k = 0; k < 2; k++)
+      {
+         u(0) = lambda*lambda/(1.0 + lambda*lambda);
+         u(1) = 0.0;
+         u(2) = 1.0;
+         double t = 0.0, dt = 1e-8;
+         dp.Init(ode);
+         dp.SetTolerances(tol, tol);
+         if (k == 0)
+         {
+            const double t_out[3] = { 1.0, 1.0 + 1e-9, tf };
+            for (int i = 0; i < 3; i++)
+            {
+               dp.Run(u, t, dt, t_out[i]);
+               REQUIRE(t == t_out[i]);
+            }
+         }
+         else
+         {
+            // As in ODESolver::Run()
+            for (int i = 0; i < 1000 && t < tf; i++) { dp.Step(u, t, dt); }
+            REQUIRE(t >= tf);
+         }
+         REQUIRE(dt > 0.05);
+         REQUIRE(dp.GetNumAcceptedSteps() < 100);
+         REQUIRE(error(u, t, lambda) < 100*tol);
+      }
+   }
+
+   SECTION("Non-finite error estimates")
+   {
+      // The explicit stages overflow for too large steps of the stiff problem,
+      // such steps must be rejected
+      class GuardedODE : public ODE
+      {
+      public:
+         GuardedODE(double _lambda) : ODE(_lambda) { }
+
+         virtual void Mult(const Vector &u, Vector &dudt) const
+         {
+            ODE::Mult(u, dudt);
+            if (std::abs(u(0)) > 10.0) { dudt(0) = NAN; }
+         }
+      };
+      const double lambda = 1e3, tol = 1e-5;
+      GuardedODE ode(lambda);
+      DormandPrinceSolver dp;
+      Vector u(3);
+      u(0) = lambda*lambda/(1.0 + lambda*lambda);
+      u(1) = 0.0;
+      u(2) = 1.0;
+      double t = 0.0, dt = 0.5;
+      dp.Init(ode);
+      dp.SetTolerances(tol, tol);
+      dp.Step(u, t, dt);
+      REQUIRE(std::abs(t - 0.5) < 1e-14);
+      REQUIRE(dp.GetNumRejectedSteps() > 0);
+      REQUIRE(u.CheckFinite() == 0);
+      REQUIRE(error(u, t, lambda) < 100*tol);
+   }
+}
+
+TEST_CASE("IMEX ODE methods",
+          "[ODE1]")
+{
+   // du/dt = f1(u) + f2(u), with the oscillator f1(u) = (u1, -u0) treated
+   // explicitly and the decay f2(u) = -mu u treated implicitly
+   class ODE : public TimeDependentOperator
+   {
+   protected:
+      double mu;
+   public:
+      std::set<double> solve_dt;
+
+      ODE(double _mu) : TimeDependentOperator(2, 0.0), mu(_mu) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         REQUIRE(GetEvalMode() != NORMAL);
+         if (GetEvalMode() == ADDITIVE_TERM_1)
+         {
+            dudt(0) = u(1);
+            dudt(1) = -u(0);
+         }
+         else
+         {
+            dudt.Set(-mu, u);
+         }
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+      {
+         REQUIRE(GetEvalMode() == ADDITIVE_TERM_2);
+         solve_dt.insert(dt);
+         dudt.Set(-mu/(1.0 + mu*dt), u);
+      }
+   };
+
+   auto order = [](ODESolver &solver, double mu)
+   {
+      const double t_final = 1.0;
+      double err[2];
+      for (int l = 0; l < 2; l++)
+      {
+         const int steps = 20 << l;
+         ODE ode(mu);
+         Vector u(2);
+         u(0) = 0.0;
+         u(1) = 1.0;
+         double t = 0.0, dt = t_final/steps;
+         solver.Init(ode);
+         for (int i = 0; i < steps; i++) { solver.Step(u, t, dt); }
+         // All implicit stages use the same time step
+         REQUIRE(ode.solve_dt.size() == 1);
+         const double e = exp(-mu*t);
+         err[l] = std::max(std::abs(u(0) - e*sin(t)), std::abs(u(1) - e*cos(t)));
+      }
+      return log(err[0]/err[1])/log(2.0);
+   };
+
+   SECTION("ARS232Solver")
+   {
+      ARS232Solver solver;
+      REQUIRE(order(solver, 1.0) > 1.9);
+   }
+
+   SECTION("ARS343Solver")
+   {
+      ARS343Solver solver;
+      REQUIRE(order(solver, 1.0) > 2.9);
+   }
+
+   SECTION("Stiff implicit term")
+   {
+      // Stable and accurate with a time step much larger than 1/mu
+      ARS343Solver solver;
+      ODE ode(1e6);
+      Vector u(2);
+      u = 1.0;
+      double t = 0.0, dt = 0.1;
+      solver.Init(ode);
+      for (int i = 0; i < 10; i++) { solver.Step(u, t, dt); }
+      REQUIRE(u.Normlinf() < 1e-5);
+   }
+}
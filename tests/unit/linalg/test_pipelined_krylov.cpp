@@ -0,0 +1,141 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+#include "unit_test_problems.hpp"
+
+using namespace mfem;
+using namespace unit_test_problems;
+
+namespace pipelined_krylov
+{
+
+// Assemble the Poisson (conv = false) or the convection-diffusion (conv =
+// true) matrix on the unit square with homogeneous Dirichlet conditions.
+void Assemble(bool conv, SparseMatrix &A, Vector &B)
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+
+   VectorFunctionCoefficient vel(2, velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   if (conv) { a.AddDomainIntegrator(new ConvectionIntegrator(vel)); }
+   a.Assemble();
+
+   GridFunction x(&fes);
+   x = 0.0;
+   Vector X, B_ref;
+   SparseMatrix A_ref;
+   a.FormLinearSystem(ess_tdof_list, x, b, A_ref, X, B_ref);
+   // A_ref and B_ref reference data owned by 'a' and 'b', copy them
+   B = B_ref;
+   SparseMatrix *mat = a.LoseMat();
+   A.Swap(*mat);
+   delete mat;
+}
+
+}
+
+using namespace pipelined_krylov;
+
+TEST_CASE("PipelinedCGSolver", "[PipelinedCGSolver]")
+{
+   SparseMatrix A;
+   Vector B;
+   Assemble(false, A, B);
+   GSSmoother gs(A);
+
+   for (int use_prec = 0; use_prec < 2; use_prec++)
+   {
+      CGSolver cg;
+      PipelinedCGSolver pcg;
+      for (IterativeSolver *solver : { (IterativeSolver*) &cg,
+                                       (IterativeSolver*) &pcg
+                                     })
+      {
+         solver->SetRelTol(1e-10);
+         solver->SetAbsTol(0.0);
+         solver->SetMaxIter(500);
+         solver->SetPrintLevel(-1);
+         if (use_prec) { solver->SetPreconditioner(gs); }
+         solver->SetOperator(A);
+      }
+
+      Vector X_cg(B.Size()), X_pcg(B.Size());
+      X_cg = 0.0;
+      X_pcg = 0.0;
+      cg.Mult(B, X_cg);
+      pcg.Mult(B, X_pcg);
+
+      REQUIRE(cg.GetConverged());
+      REQUIRE(pcg.GetConverged());
+      // The recurrences of the pipelined method are slightly less stable, allow
+      // a few more iterations
+      REQUIRE(pcg.GetNumIterations() <= 1.1*cg.GetNumIterations() + 2);
+      REQUIRE(Residual(A, B, X_pcg) < 1e-8);
+      X_pcg -= X_cg;
+      REQUIRE(X_pcg.Normlinf() < 1e-8*X_cg.Normlinf());
+   }
+}
+
+TEST_CASE("SStepGMRESSolver", "[SStepGMRESSolver]")
+{
+   SparseMatrix A;
+   Vector B;
+   Assemble(true, A, B);
+   DSmoother jacobi(A);
+
+   for (int use_prec = 0; use_prec < 2; use_prec++)
+   {
+      for (int s : { 1, 3, 5 })
+      {
+         GMRESSolver gmres;
+         SStepGMRESSolver sgmres;
+         sgmres.SetStepSize(s);
+         for (IterativeSolver *solver : { (IterativeSolver*) &gmres,
+                                          (IterativeSolver*) &sgmres
+                                        })
+         {
+            solver->SetRelTol(1e-10);
+            solver->SetAbsTol(0.0);
+            solver->SetMaxIter(1000);
+            solver->SetPrintLevel(-1);
+            if (use_prec) { solver->SetPreconditioner(jacobi); }
+            solver->SetOperator(A);
+         }
+         gmres.SetKDim(30);
+         sgmres.SetKDim(30);
+
+         Vector X_gmres(B.Size()), X_sgmres(B.Size());
+         X_gmres = 0.0;
+         X_sgmres = 0.0;
+         gmres.Mult(B, X_gmres);
+         sgmres.Mult(B, X_sgmres);
+
+         REQUIRE(gmres.GetConverged());
+         REQUIRE(sgmres.GetConverged());
+         REQUIRE(sgmres.GetNumIterations() <= 1.2*gmres.GetNumIterations() + 5);
+         REQUIRE(Residual(A, B, X_sgmres) < 1e-7);
+      }
+   }
+}
@@ -91,3 +91,487 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+static void find_points_transform(const Vector &x, Vector &p)
+{
+   p = x;
+   p(0) = 2.0*x(0) + 0.1*sin(M_PI*x(1));
+   p(1) = x(1) + 0.1*sin(M_PI*x(0));
+}
+
+static void test_find_points(Mesh &mesh)
+{
+   const int sdim = mesh.SpaceDimension();
+   const int npts = 5*mesh.GetNE();
+
+   // Sample points inside random elements at random reference coordinates
+   DenseMatrix point_mat(sdim, npts);
+   Vector pt;
+   int seed = 1;
+   for (int k = 0; k < npts; k++)
+   {
+      const int e = k % mesh.GetNE();
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(e);
+      IntegrationPoint ip;
+      Vector r(mesh.Dimension());
+      do
+      {
+         r.Randomize(seed++);
+         ip.Set(r.GetData(), mesh.Dimension());
+      }
+      while (!Geometry::CheckPoint(geom, ip));
+      pt.SetDataAndSize(point_mat.GetColumn(k), sdim);
+      mesh.GetElementTransformation(e)->Transform(ip, pt);
+   }
+
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   // Relax the default Newton tolerances which are close to round-off
+   InverseElementTransformation inv_tr;
+   inv_tr.SetReferenceTol(1e-12);
+   inv_tr.SetPhysicalRelTol(1e-12);
+   REQUIRE(mesh.FindPoints(point_mat, elem_ids, ips, true, &inv_tr) == npts);
+
+   Vector x(sdim);
+   for (int k = 0; k < npts; k++)
+   {
+      REQUIRE(elem_ids[k] >= 0);
+      mesh.GetElementTransformation(elem_ids[k])->Transform(ips[k], x);
+      x -= Vector(point_mat.GetColumn(k), sdim);
+      REQUIRE(x.Normlinf() < 1e-8);
+   }
+}
+
+TEST_CASE("FindPoints with bounding box tree", "[Mesh]")
+{
+   SECTION("Quadrilateral mesh")
+   {
+      Mesh mesh(8, 8, Element::QUADRILATERAL, true, 1.0, 1.0);
+      test_find_points(mesh);
+
+      // The tree must be rebuilt after the geometry changes ...
+      mesh.Transform(find_points_transform);
+      test_find_points(mesh);
+
+      // ... and after refinement
+      mesh.UniformRefinement();
+      test_find_points(mesh);
+   }
+
+   SECTION("Curved triangle mesh")
+   {
+      Mesh mesh(6, 6, Element::TRIANGLE, true, 1.0, 1.0);
+      mesh.SetCurvature(3);
+      mesh.Transform(find_points_transform);
+      test_find_points(mesh);
+
+      Array<int> refs;
+      refs.Append(0);
+      refs.Append(7);
+      mesh.GeneralRefinement(refs);
+      test_find_points(mesh);
+   }
+
+   SECTION("Tetrahedral mesh")
+   {
+      Mesh mesh(3, 3, 3, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      test_find_points(mesh);
+
+      DenseMatrix outside(3, 1);
+      outside = 2.0;
+      Array<int> elem_ids;
+      Array<IntegrationPoint> ips;
+      REQUIRE(mesh.FindPoints(outside, elem_ids, ips, false) == 0);
+      REQUIRE(elem_ids[0] == -1);
+   }
+}
+
+static void binary_transform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1 * sin(M_PI * x(1));
+}
+
+static void test_same_mesh(Mesh &m1, Mesh &m2)
+{
+   REQUIRE(m1.Dimension() == m2.Dimension());
+   REQUIRE(m1.SpaceDimension() == m2.SpaceDimension());
+   REQUIRE(m1.GetNV() == m2.GetNV());
+   REQUIRE(m1.GetNE() == m2.GetNE());
+   REQUIRE(m1.GetNBE() == m2.GetNBE());
+   REQUIRE(m1.GetNEdges() == m2.GetNEdges());
+   Array<int> v1, v2;
+   for (int i = 0; i < m1.GetNE(); i++)
+   {
+      REQUIRE(m1.GetElementBaseGeometry(i) == m2.GetElementBaseGeometry(i));
+      REQUIRE(m1.GetAttribute(i) == m2.GetAttribute(i));
+      m1.GetElementVertices(i, v1);
+      m2.GetElementVertices(i, v2);
+      REQUIRE(v1 == v2);
+   }
+   for (int i = 0; i < m1.GetNBE(); i++)
+   {
+      REQUIRE(m1.GetBdrAttribute(i) == m2.GetBdrAttribute(i));
+      m1.GetBdrElementVertices(i, v1);
+      m2.GetBdrElementVertices(i, v2);
+      REQUIRE(v1 == v2);
+   }
+   for (int i = 0; i < m1.GetNV(); i++)
+   {
+      for (int d = 0; d < m1.SpaceDimension(); d++)
+      {
+         REQUIRE(m1.GetVertex(i)[d] == m2.GetVertex(i)[d]);
+      }
+   }
+   REQUIRE((m1.GetNodes() == NULL) == (m2.GetNodes() == NULL));
+   if (m1.GetNodes())
+   {
+      Vector diff(*m1.GetNodes());
+      diff -= *m2.GetNodes();
+      REQUIRE(diff.Normlinf() == 0.0);
+   }
+}
+
+// Expose the protected Mesh::Swap()
+class SwapMesh : public Mesh
+{
+public:
+   SwapMesh() { }
+   SwapMesh(const char *filename) : Mesh(filename) { }
+   using Mesh::Swap;
+};
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   const char *filename = "test_mesh_binary.mesh";
+   for (int k = 0; k < 3; k++)
+   {
+      Mesh *mesh_ptr = (k == 0) ?
+                       new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                       (k == 1) ?
+                       new Mesh(3, 2, 2, Element::TETRAHEDRON, true,
+                                1.0, 1.0, 1.0) :
+                       new Mesh(2, 3, 2, Element::HEXAHEDRON, true,
+                                1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      if (k > 0) { mesh.SetCurvature(2); }
+      mesh.Transform(binary_transform);
+
+      // In-memory stream
+      std::stringstream ss;
+      mesh.PrintBinary(ss);
+      Mesh mesh_ss(ss);
+      test_same_mesh(mesh, mesh_ss);
+
+      // Memory mapped file
+      {
+         std::ofstream out(filename, std::ios::binary);
+         mesh.PrintBinary(out);
+      }
+      Mesh mesh_file(filename);
+      test_same_mesh(mesh, mesh_file);
+      // The mapped data can be modified without changing the file
+      mesh_file.Transform(binary_transform);
+      mesh_file.UniformRefinement();
+      Mesh mesh_file2(filename);
+      test_same_mesh(mesh, mesh_file2);
+
+      // The file mapping follows the swapped data
+      {
+         SwapMesh *mapped = new SwapMesh(filename);
+         SwapMesh swapped;
+         swapped.Swap(*mapped, true);
+         delete mapped;
+         test_same_mesh(mesh, swapped);
+      }
+
+      // Nonconforming refinement swaps the mapped data with a new, temporary
+      // mesh: the mapping has to stay valid for the Nodes
+      if (k != 1)
+      {
+         Mesh mesh_nc(filename);
+         mesh_nc.EnsureNCMesh();
+         Array<int> refs(1);
+         refs[0] = 0;
+         mesh_nc.GeneralRefinement(refs);
+         REQUIRE(mesh_nc.GetNE() == mesh.GetNE() + (1 << mesh.Dimension()) - 1);
+         double vol = 0.0, vol_nc = 0.0;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            vol += mesh.GetElementVolume(i);
+         }
+         for (int i = 0; i < mesh_nc.GetNE(); i++)
+         {
+            vol_nc += mesh_nc.GetElementVolume(i);
+         }
+         REQUIRE(vol_nc == Approx(vol));
+
+         // The refinement hierarchy is saved with the nonconforming mesh
+         std::stringstream nc_ss;
+         mesh_nc.PrintBinary(nc_ss);
+         Mesh mesh_nc_ss(nc_ss);
+         REQUIRE(mesh_nc_ss.Nonconforming());
+         test_same_mesh(mesh_nc, mesh_nc_ss);
+         refs[0] = mesh_nc.GetNE() - 1;
+         mesh_nc.GeneralRefinement(refs);
+         mesh_nc_ss.GeneralRefinement(refs);
+         test_same_mesh(mesh_nc, mesh_nc_ss);
+      }
+
+#ifdef MFEM_USE_ZLIB
+      // Compressed file
+      {
+         ofgzstream out(filename, true);
+         mesh.PrintBinary(out);
+      }
+      Mesh mesh_gz(filename);
+      test_same_mesh(mesh, mesh_gz);
+#endif
+
+      // GridFunction and QuadratureFunction
+      H1_FECollection fec(2, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byVDIM);
+      GridFunction gf(&fes);
+      for (int i = 0; i < gf.Size(); i++) { gf(i) = sin(i); }
+      QuadratureSpace qspace(&mesh, 3);
+      QuadratureFunction qf(&qspace, 2);
+      for (int i = 0; i < qf.Size(); i++) { qf(i) = cos(i); }
+
+      std::stringstream gf_ss, qf_ss;
+      gf.SaveBinary(gf_ss);
+      qf.SaveBinary(qf_ss);
+      GridFunction gf_in(&mesh, gf_ss);
+      QuadratureFunction qf_in(&mesh, qf_ss);
+      REQUIRE(gf_in.FESpace()->GetOrdering() == Ordering::byVDIM);
+      REQUIRE(gf_in.VectorDim() == 2);
+      REQUIRE(qf_in.GetVDim() == 2);
+      gf_in -= gf;
+      qf_in -= qf;
+      REQUIRE(gf_in.Normlinf() == 0.0);
+      REQUIRE(qf_in.Normlinf() == 0.0);
+      delete mesh_ptr;
+   }
+   std::remove(filename);
+}
+
+static double mesh_volume(Mesh &mesh)
+{
+   double volume = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      volume += mesh.GetElementVolume(i);
+   }
+   return volume;
+}
+
+static void test_vtu_mesh(Mesh &mesh, Mesh &mesh_vtu, double tol)
+{
+   REQUIRE(mesh_vtu.Dimension() == mesh.Dimension());
+   REQUIRE(mesh_vtu.GetNE() == mesh.GetNE());
+   REQUIRE(mesh_vtu.GetNBE() == mesh.GetNBE());
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      REQUIRE(mesh_vtu.GetAttribute(i) == mesh.GetAttribute(i));
+   }
+   REQUIRE(mesh_volume(mesh_vtu) ==
+           Approx(mesh_volume(mesh)).epsilon(tol));
+}
+
+TEST_CASE("VTU mesh reader", "[Mesh]")
+{
+   const char *basename = "test_mesh_vtu";
+   const std::string filename = std::string(basename) + ".vtu";
+   const VTKFormat formats[] = { VTKFormat::ASCII, VTKFormat::BINARY,
+                                 VTKFormat::BINARY32
+                               };
+#ifdef MFEM_USE_ZLIB
+   const int num_compression_levels = 2;
+#else
+   const int num_compression_levels = 1;
+#endif
+   for (int k = 0; k < 4; k++)
+   {
+      Mesh *mesh_ptr = (k == 0) ?
+                       new Mesh(4, 3, Element::QUADRILATERAL, true, 1.0, 1.0) :
+                       (k == 1) ?
+                       new Mesh(3, 4, Element::TRIANGLE, true, 1.0, 1.0) :
+                       (k == 2) ?
+                       new Mesh(2, 2, 2, Element::TETRAHEDRON, true,
+                                1.0, 1.0, 1.0) :
+                       new Mesh(2, 3, 2, Element::HEXAHEDRON, true,
+                                1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      for (int i = 0; i < mesh.GetNE(); i++) { mesh.SetAttribute(i, i%3+1); }
+      mesh.SetAttributes();
+      for (int order = 1; order <= 3; order++)
+      {
+         if (order > 1)
+         {
+            mesh.SetCurvature(order);
+            mesh.Transform(binary_transform);
+         }
+         for (VTKFormat format : formats)
+         {
+            // The ascii and Float32 points are written in single precision
+            const double tol = (format == VTKFormat::BINARY) ? 1e-12 : 1e-5;
+            for (int c = 0; c < num_compression_levels; c++)
+            {
+               // Low-order output, the duplicated points are merged on request
+               if (order == 1)
+               {
+                  mesh.PrintVTU(basename, format, false, c);
+                  Mesh mesh_dup(filename.c_str());
+                  REQUIRE(mesh_dup.GetNE() == mesh.GetNE());
+                  REQUIRE(mesh_dup.GetNV() > mesh.GetNV());
+                  Mesh mesh_vtu;
+                  mesh_vtu.LoadVTU(filename, true);
+                  REQUIRE(mesh_vtu.GetNV() == mesh.GetNV());
+                  REQUIRE(mesh_vtu.GetNodes() == NULL);
+                  test_vtu_mesh(mesh, mesh_vtu, tol);
+               }
+               // High-order output with Lagrange cells
+               else if (format != VTKFormat::BINARY32)
+               {
+                  mesh.PrintVTU(basename, format, true, c);
+                  Mesh mesh_vtu;
+                  mesh_vtu.LoadVTU(filename, true);
+                  REQUIRE(mesh_vtu.GetNodes() != NULL);
+                  REQUIRE(mesh_vtu.GetNodalFESpace()->GetOrder(0) == order);
+                  test_vtu_mesh(mesh, mesh_vtu, tol);
+               }
+            }
+         }
+      }
+      delete mesh_ptr;
+   }
+   std::remove(filename.c_str());
+}
+
+template <typename T>
+static void append_bytes(std::string &s, const T &value)
+{
+   s.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Write the data array with the given values to the appended data 'data',
+// with a UInt64 header and raw or base64 encoding.
+template <typename T>
+static std::string appended_data_array(std::string &data, bool raw,
+                                       const char *type, const char *name,
+                                       int ncomp, const std::vector<T> &values)
+{
+   std::ostringstream tag;
+   tag << "<DataArray type=\"" << type << "\" Name=\"" << name
+       << "\" NumberOfComponents=\"" << ncomp
+       << "\" format=\"appended\" offset=\"" << data.size() << "\"/>\n";
+   const uint64_t nbytes = values.size()*sizeof(T);
+   if (raw)
+   {
+      append_bytes(data, nbytes);
+      data.append(reinterpret_cast<const char*>(values.data()), nbytes);
+   }
+   else
+   {
+      std::ostringstream out;
+      bin_io::WriteBase64(out, &nbytes, sizeof(nbytes));
+      bin_io::WriteBase64(out, values.data(), nbytes);
+      data += out.str();
+   }
+   return tag.str();
+}
+
+TEST_CASE("VTU mesh reader with appended data", "[Mesh]")
+{
+   // Two triangles and a quadrilateral in [0,2]x[0,1]
+   const std::vector<double> points = { 0, 0, 0,  1, 0, 0,  1, 1, 0,  0, 1, 0,
+                                        2, 0, 0,  2, 1, 0
+                                      };
+   const std::vector<int64_t> connectivity = { 0, 1, 2,  0, 2, 3,  1, 4, 5, 2 };
+   const std::vector<int64_t> offsets = { 3, 6, 10 };
+   const std::vector<uint8_t> types = { 5, 5, 9 };
+   const std::vector<int32_t> material = { 1, 2, 3 };
+
+   for (bool raw : { true, false })
+   {
+      std::string data;
+      std::ostringstream vtu;
+      vtu << "<?xml version=\"1.0\"?>\n"
+          << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+          << VTKByteOrder() << "\" header_type=\"UInt64\">\n"
+          << "<UnstructuredGrid>\n"
+          << "<Piece NumberOfPoints=\"6\" NumberOfCells=\"3\">\n"
+          << "<Points>\n"
+          << appended_data_array(data, raw, "Float64", "Points", 3, points)
+          << "</Points>\n<Cells>\n"
+          << appended_data_array(data, raw, "Int64", "connectivity", 1,
+                                 connectivity)
+          << appended_data_array(data, raw, "Int64", "offsets", 1, offsets)
+          << appended_data_array(data, raw, "UInt8", "types", 1, types)
+          << "</Cells>\n<CellData>\n"
+          << appended_data_array(data, raw, "Int32", "material", 1, material)
+          << "</CellData>\n</Piece>\n</UnstructuredGrid>\n"
+          << "<AppendedData encoding=\"" << (raw ? "raw" : "base64")
+          << "\">\n_" << data << "\n</AppendedData>\n</VTKFile>\n";
+
+      std::istringstream in(vtu.str());
+      Mesh mesh(in);
+      REQUIRE(mesh.Dimension() == 2);
+      REQUIRE(mesh.GetNE() == 3);
+      REQUIRE(mesh.GetNV() == 6);
+      REQUIRE(mesh.GetElementType(2) == Element::QUADRILATERAL);
+      for (int i = 0; i < 3; i++) { REQUIRE(mesh.GetAttribute(i) == i+1); }
+      REQUIRE(mesh_volume(mesh) == Approx(2.0));
+   }
+}
+
+static void shift_transform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 1.0;
+}
+
+TEST_CASE("PVTU mesh reader", "[Mesh]")
+{
+   const char *pieces[2] = { "test_mesh_pvtu_0", "test_mesh_pvtu_1" };
+   const char *filename = "test_mesh_pvtu.pvtu";
+   for (int p = 0; p < 2; p++)
+   {
+      Mesh piece(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0);
+      if (p == 1) { piece.Transform(shift_transform); }
+      piece.PrintVTU(pieces[p], VTKFormat::BINARY);
+   }
+   {
+      std::ofstream out(filename);
+      out << "<?xml version=\"1.0\"?>\n"
+          << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\">\n"
+          << "<PUnstructuredGrid GhostLevel=\"0\">\n"
+          << "<PPoints>\n<PDataArray type=\"Float64\""
+          << " NumberOfComponents=\"3\"/>\n</PPoints>\n";
+      for (int p = 0; p < 2; p++)
+      {
+         out << "<Piece Source=\"" << pieces[p] << ".vtu\"/>\n";
+      }
+      out << "</PUnstructuredGrid>\n</VTKFile>\n";
+   }
+
+   Mesh mesh;
+   Array<int> partitioning;
+   mesh.LoadPVTU(filename, partitioning);
+   REQUIRE(mesh.GetNE() == 8);
+   REQUIRE(mesh.GetNV() == 15);
+   REQUIRE(mesh.GetNBE() == 12);
+   REQUIRE(mesh_volume(mesh) == Approx(2.0));
+   REQUIRE(partitioning.Size() == 8);
+   for (int i = 0; i < 8; i++) { REQUIRE(partitioning[i] == i/4); }
+
+   // The PVTU file can also be read with the Mesh constructor
+   Mesh mesh_file(filename);
+   REQUIRE(mesh_file.GetNE() == 8);
+   REQUIRE(mesh_file.GetNV() == 15);
+
+   std::remove(filename);
+   for (int p = 0; p < 2; p++)
+   {
+      std::remove((std::string(pieces[p]) + ".vtu").c_str());
+   }
+}
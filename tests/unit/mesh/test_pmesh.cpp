@@ -0,0 +1,311 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+#ifdef MFEM_USE_MPI
+
+static double rebalance_func(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += (d + 1)*x(d)*x(d); }
+   return f;
+}
+
+// Test case: Verify that load balancing a conforming ParMesh preserves the
+//            elements and migrates the data of a ParGridFunction.
+static void test_conforming_rebalance(Mesh &mesh)
+{
+   int rank, num_procs;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   const int dim = pmesh.Dimension();
+
+   H1_FECollection fec(2, dim);
+   ParFiniteElementSpace pfes(&pmesh, &fec);
+   FunctionCoefficient coeff(rebalance_func);
+   ParGridFunction x(&pfes);
+   x.ProjectCoefficient(coeff);
+   REQUIRE(x.ComputeL2Error(coeff) < 1e-12);
+   const HYPRE_Int glob_size = pfes.GlobalTrueVSize();
+
+   for (int pass = 0; pass < 2; pass++)
+   {
+      if (pass == 0)
+      {
+         // scatter the elements over all ranks
+         Array<int> partition(pmesh.GetNE());
+         for (int i = 0; i < pmesh.GetNE(); i++)
+         {
+            partition[i] = (i + rank) % num_procs;
+         }
+         pmesh.Rebalance(partition);
+      }
+      else
+      {
+         pmesh.Rebalance(); // default space-filling curve partition
+      }
+      pfes.Update();
+      x.Update();
+
+      REQUIRE(pmesh.ReduceInt(pmesh.GetNE()) == mesh.GetNE());
+      REQUIRE(pfes.GlobalTrueVSize() == glob_size);
+      REQUIRE(x.ComputeL2Error(coeff) < 1e-12);
+   }
+
+   // the rebalanced mesh can be refined further
+   pmesh.UniformRefinement();
+   pfes.Update();
+   x.Update();
+   REQUIRE(x.ComputeL2Error(coeff) < 1e-12);
+}
+
+TEST_CASE("ParMesh Rebalance conforming", "[Parallel], [ParMesh]")
+{
+   SECTION("Quad mesh")
+   {
+      Mesh mesh(4, 4, Element::QUADRILATERAL, true, 1.0, 1.0);
+      test_conforming_rebalance(mesh);
+   }
+
+   SECTION("Tri mesh")
+   {
+      Mesh mesh(4, 4, Element::TRIANGLE, true, 1.0, 1.0);
+      test_conforming_rebalance(mesh);
+   }
+
+   SECTION("Hex mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      test_conforming_rebalance(mesh);
+   }
+
+   SECTION("Tet mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      test_conforming_rebalance(mesh);
+   }
+}
+
+// Write the PVTU file 'filename' with 'npieces' copies of the linear 'mesh',
+// the piece p shifted by p in x.
+static void write_pvtu_pieces(const Mesh &mesh, const std::string &filename,
+                              const int npieces)
+{
+   std::ofstream out(filename);
+   out << "<?xml version=\"1.0\"?>\n"
+       << "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\">\n"
+       << "<PUnstructuredGrid GhostLevel=\"0\">\n"
+       << "<PPoints>\n<PDataArray type=\"Float64\""
+       << " NumberOfComponents=\"3\"/>\n</PPoints>\n";
+   for (int p = 0; p < npieces; p++)
+   {
+      Mesh piece(mesh);
+      for (int v = 0; v < piece.GetNV(); v++) { piece.GetVertex(v)[0] += p; }
+      const std::string name = "test_pmesh_pvtu_" + std::to_string(p);
+      piece.PrintVTU(name, VTKFormat::BINARY);
+      out << "<Piece Source=\"" << name << ".vtu\"/>\n";
+   }
+   out << "</PUnstructuredGrid>\n</VTKFile>\n";
+}
+
+// Check that the ranks sharing a vertex, edge or face agree on its vertex
+// coordinates, i.e. that the shared entities are listed in the same order.
+static void check_shared_entities(ParMesh &pmesh)
+{
+   const int sdim = pmesh.SpaceDimension();
+   const int max_nv = 4;
+   Array<int> ent_group, ent_verts, ev;
+   auto add_entity = [&](int g)
+   {
+      ent_group.Append(g);
+      for (int k = 0; k < max_nv; k++)
+      {
+         ent_verts.Append(k < ev.Size() ? ev[k] : -1);
+      }
+   };
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      for (int i = 0; i < pmesh.GroupNVertices(g); i++)
+      {
+         ev.SetSize(1);
+         ev[0] = pmesh.GroupVertex(g, i);
+         add_entity(g);
+      }
+      for (int i = 0; i < pmesh.GroupNEdges(g); i++)
+      {
+         int edge, o;
+         pmesh.GroupEdge(g, i, edge, o);
+         pmesh.GetEdgeVertices(edge, ev);
+         add_entity(g);
+      }
+      const int ntri = pmesh.GroupNTriangles(g);
+      for (int i = 0; i < ntri + pmesh.GroupNQuadrilaterals(g); i++)
+      {
+         int face, o;
+         if (i < ntri) { pmesh.GroupTriangle(g, i, face, o); }
+         else { pmesh.GroupQuadrilateral(g, i - ntri, face, o); }
+         pmesh.GetFaceVertices(face, ev);
+         add_entity(g);
+      }
+   }
+   const int nent = ent_group.Size();
+   if (pmesh.GetNRanks() > 1) { REQUIRE(pmesh.ReduceInt(nent) > 0); }
+
+   // The coordinates of the vertices of each entity, in lexicographic order
+   // and padded with zeros
+   std::vector<std::vector<double>> coords(nent);
+   for (int i = 0; i < nent; i++)
+   {
+      std::vector<std::vector<double>> verts;
+      for (int k = 0; k < max_nv && ent_verts[max_nv*i + k] >= 0; k++)
+      {
+         const double *x = pmesh.GetVertex(ent_verts[max_nv*i + k]);
+         verts.emplace_back(x, x + sdim);
+      }
+      std::sort(verts.begin(), verts.end());
+      for (const auto &x : verts)
+      {
+         coords[i].insert(coords[i].end(), x.begin(), x.end());
+      }
+      coords[i].resize(max_nv*sdim, 0.0);
+   }
+
+   GroupCommunicator gc(pmesh.gtopo);
+   gc.Create(ent_group);
+   Array<double> master(nent);
+   for (int c = 0; c < max_nv*sdim; c++)
+   {
+      for (int i = 0; i < nent; i++) { master[i] = coords[i][c]; }
+      gc.Bcast(master);
+      for (int i = 0; i < nent; i++)
+      {
+         REQUIRE(master[i] == Approx(coords[i][c]));
+      }
+   }
+}
+
+// Test case: Read the pieces of a PVTU file in parallel, one or more pieces
+//            per rank, and compare with the serial reader.
+static void test_pvtu_reader(const Mesh &mesh)
+{
+   int rank, num_procs;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+
+   const std::string filename = "test_pmesh_pvtu.pvtu";
+   const int npieces = num_procs + 1;
+   if (rank == 0) { write_pvtu_pieces(mesh, filename, npieces); }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   Mesh serial;
+   Array<int> piece;
+   serial.LoadPVTU(filename, piece);
+   ParMesh pmesh(MPI_COMM_WORLD, filename);
+
+   // The block of pieces of each rank
+   Array<int> piece_rank(npieces);
+   for (int r = 0; r < num_procs; r++)
+   {
+      for (int p = (r*npieces)/num_procs; p < ((r+1)*npieces)/num_procs; p++)
+      {
+         piece_rank[p] = r;
+      }
+   }
+   int ne = 0, nbe = 0, nsf = 0;
+   double volume = 0.0;
+   for (int i = 0; i < serial.GetNE(); i++)
+   {
+      if (piece_rank[piece[i]] != rank) { continue; }
+      ne++;
+      volume += serial.GetElementVolume(i);
+   }
+   Array<int> faces_bdr(serial.GetNumFaces());
+   faces_bdr = 0;
+   for (int i = 0; i < serial.GetNBE(); i++)
+   {
+      faces_bdr[serial.GetBdrElementEdgeIndex(i)] = 1;
+   }
+   for (int f = 0; f < serial.GetNumFaces(); f++)
+   {
+      int e1, e2;
+      serial.GetFaceElements(f, &e1, &e2);
+      if (faces_bdr[f] && piece_rank[piece[e1]] == rank) { nbe++; }
+      if (e2 >= 0 && (piece_rank[piece[e1]] == rank) !=
+          (piece_rank[piece[e2]] == rank)) { nsf++; }
+   }
+
+   REQUIRE(pmesh.Dimension() == serial.Dimension());
+   REQUIRE(pmesh.GetNE() == ne);
+   REQUIRE(pmesh.GetNBE() == nbe);
+   REQUIRE(pmesh.GetNSharedFaces() == nsf);
+   REQUIRE(pmesh.GetGlobalNE() == serial.GetNE());
+   double pvolume = 0.0;
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      pvolume += pmesh.GetElementVolume(i);
+   }
+   REQUIRE(pvolume == Approx(volume));
+   check_shared_entities(pmesh);
+
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0)
+   {
+      std::remove(filename.c_str());
+      for (int p = 0; p < npieces; p++)
+      {
+         std::remove(("test_pmesh_pvtu_" + std::to_string(p) + ".vtu").c_str());
+      }
+   }
+}
+
+TEST_CASE("ParMesh PVTU reader", "[Parallel], [ParMesh]")
+{
+   SECTION("Quad mesh")
+   {
+      Mesh mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0);
+      test_pvtu_reader(mesh);
+   }
+
+   SECTION("Tri mesh")
+   {
+      Mesh mesh(2, 2, Element::TRIANGLE, true, 1.0, 1.0);
+      test_pvtu_reader(mesh);
+   }
+
+   SECTION("Hex mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      test_pvtu_reader(mesh);
+   }
+
+   SECTION("Tet mesh")
+   {
+      Mesh mesh(2, 2, 2, Element::TETRAHEDRON, true, 1.0, 1.0, 1.0);
+      test_pvtu_reader(mesh);
+   }
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
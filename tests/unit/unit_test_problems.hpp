@@ -0,0 +1,56 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_UNIT_TEST_PROBLEMS
+#define MFEM_UNIT_TEST_PROBLEMS
+
+#include "mfem.hpp"
+
+// Coefficients and checks shared by the unit tests of the solvers and of the
+// partially assembled operators.
+namespace unit_test_problems
+{
+
+/// Smooth positive coefficient.
+inline double coeff(const mfem::Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+/// Rotating 2D velocity field of the convection-diffusion test problems.
+inline void velocity(const mfem::Vector &x, mfem::Vector &v)
+{
+   v(0) = 20.0*x(1);
+   v(1) = -10.0*x(0);
+}
+
+/// Smooth velocity field in 2D and 3D.
+inline void smooth_velocity(const mfem::Vector &x, mfem::Vector &v)
+{
+   v.SetSize(x.Size());
+   v(0) = 1.0 + x(1);
+   v(1) = -0.5 + x(0);
+   if (x.Size() == 3) { v(2) = 0.25 - x(0)*x(1); }
+}
+
+/// Relative residual |A x - b|_inf / |b|_inf.
+inline double Residual(const mfem::Operator &A, const mfem::Vector &b,
+                       const mfem::Vector &x)
+{
+   mfem::Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   return r.Normlinf()/b.Normlinf();
+}
+
+} // namespace unit_test_problems
+
+#endif